@@ -23,9 +23,10 @@
 #ifndef DEMO_INCLUDE_AGGREGATE_STATISTICS_HPP
 #define DEMO_INCLUDE_AGGREGATE_STATISTICS_HPP
 
-#include <iostream>
 #include <map>
+#include <memory_resource>
 
+#include "Logger.hpp"
 #include "Statistics.hpp"
 #include "Vehicles.hpp"
 
@@ -33,29 +34,54 @@ namespace Demo {
 
 // Collection of vehicle model aggregate statistics.
 class AggregateStatistics {
+private:
+  // Tree map of vehicle model IDs to statistics.
+  using StatisticsMap = std::pmr::map<VehicleModelId, Statistics>;
+
 public:
   // Constructs an empty collection of aggregate statistics.
   AggregateStatistics() noexcept = default;
 
+  // Constructs an empty collection of aggregate statistics that draws its memory from a given
+  // memory resource, which must outlive this collection.
+  explicit AggregateStatistics(std::pmr::memory_resource* const resource) noexcept
+    : vehicle_model_ids_to_statistics_(resource) {}
+
   // Constructs the collection of aggregate statistics of each vehicle model by aggregating the
-  // statistics of the individual vehicles of each model.
-  AggregateStatistics(const Vehicles& vehicles) noexcept {
+  // statistics of the individual vehicles of each model, including the vehicles retired from the
+  // collection during the simulation. The collection draws its memory from a given memory resource,
+  // which must outlive it.
+  AggregateStatistics(const Vehicles& vehicles, std::pmr::memory_resource* const resource =
+                                                    std::pmr::get_default_resource()) noexcept
+    : vehicle_model_ids_to_statistics_(resource) {
     for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
       if (vehicle != nullptr && vehicle->Model() != nullptr) {
-        // Attempt to insert this vehicle's statistics into the aggregate vehicle model statistics
-        // map.
-        const std::pair<std::map<VehicleModelId, Statistics>::iterator, bool> result =
-            vehicle_model_ids_to_statistics_.emplace(vehicle->Model()->Id(), vehicle->Statistics());
-
-        if (!result.second) {
-          // In this case, this vehicle model is already in the map, so aggregate its existing
-          // statistics with this individual vehicle's statistics.
-          result.first->second.Aggregate(vehicle->Statistics());
-        }
+        Aggregate(vehicle->Model()->Id(), vehicle->Statistics());
       }
     }
 
-    std::cout << "Computed the aggregate statistics." << std::endl;
+    for (const std::pair<const VehicleId, std::shared_ptr<Vehicle>>& id_and_vehicle :
+         vehicles.Retired()) {
+      if (id_and_vehicle.second->Model() != nullptr) {
+        Aggregate(id_and_vehicle.second->Model()->Id(), id_and_vehicle.second->Statistics());
+      }
+    }
+
+    Log(LogLevel::Information) << "Computed the aggregate statistics.";
+  }
+
+  // Aggregates the statistics of an individual vehicle of a given vehicle model into the aggregate
+  // statistics of that vehicle model.
+  void Aggregate(const VehicleModelId id, const Statistics& statistics) noexcept {
+    // Attempt to insert this vehicle's statistics into the aggregate vehicle model statistics map.
+    const std::pair<StatisticsMap::iterator, bool> result =
+        vehicle_model_ids_to_statistics_.try_emplace(id, statistics);
+
+    if (!result.second) {
+      // In this case, this vehicle model is already in the map, so aggregate its existing
+      // statistics with this individual vehicle's statistics.
+      result.first->second.Aggregate(statistics);
+    }
   }
 
   // Returns whether the collection is empty.
@@ -71,7 +97,7 @@ public:
   // Returns the aggregate statistics corresponding to a given vehicle model ID, or std::nullopt if
   // that vehicle model ID is not found in this collection.
   const std::optional<Statistics> At(const VehicleModelId id) const noexcept {
-    const std::map<VehicleModelId, Statistics>::const_iterator vehicle_model_id_and_statistics =
+    const StatisticsMap::const_iterator vehicle_model_id_and_statistics =
         vehicle_model_ids_to_statistics_.find(id);
 
     if (vehicle_model_id_and_statistics != vehicle_model_ids_to_statistics_.cend()) {
@@ -81,9 +107,9 @@ public:
     return std::nullopt;
   }
 
-  struct const_iterator : public std::map<VehicleModelId, Statistics>::const_iterator {
-    const_iterator(const std::map<VehicleModelId, Statistics>::const_iterator i) noexcept
-      : std::map<VehicleModelId, Statistics>::const_iterator(i) {}
+  struct const_iterator : public StatisticsMap::const_iterator {
+    const_iterator(const StatisticsMap::const_iterator i) noexcept
+      : StatisticsMap::const_iterator(i) {}
   };
 
   const_iterator begin() const noexcept {
@@ -108,7 +134,7 @@ private:
   // implementation assumes that only a small number of vehicle models are used, say 20 or fewer. If
   // more vehicle models are used, this implementation should instead use a hash map rather than a
   // binary tree map.
-  std::map<VehicleModelId, Statistics> vehicle_model_ids_to_statistics_;
+  StatisticsMap vehicle_model_ids_to_statistics_;
 };
 
 }  // namespace Demo
@@ -41,12 +41,83 @@ static const std::string ChargingStationsPattern{ChargingStationsKey + " <number
 static const std::string DurationKey{"--duration-hours"};
 static const std::string DurationPattern{DurationKey + " <number>"};
 
+static const std::string FleetMixKey{"--fleet-mix"};
+static const std::string FleetMixPattern{FleetMixKey + " <weights>"};
+
+static const std::string FleetMixExactKey{"--fleet-mix-exact"};
+
+static const std::string RosterKey{"--roster"};
+static const std::string RosterPattern{RosterKey + " <path>"};
+
+static const std::string VehicleModelsKey{"--vehicle-models"};
+static const std::string VehicleModelsPattern{VehicleModelsKey + " <path>"};
+
 static const std::string ResultsKey{"--results"};
 static const std::string ResultsPattern{ResultsKey + " <path>"};
 
 static const std::string SeedKey{"--seed"};
 static const std::string SeedPattern{SeedKey + " <number>"};
 
+static const std::string LogFileKey{"--log-file"};
+static const std::string LogFilePattern{LogFileKey + " <path>"};
+
+static const std::string LogLevelKey{"--log-level"};
+static const std::string LogLevelPattern{LogLevelKey + " <level>"};
+
+static const std::string LogRateLimitKey{"--log-rate-limit"};
+static const std::string LogRateLimitPattern{LogRateLimitKey + " <number>"};
+
+static const std::string TraceKey{"--trace"};
+static const std::string TracePattern{TraceKey + " <path>"};
+
+static const std::string TraceSamplingKey{"--trace-sampling"};
+static const std::string TraceSamplingPattern{TraceSamplingKey + " <number>"};
+
+static const std::string TransitionLogKey{"--transition-log"};
+static const std::string TransitionLogPattern{TransitionLogKey + " <path>"};
+
+static const std::string FlightRecorderKey{"--flight-recorder"};
+static const std::string FlightRecorderPattern{FlightRecorderKey + " <path>"};
+
+static const std::string FlightRecorderCapacityKey{"--flight-recorder-capacity"};
+static const std::string FlightRecorderCapacityPattern{FlightRecorderCapacityKey + " <number>"};
+
+static const std::string TimelineKey{"--timeline"};
+static const std::string TimelinePattern{TimelineKey + " <path>"};
+
+static const std::string PerfCountersKey{"--perf-counters"};
+static const std::string PerfCountersPattern{PerfCountersKey + " <path>"};
+
+static const std::string OutputKey{"--output"};
+static const std::string OutputPattern{OutputKey + " <path>"};
+
+static const std::string BaselineKey{"--baseline"};
+static const std::string BaselinePattern{BaselineKey + " <path>"};
+
+static const std::string ThresholdKey{"--threshold"};
+static const std::string ThresholdPattern{ThresholdKey + " <number>"};
+
+static const std::string FilterKey{"--filter"};
+static const std::string FilterPattern{FilterKey + " <text>"};
+
+static const std::string ThreadsKey{"--threads"};
+static const std::string ThreadsPattern{ThreadsKey + " <number>"};
+
+static const std::string MaxVehiclesKey{"--max-vehicles"};
+static const std::string MaxVehiclesPattern{MaxVehiclesKey + " <number>"};
+
+static const std::string MaxChargingStationsKey{"--max-charging-stations"};
+static const std::string MaxChargingStationsPattern{MaxChargingStationsKey + " <number>"};
+
+static const std::string PointsPerDecadeKey{"--points-per-decade"};
+static const std::string PointsPerDecadePattern{PointsPerDecadeKey + " <number>"};
+
+static const std::string TimeLimitKey{"--time-limit-seconds"};
+static const std::string TimeLimitPattern{TimeLimitKey + " <number>"};
+
+static const std::string MaxExponentKey{"--max-exponent"};
+static const std::string MaxExponentPattern{MaxExponentKey + " <number>"};
+
 }  // namespace Arguments
 
 }  // namespace Demo
@@ -0,0 +1,232 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_ASYNC_BINARY_FILE_WRITER_HPP
+#define DEMO_INCLUDE_ASYNC_BINARY_FILE_WRITER_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Demo {
+
+// Binary file writer that writes data in blocks from a background thread. The producer fills one
+// block at a time in memory; full blocks are handed over to the background thread, which writes
+// them to the file while the producer continues filling the next block. Only the hand-over of a
+// block takes a lock. If every block is waiting to be written, the producer waits for one to be
+// freed. This class is not thread-safe on the producer side: a single thread should write to it.
+class AsyncBinaryFileWriter {
+public:
+  // Creates and opens a binary file for writing at the given path and starts the background
+  // thread. Data is buffered in a given number of blocks of a given size in bytes.
+  AsyncBinaryFileWriter(const std::filesystem::path& path, const std::size_t block_size = 1 << 20,
+                        const std::size_t block_count = 4) noexcept
+    : path_(path), block_size_(std::max<std::size_t>(block_size, 64)) {
+    if (!path_.empty()) {
+      stream_ = std::fopen(path_.string().c_str(), "wb");
+    }
+    if (stream_ == nullptr) {
+      Log(LogLevel::Error) << "Could not open the file: " << path_.string();
+      return;
+    }
+    for (std::size_t index = 0; index < std::max<std::size_t>(block_count, 2); ++index) {
+      free_blocks_.push_back(std::make_unique<uint8_t[]>(block_size_));
+    }
+    AcquireBlock();
+    thread_ = std::thread(&AsyncBinaryFileWriter::WriteBlocks, this);
+  }
+
+  AsyncBinaryFileWriter(const AsyncBinaryFileWriter& other) = delete;
+
+  AsyncBinaryFileWriter& operator=(const AsyncBinaryFileWriter& other) = delete;
+
+  // Destructor. Writes all remaining data, stops the background thread, and closes the file.
+  ~AsyncBinaryFileWriter() noexcept {
+    if (stream_ == nullptr) {
+      return;
+    }
+    SubmitBlock();
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+    std::fclose(stream_);
+  }
+
+  // Path to this file.
+  const std::filesystem::path& Path() const noexcept {
+    return path_;
+  }
+
+  // Returns whether this file is open.
+  bool IsOpen() const noexcept {
+    return stream_ != nullptr;
+  }
+
+  // Size in bytes of each block.
+  std::size_t BlockSize() const noexcept {
+    return block_size_;
+  }
+
+  // Total number of bytes written to this file so far, including bytes that are still buffered.
+  uint64_t Size() const noexcept {
+    return submitted_size_ + static_cast<uint64_t>(cursor_ - block_begin_);
+  }
+
+  // Number of bytes remaining in the current block.
+  std::size_t Remaining() const noexcept {
+    return static_cast<std::size_t>(block_end_ - cursor_);
+  }
+
+  // Returns a pointer to at least a given number of writable bytes, which must not exceed the block
+  // size. If the current block does not have enough room, it is submitted first. The bytes that are
+  // actually written must then be committed with Commit. Returns nullptr if the file is not open.
+  uint8_t* Reserve(const std::size_t size) noexcept {
+    if (static_cast<std::size_t>(block_end_ - cursor_) < size) {
+      SubmitBlock();
+    }
+    return cursor_;
+  }
+
+  // Commits the bytes written since the last call to Reserve, up to but excluding a given pointer.
+  void Commit(uint8_t* const end) noexcept {
+    cursor_ = end;
+  }
+
+  // Writes a given number of bytes, splitting them across blocks as needed.
+  void Write(const void* data, std::size_t size) noexcept {
+    if (stream_ == nullptr) {
+      return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+      if (cursor_ == block_end_) {
+        SubmitBlock();
+      }
+      const std::size_t chunk = std::min(size, static_cast<std::size_t>(block_end_ - cursor_));
+      std::memcpy(cursor_, bytes, chunk);
+      cursor_ += chunk;
+      bytes += chunk;
+      size -= chunk;
+    }
+  }
+
+  // Hands the current block over to the background thread, even if it is not full, and begins a
+  // new block. Does nothing if the current block is empty.
+  void SubmitBlock() noexcept {
+    if (stream_ == nullptr || cursor_ == block_begin_) {
+      return;
+    }
+    const std::size_t size = static_cast<std::size_t>(cursor_ - block_begin_);
+    submitted_size_ += size;
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      pending_blocks_.push_back({std::move(block_), size});
+    }
+    condition_.notify_all();
+    AcquireBlock();
+  }
+
+private:
+  // Block of data waiting to be written, along with its size in bytes.
+  struct PendingBlock {
+    std::unique_ptr<uint8_t[]> data;
+    std::size_t size = 0;
+  };
+
+  // Takes a free block, waiting for the background thread to free one if needed, and makes it the
+  // current block.
+  void AcquireBlock() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return !free_blocks_.empty(); });
+    block_ = std::move(free_blocks_.back());
+    free_blocks_.pop_back();
+    block_begin_ = block_.get();
+    block_end_ = block_begin_ + block_size_;
+    cursor_ = block_begin_;
+  }
+
+  // Main loop of the background thread. Writes pending blocks in order until stopped.
+  void WriteBlocks() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      condition_.wait(lock, [this] { return stopping_ || !pending_blocks_.empty(); });
+      if (pending_blocks_.empty()) {
+        return;
+      }
+      PendingBlock pending = std::move(pending_blocks_.front());
+      pending_blocks_.pop_front();
+      lock.unlock();
+      std::fwrite(pending.data.get(), 1, pending.size, stream_);
+      lock.lock();
+      free_blocks_.push_back(std::move(pending.data));
+      condition_.notify_all();
+    }
+  }
+
+  std::filesystem::path path_;
+
+  std::FILE* stream_ = nullptr;
+
+  const std::size_t block_size_;
+
+  // Current block being filled by the producer.
+  std::unique_ptr<uint8_t[]> block_;
+
+  uint8_t* block_begin_ = nullptr;
+
+  uint8_t* block_end_ = nullptr;
+
+  uint8_t* cursor_ = nullptr;
+
+  // Total size in bytes of the blocks submitted so far.
+  uint64_t submitted_size_ = 0;
+
+  // Blocks waiting to be written and blocks available to the producer, protected by the mutex.
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  std::deque<PendingBlock> pending_blocks_;
+
+  std::vector<std::unique_ptr<uint8_t[]>> free_blocks_;
+
+  bool stopping_ = false;
+
+  std::thread thread_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_ASYNC_BINARY_FILE_WRITER_HPP
@@ -0,0 +1,272 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_BATCH_SAMPLER_HPP
+#define DEMO_INCLUDE_BATCH_SAMPLER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace Demo {
+
+// Number of terms of the Poisson cumulative distribution that are tabulated for each draw. Draws
+// whose uniform variate exceeds the tabulated terms continue with a sequential search.
+inline constexpr int64_t PoissonTableTerms = 4;
+
+// Largest mean for which Poisson variates are drawn by inversion. Larger means are drawn with
+// std::poisson_distribution, whose rejection method does not slow down as the mean grows.
+inline constexpr double PoissonInversionMeanLimit = 10.0;
+
+// Returns the number of the first PoissonTableTerms terms of the cumulative distribution of a
+// Poisson distribution of a given mean that a given uniform variate exceeds, given the exponential
+// of the negative of the mean. This is the variate drawn by inversion if it is less than
+// PoissonTableTerms. Has no branches, so that a loop of draws is vectorized by the compiler.
+inline int64_t PoissonTableCount(
+    const double mean, const double exp_minus_mean, const double uniform) noexcept {
+  constexpr std::array<double, PoissonTableTerms> reciprocals{1.0, 1.0 / 2.0, 1.0 / 3.0, 1.0 / 4.0};
+  int64_t count = 0;
+  double probability = exp_minus_mean;
+  double cumulative = probability;
+  for (int64_t term = 0; term < PoissonTableTerms; ++term) {
+    count += static_cast<int64_t>(uniform > cumulative);
+    probability *= mean * reciprocals[term];
+    cumulative += probability;
+  }
+  return count;
+}
+
+// Returns the Poisson variate of a given mean drawn by sequential search inversion from a given
+// uniform variate, given the exponential of the negative of the mean.
+inline int64_t PoissonSearch(
+    const double mean, const double exp_minus_mean, const double uniform) noexcept {
+  int64_t count = 0;
+  double probability = exp_minus_mean;
+  double cumulative = probability;
+  while (uniform > cumulative && probability > 0.0) {
+    ++count;
+    probability *= mean / static_cast<double>(count);
+    cumulative += probability;
+  }
+  return count;
+}
+
+// Draws batches of uniform, exponential, and Poisson variates. The uniform variates come from
+// eight interleaved xoshiro256+ generators whose states are stored as structure-of-arrays, so that
+// the compiler generates them with SIMD instructions, and they are generated in bulk into a buffer
+// from which all variates are drawn. Poisson variates of small means, such as the expected number
+// of faults of a vehicle during a time step, are drawn by inversion against a table of the first
+// terms of their cumulative distribution, which costs one exponential and no branches per draw.
+//
+// This class satisfies the uniform random bit generator requirements, so that it can also be used
+// with the distributions of the standard library.
+class BatchSampler {
+public:
+  using result_type = uint64_t;
+
+  // Number of interleaved generators.
+  static constexpr std::size_t Lanes = 8;
+
+  // Number of uniform variates generated in bulk at once.
+  static constexpr std::size_t BufferSize = 512;
+
+  // Constructs a sampler whose generators are seeded from a given seed.
+  explicit BatchSampler(const uint64_t seed) noexcept {
+    uint64_t state = seed;
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+      state_0_[lane] = SplitMix64(state);
+      state_1_[lane] = SplitMix64(state);
+      state_2_[lane] = SplitMix64(state);
+      state_3_[lane] = SplitMix64(state);
+    }
+  }
+
+  // Constructs a sampler whose generators are seeded from one draw of a given random generator.
+  explicit BatchSampler(std::mt19937_64& random_generator) noexcept
+    : BatchSampler(static_cast<uint64_t>(random_generator())) {}
+
+  static constexpr result_type min() noexcept {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  // Returns the next random 64-bit value.
+  result_type operator()() noexcept {
+    if (next_ == BufferSize) {
+      Refill();
+    }
+    return bits_[next_++];
+  }
+
+  // Returns the next uniform variate in [0, 1).
+  double Uniform() noexcept {
+    return ToUniform(operator()());
+  }
+
+  // Fills a given array with a given number of uniform variates in [0, 1).
+  void Uniform(double* const values, const std::size_t count) noexcept {
+    std::size_t filled = 0;
+    while (filled < count) {
+      if (next_ == BufferSize) {
+        Refill();
+      }
+      const std::size_t size = std::min(count - filled, BufferSize - next_);
+      for (std::size_t index = 0; index < size; ++index) {
+        values[filled + index] = ToUniform(bits_[next_ + index]);
+      }
+      next_ += size;
+      filled += size;
+    }
+  }
+
+  // Fills a given array with exponential variates, one for each of a given number of positive
+  // rates.
+  void Exponential(
+      const double* const rates, const std::size_t count, double* const values) noexcept {
+    for (std::size_t begin = 0; begin < count; begin += BufferSize) {
+      const std::size_t size = std::min(BufferSize, count - begin);
+      Uniform(uniforms_.data(), size);
+      for (std::size_t index = 0; index < size; ++index) {
+        values[begin + index] = -std::log(1.0 - uniforms_[index]) / rates[begin + index];
+      }
+    }
+  }
+
+  // Returns a Poisson variate of a given non-negative mean.
+  int64_t Poisson(const double mean) noexcept {
+    if (mean > PoissonInversionMeanLimit) {
+      std::poisson_distribution<int64_t> distribution(mean);
+      return distribution(*this);
+    }
+    const double uniform = Uniform();
+    const double exp_minus_mean = std::exp(-mean);
+    const int64_t count = PoissonTableCount(mean, exp_minus_mean, uniform);
+    if (count < PoissonTableTerms) {
+      return count;
+    }
+    return PoissonSearch(mean, exp_minus_mean, uniform);
+  }
+
+  // Fills a given array with Poisson variates, one for each of a given number of non-negative
+  // means. The uniform variates, the exponentials of the means, and the table inversions are each
+  // computed in one pass over the whole batch, and only the rare draws that exceed the table are
+  // completed one at a time. Draws the same variates as calling Poisson for each mean in turn, as
+  // long as no mean exceeds PoissonInversionMeanLimit.
+  void Poisson(const double* const means, const std::size_t count, int64_t* const values) noexcept {
+    for (std::size_t begin = 0; begin < count; begin += BufferSize) {
+      const std::size_t size = std::min(BufferSize, count - begin);
+      const double* const batch_means = means + begin;
+      int64_t* const batch_values = values + begin;
+      Uniform(uniforms_.data(), size);
+      for (std::size_t index = 0; index < size; ++index) {
+        exp_minus_means_[index] = std::exp(-batch_means[index]);
+      }
+      for (std::size_t index = 0; index < size; ++index) {
+        batch_values[index] =
+            PoissonTableCount(batch_means[index], exp_minus_means_[index], uniforms_[index]);
+      }
+      for (std::size_t index = 0; index < size; ++index) {
+        if (batch_means[index] > PoissonInversionMeanLimit) {
+          std::poisson_distribution<int64_t> distribution(batch_means[index]);
+          batch_values[index] = distribution(*this);
+        } else if (batch_values[index] == PoissonTableTerms) {
+          batch_values[index] =
+              PoissonSearch(batch_means[index], exp_minus_means_[index], uniforms_[index]);
+        }
+      }
+    }
+  }
+
+private:
+  // Advances a SplitMix64 state and returns its next output. Used to seed the generators.
+  static constexpr uint64_t SplitMix64(uint64_t& state) noexcept {
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t value = state;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+  }
+
+  // Converts the upper 53 bits of a given random 64-bit value to a uniform variate in [0, 1).
+  static constexpr double ToUniform(const uint64_t bits) noexcept {
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+  }
+
+  // Generates a buffer of random 64-bit values, advancing each generator in turn. The loop over the
+  // generators has no dependencies between its iterations, so it is vectorized by the compiler.
+  void Refill() noexcept {
+    for (std::size_t begin = 0; begin < BufferSize; begin += Lanes) {
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        bits_[begin + lane] = state_0_[lane] + state_3_[lane];
+        const uint64_t shifted = state_1_[lane] << 17;
+        state_2_[lane] ^= state_0_[lane];
+        state_3_[lane] ^= state_1_[lane];
+        state_1_[lane] ^= state_2_[lane];
+        state_0_[lane] ^= state_3_[lane];
+        state_2_[lane] ^= shifted;
+        state_3_[lane] = (state_3_[lane] << 45) | (state_3_[lane] >> 19);
+      }
+    }
+    next_ = 0;
+  }
+
+  alignas(64) std::array<uint64_t, Lanes> state_0_{};
+
+  alignas(64) std::array<uint64_t, Lanes> state_1_{};
+
+  alignas(64) std::array<uint64_t, Lanes> state_2_{};
+
+  alignas(64) std::array<uint64_t, Lanes> state_3_{};
+
+  // Buffer of random 64-bit values generated in bulk.
+  alignas(64) std::array<uint64_t, BufferSize> bits_{};
+
+  // Position of the next unused value in the buffer.
+  std::size_t next_ = BufferSize;
+
+  // Scratch buffers of uniform variates and exponentials for batches of draws.
+  alignas(64) std::array<double, BufferSize> uniforms_{};
+
+  alignas(64) std::array<double, BufferSize> exp_minus_means_{};
+};
+
+// Draws a Poisson variate of a given mean from a given standard random generator.
+inline int64_t DrawPoisson(const double mean, std::mt19937_64& random_generator) noexcept {
+  std::poisson_distribution<int64_t> distribution(mean);
+  return distribution(random_generator);
+}
+
+// Draws a Poisson variate of a given mean from a given batch sampler.
+inline int64_t DrawPoisson(const double mean, BatchSampler& sampler) noexcept {
+  return sampler.Poisson(mean);
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_BATCH_SAMPLER_HPP
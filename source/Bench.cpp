@@ -0,0 +1,540 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AggregateStatistics.hpp"
+#include "Arguments.hpp"
+#include "BatchSampler.hpp"
+#include "Benchmark.hpp"
+#include "CatalogKernels.hpp"
+#include "ChargingStation.hpp"
+#include "ChargingStations.hpp"
+#include "EventCountingObserver.hpp"
+#include "FleetComposition.hpp"
+#include "FleetKernels.hpp"
+#include "Logger.hpp"
+#include "ResultsFileWriter.hpp"
+#include "Roster.hpp"
+#include "SampleVehicleModels.hpp"
+#include "Simulation.hpp"
+#include "Statistics.hpp"
+#include "VehicleGroup.hpp"
+#include "Vehicles.hpp"
+
+namespace {
+
+// Number of vehicles of the fleet kernel benchmarks.
+constexpr int64_t KernelVehicles = 1'000'000;
+
+// State of a flying vehicle that is updated one object at a time through physical quantities, as
+// Vehicle::Fly does.
+struct FlyingVehicle {
+  PhQ::Energy<> battery = PhQ::Energy<>::Zero();
+
+  const Demo::VehicleModelTable* model_table = nullptr;
+
+  Demo::VehicleModelIndex model_index = Demo::NoVehicleModel;
+
+  Demo::Statistics statistics;
+};
+
+// Default regression threshold as a fraction of the baseline time per operation.
+constexpr double DefaultThreshold = 0.2;
+
+// Runs all benchmarks.
+void RunBenchmarks(Demo::BenchmarkRunner& runner) noexcept {
+  const Demo::VehicleModels vehicle_models = [] {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    return Demo::GenerateSampleVehicleModels();
+  }();
+
+  // Simulation throughput in vehicle events per second.
+  runner.Run("Simulation/1000Vehicles",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+               uint64_t events = 0;
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 timer.Pause();
+                 std::mt19937_64 random_generator(iteration);
+                 std::optional<Demo::Vehicles> vehicles;
+                 {
+                   const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+                   vehicles.emplace(1000, vehicle_models, random_generator);
+                 }
+                 Demo::ChargingStations charging_stations{30};
+                 timer.Resume();
+                 Demo::Simulation<Demo::EventCountingObserver> simulation{
+                     PhQ::Time(3.0, PhQ::Unit::Time::Hour), vehicles.value(), charging_stations,
+                     random_generator};
+                 simulation.Run();
+                 events += simulation.Observer().events;
+               }
+               return events;
+             });
+
+  // Construction and destruction of a fleet and its charging stations on the heap, per vehicle.
+  runner.Run("Fleet/10000Vehicles", [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+      timer.Pause();
+      std::mt19937_64 random_generator(iteration);
+      timer.Resume();
+      const Demo::Vehicles vehicles{10000, vehicle_models, random_generator};
+      const Demo::ChargingStations charging_stations{300};
+      Demo::DoNotOptimize(vehicles);
+      Demo::DoNotOptimize(charging_stations);
+    }
+    return iterations * 10000;
+  });
+
+  // Construction of a fleet and its charging stations in an arena that is released at once, per
+  // vehicle, as a batch driver that runs many short simulations would do. The arena starts with
+  // enough memory for the whole fleet.
+  runner.Run("Fleet/10000VehiclesArena",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+               const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+               std::pmr::monotonic_buffer_resource arena{std::size_t{1} << 22};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 timer.Pause();
+                 std::mt19937_64 random_generator(iteration);
+                 timer.Resume();
+                 {
+                   const Demo::Vehicles vehicles{10000, vehicle_models, random_generator, &arena};
+                   const Demo::ChargingStations charging_stations{300, &arena};
+                   Demo::DoNotOptimize(vehicles);
+                   Demo::DoNotOptimize(charging_stations);
+                 }
+                 arena.release();
+               }
+               return iterations * 10000;
+             });
+
+  // Construction of a large fleet from a fleet composition using one thread per hardware thread,
+  // per vehicle.
+  runner.Run("Fleet/1000000VehiclesParallel",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+               const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+               const Demo::FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 timer.Pause();
+                 std::mt19937_64 random_generator(iteration);
+                 timer.Resume();
+                 const Demo::Vehicles vehicles{1'000'000, vehicle_models, composition,
+                                               random_generator, std::pmr::new_delete_resource(),
+                                               0};
+                 Demo::DoNotOptimize(vehicles);
+               }
+               return iterations * 1'000'000;
+             });
+
+  // Loading of a large fleet from a memory-mapped roster file in each format using one thread per
+  // hardware thread, per vehicle. The roster files are written once, on first use.
+  for (const Demo::RosterFormat format : {Demo::RosterFormat::Csv, Demo::RosterFormat::Binary}) {
+    const bool csv = format == Demo::RosterFormat::Csv;
+    const std::filesystem::path roster_path =
+        std::filesystem::temp_directory_path() / (csv ? "joby-bench.csv" : "joby-bench.roster");
+    bool written = false;
+    runner.Run(csv ? "Roster/Load1000000Csv" : "Roster/Load1000000Binary",
+               [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+                 const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+                 if (!written) {
+                   timer.Pause();
+                   std::vector<Demo::RosterEntry> entries(1'000'000);
+                   for (std::size_t index = 0; index < entries.size(); ++index) {
+                     entries[index] = {static_cast<Demo::VehicleId>(index),
+                                       static_cast<Demo::VehicleModelId>(index % 5),
+                                       0.125 * static_cast<double>(index % 9),
+                                       static_cast<Demo::ChargingStationId>(index % 100)};
+                   }
+                   const Demo::RosterFileWriter writer{roster_path, entries, format};
+                   written = true;
+                   timer.Resume();
+                 }
+                 for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                   const Demo::Vehicles vehicles{Demo::Roster{roster_path}, vehicle_models,
+                                                 std::pmr::new_delete_resource(), 0};
+                   Demo::DoNotOptimize(vehicles);
+                 }
+                 return iterations * 1'000'000;
+               });
+    std::filesystem::remove(roster_path);
+  }
+
+  // Drawing of the vehicle models of a fleet, per vehicle, one uniform draw at a time as the fleet
+  // constructor does and in bulk from an alias table.
+  runner.Run("Fleet/DrawModels1000000Uniform",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               std::mt19937_64 random_generator(1);
+               std::vector<std::size_t> indices(1'000'000);
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 for (std::size_t& index : indices) {
+                   index = vehicle_models.RandomIndex(random_generator);
+                 }
+                 Demo::DoNotOptimize(indices);
+               }
+               return iterations * 1'000'000;
+             });
+
+  runner.Run("Fleet/DrawModels1000000Alias",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               std::mt19937_64 random_generator(1);
+               const Demo::FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 const std::vector<uint32_t> indices =
+                     composition.Draw(1'000'000, random_generator);
+                 Demo::DoNotOptimize(indices);
+               }
+               return iterations * 1'000'000;
+             });
+
+  // Lookup of vehicles by vehicle ID, per lookup, in a fleet with dense vehicle IDs and in one
+  // with sparse vehicle IDs.
+  {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    std::mt19937_64 random_generator(1);
+    const Demo::Vehicles dense_vehicles{100000, vehicle_models, random_generator};
+    Demo::Vehicles sparse_vehicles;
+    for (const std::shared_ptr<Demo::Vehicle>& vehicle : dense_vehicles) {
+      sparse_vehicles.Insert(
+          std::make_shared<Demo::Vehicle>(
+              7 * vehicle->Id() + 1000, vehicle->ModelTable(), vehicle->ModelIndex()));
+    }
+    std::vector<Demo::VehicleId> ids(1 << 16);
+    std::uniform_int_distribution<Demo::VehicleId> distribution(0, 99999);
+    for (Demo::VehicleId& id : ids) {
+      id = distribution(random_generator);
+    }
+
+    runner.Run("Vehicles/AtDense100000",
+               [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+                 for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                   for (const Demo::VehicleId id : ids) {
+                     Demo::DoNotOptimize(dense_vehicles.Find(id));
+                   }
+                 }
+                 return iterations * ids.size();
+               });
+    runner.Run("Vehicles/AtSparse100000",
+               [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+                 for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                   for (const Demo::VehicleId id : ids) {
+                     Demo::DoNotOptimize(sparse_vehicles.Find(7 * id + 1000));
+                   }
+                 }
+                 return iterations * ids.size();
+               });
+  }
+
+  // Selection of the charging station with the shortest queue.
+  runner.Run("ChargingStations/LowestCount",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+               timer.Pause();
+               Demo::ChargingStations charging_stations{1000};
+               for (Demo::ChargingStationId id = 0; id < 1000; ++id) {
+                 for (Demo::VehicleId vehicle_id = 0; vehicle_id < 1 + id % 7; ++vehicle_id) {
+                   charging_stations.At(id)->Enqueue(vehicle_id);
+                 }
+               }
+               timer.Resume();
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 Demo::DoNotOptimize(charging_stations.LowestCount());
+               }
+               return iterations;
+             });
+
+  // Queue operations of a charging station. Each enqueue and each dequeue is one operation.
+  runner.Run("ChargingStation/EnqueueDequeue",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               Demo::ChargingStation charging_station{0};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 for (Demo::VehicleId id = 0; id < 64; ++id) {
+                   Demo::DoNotOptimize(charging_station.Enqueue(id));
+                 }
+                 for (Demo::VehicleId id = 0; id < 64; ++id) {
+                   Demo::DoNotOptimize(charging_station.Dequeue());
+                 }
+               }
+               return iterations * 128;
+             });
+
+  // Flight of a fleet of vehicles for one time step, per vehicle: one object at a time, then as a
+  // structure-of-arrays group with the scalar kernel and with the widest compiled kernel.
+  std::vector<FlyingVehicle> flying_vehicles(KernelVehicles);
+  Demo::VehicleGroup flying_group;
+  {
+    std::mt19937_64 random_generator(0);
+    for (FlyingVehicle& flying_vehicle : flying_vehicles) {
+      const Demo::Vehicle vehicle{
+          0, vehicle_models.Table().get(),
+          static_cast<Demo::VehicleModelIndex>(vehicle_models.RandomIndex(random_generator))};
+      flying_vehicle.battery = vehicle.Battery();
+      flying_vehicle.model_table = vehicle.ModelTable();
+      flying_vehicle.model_index = vehicle.ModelIndex();
+      flying_vehicle.statistics.IncrementTotalFlightCount();
+      flying_group.Insert(vehicle);
+    }
+  }
+  const PhQ::Time kernel_duration{1.0, PhQ::Unit::Time::Second};
+  runner.Run("VehicleGroup/Fly1000000Objects",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 for (FlyingVehicle& flying_vehicle : flying_vehicles) {
+                   const Demo::VehicleModelParameters& parameters =
+                       flying_vehicle.model_table->Parameters(flying_vehicle.model_index);
+                   const PhQ::Length distance{parameters.cruise_speed * kernel_duration.Value(),
+                                              PhQ::Unit::Length::Metre};
+                   flying_vehicle.battery.MutableValue() -=
+                       parameters.transport_power_usage * kernel_duration.Value();
+                   flying_vehicle.statistics.ModifyTotalFlightDurationAndDistance(
+                       parameters.passenger_count, kernel_duration, distance);
+                 }
+                 Demo::DoNotOptimize(flying_vehicles.front());
+               }
+               return iterations * KernelVehicles;
+             });
+  runner.Run("VehicleGroup/Fly1000000Scalar",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 Demo::FlyKernelScalar(flying_group.Flight(), kernel_duration.Value());
+                 Demo::DoNotOptimize(flying_group.Battery(0));
+               }
+               return iterations * KernelVehicles;
+             });
+  runner.Run("VehicleGroup/Fly1000000",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 flying_group.Fly(kernel_duration);
+                 Demo::DoNotOptimize(flying_group.Battery(0));
+               }
+               return iterations * KernelVehicles;
+             });
+  runner.Run("VehicleGroup/Charge1000000",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 flying_group.Charge(kernel_duration);
+                 Demo::DoNotOptimize(flying_group.Battery(0));
+               }
+               return iterations * KernelVehicles;
+             });
+
+  // Flight of a fleet of vehicles of a single vehicle model for one time step, per vehicle, with
+  // the kernels specialized for this vehicle model at compile time.
+  {
+    const Demo::VehicleModelSpec& spec = Demo::SampleVehicleModelCatalog.front();
+    const Demo::Vehicle vehicle{0, vehicle_models.At(spec.id)};
+    Demo::VehicleGroup specialized_group{
+        *Demo::CatalogKernels<Demo::SampleVehicleModelCatalog>::Find(
+            spec.id, vehicle.ModelParameters())};
+    for (std::size_t index = 0; index < KernelVehicles; ++index) {
+      specialized_group.Insert(vehicle);
+    }
+    runner.Run("VehicleGroup/Fly1000000Specialized",
+               [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+                 for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                   specialized_group.Fly(kernel_duration);
+                   Demo::DoNotOptimize(specialized_group.Battery(0));
+                 }
+                 return iterations * KernelVehicles;
+               });
+  }
+
+  // Fault draws of a fleet of vehicles for one time step, per vehicle: one standard Poisson
+  // distribution per vehicle, then one batch from the batch sampler.
+  std::vector<double> expected_faults(10000);
+  for (std::size_t index = 0; index < expected_faults.size(); ++index) {
+    expected_faults[index] = 0.001 * static_cast<double>(1 + index % 5);
+  }
+  std::vector<int64_t> faults(expected_faults.size());
+  runner.Run("Faults/Poisson10000Standard",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               std::mt19937_64 random_generator(0);
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 for (std::size_t index = 0; index < expected_faults.size(); ++index) {
+                   std::poisson_distribution<int64_t> distribution(expected_faults[index]);
+                   faults[index] = distribution(random_generator);
+                 }
+                 Demo::DoNotOptimize(faults.front());
+               }
+               return iterations * expected_faults.size();
+             });
+  runner.Run("Faults/Poisson10000Batch",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               Demo::BatchSampler sampler{0};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 sampler.Poisson(expected_faults.data(), expected_faults.size(), faults.data());
+                 Demo::DoNotOptimize(faults.front());
+               }
+               return iterations * expected_faults.size();
+             });
+
+  // Aggregation of one set of statistics into another.
+  runner.Run("Statistics/Aggregate", [&](const uint64_t iterations, Demo::BenchmarkTimer& timer) {
+    timer.Pause();
+    Demo::Statistics statistics;
+    statistics.IncrementTotalFlightCount();
+    statistics.ModifyTotalFlightDurationAndDistance(4, PhQ::Time(1.0, PhQ::Unit::Time::Hour),
+                                                    PhQ::Length(100.0, PhQ::Unit::Length::Mile));
+    statistics.IncrementTotalChargingSessionCount();
+    statistics.ModifyTotalChargingSessionDuration(PhQ::Time(0.5, PhQ::Unit::Time::Hour));
+    statistics.ModifyTotalFaultCount(1);
+    Demo::Statistics aggregate;
+    timer.Resume();
+    for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+      aggregate.Aggregate(statistics);
+      Demo::DoNotOptimize(aggregate);
+    }
+    return iterations;
+  });
+
+  // Construction of the aggregate statistics of a fleet, per vehicle.
+  std::mt19937_64 random_generator(0);
+  std::optional<Demo::Vehicles> vehicles;
+  {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    vehicles.emplace(10000, vehicle_models, random_generator);
+  }
+  runner.Run("AggregateStatistics/10000Vehicles",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 const Demo::AggregateStatistics aggregate_statistics{vehicles.value()};
+                 Demo::DoNotOptimize(aggregate_statistics);
+               }
+               return iterations * vehicles->Size();
+             });
+
+  // Writing of the results file.
+  const Demo::AggregateStatistics aggregate_statistics = [&] {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    return Demo::AggregateStatistics{vehicles.value()};
+  }();
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "joby-bench-results.dat";
+  runner.Run("ResultsFileWriter/Write",
+             [&](const uint64_t iterations, Demo::BenchmarkTimer& /*timer*/) {
+               const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+               for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                 const Demo::ResultsFileWriter results_file_writer{
+                     path, vehicle_models, aggregate_statistics};
+               }
+               return iterations;
+             });
+  std::filesystem::remove(path);
+}
+
+// Prints the usage information of the benchmark program.
+void PrintUsage(const std::string& executable_name) noexcept {
+  Demo::Log(Demo::LogLevel::Information)
+      << "Usage: " << executable_name << " [" << Demo::Arguments::OutputPattern << "] ["
+      << Demo::Arguments::BaselinePattern << "] [" << Demo::Arguments::ThresholdPattern << "] ["
+      << Demo::Arguments::FilterPattern << "]";
+  Demo::Log(Demo::LogLevel::Information)
+      << "Runs the benchmarks, writes their results as JSON, and compares them against a "
+         "baseline. Fails if any benchmark is slower than its baseline by more than the threshold "
+         "fraction, which defaults to "
+      << DefaultThreshold << ".";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::filesystem::path output;
+  std::filesystem::path baseline;
+  double threshold = DefaultThreshold;
+  std::string filter;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == Demo::Arguments::OutputKey && index + 1 < argc) {
+      output = argv[++index];
+    } else if (argument == Demo::Arguments::BaselineKey && index + 1 < argc) {
+      baseline = argv[++index];
+    } else if (argument == Demo::Arguments::ThresholdKey && index + 1 < argc) {
+      threshold = std::max(std::atof(argv[++index]), 0.0);
+    } else if (argument == Demo::Arguments::FilterKey && index + 1 < argc) {
+      filter = argv[++index];
+    } else {
+      if (argument != Demo::Arguments::Help) {
+        Demo::Log(Demo::LogLevel::Error) << "Unrecognized argument: " << argument;
+      }
+      PrintUsage(argv[0]);
+      return argument == Demo::Arguments::Help ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  Demo::Log(Demo::LogLevel::Information) << "Benchmarks:";
+  Demo::BenchmarkRunner runner{filter};
+  RunBenchmarks(runner);
+
+  const std::string json = Demo::BenchmarkResultsToJson(runner.Results());
+  if (output.empty()) {
+    Demo::Log(Demo::LogLevel::Information) << json;
+  } else {
+    std::ofstream stream(output);
+    if (!stream.is_open()) {
+      Demo::Log(Demo::LogLevel::Error) << "Could not open the file: " << output.string();
+      return EXIT_FAILURE;
+    }
+    stream << json;
+    Demo::Log(Demo::LogLevel::Information) << "Wrote the benchmark results to: " << output.string();
+  }
+
+  if (baseline.empty()) {
+    return EXIT_SUCCESS;
+  }
+
+  std::ifstream stream(baseline);
+  if (!stream.is_open()) {
+    Demo::Log(Demo::LogLevel::Error) << "Could not open the file: " << baseline.string();
+    return EXIT_FAILURE;
+  }
+  const std::string baseline_json{
+      std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+  const std::optional<std::vector<Demo::BenchmarkResult>> baseline_results =
+      Demo::ParseBenchmarkJson(baseline_json);
+  if (!baseline_results.has_value()) {
+    Demo::Log(Demo::LogLevel::Error) << "Not a benchmark results file: " << baseline.string();
+    return EXIT_FAILURE;
+  }
+
+  Demo::Log(Demo::LogLevel::Information) << "Comparison against: " << baseline.string();
+  bool regression = false;
+  for (const Demo::BenchmarkComparison& comparison :
+       Demo::CompareBenchmarks(runner.Results(), baseline_results.value(), threshold)) {
+    Demo::Log(comparison.regression ? Demo::LogLevel::Warning : Demo::LogLevel::Information)
+        << "- " << comparison.name << ": " << comparison.nanoseconds_per_operation
+        << " ns/op vs. " << comparison.baseline_nanoseconds_per_operation << " ns/op ("
+        << (comparison.ratio - 1.0) * 100.0 << "%)"
+        << (comparison.regression ? " regression" : "");
+    regression = regression || comparison.regression;
+  }
+
+  return regression ? EXIT_FAILURE : EXIT_SUCCESS;
+}
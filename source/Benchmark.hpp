@@ -0,0 +1,271 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_BENCHMARK_HPP
+#define DEMO_INCLUDE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace Demo {
+
+// Prevents the compiler from optimizing away the computation of a given value.
+template <typename Value>
+inline void DoNotOptimize(const Value& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  const volatile char* const pointer = reinterpret_cast<const volatile char*>(&value);
+  static_cast<void>(*pointer);
+#endif
+}
+
+// Stopwatch of a benchmark. A benchmark can pause it around work that should not be measured,
+// such as preparing the inputs of each iteration.
+class BenchmarkTimer {
+public:
+  // Starts the timer.
+  void Start() noexcept {
+    elapsed_ = std::chrono::nanoseconds::zero();
+    Resume();
+  }
+
+  // Pauses the timer.
+  void Pause() noexcept {
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+  }
+
+  // Resumes the timer after a pause.
+  void Resume() noexcept {
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  // Stops the timer and returns the measured time in seconds.
+  double Stop() noexcept {
+    Pause();
+    return std::chrono::duration<double>(elapsed_).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+
+  std::chrono::steady_clock::duration elapsed_ = std::chrono::nanoseconds::zero();
+};
+
+// Result of a benchmark.
+struct BenchmarkResult {
+  std::string name;
+
+  // Number of operations measured in the fastest repetition.
+  uint64_t operations = 0;
+
+  // Median time per operation in nanoseconds over all repetitions.
+  double nanoseconds_per_operation = 0.0;
+
+  // Median number of operations per second over all repetitions.
+  double operations_per_second = 0.0;
+};
+
+// Runs benchmarks and collects their results. Each benchmark is a function that performs a given
+// number of iterations and returns the number of operations it performed, which can differ from
+// the number of iterations: for example, a simulation benchmark counts events. The number of
+// iterations is calibrated so that each repetition lasts at least a minimum time, and the median
+// of several repetitions is reported, which keeps the results stable from run to run.
+class BenchmarkRunner {
+public:
+  // Creates a runner that runs the benchmarks whose names contain a given filter, for a given
+  // number of repetitions that each last at least a given time in seconds.
+  BenchmarkRunner(const std::string_view filter = "", const double minimum_time = 0.1,
+                  const int32_t repetitions = 5) noexcept
+    : filter_(filter), minimum_time_(minimum_time), repetitions_(std::max(repetitions, 1)) {}
+
+  // Runs a benchmark with a given name. The function is called with a number of iterations and a
+  // started timer, and returns the number of operations that it performed.
+  template <typename Function>
+  void Run(const std::string_view name, Function&& function) noexcept {
+    if (name.find(filter_) == std::string_view::npos) {
+      return;
+    }
+
+    BenchmarkTimer timer;
+
+    // Calibrate the number of iterations.
+    uint64_t iterations = 1;
+    while (true) {
+      timer.Start();
+      function(iterations, timer);
+      const double seconds = timer.Stop();
+      if (seconds >= minimum_time_ || iterations >= MaximumIterations) {
+        break;
+      }
+      const double factor = seconds > 0.0 ? 1.5 * minimum_time_ / seconds : 10.0;
+      iterations = std::min<uint64_t>(
+          MaximumIterations,
+          std::max<uint64_t>(iterations + 1, static_cast<uint64_t>(iterations * factor)));
+    }
+
+    std::vector<double> nanoseconds_per_operation;
+    uint64_t operations = 0;
+    for (int32_t repetition = 0; repetition < repetitions_; ++repetition) {
+      timer.Start();
+      operations = std::max<uint64_t>(function(iterations, timer), 1);
+      const double seconds = timer.Stop();
+      nanoseconds_per_operation.push_back(seconds * 1.0E9 / static_cast<double>(operations));
+    }
+    std::sort(nanoseconds_per_operation.begin(), nanoseconds_per_operation.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.operations = operations;
+    result.nanoseconds_per_operation =
+        nanoseconds_per_operation[nanoseconds_per_operation.size() / 2];
+    result.operations_per_second =
+        result.nanoseconds_per_operation > 0.0 ? 1.0E9 / result.nanoseconds_per_operation : 0.0;
+    results_.push_back(result);
+
+    Log(LogLevel::Information) << "- " << result.name << ": " << result.nanoseconds_per_operation
+                               << " ns/op, " << result.operations_per_second << " op/s";
+  }
+
+  // Results of the benchmarks run so far.
+  const std::vector<BenchmarkResult>& Results() const noexcept {
+    return results_;
+  }
+
+private:
+  // Maximum number of iterations of a benchmark.
+  static constexpr uint64_t MaximumIterations = 1'000'000'000;
+
+  std::string filter_;
+
+  double minimum_time_;
+
+  int32_t repetitions_;
+
+  std::vector<BenchmarkResult> results_;
+};
+
+// Formats benchmark results as a JSON document.
+inline std::string BenchmarkResultsToJson(const std::vector<BenchmarkResult>& results) noexcept {
+  std::string json{"{\n  \"benchmarks\": [\n"};
+  char buffer[128];
+  for (std::size_t index = 0; index < results.size(); ++index) {
+    json += "    {\"name\": \"" + results[index].name + "\"";
+    std::snprintf(buffer, sizeof(buffer),
+                  ", \"operations\": %llu, \"ns_per_op\": %.6g, \"ops_per_second\": %.6g}",
+                  static_cast<unsigned long long>(results[index].operations),
+                  results[index].nanoseconds_per_operation, results[index].operations_per_second);
+    json += buffer;
+    json += index + 1 < results.size() ? ",\n" : "\n";
+  }
+  json += "  ]\n}\n";
+  return json;
+}
+
+// Parses benchmark results from a JSON document produced by BenchmarkResultsToJson. Only the name
+// and the time per operation of each benchmark are read. Returns std::nullopt if the document is
+// not in the expected format.
+inline std::optional<std::vector<BenchmarkResult>> ParseBenchmarkJson(
+    const std::string_view json) noexcept {
+  std::vector<BenchmarkResult> results;
+  const std::string_view name_key{"\"name\": \""};
+  const std::string_view time_key{"\"ns_per_op\": "};
+  std::size_t position = json.find(name_key);
+  while (position != std::string_view::npos) {
+    position += name_key.size();
+    const std::size_t name_end = json.find('"', position);
+    const std::size_t time_position = json.find(time_key, position);
+    const std::size_t next_position = json.find(name_key, position);
+    if (name_end == std::string_view::npos || time_position == std::string_view::npos
+        || time_position > next_position) {
+      return std::nullopt;
+    }
+    BenchmarkResult result;
+    result.name = json.substr(position, name_end - position);
+    const std::string time{json.substr(time_position + time_key.size(), 32)};
+    char* time_end = nullptr;
+    result.nanoseconds_per_operation = std::strtod(time.c_str(), &time_end);
+    if (time_end == time.c_str()) {
+      return std::nullopt;
+    }
+    result.operations_per_second =
+        result.nanoseconds_per_operation > 0.0 ? 1.0E9 / result.nanoseconds_per_operation : 0.0;
+    results.push_back(result);
+    position = next_position;
+  }
+  return results;
+}
+
+// Comparison of a benchmark result against its baseline.
+struct BenchmarkComparison {
+  std::string name;
+
+  double baseline_nanoseconds_per_operation = 0.0;
+
+  double nanoseconds_per_operation = 0.0;
+
+  // Ratio of the time per operation to the baseline time per operation. Greater than one if the
+  // benchmark is slower than its baseline.
+  double ratio = 1.0;
+
+  // Whether the benchmark is slower than its baseline by more than the regression threshold.
+  bool regression = false;
+};
+
+// Compares benchmark results against baseline results. A benchmark regresses if its time per
+// operation exceeds its baseline by more than a given threshold fraction, such as 0.1 for 10%.
+// Benchmarks without a baseline are skipped.
+inline std::vector<BenchmarkComparison> CompareBenchmarks(
+    const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+    const double threshold) noexcept {
+  std::vector<BenchmarkComparison> comparisons;
+  for (const BenchmarkResult& result : results) {
+    const std::vector<BenchmarkResult>::const_iterator baseline_result =
+        std::find_if(baseline.cbegin(), baseline.cend(),
+                     [&](const BenchmarkResult& other) { return other.name == result.name; });
+    if (baseline_result == baseline.cend() || baseline_result->nanoseconds_per_operation <= 0.0) {
+      continue;
+    }
+    BenchmarkComparison comparison;
+    comparison.name = result.name;
+    comparison.baseline_nanoseconds_per_operation = baseline_result->nanoseconds_per_operation;
+    comparison.nanoseconds_per_operation = result.nanoseconds_per_operation;
+    comparison.ratio =
+        result.nanoseconds_per_operation / baseline_result->nanoseconds_per_operation;
+    comparison.regression = comparison.ratio > 1.0 + threshold;
+    comparisons.push_back(comparison);
+  }
+  return comparisons;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_BENCHMARK_HPP
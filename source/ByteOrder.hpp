@@ -0,0 +1,75 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_BYTE_ORDER_HPP
+#define DEMO_INCLUDE_BYTE_ORDER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Demo {
+
+// Stores an integer at a given destination in little-endian byte order, regardless of the byte
+// order of this machine.
+template <typename Integer>
+inline void StoreLittleEndian(const Integer value, uint8_t* const destination) noexcept {
+  static_assert(std::is_integral_v<Integer>, "StoreLittleEndian requires an integer type.");
+  using Unsigned = std::make_unsigned_t<Integer>;
+  const Unsigned bits = static_cast<Unsigned>(value);
+  for (std::size_t index = 0; index < sizeof(Integer); ++index) {
+    destination[index] = static_cast<uint8_t>(bits >> (8 * index));
+  }
+}
+
+// Loads an integer stored in little-endian byte order at a given source, regardless of the byte
+// order of this machine.
+template <typename Integer>
+inline Integer LoadLittleEndian(const uint8_t* const source) noexcept {
+  static_assert(std::is_integral_v<Integer>, "LoadLittleEndian requires an integer type.");
+  using Unsigned = std::make_unsigned_t<Integer>;
+  Unsigned bits = 0;
+  for (std::size_t index = 0; index < sizeof(Integer); ++index) {
+    bits |= static_cast<Unsigned>(source[index]) << (8 * index);
+  }
+  return static_cast<Integer>(bits);
+}
+
+// Stores a double-precision floating-point number at a given destination as its IEEE 754 bit
+// pattern in little-endian byte order.
+inline void StoreLittleEndian(const double value, uint8_t* const destination) noexcept {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  StoreLittleEndian<uint64_t>(bits, destination);
+}
+
+// Loads a double-precision floating-point number stored by StoreLittleEndian at a given source.
+inline double LoadLittleEndianDouble(const uint8_t* const source) noexcept {
+  const uint64_t bits = LoadLittleEndian<uint64_t>(source);
+  double value = 0.0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_BYTE_ORDER_HPP
@@ -0,0 +1,177 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_CATALOG_KERNELS_HPP
+#define DEMO_INCLUDE_CATALOG_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "FleetKernels.hpp"
+#include "VehicleModelCatalog.hpp"
+#include "VehicleModelId.hpp"
+#include "VehicleModelTable.hpp"
+#include "VehicleStatus.hpp"
+
+namespace Demo {
+
+// Fleet kernels specialized for the vehicle model of the entry at a given index of a given
+// constexpr vehicle model catalog. The parameters of the vehicle model are computed at compile time
+// and folded into the kernels as constants, so the kernels read and write only the state of the
+// vehicles and ignore the parameter arrays of their arguments. They apply to groups whose vehicles
+// all have this vehicle model, and agree with the generic fleet kernels up to rounding.
+template <const auto& Catalog, std::size_t Index>
+struct ModelKernels {
+  // Hot parameters of the vehicle model of these kernels, computed at compile time.
+  static constexpr VehicleModelParameters Parameters = Catalog[Index].Parameters();
+
+  // Flies all vehicles of a group for a given duration in seconds. Applies the same update as
+  // FlyKernelScalar, with the per-vehicle products hoisted out of the loop.
+  static void Fly(const FlightArrays& arrays, const double duration) noexcept {
+    const double distance = Parameters.cruise_speed * duration;
+    const double energy = Parameters.transport_power_usage * duration;
+    const double passenger_distance = static_cast<double>(Parameters.passenger_count) * distance;
+    for (std::size_t index = 0; index < arrays.count; ++index) {
+      arrays.battery[index] -= energy;
+      arrays.flight_duration[index] += duration;
+      arrays.flight_distance[index] += distance;
+      arrays.flight_passenger_distance[index] += passenger_distance;
+    }
+  }
+
+  // Charges all vehicles of a group for a given duration in seconds. Applies the same update as
+  // ChargeKernelScalar, with the per-vehicle product hoisted out of the loop.
+  static void Charge(const ChargingArrays& arrays, const double duration) noexcept {
+    const double energy = Parameters.charging_rate * duration;
+    for (std::size_t index = 0; index < arrays.count; ++index) {
+      arrays.battery[index] += energy;
+      arrays.charging_duration[index] += duration;
+    }
+  }
+
+  // Computes the expected number of faults of all vehicles of a group during a given duration in
+  // seconds, which is the same for every vehicle.
+  static void Fault(const FaultArrays& arrays, const double duration) noexcept {
+    const double expected_faults = duration * Parameters.mean_fault_rate;
+    for (std::size_t index = 0; index < arrays.count; ++index) {
+      arrays.expected_faults[index] = expected_faults;
+    }
+  }
+
+  // Computes the time duration to the next status change of all vehicles of a group and returns the
+  // smallest of these durations and a given initial value. Applies the same rules as
+  // NextEventDurations, with the divisions by the vehicle model's parameters computed at compile
+  // time.
+  static double NextEvent(const EventArrays& arrays, const double initial) noexcept {
+    constexpr double InverseTransportEnergyConsumption =
+        Parameters.transport_energy_consumption > 0.0 && Parameters.cruise_speed > 0.0 ?
+            1.0 / (Parameters.transport_energy_consumption * Parameters.cruise_speed) :
+            0.0;
+    constexpr double InverseChargingRate =
+        Parameters.charging_rate > 0.0 ? 1.0 / Parameters.charging_rate : 0.0;
+    for (std::size_t index = 0; index < arrays.count; ++index) {
+      const VehicleStatus status = arrays.status[index];
+      const double battery = arrays.battery[index];
+      const double endurance = battery * InverseTransportEnergyConsumption;
+      const double duration_to_full_charge = battery < Parameters.battery_capacity ?
+                                                 (Parameters.battery_capacity - battery)
+                                                     * InverseChargingRate :
+                                                 0.0;
+      const bool in_flight =
+          status == VehicleStatus::Flying || (status == VehicleStatus::OnStandby && battery > 0.0);
+      arrays.durations[index] = in_flight ? endurance : duration_to_full_charge;
+    }
+    return MinimumKernel(arrays.durations, arrays.count, initial);
+  }
+
+  // Table of these kernels. The minimum kernel is the widest one supported by this processor.
+  static FleetKernelTable Table() noexcept {
+    FleetKernelTable table;
+    table.fly = &Fly;
+    table.charge = &Charge;
+    table.fault = &Fault;
+    table.minimum = GlobalFleetKernels().minimum;
+    table.next_event = &NextEvent;
+    return table;
+  }
+};
+
+// Relative tolerance within which the parameters of a vehicle model must agree with those of a
+// catalog entry for the kernels of that entry to apply to it. The parameters of an entry are
+// computed at compile time and may differ from those of the same vehicle model in the last bit.
+inline constexpr double CatalogParameterTolerance = 1.0e-12;
+
+// Returns whether two given sets of vehicle model parameters agree within
+// CatalogParameterTolerance, with the same passenger count.
+inline bool MatchingParameters(
+    const VehicleModelParameters& left, const VehicleModelParameters& right) noexcept {
+  const auto matching = [](const double left_value, const double right_value) {
+    return std::abs(left_value - right_value)
+           <= CatalogParameterTolerance * std::max(std::abs(left_value), std::abs(right_value));
+  };
+  return matching(left.cruise_speed, right.cruise_speed)
+         && matching(left.transport_power_usage, right.transport_power_usage)
+         && matching(left.transport_energy_consumption, right.transport_energy_consumption)
+         && matching(left.charging_rate, right.charging_rate)
+         && matching(left.battery_capacity, right.battery_capacity)
+         && matching(left.mean_fault_rate, right.mean_fault_rate)
+         && left.passenger_count == right.passenger_count;
+}
+
+// Tables of the fleet kernels specialized for each vehicle model of a given constexpr vehicle model
+// catalog, generated at compile time, one per entry.
+template <const auto& Catalog>
+class CatalogKernels {
+public:
+  // Returns the table of the fleet kernels specialized for a vehicle model with a given ID and
+  // given parameters, or nullptr if no entry of the catalog has this ID and these parameters. A
+  // vehicle model read at run time, such as from a CSV catalog, may reuse the ID of an entry with
+  // different parameters, in which case the specialized kernels would compute wrong results.
+  static const FleetKernelTable* Find(
+      const VehicleModelId id, const VehicleModelParameters& parameters) noexcept {
+    static const std::array<FleetKernelTable, Size> tables =
+        MakeTables(std::make_index_sequence<Size>());
+    for (std::size_t index = 0; index < Size; ++index) {
+      if (Catalog[index].id == id) {
+        return MatchingParameters(Catalog[index].Parameters(), parameters) ? &tables[index] :
+                                                                             nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  static constexpr std::size_t Size = std::size(Catalog);
+
+  template <std::size_t... Indices>
+  static std::array<FleetKernelTable, Size> MakeTables(std::index_sequence<Indices...>) noexcept {
+    return {ModelKernels<Catalog, Indices>::Table()...};
+  }
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_CATALOG_KERNELS_HPP
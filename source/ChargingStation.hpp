@@ -23,17 +23,21 @@
 #ifndef DEMO_INCLUDE_CHARGING_STATION_HPP
 #define DEMO_INCLUDE_CHARGING_STATION_HPP
 
+#include <memory_resource>
 #include <optional>
-#include <queue>
-#include <unordered_set>
 
 #include "ChargingStationId.hpp"
+#include "FlatHashSet.hpp"
+#include "MemoryAccounting.hpp"
+#include "Profiler.hpp"
+#include "RingBuffer.hpp"
 #include "VehicleId.hpp"
 
 namespace Demo {
 
 // Class representing a charging station. Vehicles queue in line and wait for their turn to charge
-// at the charging station. Only the vehicle at the front of the queue can charge its battery.
+// at the charging station. Only the vehicle at the front of the queue can charge its battery. Once
+// its queue has reached its longest length so far, enqueueing and dequeueing never allocate.
 class ChargingStation {
 public:
   // Default constructor. Constructs an empty charging station with an ID of zero.
@@ -42,6 +46,12 @@ public:
   // Constructs an empty charging station with a given ID.
   ChargingStation(const ChargingStationId& id) noexcept : id_(id) {}
 
+  // Constructs an empty charging station with a given ID whose queue and set of vehicles draw their
+  // memory from a given memory resource, which must outlive this charging station.
+  ChargingStation(const ChargingStationId& id, std::pmr::memory_resource* const resource) noexcept
+    : id_(id), queue_(VehicleQueue::allocator_type(resource)),
+      ids_(VehicleSet::allocator_type(resource)) {}
+
   // Globally-unique identifier of this charging station.
   const ChargingStationId& Id() const noexcept {
     return id_;
@@ -49,36 +59,36 @@ public:
 
   // Returns whether this charging station is empty.
   bool Empty() const noexcept {
-    return queue_.empty();
+    return queue_.Empty();
   }
 
   // Returns the count of vehicles at this charging station (either queued or charging).
   std::size_t Count() const noexcept {
-    return queue_.size();
+    return queue_.Size();
   }
 
   // Returns whether a given vehicle is present at this charging station (either queued or
   // charging).
   bool Exists(const VehicleId& id) const noexcept {
-    return ids_.find(id) != ids_.cend();
+    return ids_.Contains(id);
   }
 
   // Returns the ID of the vehicle that is currently charging at this charging station (the vehicle
   // at the front of the queue), or nullopt if there are no vehicles at this charging station.
   std::optional<VehicleId> Front() const noexcept {
-    if (queue_.empty()) {
+    if (queue_.Empty()) {
       return std::nullopt;
     }
 
-    return queue_.front();
+    return queue_.Front();
   }
 
   // Attempts to enqueue a new vehicle at the back of the queue of this charging station. Returns
   // true if the vehicle was successfully enqueued, or false if the vehicle was already queued.
   bool Enqueue(const VehicleId& id) noexcept {
-    const std::pair<std::unordered_set<VehicleId>::iterator, bool> result = ids_.insert(id);
-    if (result.second) {
-      queue_.push(id);
+    if (ids_.Insert(id)) {
+      queue_.PushBack(id);
+      DEMO_PROFILE_COUNT(Enqueues, 1);
       return true;
     }
 
@@ -89,25 +99,53 @@ public:
   // queue) from this charging station. Returns true if the vehicle was successfully dequeued, or
   // false if there are no vehicles at this charging station.
   bool Dequeue() noexcept {
-    if (queue_.empty()) {
+    if (queue_.Empty()) {
       return false;
     }
 
-    ids_.erase(queue_.front());
+    ids_.Erase(queue_.Front());
+
+    queue_.PopFront();
+
+    DEMO_PROFILE_COUNT(Dequeues, 1);
+
+    return true;
+  }
+
+  // Attempts to remove a given vehicle from this charging station, wherever it is in the queue, as
+  // when the vehicle is withdrawn from service. The vehicles behind it move up. Returns true if the
+  // vehicle was successfully removed, or false if the vehicle was not at this charging station.
+  bool Remove(const VehicleId& id) noexcept {
+    if (!ids_.Erase(id)) {
+      return false;
+    }
 
-    queue_.pop();
+    for (std::size_t position = 0; position < queue_.Size(); ++position) {
+      if (queue_[position] == id) {
+        queue_.Erase(position);
+        break;
+      }
+    }
 
     return true;
   }
 
 private:
+  // Queue of vehicle IDs, whose memory is accounted for.
+  using VehicleQueue =
+      RingBuffer<VehicleId, TrackingAllocator<VehicleId, MemorySubsystem::ChargingStationQueues>>;
+
+  // Hash set of vehicle IDs, whose memory is accounted for.
+  using VehicleSet =
+      FlatHashSet<VehicleId, TrackingAllocator<VehicleId, MemorySubsystem::ChargingStationSets>>;
+
   ChargingStationId id_ = 0;
 
   // Queue of vehicle IDs at this charging station.
-  std::queue<VehicleId> queue_;
+  VehicleQueue queue_;
 
   // Set of vehicle IDs at this charging station.
-  std::unordered_set<VehicleId> ids_;
+  VehicleSet ids_;
 };
 
 }  // namespace Demo
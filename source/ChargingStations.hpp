@@ -23,26 +23,46 @@
 #ifndef DEMO_INCLUDE_CHARGING_STATIONS_HPP
 #define DEMO_INCLUDE_CHARGING_STATIONS_HPP
 
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
 
 #include "ChargingStation.hpp"
+#include "MemoryAccounting.hpp"
+#include "Profiler.hpp"
 
 namespace Demo {
 
 // Collection of charging stations.
 class ChargingStations {
+private:
+  // Tree map of charging station IDs to charging stations, whose memory is accounted for.
+  using ChargingStationMap = std::map<
+      ChargingStationId, std::shared_ptr<ChargingStation>, std::less<ChargingStationId>,
+      TrackingAllocator<std::pair<const ChargingStationId, std::shared_ptr<ChargingStation>>,
+                        MemorySubsystem::ChargingStationMap>>;
+
 public:
   // Constructs an empty collection of charging stations.
   ChargingStations() noexcept = default;
 
-  // Constructs a collection containing a given number of charging stations.
-  ChargingStations(const int32_t count) noexcept {
+  // Constructs an empty collection of charging stations that draws its memory from a given memory
+  // resource, which must outlive this collection.
+  explicit ChargingStations(std::pmr::memory_resource* const resource) noexcept
+    : data_(ChargingStationMap::allocator_type(resource)) {}
+
+  // Constructs a collection containing a given number of charging stations. The collection and its
+  // charging stations draw their memory from a given memory resource, which must outlive them.
+  ChargingStations(const int32_t count, std::pmr::memory_resource* const resource =
+                                            std::pmr::get_default_resource()) noexcept
+    : data_(ChargingStationMap::allocator_type(resource)) {
     ChargingStationId id = 0;
 
     for (int32_t index = 0; index < count; ++index) {
-      Insert(std::make_shared<ChargingStation>(id));
+      Insert(std::allocate_shared<ChargingStation>(
+          TrackingAllocator<ChargingStation, MemorySubsystem::ChargingStations>(resource), id,
+          resource));
       ++id;
     }
   }
@@ -64,9 +84,8 @@ public:
       return false;
     }
 
-    const std::pair<std::map<ChargingStationId, std::shared_ptr<ChargingStation>>::const_iterator,
-                    bool>
-        result = data_.emplace(charging_station->Id(), charging_station);
+    const std::pair<ChargingStationMap::const_iterator, bool> result =
+        data_.emplace(charging_station->Id(), charging_station);
 
     return result.second;
   }
@@ -74,8 +93,7 @@ public:
   // Returns the charging station corresponding to a given charging station ID, or nullptr if that
   // charging station ID is not found in this collection.
   std::shared_ptr<ChargingStation> At(const ChargingStationId id) const noexcept {
-    const std::map<ChargingStationId, std::shared_ptr<ChargingStation>>::const_iterator
-        id_and_data = data_.find(id);
+    const ChargingStationMap::const_iterator id_and_data = data_.find(id);
 
     if (id_and_data != data_.cend()) {
       return id_and_data->second;
@@ -89,6 +107,8 @@ public:
   // stations are tied for the lowest count, returns the first one encountered while traversing the
   // collection.
   std::shared_ptr<ChargingStation> LowestCount() const noexcept {
+    DEMO_PROFILE_SCOPE(LowestCount);
+
     std::shared_ptr<ChargingStation> best = nullptr;
 
     std::size_t lowest_count = std::numeric_limits<std::size_t>::max();
@@ -109,7 +129,7 @@ private:
   // assumes that only a small number of charging stations are used, say 20 or fewer. If more
   // charging stations are used, this implementation should instead use a hash map rather than a
   // binary tree map.
-  std::map<ChargingStationId, std::shared_ptr<ChargingStation>> data_;
+  ChargingStationMap data_;
 };
 
 }  // namespace Demo
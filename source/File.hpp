@@ -25,7 +25,8 @@
 
 #include <filesystem>
 #include <fstream>
-#include <iostream>
+
+#include "Logger.hpp"
 
 namespace Demo {
 
@@ -55,7 +56,7 @@ protected:
     if (!path_.empty()) {
       stream_.open(path_.string());
       if (!stream_.is_open()) {
-        std::cerr << "Could not open the file: " << path_.string() << std::endl;
+        Log(LogLevel::Error) << "Could not open the file: " << path_.string();
       }
     }
   }
@@ -0,0 +1,209 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLAT_HASH_MAP_HPP
+#define DEMO_INCLUDE_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Demo {
+
+// Map of integer keys to values stored in a single open-addressing table with linear probing, like
+// FlatHashSet. A lookup hashes the key once and usually finds it in the first slot, which holds
+// both the key and its value, so it costs one cache miss rather than the bucket and node misses of
+// std::unordered_map. Erasing shifts the following entries back instead of leaving tombstones.
+template <typename Key, typename Value, typename Allocator = std::allocator<Key>>
+class FlatHashMap {
+public:
+  using allocator_type = Allocator;
+
+  // Constructs an empty map without allocating.
+  FlatHashMap() noexcept = default;
+
+  // Constructs an empty map that allocates with a given allocator, without allocating.
+  explicit FlatHashMap(const Allocator& allocator) noexcept : slots_(SlotAllocator(allocator)) {}
+
+  // Returns whether this map is empty.
+  bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Returns the number of entries in this map.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Returns the number of slots in the table of this map.
+  std::size_t Capacity() const noexcept {
+    return slots_.size();
+  }
+
+  // Grows the table of this map so that it holds a given number of entries without growing again.
+  void Reserve(const std::size_t count) noexcept {
+    std::size_t capacity = slots_.empty() ? MinimumCapacity : slots_.size();
+    while (2 * count > capacity) {
+      capacity *= 2;
+    }
+    if (capacity > slots_.size()) {
+      Rehash(capacity);
+    }
+  }
+
+  // Returns the value of a given key, or nullptr if the key is not in this map.
+  const Value* Find(const Key key) const noexcept {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    for (std::size_t index = Home(key);; index = Next(index)) {
+      if (!slots_[index].occupied) {
+        return nullptr;
+      }
+      if (slots_[index].key == key) {
+        return &slots_[index].value;
+      }
+    }
+  }
+
+  // Returns whether a given key is in this map.
+  bool Contains(const Key key) const noexcept {
+    return Find(key) != nullptr;
+  }
+
+  // Inserts a given key with a given value into this map. Returns true if the key was inserted, or
+  // false if it was already in this map, in which case its value is unchanged.
+  bool Insert(const Key key, const Value& value) noexcept {
+    if (2 * (size_ + 1) > slots_.size()) {
+      if (Contains(key)) {
+        return false;
+      }
+      Rehash(slots_.empty() ? MinimumCapacity : 2 * slots_.size());
+    }
+    std::size_t index = Home(key);
+    while (slots_[index].occupied) {
+      if (slots_[index].key == key) {
+        return false;
+      }
+      index = Next(index);
+    }
+    slots_[index].key = key;
+    slots_[index].value = value;
+    slots_[index].occupied = true;
+    ++size_;
+    return true;
+  }
+
+  // Erases a given key from this map. Returns true if the key was erased, or false if it was not in
+  // this map.
+  bool Erase(const Key key) noexcept {
+    if (slots_.empty()) {
+      return false;
+    }
+    std::size_t index = Home(key);
+    while (slots_[index].key != key || !slots_[index].occupied) {
+      if (!slots_[index].occupied) {
+        return false;
+      }
+      index = Next(index);
+    }
+    // Shift back the following entries of the same probe sequence so that no gap breaks it.
+    std::size_t next = Next(index);
+    while (slots_[next].occupied) {
+      const std::size_t home = Home(slots_[next].key);
+      if (((next - home) & Mask()) >= ((next - index) & Mask())) {
+        slots_[index] = slots_[next];
+        index = next;
+      }
+      next = Next(next);
+    }
+    slots_[index].occupied = false;
+    --size_;
+    return true;
+  }
+
+  // Removes all entries from this map without releasing its table.
+  void Clear() noexcept {
+    for (Slot& slot : slots_) {
+      slot.occupied = false;
+    }
+    size_ = 0;
+  }
+
+private:
+  struct Slot {
+    Key key{};
+
+    Value value{};
+
+    bool occupied = false;
+  };
+
+  using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+  // Smallest non-zero number of slots.
+  static constexpr std::size_t MinimumCapacity = 8;
+
+  std::size_t Mask() const noexcept {
+    return slots_.size() - 1;
+  }
+
+  // Returns the first slot of the probe sequence of a given key. Keys are mixed first so that
+  // sequential keys do not cluster.
+  std::size_t Home(const Key key) const noexcept {
+    uint64_t hash = static_cast<uint64_t>(key);
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return static_cast<std::size_t>(hash) & Mask();
+  }
+
+  std::size_t Next(const std::size_t index) const noexcept {
+    return (index + 1) & Mask();
+  }
+
+  // Moves the entries into a new table with a given number of slots, which is a power of two.
+  void Rehash(const std::size_t capacity) noexcept {
+    std::vector<Slot, SlotAllocator> slots(capacity, slots_.get_allocator());
+    slots_.swap(slots);
+    size_ = 0;
+    for (const Slot& slot : slots) {
+      if (slot.occupied) {
+        std::size_t index = Home(slot.key);
+        while (slots_[index].occupied) {
+          index = Next(index);
+        }
+        slots_[index] = slot;
+        ++size_;
+      }
+    }
+  }
+
+  std::vector<Slot, SlotAllocator> slots_;
+
+  std::size_t size_ = 0;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLAT_HASH_MAP_HPP
@@ -0,0 +1,191 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLAT_HASH_SET_HPP
+#define DEMO_INCLUDE_FLAT_HASH_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Demo {
+
+// Set of integer keys stored in a single open-addressing table with linear probing. Unlike
+// std::unordered_set, which allocates a node for every inserted key, it allocates nothing until its
+// first key is inserted and only allocates when it grows beyond its largest size so far, so a set
+// that has reached its working size never allocates again. Erasing shifts the following keys back
+// instead of leaving tombstones, so the table never degrades.
+template <typename Key, typename Allocator = std::allocator<Key>>
+class FlatHashSet {
+public:
+  using allocator_type = Allocator;
+
+  // Constructs an empty set without allocating.
+  FlatHashSet() noexcept = default;
+
+  // Constructs an empty set that allocates with a given allocator, without allocating.
+  explicit FlatHashSet(const Allocator& allocator) noexcept : slots_(SlotAllocator(allocator)) {}
+
+  // Returns whether this set is empty.
+  bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Returns the number of keys in this set.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Returns the number of slots in the table of this set.
+  std::size_t Capacity() const noexcept {
+    return slots_.size();
+  }
+
+  // Returns whether a given key is in this set.
+  bool Contains(const Key key) const noexcept {
+    if (slots_.empty()) {
+      return false;
+    }
+    for (std::size_t index = Home(key);; index = Next(index)) {
+      if (!slots_[index].occupied) {
+        return false;
+      }
+      if (slots_[index].key == key) {
+        return true;
+      }
+    }
+  }
+
+  // Inserts a given key into this set. Returns true if the key was inserted, or false if it was
+  // already in this set.
+  bool Insert(const Key key) noexcept {
+    if (2 * (size_ + 1) > slots_.size()) {
+      if (Contains(key)) {
+        return false;
+      }
+      Rehash(slots_.empty() ? MinimumCapacity : 2 * slots_.size());
+    }
+    std::size_t index = Home(key);
+    while (slots_[index].occupied) {
+      if (slots_[index].key == key) {
+        return false;
+      }
+      index = Next(index);
+    }
+    slots_[index].key = key;
+    slots_[index].occupied = true;
+    ++size_;
+    return true;
+  }
+
+  // Erases a given key from this set. Returns true if the key was erased, or false if it was not in
+  // this set.
+  bool Erase(const Key key) noexcept {
+    if (slots_.empty()) {
+      return false;
+    }
+    std::size_t index = Home(key);
+    while (slots_[index].key != key || !slots_[index].occupied) {
+      if (!slots_[index].occupied) {
+        return false;
+      }
+      index = Next(index);
+    }
+    // Shift back the following keys of the same probe sequence so that no gap breaks it.
+    std::size_t next = Next(index);
+    while (slots_[next].occupied) {
+      const std::size_t home = Home(slots_[next].key);
+      if (((next - home) & Mask()) >= ((next - index) & Mask())) {
+        slots_[index] = slots_[next];
+        index = next;
+      }
+      next = Next(next);
+    }
+    slots_[index].occupied = false;
+    --size_;
+    return true;
+  }
+
+  // Removes all keys from this set without releasing its table.
+  void Clear() noexcept {
+    for (Slot& slot : slots_) {
+      slot.occupied = false;
+    }
+    size_ = 0;
+  }
+
+private:
+  struct Slot {
+    Key key{};
+
+    bool occupied = false;
+  };
+
+  using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+  // Smallest non-zero number of slots.
+  static constexpr std::size_t MinimumCapacity = 8;
+
+  std::size_t Mask() const noexcept {
+    return slots_.size() - 1;
+  }
+
+  // Returns the first slot of the probe sequence of a given key. Keys are mixed first so that
+  // sequential keys do not cluster.
+  std::size_t Home(const Key key) const noexcept {
+    uint64_t hash = static_cast<uint64_t>(key);
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return static_cast<std::size_t>(hash) & Mask();
+  }
+
+  std::size_t Next(const std::size_t index) const noexcept {
+    return (index + 1) & Mask();
+  }
+
+  // Moves the keys into a new table with a given number of slots, which is a power of two.
+  void Rehash(const std::size_t capacity) noexcept {
+    std::vector<Slot, SlotAllocator> slots(capacity, slots_.get_allocator());
+    slots_.swap(slots);
+    size_ = 0;
+    for (const Slot& slot : slots) {
+      if (slot.occupied) {
+        std::size_t index = Home(slot.key);
+        while (slots_[index].occupied) {
+          index = Next(index);
+        }
+        slots_[index] = slot;
+        ++size_;
+      }
+    }
+  }
+
+  std::vector<Slot, SlotAllocator> slots_;
+
+  std::size_t size_ = 0;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLAT_HASH_SET_HPP
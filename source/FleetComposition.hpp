@@ -0,0 +1,323 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLEET_COMPOSITION_HPP
+#define DEMO_INCLUDE_FLEET_COMPOSITION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "BatchSampler.hpp"
+#include "Parallel.hpp"
+
+namespace Demo {
+
+// Returns whether a weight is finite. This inspects the exponent bits of the weight because
+// -ffast-math lets the compiler assume that std::isfinite is always true.
+inline bool FiniteWeight(const double weight) noexcept {
+  constexpr uint64_t exponent_mask = 0x7FF0000000000000;
+  uint64_t bits = 0;
+  std::memcpy(&bits, &weight, sizeof(bits));
+  return (bits & exponent_mask) != exponent_mask;
+}
+
+// Method by which the vehicle models of a fleet are drawn from a fleet composition.
+enum class FleetCompositionMode : int8_t {
+  // Each vehicle draws its vehicle model independently, so the number of vehicles of each vehicle
+  // model follows a multinomial distribution.
+  Sampled,
+
+  // The number of vehicles of each vehicle model is the closest apportionment of the fleet to the
+  // weights, and only the order of the vehicle models within the fleet is random.
+  Exact,
+};
+
+// Table of Walker's alias method over a discrete distribution of given non-negative weights. Draws
+// an index from the distribution in constant time from one uniform variate, regardless of the
+// number of weights.
+class AliasTable {
+public:
+  // Constructs an empty alias table.
+  AliasTable() noexcept = default;
+
+  // Constructs an alias table over given non-negative weights, at least one of which is positive.
+  explicit AliasTable(const std::vector<double>& weights) noexcept
+    : probabilities_(weights.size(), 1.0), aliases_(weights.size()) {
+    const std::size_t size = weights.size();
+    const double total = std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+    if (size == 0 || !(total > 0.0)) {
+      return;
+    }
+
+    // Scale the weights so that their mean is one, and split them into the columns that are
+    // underfull and those that are overfull.
+    std::vector<double> scaled(size);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (std::size_t index = 0; index < size; ++index) {
+      aliases_[index] = static_cast<uint32_t>(index);
+      scaled[index] = weights[index] * static_cast<double>(size) / total;
+      (scaled[index] < 1.0 ? small : large).push_back(static_cast<uint32_t>(index));
+    }
+
+    // Fill each underfull column with the excess of an overfull column.
+    while (!small.empty() && !large.empty()) {
+      const uint32_t underfull = small.back();
+      small.pop_back();
+      const uint32_t overfull = large.back();
+      probabilities_[underfull] = scaled[underfull];
+      aliases_[underfull] = overfull;
+      scaled[overfull] -= 1.0 - scaled[underfull];
+      if (scaled[overfull] < 1.0) {
+        large.pop_back();
+        small.push_back(overfull);
+      }
+    }
+
+    // Any remaining column is full up to rounding errors.
+    for (const uint32_t index : small) {
+      probabilities_[index] = 1.0;
+    }
+    for (const uint32_t index : large) {
+      probabilities_[index] = 1.0;
+    }
+  }
+
+  // Returns whether this alias table is empty.
+  bool Empty() const noexcept {
+    return probabilities_.empty();
+  }
+
+  // Returns the number of weights of this alias table.
+  std::size_t Size() const noexcept {
+    return probabilities_.size();
+  }
+
+  // Returns the index drawn by a given uniform variate in [0, 1). This table must not be empty. Has
+  // no branches, because the choice between a column and its alias is unpredictable.
+  uint32_t Draw(const double uniform) const noexcept {
+    const double scaled = uniform * static_cast<double>(probabilities_.size());
+    const uint32_t column = static_cast<uint32_t>(std::min(
+        static_cast<int64_t>(scaled), static_cast<int64_t>(probabilities_.size()) - 1));
+    const double fraction = scaled - static_cast<double>(column);
+    const uint32_t alias = aliases_[column];
+    const uint32_t keep = static_cast<uint32_t>(fraction < probabilities_[column]);
+    return alias + keep * (column - alias);
+  }
+
+private:
+  // Probability of drawing the index of each column rather than its alias.
+  std::vector<double> probabilities_;
+
+  // Index drawn by each column when its own index is not drawn.
+  std::vector<uint32_t> aliases_;
+};
+
+// Relative weights of the vehicle models of a fleet, in the order of the collection of vehicle
+// models, and the method by which the vehicle models of a fleet are drawn from them.
+class FleetComposition {
+public:
+  // Constructs an empty fleet composition.
+  FleetComposition() noexcept = default;
+
+  // Constructs a fleet composition from given non-negative weights, at least one of which is
+  // positive, and a given mode.
+  explicit FleetComposition(
+      std::vector<double> weights,
+      const FleetCompositionMode mode = FleetCompositionMode::Sampled) noexcept
+    : weights_(std::move(weights)), mode_(mode), alias_table_(weights_) {}
+
+  // Returns a fleet composition with equal weights for a given number of vehicle models.
+  static FleetComposition Uniform(
+      const std::size_t vehicle_models,
+      const FleetCompositionMode mode = FleetCompositionMode::Sampled) noexcept {
+    return FleetComposition(std::vector<double>(vehicle_models, 1.0), mode);
+  }
+
+  // Returns the number of vehicle models of this fleet composition.
+  std::size_t Size() const noexcept {
+    return weights_.size();
+  }
+
+  // Weights of the vehicle models.
+  const std::vector<double>& Weights() const noexcept {
+    return weights_;
+  }
+
+  // Method by which the vehicle models of a fleet are drawn.
+  FleetCompositionMode Mode() const noexcept {
+    return mode_;
+  }
+
+  // Returns whether vehicle models can be drawn from this fleet composition, which requires at
+  // least one positive weight and no negative, infinite, or NaN weight.
+  bool Valid() const noexcept {
+    return std::all_of(weights_.cbegin(), weights_.cend(),
+                       [](const double weight) { return FiniteWeight(weight) && weight >= 0.0; })
+           && std::any_of(weights_.cbegin(), weights_.cend(),
+                          [](const double weight) { return weight > 0.0; });
+  }
+
+  // Returns the number of vehicles of each vehicle model in an exact apportionment of a fleet of
+  // a given number of vehicles to the weights. Each vehicle model receives the integer part of its
+  // share, and the remaining vehicles go to the largest fractional parts, ties going to the first
+  // vehicle models.
+  std::vector<std::size_t> Apportion(const std::size_t count) const noexcept {
+    std::vector<std::size_t> counts(weights_.size(), 0);
+    if (!Valid()) {
+      return counts;
+    }
+
+    const double total = std::accumulate(weights_.cbegin(), weights_.cend(), 0.0);
+    std::vector<std::pair<double, std::size_t>> remainders;
+    remainders.reserve(weights_.size());
+    std::size_t assigned = 0;
+    for (std::size_t index = 0; index < weights_.size(); ++index) {
+      const double share = weights_[index] / total * static_cast<double>(count);
+      counts[index] = std::min(static_cast<std::size_t>(share), count - assigned);
+      assigned += counts[index];
+      remainders.emplace_back(share - static_cast<double>(counts[index]), index);
+    }
+
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const std::pair<double, std::size_t>& left,
+                        const std::pair<double, std::size_t>& right) {
+                       return left.first > right.first;
+                     });
+    for (std::size_t rank = 0; assigned < count; rank = (rank + 1) % remainders.size()) {
+      ++counts[remainders[rank].second];
+      ++assigned;
+    }
+
+    return counts;
+  }
+
+  // Number of consecutive vehicles whose vehicle models are drawn from the same random stream.
+  static constexpr std::size_t ChunkSize = std::size_t{1} << 16;
+
+  // Draws the vehicle model index of each vehicle of a fleet of a given number of vehicles, using
+  // up to a given number of threads. If the number of threads is zero, uses one thread per hardware
+  // thread. Returns no indices if this fleet composition is not valid.
+  //
+  // In the sampled mode, the fleet is split into chunks of ChunkSize vehicles, and each chunk draws
+  // its uniform variates in bulk from its own batch sampler, seeded from its position and from one
+  // draw of a given random generator. The chunks are drawn in parallel, and the drawn indices do
+  // not depend on the number of threads. In the exact mode, the apportioned indices are shuffled on
+  // the calling thread.
+  std::vector<uint32_t> Draw(const std::size_t count, std::mt19937_64& random_generator,
+                             const std::size_t thread_count = 1) const noexcept {
+    std::vector<uint32_t> indices;
+    if (!Valid()) {
+      return indices;
+    }
+
+    const uint64_t seed = random_generator();
+    indices.resize(count);
+
+    if (mode_ == FleetCompositionMode::Exact) {
+      const std::vector<std::size_t> counts = Apportion(count);
+      std::size_t position = 0;
+      for (std::size_t index = 0; index < counts.size(); ++index) {
+        std::fill_n(indices.begin() + position, counts[index], static_cast<uint32_t>(index));
+        position += counts[index];
+      }
+      BatchSampler sampler{seed};
+      Shuffle(indices, sampler);
+      return indices;
+    }
+
+    const std::size_t chunk_count = (count + ChunkSize - 1) / ChunkSize;
+    ParallelFor(chunk_count, thread_count, [&](const std::size_t chunk) {
+      BatchSampler sampler{seed + chunk};
+      std::array<double, BatchSampler::BufferSize> uniforms;
+      const std::size_t end = std::min((chunk + 1) * ChunkSize, count);
+      for (std::size_t begin = chunk * ChunkSize; begin < end; begin += uniforms.size()) {
+        const std::size_t size = std::min(uniforms.size(), end - begin);
+        sampler.Uniform(uniforms.data(), size);
+        for (std::size_t offset = 0; offset < size; ++offset) {
+          indices[begin + offset] = alias_table_.Draw(uniforms[offset]);
+        }
+      }
+    });
+    return indices;
+  }
+
+private:
+  // Shuffles given indices with the Fisher-Yates algorithm.
+  static void Shuffle(std::vector<uint32_t>& indices, BatchSampler& sampler) noexcept {
+    for (std::size_t position = indices.size(); position > 1; --position) {
+      const std::size_t other = std::min(
+          static_cast<std::size_t>(sampler.Uniform() * static_cast<double>(position)),
+          position - 1);
+      std::swap(indices[position - 1], indices[other]);
+    }
+  }
+
+  // Relative weights of the vehicle models.
+  std::vector<double> weights_;
+
+  // Method by which the vehicle models of a fleet are drawn.
+  FleetCompositionMode mode_ = FleetCompositionMode::Sampled;
+
+  // Alias table over the weights.
+  AliasTable alias_table_;
+};
+
+// Parses a comma-separated list of finite non-negative weights, such as "60,20,10,5,5". Returns
+// std::nullopt if the text is not such a list or if all of its weights are zero.
+inline std::optional<std::vector<double>> ParseWeights(const std::string_view text) noexcept {
+  std::vector<double> weights;
+  std::size_t begin = 0;
+  while (begin <= text.size()) {
+    const std::size_t end = std::min(text.find(',', begin), text.size());
+    const std::string field{text.substr(begin, end - begin)};
+    char* parsed_end = nullptr;
+    const double weight = std::strtod(field.c_str(), &parsed_end);
+    if (field.empty() || parsed_end != field.c_str() + field.size() || !FiniteWeight(weight)
+        || weight < 0.0) {
+      return std::nullopt;
+    }
+    weights.push_back(weight);
+    begin = end + 1;
+  }
+
+  if (std::none_of(
+          weights.cbegin(), weights.cend(), [](const double weight) { return weight > 0.0; })) {
+    return std::nullopt;
+  }
+  return weights;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLEET_COMPOSITION_HPP
@@ -0,0 +1,587 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLEET_KERNELS_HPP
+#define DEMO_INCLUDE_FLEET_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "VehicleStatus.hpp"
+
+// The SSE4.2, AVX2, and AVX-512 kernels are compiled for their instruction sets with function
+// attributes regardless of the build flags, and one of them is chosen at run time with CPUID. This
+// requires GCC or Clang on x86. Otherwise only the scalar kernels are compiled.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DEMO_FLEET_KERNELS_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace Demo {
+
+// Instruction sets for which the fleet kernels are compiled, from narrowest to widest.
+enum class InstructionSet : int8_t {
+  Scalar,
+  Sse42,
+  Avx2,
+  Avx512,
+};
+
+// Name of a given instruction set.
+inline constexpr std::string_view InstructionSetName(
+    const InstructionSet instruction_set) noexcept {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return "Scalar";
+    case InstructionSet::Sse42:
+      return "SSE4.2";
+    case InstructionSet::Avx2:
+      return "AVX2";
+    case InstructionSet::Avx512:
+      return "AVX-512";
+  }
+}
+
+// Structure-of-arrays view of the state of a group of flying vehicles, as raw values in SI units.
+// All arrays have the same number of elements.
+struct FlightArrays {
+  std::size_t count = 0;
+
+  // Remaining battery energy of each vehicle in joules.
+  double* battery = nullptr;
+
+  // Transport power usage of each vehicle's model in watts.
+  const double* transport_power_usage = nullptr;
+
+  // Cruise speed of each vehicle's model in metres per second.
+  const double* cruise_speed = nullptr;
+
+  // Passenger count of each vehicle's model.
+  const double* passenger_count = nullptr;
+
+  // Total flight duration of each vehicle in seconds.
+  double* flight_duration = nullptr;
+
+  // Total flight distance of each vehicle in metres.
+  double* flight_distance = nullptr;
+
+  // Total flight passenger distance of each vehicle in metres.
+  double* flight_passenger_distance = nullptr;
+};
+
+// Structure-of-arrays view of the state of a group of charging vehicles, as raw values in SI
+// units. All arrays have the same number of elements.
+struct ChargingArrays {
+  std::size_t count = 0;
+
+  // Remaining battery energy of each vehicle in joules.
+  double* battery = nullptr;
+
+  // Charging rate of each vehicle's model in watts.
+  const double* charging_rate = nullptr;
+
+  // Total charging duration of each vehicle in seconds.
+  double* charging_duration = nullptr;
+};
+
+// Structure-of-arrays view of the inputs and outputs of fault sampling for a group of vehicles, as
+// raw values in SI units. All arrays have the same number of elements.
+struct FaultArrays {
+  std::size_t count = 0;
+
+  // Mean fault rate of each vehicle's model in faults per second.
+  const double* mean_fault_rate = nullptr;
+
+  // Expected number of faults of each vehicle during the sampled time duration. This is the mean of
+  // the Poisson distribution from which the vehicle's faults are drawn.
+  double* expected_faults = nullptr;
+};
+
+// Floating-point contraction is disabled in all kernels, because AVX-512 implies FMA. This keeps
+// the results of every kernel bit-identical on every processor.
+#if defined(__clang__)
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Structure-of-arrays view of the state of a group of vehicles from which the time duration to the
+// next status change of each vehicle is computed, as raw values in SI units. All arrays have the
+// same number of elements. Vehicles without a vehicle model have model parameters of zero.
+struct EventArrays {
+  std::size_t count = 0;
+
+  // Status of each vehicle.
+  const VehicleStatus* status = nullptr;
+
+  // Remaining battery energy of each vehicle in joules.
+  const double* battery = nullptr;
+
+  // Battery capacity of each vehicle's model in joules.
+  const double* battery_capacity = nullptr;
+
+  // Charging rate of each vehicle's model in watts.
+  const double* charging_rate = nullptr;
+
+  // Transport energy consumption of each vehicle's model in joules per metre.
+  const double* transport_energy_consumption = nullptr;
+
+  // Cruise speed of each vehicle's model in metres per second.
+  const double* cruise_speed = nullptr;
+
+  // Time duration to the next status change of each vehicle in seconds.
+  double* durations = nullptr;
+};
+
+// Flies the vehicles from a given begin index to a given end index for a given duration in
+// seconds, one vehicle at a time. Applies the same update as Vehicle::Fly.
+inline void FlyKernelScalar(const FlightArrays& arrays, const double duration,
+                            const std::size_t begin, const std::size_t end) noexcept {
+  for (std::size_t index = begin; index < end; ++index) {
+    const double distance = arrays.cruise_speed[index] * duration;
+    arrays.battery[index] -= arrays.transport_power_usage[index] * duration;
+    arrays.flight_duration[index] += duration;
+    arrays.flight_distance[index] += distance;
+    arrays.flight_passenger_distance[index] += arrays.passenger_count[index] * distance;
+  }
+}
+
+// Flies all vehicles of a group for a given duration in seconds without SIMD instructions.
+inline void FlyKernelScalar(const FlightArrays& arrays, const double duration) noexcept {
+  FlyKernelScalar(arrays, duration, 0, arrays.count);
+}
+
+// Charges the vehicles from a given begin index to a given end index for a given duration in
+// seconds, one vehicle at a time. Applies the same update as Vehicle::Charge.
+inline void ChargeKernelScalar(const ChargingArrays& arrays, const double duration,
+                               const std::size_t begin, const std::size_t end) noexcept {
+  for (std::size_t index = begin; index < end; ++index) {
+    arrays.battery[index] += arrays.charging_rate[index] * duration;
+    arrays.charging_duration[index] += duration;
+  }
+}
+
+// Charges all vehicles of a group for a given duration in seconds without SIMD instructions.
+inline void ChargeKernelScalar(const ChargingArrays& arrays, const double duration) noexcept {
+  ChargeKernelScalar(arrays, duration, 0, arrays.count);
+}
+
+// Computes the expected number of faults of the vehicles from a given begin index to a given end
+// index during a given duration in seconds, one vehicle at a time. Applies the same product as
+// Vehicle::RandomlyGenerateFaults.
+inline void FaultKernelScalar(const FaultArrays& arrays, const double duration,
+                              const std::size_t begin, const std::size_t end) noexcept {
+  for (std::size_t index = begin; index < end; ++index) {
+    arrays.expected_faults[index] = duration * arrays.mean_fault_rate[index];
+  }
+}
+
+// Computes the expected number of faults of all vehicles of a group during a given duration in
+// seconds without SIMD instructions.
+inline void FaultKernelScalar(const FaultArrays& arrays, const double duration) noexcept {
+  FaultKernelScalar(arrays, duration, 0, arrays.count);
+}
+
+// Returns the smallest of a given initial value and the values from a given begin index to a
+// given end index, one value at a time.
+inline double MinimumKernelScalar(const double* const values, const std::size_t begin,
+                                  const std::size_t end, const double initial) noexcept {
+  double minimum = initial;
+  for (std::size_t index = begin; index < end; ++index) {
+    if (values[index] < minimum) {
+      minimum = values[index];
+    }
+  }
+  return minimum;
+}
+
+// Returns the smallest of a given initial value and a given number of values without SIMD
+// instructions.
+inline double MinimumKernelScalar(
+    const double* const values, const std::size_t count, const double initial) noexcept {
+  return MinimumKernelScalar(values, 0, count, initial);
+}
+
+// Computes the time duration to the next status change of all vehicles of a group. Applies the
+// same rules as Vehicle::DurationToNextStatusChange, but without branches: both the endurance and
+// the time duration to a full charge are computed for every vehicle and the relevant one is
+// selected, so that the loop is vectorized by the compiler for each instruction set.
+inline void NextEventDurations(const EventArrays& arrays) noexcept {
+  for (std::size_t index = 0; index < arrays.count; ++index) {
+    const VehicleStatus status = arrays.status[index];
+    const double battery = arrays.battery[index];
+    const double battery_capacity = arrays.battery_capacity[index];
+    const double charging_rate = arrays.charging_rate[index];
+    const double transport_energy_consumption = arrays.transport_energy_consumption[index];
+    const double cruise_speed = arrays.cruise_speed[index];
+    const double range =
+        transport_energy_consumption > 0.0 ? battery / transport_energy_consumption : 0.0;
+    const double endurance = cruise_speed > 0.0 ? range / cruise_speed : 0.0;
+    const double duration_to_full_charge = battery < battery_capacity && charging_rate > 0.0 ?
+                                               (battery_capacity - battery) / charging_rate :
+                                               0.0;
+    const bool in_flight =
+        status == VehicleStatus::Flying || (status == VehicleStatus::OnStandby && battery > 0.0);
+    arrays.durations[index] = in_flight ? endurance : duration_to_full_charge;
+  }
+}
+
+// Computes the time duration to the next status change of all vehicles of a group and returns the
+// smallest of these durations and a given initial value, without SIMD instructions.
+inline double NextEventKernelScalar(const EventArrays& arrays, const double initial) noexcept {
+  NextEventDurations(arrays);
+  return MinimumKernelScalar(arrays.durations, arrays.count, initial);
+}
+
+#if defined(DEMO_FLEET_KERNELS_DISPATCH)
+
+// Flies all vehicles of a group for a given duration in seconds, two vehicles at a time.
+__attribute__((target("sse4.2"))) inline void FlyKernelSse42(
+    const FlightArrays& arrays, const double duration) noexcept {
+  const __m128d step = _mm_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 2 <= arrays.count; index += 2) {
+    const __m128d distance = _mm_mul_pd(_mm_loadu_pd(arrays.cruise_speed + index), step);
+    const __m128d energy = _mm_mul_pd(_mm_loadu_pd(arrays.transport_power_usage + index), step);
+    _mm_storeu_pd(arrays.battery + index, _mm_sub_pd(_mm_loadu_pd(arrays.battery + index), energy));
+    _mm_storeu_pd(arrays.flight_duration + index,
+                  _mm_add_pd(_mm_loadu_pd(arrays.flight_duration + index), step));
+    _mm_storeu_pd(arrays.flight_distance + index,
+                  _mm_add_pd(_mm_loadu_pd(arrays.flight_distance + index), distance));
+    const __m128d passenger_distance =
+        _mm_mul_pd(_mm_loadu_pd(arrays.passenger_count + index), distance);
+    _mm_storeu_pd(
+        arrays.flight_passenger_distance + index,
+        _mm_add_pd(_mm_loadu_pd(arrays.flight_passenger_distance + index), passenger_distance));
+  }
+  FlyKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Charges all vehicles of a group for a given duration in seconds, two vehicles at a time.
+__attribute__((target("sse4.2"))) inline void ChargeKernelSse42(
+    const ChargingArrays& arrays, const double duration) noexcept {
+  const __m128d step = _mm_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 2 <= arrays.count; index += 2) {
+    const __m128d energy = _mm_mul_pd(_mm_loadu_pd(arrays.charging_rate + index), step);
+    _mm_storeu_pd(arrays.battery + index, _mm_add_pd(_mm_loadu_pd(arrays.battery + index), energy));
+    _mm_storeu_pd(arrays.charging_duration + index,
+                  _mm_add_pd(_mm_loadu_pd(arrays.charging_duration + index), step));
+  }
+  ChargeKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Returns the smallest of a given initial value and a given number of values, two values at a
+// time.
+__attribute__((target("sse4.2"))) inline double MinimumKernelSse42(
+    const double* const values, const std::size_t count, const double initial) noexcept {
+  __m128d minimum = _mm_set1_pd(initial);
+  std::size_t index = 0;
+  for (; index + 2 <= count; index += 2) {
+    minimum = _mm_min_pd(minimum, _mm_loadu_pd(values + index));
+  }
+  minimum = _mm_min_sd(minimum, _mm_unpackhi_pd(minimum, minimum));
+  return MinimumKernelScalar(values, index, count, _mm_cvtsd_f64(minimum));
+}
+
+// Computes the time duration to the next status change of all vehicles of a group and returns the
+// smallest of these durations and a given initial value, two vehicles at a time.
+__attribute__((target("sse4.2"))) inline double NextEventKernelSse42(
+    const EventArrays& arrays, const double initial) noexcept {
+  NextEventDurations(arrays);
+  return MinimumKernelSse42(arrays.durations, arrays.count, initial);
+}
+
+// Flies all vehicles of a group for a given duration in seconds, four vehicles at a time.
+__attribute__((target("avx2"))) inline void FlyKernelAvx2(
+    const FlightArrays& arrays, const double duration) noexcept {
+  const __m256d step = _mm256_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 4 <= arrays.count; index += 4) {
+    const __m256d distance = _mm256_mul_pd(_mm256_loadu_pd(arrays.cruise_speed + index), step);
+    const __m256d energy =
+        _mm256_mul_pd(_mm256_loadu_pd(arrays.transport_power_usage + index), step);
+    _mm256_storeu_pd(
+        arrays.battery + index, _mm256_sub_pd(_mm256_loadu_pd(arrays.battery + index), energy));
+    _mm256_storeu_pd(arrays.flight_duration + index,
+                     _mm256_add_pd(_mm256_loadu_pd(arrays.flight_duration + index), step));
+    _mm256_storeu_pd(arrays.flight_distance + index,
+                     _mm256_add_pd(_mm256_loadu_pd(arrays.flight_distance + index), distance));
+    const __m256d passenger_distance =
+        _mm256_mul_pd(_mm256_loadu_pd(arrays.passenger_count + index), distance);
+    _mm256_storeu_pd(
+        arrays.flight_passenger_distance + index,
+        _mm256_add_pd(_mm256_loadu_pd(arrays.flight_passenger_distance + index),
+                      passenger_distance));
+  }
+  FlyKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Charges all vehicles of a group for a given duration in seconds, four vehicles at a time.
+__attribute__((target("avx2"))) inline void ChargeKernelAvx2(
+    const ChargingArrays& arrays, const double duration) noexcept {
+  const __m256d step = _mm256_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 4 <= arrays.count; index += 4) {
+    const __m256d energy = _mm256_mul_pd(_mm256_loadu_pd(arrays.charging_rate + index), step);
+    _mm256_storeu_pd(
+        arrays.battery + index, _mm256_add_pd(_mm256_loadu_pd(arrays.battery + index), energy));
+    _mm256_storeu_pd(arrays.charging_duration + index,
+                     _mm256_add_pd(_mm256_loadu_pd(arrays.charging_duration + index), step));
+  }
+  ChargeKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Returns the smallest of a given initial value and a given number of values, four values at a
+// time.
+__attribute__((target("avx2"))) inline double MinimumKernelAvx2(
+    const double* const values, const std::size_t count, const double initial) noexcept {
+  __m256d minimum = _mm256_set1_pd(initial);
+  std::size_t index = 0;
+  for (; index + 4 <= count; index += 4) {
+    minimum = _mm256_min_pd(minimum, _mm256_loadu_pd(values + index));
+  }
+  __m128d half = _mm_min_pd(_mm256_castpd256_pd128(minimum), _mm256_extractf128_pd(minimum, 1));
+  half = _mm_min_sd(half, _mm_unpackhi_pd(half, half));
+  return MinimumKernelScalar(values, index, count, _mm_cvtsd_f64(half));
+}
+
+// Computes the time duration to the next status change of all vehicles of a group and returns the
+// smallest of these durations and a given initial value, four vehicles at a time.
+__attribute__((target("avx2"))) inline double NextEventKernelAvx2(
+    const EventArrays& arrays, const double initial) noexcept {
+  NextEventDurations(arrays);
+  return MinimumKernelAvx2(arrays.durations, arrays.count, initial);
+}
+
+// Flies all vehicles of a group for a given duration in seconds, eight vehicles at a time.
+__attribute__((target("avx512f"))) inline void FlyKernelAvx512(
+    const FlightArrays& arrays, const double duration) noexcept {
+  const __m512d step = _mm512_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 8 <= arrays.count; index += 8) {
+    const __m512d distance = _mm512_mul_pd(_mm512_loadu_pd(arrays.cruise_speed + index), step);
+    const __m512d energy =
+        _mm512_mul_pd(_mm512_loadu_pd(arrays.transport_power_usage + index), step);
+    _mm512_storeu_pd(
+        arrays.battery + index, _mm512_sub_pd(_mm512_loadu_pd(arrays.battery + index), energy));
+    _mm512_storeu_pd(arrays.flight_duration + index,
+                     _mm512_add_pd(_mm512_loadu_pd(arrays.flight_duration + index), step));
+    _mm512_storeu_pd(arrays.flight_distance + index,
+                     _mm512_add_pd(_mm512_loadu_pd(arrays.flight_distance + index), distance));
+    const __m512d passenger_distance =
+        _mm512_mul_pd(_mm512_loadu_pd(arrays.passenger_count + index), distance);
+    _mm512_storeu_pd(
+        arrays.flight_passenger_distance + index,
+        _mm512_add_pd(_mm512_loadu_pd(arrays.flight_passenger_distance + index),
+                      passenger_distance));
+  }
+  FlyKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Charges all vehicles of a group for a given duration in seconds, eight vehicles at a time.
+__attribute__((target("avx512f"))) inline void ChargeKernelAvx512(
+    const ChargingArrays& arrays, const double duration) noexcept {
+  const __m512d step = _mm512_set1_pd(duration);
+  std::size_t index = 0;
+  for (; index + 8 <= arrays.count; index += 8) {
+    const __m512d energy = _mm512_mul_pd(_mm512_loadu_pd(arrays.charging_rate + index), step);
+    _mm512_storeu_pd(
+        arrays.battery + index, _mm512_add_pd(_mm512_loadu_pd(arrays.battery + index), energy));
+    _mm512_storeu_pd(arrays.charging_duration + index,
+                     _mm512_add_pd(_mm512_loadu_pd(arrays.charging_duration + index), step));
+  }
+  ChargeKernelScalar(arrays, duration, index, arrays.count);
+}
+
+// Returns the smallest of a given initial value and a given number of values, eight values at a
+// time.
+__attribute__((target("avx512f"))) inline double MinimumKernelAvx512(
+    const double* const values, const std::size_t count, const double initial) noexcept {
+  __m512d minimum = _mm512_set1_pd(initial);
+  std::size_t index = 0;
+  for (; index + 8 <= count; index += 8) {
+    const __m512d loaded = _mm512_loadu_pd(values + index);
+    minimum = _mm512_mask_blend_pd(
+        _mm512_cmp_pd_mask(loaded, minimum, _CMP_LT_OQ), minimum, loaded);
+  }
+  double lanes[8];
+  _mm512_storeu_pd(lanes, minimum);
+  return MinimumKernelScalar(values, index, count, MinimumKernelScalar(lanes, 8, initial));
+}
+
+// Computes the time duration to the next status change of all vehicles of a group and returns the
+// smallest of these durations and a given initial value, eight vehicles at a time.
+__attribute__((target("avx512f"))) inline double NextEventKernelAvx512(
+    const EventArrays& arrays, const double initial) noexcept {
+  NextEventDurations(arrays);
+  return MinimumKernelAvx512(arrays.durations, arrays.count, initial);
+}
+
+#endif  // defined(DEMO_FLEET_KERNELS_DISPATCH)
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+// Table of the fleet kernels compiled for one instruction set.
+struct FleetKernelTable {
+  // Instruction set for which the kernels of this table are compiled.
+  InstructionSet instruction_set = InstructionSet::Scalar;
+
+  // Flies all vehicles of a group for a given duration in seconds.
+  void (*fly)(const FlightArrays&, double) noexcept = &FlyKernelScalar;
+
+  // Charges all vehicles of a group for a given duration in seconds.
+  void (*charge)(const ChargingArrays&, double) noexcept = &ChargeKernelScalar;
+
+  // Computes the expected number of faults of all vehicles of a group during a given duration in
+  // seconds. This is one multiplication per vehicle, which the compiler vectorizes for the baseline
+  // instruction set and which is bound by memory bandwidth, so it is not compiled per instruction
+  // set: every table uses the scalar kernel unless a vehicle model's specialized kernel fills in a
+  // constant.
+  void (*fault)(const FaultArrays&, double) noexcept = &FaultKernelScalar;
+
+  // Returns the smallest of a given initial value and a given number of values.
+  double (*minimum)(const double*, std::size_t, double) noexcept = &MinimumKernelScalar;
+
+  // Computes the time duration to the next status change of all vehicles of a group and returns the
+  // smallest of these durations and a given initial value.
+  double (*next_event)(const EventArrays&, double) noexcept = &NextEventKernelScalar;
+};
+
+// Returns the widest instruction set for which the fleet kernels are compiled and which both the
+// processor and the operating system support, as reported by CPUID.
+inline InstructionSet DetectInstructionSet() noexcept {
+#if defined(DEMO_FLEET_KERNELS_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return InstructionSet::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return InstructionSet::Avx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return InstructionSet::Sse42;
+  }
+#endif
+  return InstructionSet::Scalar;
+}
+
+// Returns the table of the fleet kernels compiled for a given instruction set, or the scalar
+// kernels if the fleet kernels are not compiled for that instruction set. The caller must make sure
+// that the processor supports the given instruction set.
+inline FleetKernelTable FleetKernelsFor(const InstructionSet instruction_set) noexcept {
+  FleetKernelTable table;
+#if defined(DEMO_FLEET_KERNELS_DISPATCH)
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      break;
+    case InstructionSet::Sse42:
+      table = {InstructionSet::Sse42, &FlyKernelSse42, &ChargeKernelSse42, &FaultKernelScalar,
+               &MinimumKernelSse42, &NextEventKernelSse42};
+      break;
+    case InstructionSet::Avx2:
+      table = {InstructionSet::Avx2, &FlyKernelAvx2, &ChargeKernelAvx2, &FaultKernelScalar,
+               &MinimumKernelAvx2, &NextEventKernelAvx2};
+      break;
+    case InstructionSet::Avx512:
+      table = {InstructionSet::Avx512, &FlyKernelAvx512, &ChargeKernelAvx512, &FaultKernelScalar,
+               &MinimumKernelAvx512, &NextEventKernelAvx512};
+      break;
+  }
+#else
+  static_cast<void>(instruction_set);
+#endif
+  return table;
+}
+
+// Table of the fleet kernels for the widest instruction set supported by this processor. The
+// instruction set is detected once, on first use.
+inline const FleetKernelTable& GlobalFleetKernels() noexcept {
+  static const FleetKernelTable table = FleetKernelsFor(DetectInstructionSet());
+  return table;
+}
+
+// Name of the instruction set of the fleet kernels chosen for this processor.
+inline std::string_view FleetKernelInstructionSet() noexcept {
+  return InstructionSetName(GlobalFleetKernels().instruction_set);
+}
+
+// Flies all vehicles of a group for a given duration in seconds with the widest kernel supported by
+// this processor.
+inline void FlyKernel(const FlightArrays& arrays, const double duration) noexcept {
+  GlobalFleetKernels().fly(arrays, duration);
+}
+
+// Charges all vehicles of a group for a given duration in seconds with the widest kernel supported
+// by this processor.
+inline void ChargeKernel(const ChargingArrays& arrays, const double duration) noexcept {
+  GlobalFleetKernels().charge(arrays, duration);
+}
+
+// Computes the expected number of faults of all vehicles of a group during a given duration in
+// seconds. The same kernel is used for every instruction set.
+inline void FaultKernel(const FaultArrays& arrays, const double duration) noexcept {
+  FaultKernelScalar(arrays, duration);
+}
+
+// Returns the smallest of a given initial value and a given number of values with the widest
+// kernel supported by this processor.
+inline double MinimumKernel(
+    const double* const values, const std::size_t count, const double initial) noexcept {
+  return GlobalFleetKernels().minimum(values, count, initial);
+}
+
+// Computes the time duration to the next status change of all vehicles of a group and returns the
+// smallest of these durations and a given initial value with the widest kernel supported by this
+// processor.
+inline double NextEventKernel(const EventArrays& arrays, const double initial) noexcept {
+  return GlobalFleetKernels().next_event(arrays, initial);
+}
+
+// Collects the positions of the vehicles of a group whose status may change at the end of a time
+// step, which are those whose time duration to their next status change does not exceed a given
+// threshold, together with those that are on standby or waiting to charge, whose status depends on
+// other vehicles. The positions are written in increasing order, without branches, to a given
+// buffer that has room for all vehicles of the group. Returns the number of positions collected.
+inline std::size_t SelectEventsKernel(
+    const EventArrays& arrays, const double threshold, std::size_t* const positions) noexcept {
+  std::size_t count = 0;
+  for (std::size_t index = 0; index < arrays.count; ++index) {
+    const VehicleStatus status = arrays.status[index];
+    positions[count] = index;
+    count += static_cast<std::size_t>((arrays.durations[index] <= threshold)
+                                      | (status == VehicleStatus::OnStandby)
+                                      | (status == VehicleStatus::WaitingToCharge));
+  }
+  return count;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLEET_KERNELS_HPP
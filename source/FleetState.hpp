@@ -0,0 +1,548 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLEET_STATE_HPP
+#define DEMO_INCLUDE_FLEET_STATE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <PhQ/Energy.hpp>
+#include <PhQ/Length.hpp>
+#include <PhQ/Time.hpp>
+#include <utility>
+#include <vector>
+
+#include "BatchSampler.hpp"
+#include "CatalogKernels.hpp"
+#include "FleetKernels.hpp"
+#include "MemoryAccounting.hpp"
+#include "Profiler.hpp"
+#include "SampleVehicleModels.hpp"
+#include "Vehicle.hpp"
+#include "VehicleModelTable.hpp"
+#include "VehicleStatus.hpp"
+#include "Vehicles.hpp"
+
+namespace Demo {
+
+// Structure-of-arrays copy of the state of a fleet of vehicles that persists across the time steps
+// of a simulation. The status, battery, and vehicle model parameters of every vehicle are gathered
+// into contiguous arrays only when the membership of the fleet changes, and the time steps keep
+// them up to date from then on:
+// - The time duration to each vehicle's next status change and its minimum, which is the next
+//   time step, are computed by the next event kernel from these arrays.
+// - The vehicles whose status may change during a time step are selected, their state is written
+//   back to their objects, which then perform the time step, and their new state is read back.
+// - Every other vehicle is flying or charging throughout the time step, so it is advanced in bulk
+//   by the flight and charging kernels, and the flight and charging totals that it accumulates are
+//   kept in these arrays until they are written back to its object.
+// The vehicles of a vehicle model of the sample catalog, whose ID and parameters both match those of
+// the catalog entry, use the kernels specialized for it at compile time. Other vehicles use the
+// kernels of the widest instruction set that this processor supports.
+// The vehicles are arranged in blocks of the same vehicle model, and each block is partitioned into
+// flying, charging, and other vehicles, so that each kernel runs over contiguous ranges. A vehicle
+// whose status changes is moved to its partition with at most two swaps. The buffers are reused by
+// every time step, so they only allocate when the fleet changes.
+class FleetState {
+public:
+  // Relative and absolute tolerance in seconds by which a vehicle's time duration to its next
+  // status change may exceed the time step while the vehicle is still selected. This absorbs the
+  // rounding of the battery updates during the time step, which may complete a status change
+  // slightly early.
+  static constexpr double Tolerance = 1.0e-6;
+
+  // Constructs an empty fleet state.
+  FleetState() noexcept = default;
+
+  // Number of vehicles gathered by the last call to Gather.
+  std::size_t Size() const noexcept {
+    return vehicles_.size();
+  }
+
+  // Returns whether this state was gathered from a given fleet whose membership has not changed
+  // since.
+  bool Current(const Vehicles& vehicles) const noexcept {
+    return gathered_ && fleet_ == &vehicles && version_ == vehicles.Version();
+  }
+
+  // Gathers the states of all vehicles of a given fleet, skipping null vehicles. The vehicles must
+  // be up to date, which they are after a call to Flush.
+  void Gather(const Vehicles& vehicles) noexcept {
+    fleet_vehicles_.clear();
+    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+      if (vehicle != nullptr) {
+        fleet_vehicles_.push_back(vehicle.get());
+      }
+    }
+    const std::size_t count = fleet_vehicles_.size();
+
+    // Arrange the vehicles by vehicle model, then by partition, then in the order of the fleet.
+    fleet_positions_.resize(count);
+    std::iota(fleet_positions_.begin(), fleet_positions_.end(), std::size_t{0});
+    std::sort(fleet_positions_.begin(), fleet_positions_.end(),
+              [this](const std::size_t left, const std::size_t right) {
+                const Vehicle& left_vehicle = *fleet_vehicles_[left];
+                const Vehicle& right_vehicle = *fleet_vehicles_[right];
+                if (left_vehicle.ModelTable() != right_vehicle.ModelTable()) {
+                  return std::less<const VehicleModelTable*>()(
+                      left_vehicle.ModelTable(), right_vehicle.ModelTable());
+                }
+                if (left_vehicle.ModelIndex() != right_vehicle.ModelIndex()) {
+                  return left_vehicle.ModelIndex() < right_vehicle.ModelIndex();
+                }
+                const int left_partition = Partition(left_vehicle.Status());
+                const int right_partition = Partition(right_vehicle.Status());
+                if (left_partition != right_partition) {
+                  return left_partition < right_partition;
+                }
+                return left < right;
+              });
+
+    vehicles_.resize(count);
+    layout_positions_.resize(count);
+    status_.resize(count);
+    battery_.resize(count);
+    battery_capacity_.resize(count);
+    charging_rate_.resize(count);
+    transport_energy_consumption_.resize(count);
+    cruise_speed_.resize(count);
+    transport_power_usage_.resize(count);
+    passenger_count_.resize(count);
+    mean_fault_rate_.resize(count);
+    flight_duration_.assign(count, 0.0);
+    flight_distance_.assign(count, 0.0);
+    flight_passenger_distance_.assign(count, 0.0);
+    charging_duration_.assign(count, 0.0);
+    durations_.resize(count);
+    expected_faults_.resize(count);
+    faults_.resize(count);
+    selected_.resize(count);
+    selected_flags_.assign(count, 0);
+    selected_count_ = 0;
+    blocks_.clear();
+
+    for (std::size_t position = 0; position < count; ++position) {
+      Vehicle* const vehicle = fleet_vehicles_[fleet_positions_[position]];
+      vehicles_[position] = vehicle;
+      layout_positions_[fleet_positions_[position]] = position;
+      status_[position] = vehicle->Status();
+      battery_[position] = vehicle->Battery().Value();
+      const VehicleModelParameters parameters = vehicle->ModelIndex() != NoVehicleModel ?
+                                                    vehicle->ModelParameters() :
+                                                    VehicleModelParameters();
+      battery_capacity_[position] = parameters.battery_capacity;
+      charging_rate_[position] = parameters.charging_rate;
+      transport_energy_consumption_[position] = parameters.transport_energy_consumption;
+      cruise_speed_[position] = parameters.cruise_speed;
+      transport_power_usage_[position] = parameters.transport_power_usage;
+      passenger_count_[position] = static_cast<double>(parameters.passenger_count);
+      mean_fault_rate_[position] = parameters.mean_fault_rate;
+
+      // Start a new block at the first vehicle of each vehicle model.
+      if (position == 0 || vehicle->ModelTable() != vehicles_[position - 1]->ModelTable()
+          || vehicle->ModelIndex() != vehicles_[position - 1]->ModelIndex()) {
+        blocks_.push_back({position, position, position, position, FindKernels(*vehicle)});
+      }
+      Block& block = blocks_.back();
+      block.end = position + 1;
+      const int partition = Partition(status_[position]);
+      if (partition <= 0) {
+        block.flying_end = position + 1;
+      }
+      if (partition <= 1) {
+        block.charging_end = position + 1;
+      }
+    }
+
+    gathered_ = true;
+    fleet_ = &vehicles;
+    version_ = vehicles.Version();
+  }
+
+  // Writes the battery and the flight and charging totals accumulated in this state back to every
+  // vehicle, so that the vehicles are up to date. The vehicles must still exist.
+  void Flush() noexcept {
+    for (std::size_t position = 0; position < vehicles_.size(); ++position) {
+      Store(position);
+    }
+  }
+
+  // Computes the time duration in seconds to the next status change of every gathered vehicle and
+  // returns the smallest of these durations and a given initial value in seconds.
+  double Reduce(const double initial) noexcept {
+    double minimum = initial;
+    for (const Block& block : blocks_) {
+      minimum = block.kernels->next_event(Events(block.begin, block.end), minimum);
+    }
+    return minimum;
+  }
+
+  // Time duration in seconds to the next status change of the gathered vehicle at a given position,
+  // as computed by the last call to Reduce.
+  double Duration(const std::size_t position) const noexcept {
+    return durations_[position];
+  }
+
+  // Kernels that advance the gathered vehicle at a given position.
+  const FleetKernelTable& Kernels(const std::size_t position) const noexcept {
+    return *blocks_[BlockIndex(position)].kernels;
+  }
+
+  // Gathered vehicle at a given position. The vehicles are arranged by vehicle model and status
+  // rather than in the order of the fleet.
+  const Vehicle& At(const std::size_t position) const noexcept {
+    return *vehicles_[position];
+  }
+
+  // Selects the gathered vehicles that may change status during a time step of a given duration in
+  // seconds: the vehicles whose next status change is due within the time step, which are the ones
+  // that attain the minimum computed by Reduce, and the vehicles on standby or waiting to charge,
+  // whose status depends on the charging station queues. The selected vehicles are ordered as in
+  // the fleet and their state is written back to them, so that they can perform the time step
+  // themselves. Returns the number of vehicles selected.
+  std::size_t Select(const double time_step) noexcept {
+    selected_count_ = SelectEventsKernel(
+        Events(0, vehicles_.size()), time_step * (1.0 + Tolerance) + Tolerance, selected_.data());
+    std::sort(selected_.begin(), selected_.begin() + static_cast<std::ptrdiff_t>(selected_count_),
+              [this](const std::size_t left, const std::size_t right) {
+                return fleet_positions_[left] < fleet_positions_[right];
+              });
+    for (std::size_t index = 0; index < selected_count_; ++index) {
+      const std::size_t position = selected_[index];
+      selected_flags_[position] = 1;
+      Store(position);
+    }
+    return selected_count_;
+  }
+
+  // Number of vehicles selected by the last call to Select.
+  std::size_t SelectedCount() const noexcept {
+    return selected_count_;
+  }
+
+  // Vehicle at a given position among the vehicles selected by the last call to Select, in the
+  // order of the fleet.
+  Vehicle& Selected(const std::size_t position) const noexcept {
+    return *vehicles_[selected_[position]];
+  }
+
+  // Advances every vehicle that is flying or charging and that was not selected by a time step of
+  // a given duration in seconds, which begins at a given time. The batteries and the flight and
+  // charging totals are updated in bulk. The expected numbers of faults of these vehicles are
+  // computed in bulk, their faults are drawn from a given batch sampler in one batch, and each
+  // vehicle with faults records them and notifies a given observer. The selected vehicles are
+  // advanced in bulk as well, but their state is read back from their objects by Deselect, and they
+  // draw their own faults when they perform the time step.
+  template <typename Observer>
+  void Advance(const double time_step, BatchSampler& sampler, const PhQ::Time<>& time,
+               Observer& observer) noexcept {
+    for (const Block& block : blocks_) {
+      block.kernels->fly(Flight(block.begin, block.flying_end), time_step);
+      block.kernels->charge(Charging(block.flying_end, block.charging_end), time_step);
+    }
+
+    // The flying and charging vehicles of all blocks are drawn together in one contiguous batch.
+    std::size_t count = 0;
+    for (const Block& block : blocks_) {
+      FaultArrays arrays;
+      arrays.count = block.charging_end - block.begin;
+      arrays.mean_fault_rate = mean_fault_rate_.data() + block.begin;
+      arrays.expected_faults = expected_faults_.data() + count;
+      block.kernels->fault(arrays, time_step);
+      for (std::size_t index = 0; index < arrays.count; ++index) {
+        arrays.expected_faults[index] *=
+            static_cast<double>(selected_flags_[block.begin + index] == 0);
+      }
+      count += arrays.count;
+    }
+
+    {
+      DEMO_PROFILE_SCOPE(RandomDraw);
+      sampler.Poisson(expected_faults_.data(), count, faults_.data());
+    }
+
+    count = 0;
+    for (const Block& block : blocks_) {
+      for (std::size_t position = block.begin; position < block.charging_end; ++position) {
+        const int64_t faults = faults_[count++];
+        if (faults > 0) {
+          Store(position);
+          vehicles_[position]->RecordFaults(time, faults, observer);
+        }
+      }
+    }
+  }
+
+  // Reads back the state of the vehicles selected by the last call to Select after they have
+  // performed the time step, and moves each vehicle whose status changed to its partition.
+  void Deselect() noexcept {
+    for (std::size_t index = 0; index < selected_count_; ++index) {
+      const std::size_t position = selected_[index];
+      Load(position);
+      selected_flags_[position] = 0;
+      selected_[index] = fleet_positions_[position];
+    }
+    for (std::size_t index = 0; index < selected_count_; ++index) {
+      Arrange(layout_positions_[selected_[index]]);
+    }
+    selected_count_ = 0;
+  }
+
+private:
+  // Contiguous range of the vehicles of one vehicle model, partitioned into flying vehicles from
+  // begin to flying_end, charging vehicles from flying_end to charging_end, and other vehicles from
+  // charging_end to end, together with the kernels that advance them.
+  struct Block {
+    std::size_t begin = 0;
+
+    std::size_t flying_end = 0;
+
+    std::size_t charging_end = 0;
+
+    std::size_t end = 0;
+
+    const FleetKernelTable* kernels = nullptr;
+  };
+
+  // Partition of the vehicles of a given status within their block: 0 for flying, 1 for charging,
+  // and 2 for on standby or waiting to charge.
+  static constexpr int Partition(const VehicleStatus status) noexcept {
+    switch (status) {
+      case VehicleStatus::Flying:
+        return 0;
+      case VehicleStatus::Charging:
+        return 1;
+      case VehicleStatus::OnStandby:
+      case VehicleStatus::WaitingToCharge:
+        return 2;
+    }
+    return 2;
+  }
+
+  // Writes the battery and the flight and charging totals of the vehicle at a given position back
+  // to it, and resets these totals.
+  void Store(const std::size_t position) noexcept {
+    vehicles_[position]->ApplyTimeSteps(
+        PhQ::Energy<>(battery_[position], PhQ::Unit::Energy::Joule),
+        PhQ::Time<>(flight_duration_[position], PhQ::Unit::Time::Second),
+        PhQ::Length<>(flight_distance_[position], PhQ::Unit::Length::Metre),
+        PhQ::Length<>(flight_passenger_distance_[position], PhQ::Unit::Length::Metre),
+        PhQ::Time<>(charging_duration_[position], PhQ::Unit::Time::Second));
+    flight_duration_[position] = 0.0;
+    flight_distance_[position] = 0.0;
+    flight_passenger_distance_[position] = 0.0;
+    charging_duration_[position] = 0.0;
+  }
+
+  // Reads the status and battery of the vehicle at a given position, whose totals are up to date.
+  void Load(const std::size_t position) noexcept {
+    const Vehicle& vehicle = *vehicles_[position];
+    status_[position] = vehicle.Status();
+    battery_[position] = vehicle.Battery().Value();
+    flight_duration_[position] = 0.0;
+    flight_distance_[position] = 0.0;
+    flight_passenger_distance_[position] = 0.0;
+    charging_duration_[position] = 0.0;
+  }
+
+  // Catalog of the vehicle models for which kernels are specialized at compile time.
+  using SpecializedKernels = CatalogKernels<SampleVehicleModelCatalog>;
+
+  // Returns the kernels specialized for the vehicle model of a given vehicle if it is in the
+  // catalog of SpecializedKernels with the same parameters, or else the kernels of this processor.
+  const FleetKernelTable* FindKernels(const Vehicle& vehicle) const noexcept {
+    if (vehicle.ModelIndex() != NoVehicleModel) {
+      const FleetKernelTable* const kernels =
+          SpecializedKernels::Find(vehicle.Model()->Id(), vehicle.ModelParameters());
+      if (kernels != nullptr) {
+        return kernels;
+      }
+    }
+    return &GlobalFleetKernels();
+  }
+
+  // Index of the block that contains a given position.
+  std::size_t BlockIndex(const std::size_t position) const noexcept {
+    return static_cast<std::size_t>(
+        std::upper_bound(blocks_.cbegin(), blocks_.cend(), position,
+                         [](const std::size_t value, const Block& candidate) {
+                           return value < candidate.begin;
+                         })
+        - blocks_.cbegin() - 1);
+  }
+
+  // Moves the vehicle at a given position to the partition of its status within its block.
+  void Arrange(std::size_t position) noexcept {
+    Block& block = blocks_[BlockIndex(position)];
+    const int target = Partition(status_[position]);
+    int current = position < block.flying_end ? 0 : position < block.charging_end ? 1 : 2;
+    while (current < target) {
+      std::size_t& boundary = current == 0 ? block.flying_end : block.charging_end;
+      --boundary;
+      Swap(position, boundary);
+      position = boundary;
+      ++current;
+    }
+    while (current > target) {
+      std::size_t& boundary = current == 2 ? block.charging_end : block.flying_end;
+      Swap(position, boundary);
+      position = boundary;
+      ++boundary;
+      --current;
+    }
+  }
+
+  // Swaps the vehicles at two given positions of the same block. Their vehicle model parameters are
+  // the same, so they are not swapped.
+  void Swap(const std::size_t first, const std::size_t second) noexcept {
+    if (first == second) {
+      return;
+    }
+    std::swap(vehicles_[first], vehicles_[second]);
+    std::swap(fleet_positions_[first], fleet_positions_[second]);
+    std::swap(status_[first], status_[second]);
+    std::swap(battery_[first], battery_[second]);
+    std::swap(flight_duration_[first], flight_duration_[second]);
+    std::swap(flight_distance_[first], flight_distance_[second]);
+    std::swap(flight_passenger_distance_[first], flight_passenger_distance_[second]);
+    std::swap(charging_duration_[first], charging_duration_[second]);
+    std::swap(durations_[first], durations_[second]);
+    std::swap(selected_flags_[first], selected_flags_[second]);
+    layout_positions_[fleet_positions_[first]] = first;
+    layout_positions_[fleet_positions_[second]] = second;
+  }
+
+  // Structure-of-arrays view of the vehicles from a given begin position to a given end position
+  // for the next event kernels.
+  EventArrays Events(const std::size_t begin, const std::size_t end) noexcept {
+    EventArrays arrays;
+    arrays.count = end - begin;
+    arrays.status = status_.data() + begin;
+    arrays.battery = battery_.data() + begin;
+    arrays.battery_capacity = battery_capacity_.data() + begin;
+    arrays.charging_rate = charging_rate_.data() + begin;
+    arrays.transport_energy_consumption = transport_energy_consumption_.data() + begin;
+    arrays.cruise_speed = cruise_speed_.data() + begin;
+    arrays.durations = durations_.data() + begin;
+    return arrays;
+  }
+
+  // Structure-of-arrays view of the vehicles from a given begin position to a given end position
+  // for the flight kernels.
+  FlightArrays Flight(const std::size_t begin, const std::size_t end) noexcept {
+    FlightArrays arrays;
+    arrays.count = end - begin;
+    arrays.battery = battery_.data() + begin;
+    arrays.transport_power_usage = transport_power_usage_.data() + begin;
+    arrays.cruise_speed = cruise_speed_.data() + begin;
+    arrays.passenger_count = passenger_count_.data() + begin;
+    arrays.flight_duration = flight_duration_.data() + begin;
+    arrays.flight_distance = flight_distance_.data() + begin;
+    arrays.flight_passenger_distance = flight_passenger_distance_.data() + begin;
+    return arrays;
+  }
+
+  // Structure-of-arrays view of the vehicles from a given begin position to a given end position
+  // for the charging kernels.
+  ChargingArrays Charging(const std::size_t begin, const std::size_t end) noexcept {
+    ChargingArrays arrays;
+    arrays.count = end - begin;
+    arrays.battery = battery_.data() + begin;
+    arrays.charging_rate = charging_rate_.data() + begin;
+    arrays.charging_duration = charging_duration_.data() + begin;
+    return arrays;
+  }
+
+  // Array of one element per vehicle or per block, whose memory is accounted for.
+  template <typename Type>
+  using Array = std::vector<Type, TrackingAllocator<Type, MemorySubsystem::FleetState>>;
+
+  // Whether this state was gathered, from which fleet, and at which version of its membership.
+  bool gathered_ = false;
+
+  const Vehicles* fleet_ = nullptr;
+
+  uint64_t version_ = 0;
+
+  // Vehicles in the order of the fleet, used while gathering.
+  Array<Vehicle*> fleet_vehicles_;
+
+  // Vehicles, and their positions in the order of the fleet.
+  Array<Vehicle*> vehicles_;
+
+  Array<std::size_t> fleet_positions_;
+
+  // Position of each vehicle of the fleet in these arrays, in the order of the fleet.
+  Array<std::size_t> layout_positions_;
+
+  Array<Block> blocks_;
+
+  Array<VehicleStatus> status_;
+
+  Array<double> battery_;
+
+  Array<double> battery_capacity_;
+
+  Array<double> charging_rate_;
+
+  Array<double> transport_energy_consumption_;
+
+  Array<double> cruise_speed_;
+
+  Array<double> transport_power_usage_;
+
+  Array<double> passenger_count_;
+
+  Array<double> mean_fault_rate_;
+
+  // Flight and charging totals accumulated since they were last written back to the vehicles.
+  Array<double> flight_duration_;
+
+  Array<double> flight_distance_;
+
+  Array<double> flight_passenger_distance_;
+
+  Array<double> charging_duration_;
+
+  Array<double> durations_;
+
+  // Expected numbers of faults and numbers of faults drawn during a time step, for the flying and
+  // charging vehicles of all blocks in turn.
+  Array<double> expected_faults_;
+
+  Array<int64_t> faults_;
+
+  // Positions of the selected vehicles, and whether the vehicle at each position is selected.
+  Array<std::size_t> selected_;
+
+  Array<uint8_t> selected_flags_;
+
+  std::size_t selected_count_ = 0;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLEET_STATE_HPP
@@ -0,0 +1,332 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLIGHT_RECORDER_HPP
+#define DEMO_INCLUDE_FLIGHT_RECORDER_HPP
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <PhQ/Time.hpp>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Logger.hpp"
+#include "SimulationObserver.hpp"
+#include "Vehicle.hpp"
+
+namespace Demo {
+
+// Magic bytes at the beginning of a flight recorder file.
+inline constexpr std::array<uint8_t, 8> FlightRecorderMagic{'J', 'O', 'B', 'Y', 'F', 'L', 'R', '1'};
+
+// Version of the flight recorder file format.
+inline constexpr uint32_t FlightRecorderVersion = 1;
+
+// Default number of entries of a flight recorder.
+inline constexpr std::size_t DefaultFlightRecorderCapacity = 1 << 16;
+
+// Kind of event recorded by a flight recorder. The vehicle events have the same values as the
+// corresponding trace events.
+enum class FlightRecorderEvent : uint8_t {
+  Takeoff,
+  Landing,
+  Enqueue,
+  ChargeStart,
+  ChargeEnd,
+  Fault,
+  TimeStep,
+};
+
+// Header of a flight recorder file.
+struct FlightRecorderHeader {
+  std::array<uint8_t, 8> magic;
+
+  uint32_t version;
+
+  // Size in bytes of each entry.
+  uint32_t entry_size;
+
+  // Number of entries of the ring. Always a power of two.
+  uint64_t capacity;
+
+  // Number of entries written so far. The most recent entry has this sequence number.
+  std::atomic<uint64_t> count;
+};
+
+// Entry of a flight recorder file. Entries are written in place by the simulation while other
+// processes may be reading them, so each entry is guarded by its tag: the tag is zeroed before
+// the entry is modified and set after it is complete. A reader that reads the same non-zero tag
+// before and after copying an entry has a consistent copy of it.
+struct FlightRecorderEntry {
+  // Sequence number of this entry, starting at 1, shifted left by 8 bits, combined with the kind of
+  // event in the low 8 bits. Zero while the entry is being written.
+  std::atomic<uint64_t> tag;
+
+  // Time of the event in seconds. For time steps, this is the elapsed time at the end of the step.
+  double time;
+
+  // ID of the vehicle, or the time step count for time steps.
+  int64_t subject;
+
+  // ID of the charging station for enqueue and charge events, the fault count for fault events, or
+  // the bits of the time step duration in seconds as a double for time steps.
+  int64_t value;
+};
+
+static_assert(sizeof(FlightRecorderEntry) == 32, "Flight recorder entries must be 32 bytes.");
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Flight recorder entries require lock-free 64-bit atomics.");
+
+// Size in bytes reserved for the header of a flight recorder file.
+inline constexpr std::size_t FlightRecorderHeaderSize = 64;
+
+static_assert(sizeof(FlightRecorderHeader) <= FlightRecorderHeaderSize,
+              "The flight recorder header must fit in its reserved size.");
+
+// Largest number of entries of a flight recorder. This is a power of two small enough that the size
+// in bytes of the file, including its header, fits in both std::size_t and off_t: 2^56 entries of
+// 32 bytes on 64-bit systems, or 2^24 entries on 32-bit systems.
+inline constexpr std::size_t MaximumFlightRecorderCapacity = std::size_t{1}
+                                                             << (8 * sizeof(std::size_t) - 8);
+
+// Always-on recorder of the most recent events of a simulation in a fixed-size ring of entries,
+// stored in a memory-mapped file. Recording an event is a handful of stores into shared memory with
+// no system call, so the recorder can be left enabled in production runs. Because the file is
+// shared with the operating system's page cache, its contents survive a crash of the simulation,
+// and other processes can read it with FlightRecorderReader while the simulation runs. On systems
+// without memory mapping, the ring is kept in memory only.
+class FlightRecorder {
+public:
+  // Creates a flight recorder file at the given path that holds at least a given number of the most
+  // recent entries. The capacity is rounded up to a power of two. The capacity must not exceed
+  // MaximumFlightRecorderCapacity; otherwise, an error is logged and nothing is recorded.
+  FlightRecorder(const std::filesystem::path& path,
+                 const std::size_t capacity = DefaultFlightRecorderCapacity) noexcept
+    : path_(path) {
+    assert(capacity <= MaximumFlightRecorderCapacity);
+    if (capacity > MaximumFlightRecorderCapacity) {
+      Log(LogLevel::Error) << "The flight recorder capacity of " << capacity
+                           << " entries exceeds the maximum of " << MaximumFlightRecorderCapacity
+                           << " entries.";
+      return;
+    }
+    capacity_ = 1;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    size_ = FlightRecorderHeaderSize + capacity_ * sizeof(FlightRecorderEntry);
+#if defined(__unix__) || defined(__APPLE__)
+    const int descriptor = ::open(path_.string().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0 || ::ftruncate(descriptor, static_cast<off_t>(size_)) != 0) {
+      Log(LogLevel::Error) << "Could not open the file: " << path_.string();
+      if (descriptor >= 0) {
+        ::close(descriptor);
+      }
+      return;
+    }
+    void* const address =
+        ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED) {
+      Log(LogLevel::Error) << "Could not map the file: " << path_.string();
+      return;
+    }
+    data_ = static_cast<uint8_t*>(address);
+#else
+    Log(LogLevel::Warning) << "Memory-mapped files are not supported on this system. The flight "
+                              "recorder is kept in memory only.";
+    buffer_.resize(size_);
+    data_ = buffer_.data();
+#endif
+    // The file is zero-filled, so all entries begin with a zero tag.
+    header_ = new (data_) FlightRecorderHeader{
+        FlightRecorderMagic, FlightRecorderVersion, sizeof(FlightRecorderEntry), capacity_, {0}};
+    entries_ = reinterpret_cast<FlightRecorderEntry*>(data_ + FlightRecorderHeaderSize);
+  }
+
+  FlightRecorder(const FlightRecorder& other) = delete;
+
+  FlightRecorder& operator=(const FlightRecorder& other) = delete;
+
+  // Destructor. Unmaps the file, which persists.
+  ~FlightRecorder() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+#endif
+  }
+
+  // Path to the flight recorder file.
+  const std::filesystem::path& Path() const noexcept {
+    return path_;
+  }
+
+  // Returns whether the flight recorder is recording.
+  bool IsOpen() const noexcept {
+    return data_ != nullptr;
+  }
+
+  // Number of entries of the ring.
+  std::size_t Capacity() const noexcept {
+    return capacity_;
+  }
+
+  // Number of entries recorded so far, including those that have since been overwritten.
+  uint64_t Count() const noexcept {
+    return count_;
+  }
+
+  // Records an event at a given time with a given subject and value.
+  void Record(const FlightRecorderEvent event, const double time, const int64_t subject,
+              const int64_t value) noexcept {
+    if (data_ == nullptr) {
+      return;
+    }
+    const uint64_t sequence = ++count_;
+    FlightRecorderEntry& entry = entries_[(sequence - 1) & (capacity_ - 1)];
+    entry.tag.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.time = time;
+    entry.subject = subject;
+    entry.value = value;
+    entry.tag.store((sequence << 8) | static_cast<uint64_t>(event), std::memory_order_release);
+    header_->count.store(sequence, std::memory_order_release);
+  }
+
+  // Records an event of a given kind for a given vehicle at a given time.
+  void Record(const FlightRecorderEvent event, const PhQ::Time<>& time, const Vehicle& vehicle,
+              const int64_t value) noexcept {
+    Record(event, time.Value(), vehicle.Id(), value);
+  }
+
+  // Records a time step.
+  void RecordTimeStep(const std::size_t time_step_count, const PhQ::Time<>& time_step,
+                      const PhQ::Time<>& elapsed_time) noexcept {
+    const double duration = time_step.Value();
+    int64_t bits = 0;
+    std::memcpy(&bits, &duration, sizeof(bits));
+    Record(FlightRecorderEvent::TimeStep, elapsed_time.Value(),
+           static_cast<int64_t>(time_step_count), bits);
+  }
+
+private:
+  std::filesystem::path path_;
+
+  std::size_t capacity_ = 0;
+
+  std::size_t size_ = 0;
+
+  uint8_t* data_ = nullptr;
+
+  FlightRecorderHeader* header_ = nullptr;
+
+  FlightRecorderEntry* entries_ = nullptr;
+
+  // Number of entries recorded so far. Kept here so that recording does not read shared memory.
+  uint64_t count_ = 0;
+
+#if !defined(__unix__) && !defined(__APPLE__)
+  std::vector<uint8_t> buffer_;
+#endif
+};
+
+// Simulation observer that records every event and time step through a flight recorder. The
+// flight recorder is not owned by this observer. If no flight recorder is given, nothing is
+// recorded.
+class FlightRecorderObserver : public SimulationObserver {
+public:
+  // Creates an observer that records events through a given flight recorder, which may be null.
+  FlightRecorderObserver(FlightRecorder* const recorder = nullptr) noexcept
+    : recorder_(recorder) {}
+
+  // Flight recorder of this observer. May be null.
+  FlightRecorder* Recorder() const noexcept {
+    return recorder_;
+  }
+
+  void OnTimeStep(const std::size_t time_step_count, const PhQ::Time<>& time_step,
+                  const PhQ::Time<>& elapsed_time) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->RecordTimeStep(time_step_count, time_step, elapsed_time);
+    }
+  }
+
+  void OnTakeoff(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::Takeoff, time, vehicle, 0);
+    }
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::Landing, time, vehicle, 0);
+    }
+  }
+
+  void OnEnqueue(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::Enqueue, time, vehicle,
+                        vehicle.ChargingStationId().value_or(-1));
+    }
+  }
+
+  void OnChargeStart(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::ChargeStart, time, vehicle,
+                        vehicle.ChargingStationId().value_or(-1));
+    }
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::ChargeEnd, time, vehicle,
+                        vehicle.ChargingStationId().value_or(-1));
+    }
+  }
+
+  void OnFault(const PhQ::Time<>& time, const Vehicle& vehicle,
+               const int64_t fault_count) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(FlightRecorderEvent::Fault, time, vehicle, fault_count);
+    }
+  }
+
+private:
+  FlightRecorder* recorder_ = nullptr;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLIGHT_RECORDER_HPP
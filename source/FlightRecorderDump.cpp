@@ -0,0 +1,129 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Arguments.hpp"
+#include "FlightRecorderReader.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+// Time steps shorter than this duration in seconds are reported as vanishing time steps, which
+// indicate that the simulation is stalling.
+constexpr double VanishingTimeStepDuration = 1.0E-9;
+
+// Prints the usage information of the flight recorder dump program.
+void PrintUsage(const std::string& executable_name) noexcept {
+  Demo::Log(Demo::LogLevel::Information)
+      << "Usage: " << executable_name << " " << Demo::Arguments::FlightRecorderPattern;
+  Demo::Log(Demo::LogLevel::Information)
+      << "Prints the most recent events of a simulation from its flight recorder file. The "
+         "simulation may still be running.";
+}
+
+// Prints a flight recorder record.
+void Print(const Demo::FlightRecorderRecord& record) noexcept {
+  if (record.event == Demo::FlightRecorderEvent::TimeStep) {
+    Demo::Log(Demo::LogLevel::Information)
+        << "#" << record.sequence << " Time step " << record.subject
+        << ": increment = " << record.TimeStepDuration() << " s, elapsed = " << record.time
+        << " s";
+    return;
+  }
+  Demo::LogMessage message = Demo::Log(Demo::LogLevel::Information);
+  message << "#" << record.sequence << " " << record.time << " s: "
+          << Demo::FlightRecorderEventName(record.event) << " of vehicle " << record.subject;
+  switch (record.event) {
+    case Demo::FlightRecorderEvent::Enqueue:
+    case Demo::FlightRecorderEvent::ChargeStart:
+    case Demo::FlightRecorderEvent::ChargeEnd:
+      message << " at charging station " << record.value;
+      break;
+    case Demo::FlightRecorderEvent::Fault:
+      message << " (" << record.value << " faults)";
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::filesystem::path flight_recorder;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == Demo::Arguments::FlightRecorderKey && index + 1 < argc) {
+      flight_recorder = argv[++index];
+    } else {
+      if (argument != Demo::Arguments::Help) {
+        Demo::Log(Demo::LogLevel::Error) << "Unrecognized argument: " << argument;
+      }
+      PrintUsage(argv[0]);
+      return argument == Demo::Arguments::Help ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  if (flight_recorder.empty()) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const Demo::FlightRecorderReader reader{flight_recorder};
+  if (!reader.IsValid()) {
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<Demo::FlightRecorderRecord> records = reader.Snapshot();
+
+  Demo::Log(Demo::LogLevel::Information)
+      << "The flight recorder holds " << records.size() << " of " << reader.Count()
+      << " events recorded so far:";
+
+  for (const Demo::FlightRecorderRecord& record : records) {
+    Print(record);
+  }
+
+  const int64_t time_step_count = std::count_if(
+      records.begin(), records.end(), [](const Demo::FlightRecorderRecord& record) {
+        return record.event == Demo::FlightRecorderEvent::TimeStep;
+      });
+  const int64_t vanishing_time_step_count = std::count_if(
+      records.begin(), records.end(), [](const Demo::FlightRecorderRecord& record) {
+        return record.event == Demo::FlightRecorderEvent::TimeStep
+               && record.TimeStepDuration() < VanishingTimeStepDuration;
+      });
+  if (vanishing_time_step_count > 0) {
+    Demo::Log(Demo::LogLevel::Warning)
+        << vanishing_time_step_count << " of the last " << time_step_count
+        << " time steps are shorter than " << VanishingTimeStepDuration
+        << " s, which indicates that the simulation is stalling.";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_FLIGHT_RECORDER_READER_HPP
+#define DEMO_INCLUDE_FLIGHT_RECORDER_READER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "FlightRecorder.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+
+namespace Demo {
+
+// Returns the name of a kind of flight recorder event.
+inline std::string_view FlightRecorderEventName(const FlightRecorderEvent event) noexcept {
+  switch (event) {
+    case FlightRecorderEvent::Takeoff:
+      return "Takeoff";
+    case FlightRecorderEvent::Landing:
+      return "Landing";
+    case FlightRecorderEvent::Enqueue:
+      return "Enqueue";
+    case FlightRecorderEvent::ChargeStart:
+      return "ChargeStart";
+    case FlightRecorderEvent::ChargeEnd:
+      return "ChargeEnd";
+    case FlightRecorderEvent::Fault:
+      return "Fault";
+    case FlightRecorderEvent::TimeStep:
+      return "TimeStep";
+  }
+  return "Unknown";
+}
+
+// Consistent copy of a flight recorder entry.
+struct FlightRecorderRecord {
+  // Sequence number of the entry, starting at 1.
+  uint64_t sequence = 0;
+
+  FlightRecorderEvent event = FlightRecorderEvent::Takeoff;
+
+  // Time of the event in seconds. For time steps, this is the elapsed time at the end of the step.
+  double time = 0.0;
+
+  // ID of the vehicle, or the time step count for time steps.
+  int64_t subject = 0;
+
+  // ID of the charging station for enqueue and charge events or the fault count for fault events.
+  int64_t value = 0;
+
+  // Duration in seconds of the time step. Only meaningful for time steps.
+  double TimeStepDuration() const noexcept {
+    double duration = 0.0;
+    std::memcpy(&duration, &value, sizeof(duration));
+    return duration;
+  }
+};
+
+// Reads a flight recorder file, possibly while a simulation is still writing to it.
+class FlightRecorderReader {
+public:
+  // Maps the flight recorder file at the given path and validates its header.
+  FlightRecorderReader(const std::filesystem::path& path) noexcept : file_(path) {
+    if (!file_.IsOpen()) {
+      return;
+    }
+    if (file_.Size() < FlightRecorderHeaderSize) {
+      Log(LogLevel::Error) << "Not a flight recorder file: " << path.string();
+      return;
+    }
+    header_ = reinterpret_cast<const FlightRecorderHeader*>(file_.Data());
+    const uint64_t capacity = header_->capacity;
+    if (header_->magic != FlightRecorderMagic || header_->version != FlightRecorderVersion
+        || header_->entry_size != sizeof(FlightRecorderEntry) || capacity == 0
+        || (capacity & (capacity - 1)) != 0
+        || file_.Size() != FlightRecorderHeaderSize + capacity * sizeof(FlightRecorderEntry)) {
+      Log(LogLevel::Error) << "Not a flight recorder file: " << path.string();
+      header_ = nullptr;
+      return;
+    }
+    entries_ =
+        reinterpret_cast<const FlightRecorderEntry*>(file_.Data() + FlightRecorderHeaderSize);
+  }
+
+  // Returns whether the flight recorder file is valid.
+  bool IsValid() const noexcept {
+    return header_ != nullptr;
+  }
+
+  // Number of entries of the ring.
+  uint64_t Capacity() const noexcept {
+    return header_ != nullptr ? header_->capacity : 0;
+  }
+
+  // Number of entries recorded so far, including those that have since been overwritten.
+  uint64_t Count() const noexcept {
+    return header_ != nullptr ? header_->count.load(std::memory_order_acquire) : 0;
+  }
+
+  // Returns consistent copies of the entries currently in the ring, oldest first. Entries that are
+  // being overwritten while they are copied are skipped.
+  std::vector<FlightRecorderRecord> Snapshot() const noexcept {
+    std::vector<FlightRecorderRecord> records;
+    if (header_ == nullptr) {
+      return records;
+    }
+    const uint64_t capacity = header_->capacity;
+    const uint64_t count = Count();
+    const uint64_t first = count > capacity ? count - capacity + 1 : 1;
+    records.reserve(static_cast<std::size_t>(count - first + 1));
+    for (uint64_t sequence = first; sequence <= count; ++sequence) {
+      const FlightRecorderEntry& entry = entries_[(sequence - 1) & (capacity - 1)];
+      const uint64_t tag = entry.tag.load(std::memory_order_acquire);
+      if (tag >> 8 != sequence) {
+        continue;
+      }
+      FlightRecorderRecord record;
+      record.sequence = sequence;
+      record.event = static_cast<FlightRecorderEvent>(tag & 0xFF);
+      record.time = entry.time;
+      record.subject = entry.subject;
+      record.value = entry.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (entry.tag.load(std::memory_order_relaxed) != tag) {
+        continue;
+      }
+      records.push_back(record);
+    }
+    return records;
+  }
+
+private:
+  MappedFile file_;
+
+  const FlightRecorderHeader* header_ = nullptr;
+
+  const FlightRecorderEntry* entries_ = nullptr;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_FLIGHT_RECORDER_READER_HPP
@@ -0,0 +1,73 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_LOG_LEVEL_HPP
+#define DEMO_INCLUDE_LOG_LEVEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace Demo {
+
+// Severity level of a log message. Lower levels are more severe. A logger configured at a given
+// level emits all messages at that level or at any more severe level.
+enum class LogLevel : int8_t {
+  Error,
+  Warning,
+  Information,
+  Debug,
+};
+
+// Number of log levels.
+inline constexpr std::size_t LogLevelCount = 4;
+
+// Returns the name of a given log level.
+inline constexpr std::string_view LogLevelName(const LogLevel level) noexcept {
+  switch (level) {
+    case LogLevel::Error:
+      return "error";
+    case LogLevel::Warning:
+      return "warning";
+    case LogLevel::Information:
+      return "information";
+    case LogLevel::Debug:
+      return "debug";
+  }
+  return "";
+}
+
+// Parses a log level from its name, or returns std::nullopt if the name is not recognized.
+inline std::optional<LogLevel> ParseLogLevel(const std::string_view name) noexcept {
+  for (const LogLevel level :
+       {LogLevel::Error, LogLevel::Warning, LogLevel::Information, LogLevel::Debug}) {
+    if (name == LogLevelName(level)) {
+      return level;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_LOG_LEVEL_HPP
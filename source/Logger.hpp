@@ -0,0 +1,540 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_LOGGER_HPP
+#define DEMO_INCLUDE_LOGGER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "LogLevel.hpp"
+
+namespace Demo {
+
+// Asynchronous leveled logger. Messages are copied into a fixed-capacity lock-free ring buffer and
+// are written to the standard output or to a file by a background thread, so logging never blocks
+// on terminal or file I/O unless the ring buffer is full. Messages that are less severe than the
+// logger's level are discarded, and each level can optionally be rate-limited.
+class Logger {
+public:
+  // Constructs a logger that writes to the standard output and starts its background thread. The
+  // capacity is the number of slots in the ring buffer and is rounded up to a power of two.
+  Logger(const std::size_t capacity = 4096) noexcept
+    : capacity_(RoundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2))), mask_(capacity_ - 1),
+      slots_(new Slot[capacity_]), stream_(stdout) {
+    for (std::size_t index = 0; index < capacity_; ++index) {
+      slots_[index].sequence.store(index, std::memory_order_relaxed);
+    }
+    thread_ = std::thread(&Logger::Drain, this);
+  }
+
+  Logger(const Logger& other) = delete;
+
+  Logger& operator=(const Logger& other) = delete;
+
+  // Destructor. Reports the number of messages suppressed by rate limiting, if any, writes all
+  // pending messages, stops the background thread, and closes the file, if any.
+  ~Logger() noexcept {
+    const std::size_t suppressed_count = SuppressedCount();
+    if (suppressed_count > 0) {
+      Publish(LogLevel::Warning, std::to_string(suppressed_count)
+                                     + " log messages were suppressed by rate limiting.");
+    }
+    {
+      const std::lock_guard<std::mutex> lock(wake_mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    CloseFile();
+  }
+
+  // Current level of this logger. Messages that are less severe than this level are discarded.
+  LogLevel Level() const noexcept {
+    return level_.load(std::memory_order_relaxed);
+  }
+
+  // Sets the level of this logger.
+  void SetLevel(const LogLevel level) noexcept {
+    level_.store(level, std::memory_order_relaxed);
+  }
+
+  // Directs subsequent messages to the file at the given path, or to the standard output if the
+  // path is empty. Pending messages are written to the previous destination first. Returns false
+  // if the file could not be opened, in which case the destination is unchanged.
+  bool SetFile(const std::filesystem::path& path) noexcept {
+    Flush();
+    std::FILE* stream = stdout;
+    if (!path.empty()) {
+      stream = std::fopen(path.string().c_str(), "w");
+      if (stream == nullptr) {
+        return false;
+      }
+    }
+    const std::lock_guard<std::mutex> lock(stream_mutex_);
+    CloseFile();
+    stream_ = stream;
+    return true;
+  }
+
+  // Limits the messages of a given level to a sustained rate in messages per second, with bursts of
+  // up to a given number of messages. Messages in excess of this limit are discarded and counted. A
+  // non-positive rate removes the limit.
+  void SetRateLimit(
+      const LogLevel level, const double messages_per_second, const std::size_t burst) noexcept {
+    rate_limiters_[Index(level)].Configure(messages_per_second, burst);
+  }
+
+  // Returns whether messages of a given level are currently emitted by this logger.
+  bool Enabled(const LogLevel level) const noexcept {
+    return level <= Level();
+  }
+
+  // Returns whether a message of a given level should be formatted and logged now. This accounts
+  // for both the level of this logger and the rate limit of the given level.
+  bool Admit(const LogLevel level) noexcept {
+    if (!Enabled(level)) {
+      return false;
+    }
+    if (!rate_limiters_[Index(level)].Acquire()) {
+      suppressed_count_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  // Total number of messages that were discarded due to rate limiting.
+  std::size_t SuppressedCount() const noexcept {
+    return suppressed_count_.load(std::memory_order_relaxed);
+  }
+
+  // Logs a message at a given level, subject to the level and rate limit of this logger.
+  void Log(const LogLevel level, const std::string_view text) noexcept {
+    if (Admit(level)) {
+      Publish(level, text);
+    }
+  }
+
+  // Publishes a message at a given level without checking the level or rate limit of this logger.
+  // A trailing newline is appended to the message when it is written. Long messages occupy several
+  // consecutive slots of the ring buffer. If the ring buffer is full, waits for the background
+  // thread to make room.
+  void Publish(const LogLevel level, std::string_view text) noexcept {
+    const std::string_view prefix = Prefix(level);
+    const std::size_t length = prefix.size() + text.size();
+    const std::size_t count = std::min(
+        std::max<std::size_t>((length + SlotTextCapacity - 1) / SlotTextCapacity, 1), capacity_);
+
+    // Reserve a run of consecutive slots. Slots are released by the single consumer in order, so
+    // the run is free once its last slot is free.
+    uint64_t position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true) {
+      const uint64_t last = position + count - 1;
+      const uint64_t sequence = slots_[last & mask_].sequence.load(std::memory_order_acquire);
+      if (sequence == last) {
+        if (enqueue_position_.compare_exchange_weak(
+                position, position + count, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (sequence < last) {
+        // The ring buffer is full: wait for the background thread to drain it.
+        Wake();
+        std::this_thread::yield();
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+
+    // Copy the message into the reserved slots, splitting it across them as needed.
+    std::size_t prefix_offset = 0;
+    for (std::size_t index = 0; index < count; ++index) {
+      Slot& slot = slots_[(position + index) & mask_];
+      std::size_t slot_length = 0;
+      const std::size_t prefix_part =
+          std::min(prefix.size() - prefix_offset, SlotTextCapacity - slot_length);
+      std::memcpy(slot.text, prefix.data() + prefix_offset, prefix_part);
+      prefix_offset += prefix_part;
+      slot_length += prefix_part;
+      const std::size_t text_part = std::min(text.size(), SlotTextCapacity - slot_length);
+      std::memcpy(slot.text + slot_length, text.data(), text_part);
+      text.remove_prefix(text_part);
+      slot_length += text_part;
+      slot.length = static_cast<uint16_t>(slot_length);
+      slot.last = index + 1 == count;
+      slot.sequence.store(position + index + 1, std::memory_order_release);
+    }
+
+    if (level <= LogLevel::Warning) {
+      Wake();
+    }
+  }
+
+  // Blocks until all messages published so far have been written to their destination.
+  void Flush() noexcept {
+    const uint64_t target = enqueue_position_.load(std::memory_order_acquire);
+    while (dequeue_position_.load(std::memory_order_acquire) < target) {
+      Wake();
+      std::this_thread::yield();
+    }
+    const std::lock_guard<std::mutex> lock(stream_mutex_);
+    std::fflush(stream_);
+  }
+
+private:
+  // Maximum number of characters stored in one slot of the ring buffer.
+  static constexpr std::size_t SlotTextCapacity = 240;
+
+  // Interval at which the background thread polls the ring buffer when it is not woken up.
+  static constexpr std::chrono::milliseconds PollInterval{10};
+
+  // Slot of the ring buffer. The sequence number encodes the state of the slot: a slot at position
+  // p is free when its sequence number is p, and holds a published message when its sequence
+  // number is p + 1.
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    uint16_t length = 0;
+    bool last = true;
+    char text[SlotTextCapacity];
+  };
+
+  // Token-bucket rate limiter.
+  class RateLimiter {
+  public:
+    void Configure(const double messages_per_second, const std::size_t burst) noexcept {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      rate_ = messages_per_second;
+      burst_ = static_cast<double>(std::max<std::size_t>(burst, 1));
+      tokens_ = burst_;
+      refill_time_ = std::chrono::steady_clock::now();
+      limited_.store(messages_per_second > 0.0, std::memory_order_relaxed);
+    }
+
+    // Returns whether a message may be emitted now and consumes a token if so.
+    bool Acquire() noexcept {
+      if (!limited_.load(std::memory_order_relaxed)) {
+        return true;
+      }
+      const std::lock_guard<std::mutex> lock(mutex_);
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      tokens_ = std::min(
+          burst_, tokens_ + rate_ * std::chrono::duration<double>(now - refill_time_).count());
+      refill_time_ = now;
+      if (tokens_ < 1.0) {
+        return false;
+      }
+      tokens_ -= 1.0;
+      return true;
+    }
+
+  private:
+    std::atomic<bool> limited_{false};
+
+    std::mutex mutex_;
+
+    double rate_ = 0.0;
+
+    double burst_ = 1.0;
+
+    double tokens_ = 0.0;
+
+    std::chrono::steady_clock::time_point refill_time_;
+  };
+
+  static constexpr std::size_t RoundUpToPowerOfTwo(const std::size_t value) noexcept {
+    std::size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  static constexpr std::size_t Index(const LogLevel level) noexcept {
+    return static_cast<std::size_t>(level);
+  }
+
+  // Returns the text printed before messages of a given level.
+  static constexpr std::string_view Prefix(const LogLevel level) noexcept {
+    switch (level) {
+      case LogLevel::Error:
+        return "Error: ";
+      case LogLevel::Warning:
+        return "Warning: ";
+      case LogLevel::Information:
+      case LogLevel::Debug:
+        return "";
+    }
+    return "";
+  }
+
+  // Wakes up the background thread if it is waiting.
+  void Wake() noexcept {
+    if (waiting_.load(std::memory_order_acquire)) {
+      wake_.notify_one();
+    }
+  }
+
+  // Closes the current file, if any.
+  void CloseFile() noexcept {
+    if (stream_ != stdout && stream_ != nullptr) {
+      std::fclose(stream_);
+    }
+    stream_ = stdout;
+  }
+
+  // Main loop of the background thread. Writes published messages in batches until the logger is
+  // destroyed, then writes any remaining messages.
+  void Drain() noexcept {
+    std::string batch;
+    batch.reserve(capacity_ * (SlotTextCapacity + 1));
+    while (true) {
+      const bool stopping = [this] {
+        const std::lock_guard<std::mutex> lock(wake_mutex_);
+        return stopping_;
+      }();
+
+      if (!DrainBatch(batch)) {
+        if (stopping) {
+          return;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        waiting_.store(true, std::memory_order_release);
+        wake_.wait_for(lock, PollInterval);
+        waiting_.store(false, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Writes all messages that are currently published. Returns false if there were none.
+  bool DrainBatch(std::string& batch) noexcept {
+    batch.clear();
+    uint64_t position = dequeue_position_.load(std::memory_order_relaxed);
+    const uint64_t first = position;
+    while (true) {
+      Slot& slot = slots_[position & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+        break;
+      }
+      batch.append(slot.text, slot.length);
+      if (slot.last) {
+        batch.push_back('\n');
+      }
+      slot.sequence.store(position + capacity_, std::memory_order_release);
+      ++position;
+    }
+
+    if (position == first) {
+      return false;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(stream_mutex_);
+      std::fwrite(batch.data(), 1, batch.size(), stream_);
+      std::fflush(stream_);
+    }
+    dequeue_position_.store(position, std::memory_order_release);
+    return true;
+  }
+
+  const std::size_t capacity_;
+
+  const std::size_t mask_;
+
+  std::unique_ptr<Slot[]> slots_;
+
+  std::atomic<uint64_t> enqueue_position_{0};
+
+  std::atomic<uint64_t> dequeue_position_{0};
+
+  std::atomic<LogLevel> level_{LogLevel::Information};
+
+  std::array<RateLimiter, LogLevelCount> rate_limiters_;
+
+  std::atomic<std::size_t> suppressed_count_{0};
+
+  // Destination of the messages, and mutex protecting it.
+  std::FILE* stream_;
+
+  std::mutex stream_mutex_;
+
+  // Synchronization used to wake up the background thread.
+  std::mutex wake_mutex_;
+
+  std::condition_variable wake_;
+
+  std::atomic<bool> waiting_{false};
+
+  bool stopping_ = false;
+
+  std::thread thread_;
+};
+
+// Stream buffer of a log message. Characters are written to a fixed-capacity array that lives with
+// the message, typically on the stack, and only spill over to the heap for messages that are
+// longer than this array.
+class LogMessageBuffer : public std::streambuf {
+public:
+  LogMessageBuffer() noexcept {
+    setp(local_, local_ + LocalCapacity);
+  }
+
+  LogMessageBuffer(const LogMessageBuffer& other) = delete;
+
+  LogMessageBuffer& operator=(const LogMessageBuffer& other) = delete;
+
+  // Text written so far.
+  std::string_view Text() const noexcept {
+    if (spilled_) {
+      return spill_;
+    }
+    return {pbase(), static_cast<std::size_t>(pptr() - pbase())};
+  }
+
+protected:
+  int_type overflow(const int_type character) override {
+    if (traits_type::eq_int_type(character, traits_type::eof())) {
+      return traits_type::not_eof(character);
+    }
+    Spill();
+    spill_.push_back(traits_type::to_char_type(character));
+    return character;
+  }
+
+  std::streamsize xsputn(const char_type* characters, const std::streamsize count) override {
+    if (!spilled_ && count <= epptr() - pptr()) {
+      std::memcpy(pptr(), characters, static_cast<std::size_t>(count));
+      pbump(static_cast<int>(count));
+      return count;
+    }
+    Spill();
+    spill_.append(characters, static_cast<std::size_t>(count));
+    return count;
+  }
+
+private:
+  // Number of characters that fit in the fixed-capacity array.
+  static constexpr std::size_t LocalCapacity = 512;
+
+  // Moves the text written so far to the heap. Subsequent characters are appended there.
+  void Spill() {
+    if (!spilled_) {
+      spill_.assign(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+      setp(nullptr, nullptr);
+      spilled_ = true;
+    }
+  }
+
+  char local_[LocalCapacity];
+
+  bool spilled_ = false;
+
+  std::string spill_;
+};
+
+// Builder of a single log message. Values are formatted with the stream insertion operator and the
+// message is published when the builder is destroyed. If the message is not admitted by the logger
+// because of its level or rate limit, nothing is formatted. Messages of typical length are
+// formatted without allocating memory.
+class LogMessage {
+public:
+  LogMessage(Logger& logger, const LogLevel level) noexcept
+    : logger_(logger), level_(level), admitted_(logger.Admit(level)) {}
+
+  LogMessage(const LogMessage& other) = delete;
+
+  LogMessage& operator=(const LogMessage& other) = delete;
+
+  // Destructor. Publishes the message.
+  ~LogMessage() noexcept {
+    if (admitted_) {
+      logger_.Publish(level_, buffer_.Text());
+    }
+  }
+
+  template <typename Value>
+  LogMessage& operator<<(const Value& value) noexcept {
+    if (admitted_) {
+      stream_ << value;
+    }
+    return *this;
+  }
+
+private:
+  Logger& logger_;
+
+  LogLevel level_;
+
+  bool admitted_;
+
+  LogMessageBuffer buffer_;
+
+  std::ostream stream_{&buffer_};
+};
+
+// Returns the logger shared by this program.
+inline Logger& GlobalLogger() noexcept {
+  static Logger logger;
+  return logger;
+}
+
+// Returns a builder of a message at a given level for the logger shared by this program.
+inline LogMessage Log(const LogLevel level) noexcept {
+  return LogMessage(GlobalLogger(), level);
+}
+
+// Sets the level of the logger shared by this program for as long as it exists, and restores the
+// previous level when destroyed. Used to silence the informational messages of code that is being
+// measured.
+class ScopedLogLevel {
+public:
+  ScopedLogLevel(const LogLevel level) noexcept : previous_level_(GlobalLogger().Level()) {
+    GlobalLogger().SetLevel(level);
+  }
+
+  ScopedLogLevel(const ScopedLogLevel& other) = delete;
+
+  ScopedLogLevel& operator=(const ScopedLogLevel& other) = delete;
+
+  ~ScopedLogLevel() noexcept {
+    GlobalLogger().SetLevel(previous_level_);
+  }
+
+private:
+  LogLevel previous_level_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_LOGGER_HPP
@@ -0,0 +1,54 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_LOGGING_OBSERVER_HPP
+#define DEMO_INCLUDE_LOGGING_OBSERVER_HPP
+
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "SimulationObserver.hpp"
+
+namespace Demo {
+
+// Observer of a vehicle fleet simulation that logs each time step. Times are formatted as raw values
+// rather than printed as strings so that logging a time step does not allocate memory.
+class LoggingObserver : public SimulationObserver {
+public:
+  // Logs the current time step information.
+  void OnTimeStep(const std::size_t time_step_count, const PhQ::Time<>& time_step,
+                  const PhQ::Time<>& elapsed_time) noexcept {
+    DEMO_PROFILE_SCOPE(Output);
+
+    if (time_step_count == 1) {
+      Log(LogLevel::Information) << "Time steps:";
+    }
+
+    Log(LogLevel::Information) << "- Time step " << time_step_count << ": increment = "
+                               << time_step.Value(PhQ::Unit::Time::Minute)
+                               << " min, elapsed = " << elapsed_time.Value(PhQ::Unit::Time::Minute)
+                               << " min";
+  }
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_LOGGING_OBSERVER_HPP
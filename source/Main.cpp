@@ -20,21 +20,40 @@
 //     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
 //     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-#include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <random>
 
 #include "AggregateStatistics.hpp"
 #include "ChargingStations.hpp"
+#include "FleetComposition.hpp"
+#include "FlightRecorder.hpp"
+#include "Logger.hpp"
+#include "LoggingObserver.hpp"
+#include "MemoryAccounting.hpp"
+#include "ObserverGroup.hpp"
+#include "PerfCounters.hpp"
+#include "Profiler.hpp"
 #include "ResultsFileWriter.hpp"
+#include "Roster.hpp"
 #include "SampleVehicleModels.hpp"
 #include "Settings.hpp"
 #include "Simulation.hpp"
+#include "Statistics.hpp"
+#include "Timeline.hpp"
+#include "TraceRecorder.hpp"
+#include "TransitionLog.hpp"
+#include "Vehicle.hpp"
+#include "VehicleModelCatalog.hpp"
 #include "Vehicles.hpp"
 
 int main(int argc, char* argv[]) {
   const Demo::Settings settings{argc, argv};
 
-  const Demo::VehicleModels vehicle_models = Demo::GenerateSampleVehicleModels();
+  const Demo::VehicleModels vehicle_models =
+      !settings.VehicleModelCatalog().empty() ?
+          Demo::ReadVehicleModelCatalog(settings.VehicleModelCatalog()) :
+          Demo::GenerateSampleVehicleModels();
 
   std::random_device random_device;
   std::mt19937_64 random_generator(random_device());
@@ -42,19 +61,132 @@ int main(int argc, char* argv[]) {
     random_generator.seed(settings.Seed().value());
   }
 
-  Demo::Vehicles vehicles{settings.Vehicles(), vehicle_models, random_generator};
+  Demo::Vehicles vehicles =
+      !settings.Roster().empty() ?
+          Demo::Vehicles{Demo::Roster{settings.Roster()}, vehicle_models,
+                         std::pmr::get_default_resource(), settings.Threads()} :
+      settings.FleetMix().empty() ?
+          Demo::Vehicles{settings.Vehicles(), vehicle_models, random_generator,
+                         std::pmr::get_default_resource(), settings.Threads()} :
+          Demo::Vehicles{settings.Vehicles(),
+                         vehicle_models,
+                         Demo::FleetComposition{settings.FleetMix(),
+                                                settings.FleetMixExact() ?
+                                                    Demo::FleetCompositionMode::Exact :
+                                                    Demo::FleetCompositionMode::Sampled},
+                         random_generator,
+                         std::pmr::get_default_resource(),
+                         settings.Threads()};
 
   Demo::ChargingStations charging_stations{settings.ChargingStations()};
 
-  const Demo::Simulation simulation{
-      settings.Duration(), vehicles, charging_stations, random_generator};
+  std::unique_ptr<Demo::TraceRecorder> trace_recorder;
+  if (!settings.Trace().empty()) {
+    trace_recorder = std::make_unique<Demo::TraceRecorder>(
+        settings.Trace(), static_cast<uint64_t>(settings.TraceSampling()));
+  }
+
+  std::unique_ptr<Demo::TransitionLogWriter> transition_log_writer;
+  if (!settings.TransitionLog().empty()) {
+    transition_log_writer = std::make_unique<Demo::TransitionLogWriter>(
+        settings.TransitionLog(), vehicle_models, vehicles);
+  }
+
+  std::unique_ptr<Demo::FlightRecorder> flight_recorder;
+  if (!settings.FlightRecorder().empty()) {
+    flight_recorder = std::make_unique<Demo::FlightRecorder>(
+        settings.FlightRecorder(), static_cast<std::size_t>(settings.FlightRecorderCapacity()));
+  }
+
+  if (!settings.Timeline().empty()) {
+    if constexpr (Demo::ProfilingEnabled) {
+      Demo::GlobalTimeline().Start();
+    } else {
+      Demo::Log(Demo::LogLevel::Warning)
+          << "The timeline is not recorded because this program was built without the profiler. "
+             "Configure with -DDEMO_PROFILE=ON to enable it.";
+    }
+  }
+
+  if (!settings.PerfCounters().empty()) {
+    if constexpr (Demo::ProfilingEnabled) {
+      if (!Demo::GlobalPerfCounters().Start()) {
+        Demo::Log(Demo::LogLevel::Warning)
+            << "Hardware performance counters are unavailable on this system, so the report will "
+               "contain no measurements.";
+      }
+    } else {
+      Demo::Log(Demo::LogLevel::Warning)
+          << "The hardware performance counters are not measured because this program was built "
+             "without the profiler. Configure with -DDEMO_PROFILE=ON to enable them.";
+    }
+  }
+
+  Demo::Simulation<Demo::ObserverGroup<Demo::LoggingObserver, Demo::TraceObserver,
+                                       Demo::TransitionLogObserver, Demo::FlightRecorderObserver>>
+      simulation{settings.Duration(),
+                 vehicles,
+                 charging_stations,
+                 random_generator,
+                 {Demo::LoggingObserver{}, Demo::TraceObserver{trace_recorder.get()},
+                  Demo::TransitionLogObserver{transition_log_writer.get()},
+                  Demo::FlightRecorderObserver{flight_recorder.get()}}};
+
+  simulation.Run();
+
+  // Write the remaining trace events and transitions before continuing.
+  trace_recorder.reset();
+  if (transition_log_writer != nullptr) {
+    transition_log_writer->Close(simulation.ElapsedTime());
+    transition_log_writer.reset();
+  }
 
   const Demo::AggregateStatistics aggregate_statistics{vehicles};
 
-  const Demo::ResultsFileWriter results_file_writer{
-      settings.Results(), vehicle_models, aggregate_statistics};
+  {
+    DEMO_PROFILE_SCOPE(WriteResults);
+    const Demo::ResultsFileWriter results_file_writer{
+        settings.Results(), vehicle_models, aggregate_statistics};
+  }
+
+  if constexpr (Demo::ProfilingEnabled) {
+    Demo::GlobalProfiler().Print();
+  }
+
+  Demo::GlobalMemoryAccounting().Print(vehicles.Size());
+  Demo::Log(Demo::LogLevel::Information)
+      << "Each vehicle object takes " << sizeof(Demo::Vehicle) << " bytes, of which its statistics "
+      << "take " << sizeof(Demo::Statistics) << " bytes and track these metrics:"
+      << (Demo::Statistics::TracksFlights ? " flights" : "")
+      << (Demo::Statistics::TracksChargingSessions ? " charging-sessions" : "")
+      << (Demo::Statistics::TracksFaults ? " faults" : "") << ".";
+
+  if constexpr (Demo::ProfilingEnabled) {
+    if (!settings.PerfCounters().empty()) {
+      Demo::GlobalPerfCounters().Stop();
+      if (Demo::GlobalPerfCounters().Write(settings.PerfCounters())) {
+        Demo::Log(Demo::LogLevel::Information)
+            << "Wrote the hardware performance counters to: " << settings.PerfCounters().string();
+      }
+    }
+  }
+
+  // Write the timeline only once the simulation is over so that writing it does not perturb it.
+  if (Demo::GlobalTimeline().Active()) {
+    Demo::GlobalTimeline().Stop();
+    if (Demo::GlobalTimeline().Write(settings.Timeline())) {
+      Demo::Log(Demo::LogLevel::Information)
+          << "Wrote " << Demo::GlobalTimeline().SpanCount() << " timeline spans to: "
+          << settings.Timeline().string();
+    }
+    if (Demo::GlobalTimeline().DroppedCount() > 0) {
+      Demo::Log(Demo::LogLevel::Warning)
+          << "Dropped " << Demo::GlobalTimeline().DroppedCount()
+          << " timeline spans because the timeline buffers were full.";
+    }
+  }
 
-  std::cout << "End of " << Demo::Program::Title << "." << std::endl;
+  Demo::Log(Demo::LogLevel::Information) << "End of " << Demo::Program::Title << ".";
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,139 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_MAPPED_FILE_HPP
+#define DEMO_INCLUDE_MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+#include "Logger.hpp"
+
+namespace Demo {
+
+// Read-only view of the contents of a file. On POSIX systems, the file is memory-mapped, so its
+// contents are paged in on demand and can be decoded in place without copying, and changes made to
+// the file by other processes are visible. On other systems, the file is read into memory.
+class MappedFile {
+public:
+  // Maps the file at the given path into memory.
+  MappedFile(const std::filesystem::path& path) noexcept : path_(path) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int descriptor = ::open(path_.string().c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      Log(LogLevel::Error) << "Could not open the file: " << path_.string();
+      return;
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0) {
+      Log(LogLevel::Error) << "Could not open the file: " << path_.string();
+      ::close(descriptor);
+      return;
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0) {
+      void* const address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+      if (address == MAP_FAILED) {
+        Log(LogLevel::Error) << "Could not map the file: " << path_.string();
+        ::close(descriptor);
+        size_ = 0;
+        return;
+      }
+      ::madvise(address, size_, MADV_WILLNEED);
+      data_ = static_cast<const uint8_t*>(address);
+    }
+    ::close(descriptor);
+    open_ = true;
+#else
+    std::ifstream stream(path_, std::ios::binary);
+    if (!stream.is_open()) {
+      Log(LogLevel::Error) << "Could not open the file: " << path_.string();
+      return;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+#endif
+  }
+
+  MappedFile(const MappedFile& other) = delete;
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  // Destructor. Unmaps the file.
+  ~MappedFile() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    if (data_ != nullptr) {
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+  }
+
+  // Path to this file.
+  const std::filesystem::path& Path() const noexcept {
+    return path_;
+  }
+
+  // Returns whether this file was opened successfully.
+  bool IsOpen() const noexcept {
+    return open_;
+  }
+
+  // Pointer to the first byte of the contents of this file, or nullptr if it is empty.
+  const uint8_t* Data() const noexcept {
+    return data_;
+  }
+
+  // Size of this file in bytes.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+private:
+  std::filesystem::path path_;
+
+  const uint8_t* data_ = nullptr;
+
+  std::size_t size_ = 0;
+
+  bool open_ = false;
+
+#if !defined(__unix__) && !defined(__APPLE__)
+  std::vector<uint8_t> buffer_;
+#endif
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_MAPPED_FILE_HPP
@@ -0,0 +1,268 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_MEMORY_ACCOUNTING_HPP
+#define DEMO_INCLUDE_MEMORY_ACCOUNTING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+
+#include "Logger.hpp"
+
+namespace Demo {
+
+// Subsystems whose heap memory is accounted for separately.
+enum class MemorySubsystem : int8_t {
+  // Vehicle objects, including their statistics, together with their shared pointer control
+  // blocks.
+  Vehicles,
+
+  // Contiguous list of the shared pointers to the vehicles.
+  VehicleList,
+
+  // Hash map index of the vehicle IDs to their positions in the list.
+  VehicleIndex,
+
+  // Charging station objects together with their shared pointer control blocks.
+  ChargingStations,
+
+  // Tree map of the charging station IDs to the charging stations.
+  ChargingStationMap,
+
+  // Queues of the vehicles at each charging station.
+  ChargingStationQueues,
+
+  // Hash sets of the vehicles at each charging station.
+  ChargingStationSets,
+
+  // Structure-of-arrays copy of the state of the fleet that the simulation keeps across its time
+  // steps.
+  FleetState,
+};
+
+// Number of accounted memory subsystems.
+inline constexpr std::size_t MemorySubsystemCount = 8;
+
+// Returns the name of an accounted memory subsystem.
+inline constexpr std::string_view MemorySubsystemName(const MemorySubsystem subsystem) noexcept {
+  switch (subsystem) {
+    case MemorySubsystem::Vehicles:
+      return "Vehicles";
+    case MemorySubsystem::VehicleList:
+      return "VehicleList";
+    case MemorySubsystem::VehicleIndex:
+      return "VehicleIndex";
+    case MemorySubsystem::ChargingStations:
+      return "ChargingStations";
+    case MemorySubsystem::ChargingStationMap:
+      return "ChargingStationMap";
+    case MemorySubsystem::ChargingStationQueues:
+      return "ChargingStationQueues";
+    case MemorySubsystem::ChargingStationSets:
+      return "ChargingStationSets";
+    case MemorySubsystem::FleetState:
+      return "FleetState";
+  }
+  return "Unknown";
+}
+
+// Live and peak heap bytes of one subsystem. Updated with relaxed atomic operations, which cost far
+// less than the allocations that they account for.
+class MemoryAccount {
+public:
+  // Accounts for the allocation of a given number of bytes.
+  void Allocate(const std::size_t bytes) noexcept {
+    const std::size_t live = live_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peak_.load(std::memory_order_relaxed);
+    while (live > peak && !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Accounts for the deallocation of a given number of bytes.
+  void Deallocate(const std::size_t bytes) noexcept {
+    live_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  // Number of bytes currently allocated.
+  std::size_t Live() const noexcept {
+    return live_.load(std::memory_order_relaxed);
+  }
+
+  // Largest number of bytes allocated at any one time.
+  std::size_t Peak() const noexcept {
+    return peak_.load(std::memory_order_relaxed);
+  }
+
+  // Total number of allocations.
+  uint64_t Allocations() const noexcept {
+    return allocations_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::size_t> live_{0};
+
+  std::atomic<std::size_t> peak_{0};
+
+  std::atomic<uint64_t> allocations_{0};
+};
+
+// Heap memory accounts of all subsystems.
+class MemoryAccounting {
+public:
+  // Account of a given subsystem.
+  MemoryAccount& Account(const MemorySubsystem subsystem) noexcept {
+    return accounts_[static_cast<std::size_t>(subsystem)];
+  }
+
+  // Account of a given subsystem.
+  const MemoryAccount& Account(const MemorySubsystem subsystem) const noexcept {
+    return accounts_[static_cast<std::size_t>(subsystem)];
+  }
+
+  // Account of all subsystems together. Its peak is the largest number of bytes allocated by all
+  // subsystems at any one time, which is at most the sum of the peaks of the subsystems, since the
+  // subsystems generally do not reach their peaks at the same time.
+  const MemoryAccount& Total() const noexcept {
+    return total_;
+  }
+
+  // Number of bytes currently allocated by all subsystems.
+  std::size_t TotalLive() const noexcept {
+    return total_.Live();
+  }
+
+  // Accounts for the allocation of a given number of bytes by a given subsystem.
+  void Allocate(const MemorySubsystem subsystem, const std::size_t bytes) noexcept {
+    Account(subsystem).Allocate(bytes);
+    total_.Allocate(bytes);
+  }
+
+  // Accounts for the deallocation of a given number of bytes by a given subsystem.
+  void Deallocate(const MemorySubsystem subsystem, const std::size_t bytes) noexcept {
+    Account(subsystem).Deallocate(bytes);
+    total_.Deallocate(bytes);
+  }
+
+  // Logs a table of the live and peak bytes of each subsystem and of all subsystems together, along
+  // with the live bytes per vehicle for a given number of vehicles.
+  void Print(const std::size_t vehicle_count) const noexcept {
+    char buffer[128];
+    Log(LogLevel::Information) << "Memory:";
+    std::snprintf(buffer, sizeof(buffer), "  %-22s %14s %14s %12s %13s", "Subsystem",
+                  "Live (bytes)", "Peak (bytes)", "Allocations", "Bytes/vehicle");
+    Log(LogLevel::Information) << buffer;
+    for (std::size_t index = 0; index <= MemorySubsystemCount; ++index) {
+      const bool total = index == MemorySubsystemCount;
+      const std::string_view name =
+          total ? "Total" : MemorySubsystemName(static_cast<MemorySubsystem>(index));
+      const MemoryAccount& account = total ? total_ : accounts_[index];
+      const std::size_t live = account.Live();
+      const std::size_t peak = account.Peak();
+      const uint64_t allocations = account.Allocations();
+      std::snprintf(
+          buffer, sizeof(buffer), "  %-22.*s %14zu %14zu %12llu %13.1f",
+          static_cast<int>(name.size()), name.data(), live, peak,
+          static_cast<unsigned long long>(allocations),
+          vehicle_count > 0 ? static_cast<double>(live) / static_cast<double>(vehicle_count) : 0.0);
+      Log(LogLevel::Information) << buffer;
+    }
+  }
+
+private:
+  std::array<MemoryAccount, MemorySubsystemCount> accounts_;
+
+  // Account of all subsystems together.
+  MemoryAccount total_;
+};
+
+// Returns the memory accounts shared by this program.
+inline MemoryAccounting& GlobalMemoryAccounting() noexcept {
+  static MemoryAccounting memory_accounting;
+  return memory_accounting;
+}
+
+// Standard allocator that accounts for its allocations in the account of a given subsystem. Used
+// as the allocator of the containers of that subsystem, and with std::allocate_shared so that the
+// shared pointer control blocks are accounted for as well. Like std::pmr::polymorphic_allocator,
+// it draws its memory from a memory resource, which defaults to the default memory resource, so a
+// run can place its containers in an arena such as std::pmr::monotonic_buffer_resource and release
+// them all at once. Containers copy the resource of their allocator to their elements' allocators.
+template <typename Type, MemorySubsystem Subsystem>
+class TrackingAllocator {
+public:
+  using value_type = Type;
+
+  template <typename Other>
+  struct rebind {
+    using other = TrackingAllocator<Other, Subsystem>;
+  };
+
+  // Constructs an allocator that draws from the default memory resource.
+  TrackingAllocator() noexcept : resource_(std::pmr::get_default_resource()) {}
+
+  // Constructs an allocator that draws from a given memory resource, which must outlive it.
+  TrackingAllocator(std::pmr::memory_resource* const resource) noexcept : resource_(resource) {}
+
+  template <typename Other>
+  TrackingAllocator(const TrackingAllocator<Other, Subsystem>& other) noexcept
+    : resource_(other.Resource()) {}
+
+  // Memory resource from which this allocator draws.
+  std::pmr::memory_resource* Resource() const noexcept {
+    return resource_;
+  }
+
+  Type* allocate(const std::size_t count) {
+    Type* const pointer =
+        static_cast<Type*>(resource_->allocate(count * sizeof(Type), alignof(Type)));
+    GlobalMemoryAccounting().Allocate(Subsystem, count * sizeof(Type));
+    return pointer;
+  }
+
+  void deallocate(Type* const pointer, const std::size_t count) noexcept {
+    GlobalMemoryAccounting().Deallocate(Subsystem, count * sizeof(Type));
+    resource_->deallocate(pointer, count * sizeof(Type), alignof(Type));
+  }
+
+  template <typename Other>
+  bool operator==(const TrackingAllocator<Other, Subsystem>& other) const noexcept {
+    return *resource_ == *other.Resource();
+  }
+
+  template <typename Other>
+  bool operator!=(const TrackingAllocator<Other, Subsystem>& other) const noexcept {
+    return !(*this == other);
+  }
+
+private:
+  std::pmr::memory_resource* resource_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_MEMORY_ACCOUNTING_HPP
@@ -0,0 +1,98 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_OBSERVER_GROUP_HPP
+#define DEMO_INCLUDE_OBSERVER_GROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <PhQ/Time.hpp>
+#include <tuple>
+#include <utility>
+
+#include "SimulationObserver.hpp"
+
+namespace Demo {
+
+// Simulation observer that forwards every event to each of a group of observers, in order. Like
+// any other observer, the group is dispatched statically, so combining observers costs nothing
+// beyond the observers themselves.
+template <typename... Observers>
+class ObserverGroup {
+public:
+  // Creates a group of the given observers.
+  ObserverGroup(Observers... observers) noexcept : observers_(std::move(observers)...) {}
+
+  // Observer of this group at a given index.
+  template <std::size_t Index>
+  const auto& Get() const noexcept {
+    return std::get<Index>(observers_);
+  }
+
+  // Mutable observer of this group at a given index.
+  template <std::size_t Index>
+  auto& MutableGet() noexcept {
+    return std::get<Index>(observers_);
+  }
+
+  void OnTimeStep(const std::size_t time_step_count, const PhQ::Time<>& time_step,
+                  const PhQ::Time<>& elapsed_time) noexcept {
+    std::apply([&](auto&... observers) {
+      (observers.OnTimeStep(time_step_count, time_step, elapsed_time), ...);
+    }, observers_);
+  }
+
+  void OnTakeoff(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    std::apply([&](auto&... observers) { (observers.OnTakeoff(time, vehicle), ...); }, observers_);
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    std::apply([&](auto&... observers) { (observers.OnLanding(time, vehicle), ...); }, observers_);
+  }
+
+  void OnEnqueue(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    std::apply([&](auto&... observers) { (observers.OnEnqueue(time, vehicle), ...); }, observers_);
+  }
+
+  void OnChargeStart(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    std::apply(
+        [&](auto&... observers) { (observers.OnChargeStart(time, vehicle), ...); }, observers_);
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    std::apply(
+        [&](auto&... observers) { (observers.OnChargeEnd(time, vehicle), ...); }, observers_);
+  }
+
+  void OnFault(const PhQ::Time<>& time, const Vehicle& vehicle,
+               const int64_t fault_count) noexcept {
+    std::apply([&](auto&... observers) { (observers.OnFault(time, vehicle, fault_count), ...); },
+               observers_);
+  }
+
+private:
+  std::tuple<Observers...> observers_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_OBSERVER_GROUP_HPP
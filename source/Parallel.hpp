@@ -0,0 +1,80 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_PARALLEL_HPP
+#define DEMO_INCLUDE_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Demo {
+
+// Returns the number of threads to use for a given requested number of threads. If the requested
+// number of threads is zero, uses one thread per hardware thread.
+inline std::size_t ResolveThreadCount(const std::size_t thread_count) noexcept {
+  if (thread_count == 0) {
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  return thread_count;
+}
+
+// Calls a given function once for each of a given number of tasks, passing it the index of the
+// task, using up to a given number of threads. If the number of threads is zero, uses one thread
+// per hardware thread. Threads claim tasks in increasing order of index as they become free, so
+// tasks of uneven cost are balanced. The function must be safe to call concurrently on different
+// tasks. Runs on the calling thread if there is only one thread or one task.
+template <typename Function>
+void ParallelFor(const std::size_t task_count, const std::size_t thread_count,
+                 const Function& function) noexcept {
+  const std::size_t threads = std::min(ResolveThreadCount(thread_count), task_count);
+  if (threads <= 1) {
+    for (std::size_t task = 0; task < task_count; ++task) {
+      function(task);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_task{0};
+  const auto work = [&]() {
+    for (std::size_t task = next_task.fetch_add(1, std::memory_order_relaxed); task < task_count;
+         task = next_task.fetch_add(1, std::memory_order_relaxed)) {
+      function(task);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t index = 1; index < threads; ++index) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_PARALLEL_HPP
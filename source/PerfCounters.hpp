@@ -0,0 +1,329 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_PERF_COUNTERS_HPP
+#define DEMO_INCLUDE_PERF_COUNTERS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Logger.hpp"
+#include "ProfilePhase.hpp"
+
+namespace Demo {
+
+// Hardware performance counters measured for each profiled phase.
+enum class PerfCounter : int8_t {
+  // CPU cycles.
+  Cycles,
+
+  // Retired instructions.
+  Instructions,
+
+  // Last-level cache misses.
+  CacheMisses,
+
+  // Mispredicted branches.
+  BranchMisses,
+};
+
+// Number of hardware performance counters.
+inline constexpr std::size_t PerfCounterCount = 4;
+
+// Returns the name of a hardware performance counter as it appears in the report.
+inline constexpr std::string_view PerfCounterName(const PerfCounter counter) noexcept {
+  switch (counter) {
+    case PerfCounter::Cycles:
+      return "cycles";
+    case PerfCounter::Instructions:
+      return "instructions";
+    case PerfCounter::CacheMisses:
+      return "cache_misses";
+    case PerfCounter::BranchMisses:
+      return "branch_misses";
+  }
+  return "unknown";
+}
+
+// Values of the hardware performance counters at one instant.
+using PerfCounterValues = std::array<uint64_t, PerfCounterCount>;
+
+// Group of hardware performance counters of the calling thread, opened with the Linux
+// perf_event_open system call and counting in user space only. Counters that cannot be opened,
+// because the system is not Linux, the kernel forbids it, or the processor does not expose them,
+// are marked unavailable and read as zero.
+class PerfCounterGroup {
+public:
+  // Opens the counters of the calling thread.
+  PerfCounterGroup() noexcept {
+    descriptors_.fill(-1);
+#if defined(__linux__)
+    constexpr std::array<uint64_t, PerfCounterCount> configurations{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+    for (std::size_t index = 0; index < PerfCounterCount; ++index) {
+      perf_event_attr attributes;
+      std::memset(&attributes, 0, sizeof(attributes));
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.size = sizeof(attributes);
+      attributes.config = configurations[index];
+      attributes.disabled = leader_ < 0 ? 1 : 0;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_GROUP;
+      const int descriptor = static_cast<int>(
+          syscall(SYS_perf_event_open, &attributes, 0, -1, leader_ < 0 ? -1 : leader_, 0));
+      if (descriptor >= 0) {
+        descriptors_[index] = descriptor;
+        order_[count_++] = index;
+        if (leader_ < 0) {
+          leader_ = descriptor;
+        }
+      }
+    }
+    if (leader_ >= 0) {
+      ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  PerfCounterGroup(const PerfCounterGroup& other) = delete;
+
+  PerfCounterGroup& operator=(const PerfCounterGroup& other) = delete;
+
+  // Closes the counters.
+  ~PerfCounterGroup() noexcept {
+#if defined(__linux__)
+    for (const int descriptor : descriptors_) {
+      if (descriptor >= 0) {
+        close(descriptor);
+      }
+    }
+#endif
+  }
+
+  // Whether any counter could be opened.
+  bool Available() const noexcept {
+    return leader_ >= 0;
+  }
+
+  // Whether a given counter could be opened.
+  bool Available(const PerfCounter counter) const noexcept {
+    return descriptors_[static_cast<std::size_t>(counter)] >= 0;
+  }
+
+  // Reads the current values of all counters with a single system call. Unavailable counters read
+  // as zero.
+  PerfCounterValues Read() const noexcept {
+    PerfCounterValues values{};
+#if defined(__linux__)
+    if (leader_ >= 0) {
+      // The group is read as the number of counters followed by their values in the order in
+      // which they were opened.
+      std::array<uint64_t, PerfCounterCount + 1> buffer{};
+      if (read(leader_, buffer.data(), sizeof(buffer)) > 0) {
+        const std::size_t count = std::min<std::size_t>(buffer[0], count_);
+        for (std::size_t index = 0; index < count; ++index) {
+          values[order_[index]] = buffer[index + 1];
+        }
+      }
+    }
+#endif
+    return values;
+  }
+
+private:
+  std::array<int, PerfCounterCount> descriptors_;
+
+  // Indices of the opened counters in the order in which they were opened.
+  std::array<std::size_t, PerfCounterCount> order_{};
+
+  std::size_t count_ = 0;
+
+  int leader_ = -1;
+};
+
+// Accumulates the hardware performance counters of each profiled phase. The counters are those of
+// the thread that started the measurement; phases that run on other threads are ignored. The
+// counters of nested phases are also included in their enclosing phases, like their times.
+class PerfCounters {
+public:
+  PerfCounters() noexcept = default;
+
+  PerfCounters(const PerfCounters& other) = delete;
+
+  PerfCounters& operator=(const PerfCounters& other) = delete;
+
+  // Opens the counters of the calling thread, discards any previous measurements, and starts
+  // measuring. Returns false if no counter is available on this system, in which case nothing is
+  // measured but the report can still be written.
+  bool Start() noexcept {
+    active_.store(false, std::memory_order_release);
+    group_ = std::make_unique<PerfCounterGroup>();
+    thread_ = std::this_thread::get_id();
+    totals_ = {};
+    calls_.fill(0);
+    if (!group_->Available()) {
+      return false;
+    }
+    active_.store(true, std::memory_order_release);
+    return true;
+  }
+
+  // Stops measuring. The measurements so far are kept until the next start.
+  void Stop() noexcept {
+    active_.store(false, std::memory_order_release);
+  }
+
+  // Whether this is measuring on the calling thread.
+  bool Active() const noexcept {
+    return active_.load(std::memory_order_relaxed) && std::this_thread::get_id() == thread_;
+  }
+
+  // Whether any counter is available, or false if this has not been started.
+  bool Available() const noexcept {
+    return group_ != nullptr && group_->Available();
+  }
+
+  // Whether a given counter is available, or false if this has not been started.
+  bool Available(const PerfCounter counter) const noexcept {
+    return group_ != nullptr && group_->Available(counter);
+  }
+
+  // Reads the current values of the counters, or zeros if this is not measuring.
+  PerfCounterValues Read() const noexcept {
+    return group_ != nullptr ? group_->Read() : PerfCounterValues{};
+  }
+
+  // Adds the difference between given end and start values of the counters to a given phase.
+  void Add(const ProfilePhase phase, const PerfCounterValues& start,
+           const PerfCounterValues& end) noexcept {
+    PerfCounterValues& total = totals_[static_cast<std::size_t>(phase)];
+    for (std::size_t index = 0; index < PerfCounterCount; ++index) {
+      total[index] += end[index] - start[index];
+    }
+    ++calls_[static_cast<std::size_t>(phase)];
+  }
+
+  // Total value of a given counter in a given phase.
+  uint64_t Total(const ProfilePhase phase, const PerfCounter counter) const noexcept {
+    return totals_[static_cast<std::size_t>(phase)][static_cast<std::size_t>(counter)];
+  }
+
+  // Number of measured calls of a given phase.
+  uint64_t Calls(const ProfilePhase phase) const noexcept {
+    return calls_[static_cast<std::size_t>(phase)];
+  }
+
+  // Formats the measurements as a JSON document. Unavailable counters are reported as null. The
+  // instructions per cycle of each phase are included when both counters are available.
+  std::string ToJson() const noexcept {
+    std::string json{"{\n  \"available\": "};
+    json += Available() ? "true" : "false";
+    json += ",\n  \"counters\": {";
+    for (std::size_t index = 0; index < PerfCounterCount; ++index) {
+      const PerfCounter counter = static_cast<PerfCounter>(index);
+      json += index > 0 ? ", \"" : "\"";
+      json += PerfCounterName(counter);
+      json += Available(counter) ? "\": true" : "\": false";
+    }
+    json += "},\n  \"phases\": [\n";
+    char buffer[64];
+    for (std::size_t phase_index = 0; phase_index < ProfilePhaseCount; ++phase_index) {
+      const ProfilePhase phase = static_cast<ProfilePhase>(phase_index);
+      json += "    {\"name\": \"";
+      json += ProfilePhaseName(phase);
+      json += "\", \"calls\": " + std::to_string(calls_[phase_index]);
+      for (std::size_t index = 0; index < PerfCounterCount; ++index) {
+        const PerfCounter counter = static_cast<PerfCounter>(index);
+        json += ", \"";
+        json += PerfCounterName(counter);
+        json += "\": ";
+        json += Available(counter) ? std::to_string(totals_[phase_index][index]) : "null";
+      }
+      const uint64_t cycles = Total(phase, PerfCounter::Cycles);
+      if (Available(PerfCounter::Cycles) && Available(PerfCounter::Instructions) && cycles > 0) {
+        std::snprintf(buffer, sizeof(buffer), ", \"ipc\": %.4f",
+                      static_cast<double>(Total(phase, PerfCounter::Instructions))
+                          / static_cast<double>(cycles));
+        json += buffer;
+      } else {
+        json += ", \"ipc\": null";
+      }
+      json += phase_index + 1 < ProfilePhaseCount ? "},\n" : "}\n";
+    }
+    json += "  ]\n}\n";
+    return json;
+  }
+
+  // Writes the measurements as a JSON document to a file at a given path. Returns false if the
+  // file could not be written.
+  bool Write(const std::filesystem::path& path) const noexcept {
+    std::ofstream stream(path);
+    if (!stream.is_open()) {
+      Log(LogLevel::Error) << "Could not open the performance counters file: " << path.string();
+      return false;
+    }
+    stream << ToJson();
+    return stream.good();
+  }
+
+private:
+  std::unique_ptr<PerfCounterGroup> group_;
+
+  std::thread::id thread_;
+
+  std::array<PerfCounterValues, ProfilePhaseCount> totals_{};
+
+  std::array<uint64_t, ProfilePhaseCount> calls_{};
+
+  std::atomic<bool> active_{false};
+};
+
+// Returns the hardware performance counters shared by this program.
+inline PerfCounters& GlobalPerfCounters() noexcept {
+  static PerfCounters perf_counters;
+  return perf_counters;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_PERF_COUNTERS_HPP
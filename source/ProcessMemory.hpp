@@ -0,0 +1,109 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_PROCESS_MEMORY_HPP
+#define DEMO_INCLUDE_PROCESS_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace Demo {
+
+namespace Internal {
+
+// Reads a field of the /proc/self/status file, which is given in kibibytes, and returns it in
+// bytes. Returns zero if the file or the field does not exist, such as on systems other than Linux.
+inline std::size_t ReadProcessStatusBytes(const std::string_view field) noexcept {
+  std::ifstream stream("/proc/self/status");
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.compare(0, field.size(), field) == 0) {
+      return static_cast<std::size_t>(std::strtoull(line.c_str() + field.size(), nullptr, 10))
+             * 1024;
+    }
+  }
+  return 0;
+}
+
+}  // namespace Internal
+
+// Returns the current resident set size of this process in bytes, or zero if it cannot be
+// determined on this system.
+inline std::size_t CurrentResidentSetSize() noexcept {
+  return Internal::ReadProcessStatusBytes("VmRSS:");
+}
+
+// Returns the peak resident set size of this process in bytes since it started or since the peak
+// was last reset, or zero if it cannot be determined on this system.
+inline std::size_t PeakResidentSetSize() noexcept {
+  const std::size_t peak = Internal::ReadProcessStatusBytes("VmHWM:");
+  if (peak > 0) {
+    return peak;
+  }
+#if defined(__unix__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+// Resets the peak resident set size of this process to its current resident set size so that
+// successive measurements can each report their own peak. Returns false if this is not supported
+// on this system, in which case the peak only ever grows.
+inline bool ResetPeakResidentSetSize() noexcept {
+  std::ofstream stream("/proc/self/clear_refs");
+  if (!stream.is_open()) {
+    return false;
+  }
+  stream << "5";
+  stream.flush();
+  return stream.good();
+}
+
+// Returns the memory that is free in the heap of this process to the operating system where
+// supported, so that the resident set size reflects the memory that is actually in use.
+inline void ReleaseFreeMemory() noexcept {
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_PROCESS_MEMORY_HPP
@@ -0,0 +1,94 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_PROFILE_PHASE_HPP
+#define DEMO_INCLUDE_PROFILE_PHASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Demo {
+
+// Phases of the simulation that are timed by the profiler. The phases are ordered as they are
+// printed. Nested phases are timed within their enclosing phase, so their time is also included in
+// the time of that phase.
+enum class ProfilePhase : int8_t {
+  // Computation of the next time step from the states of all vehicles.
+  ComputeTimeStep,
+
+  // Update of all vehicles at the beginning of a time step.
+  UpdateVehiclesAtStart,
+
+  // Time step of all vehicles.
+  PerformTimeStep,
+
+  // Update of all vehicles at the end of a time step.
+  UpdateVehiclesAtEnd,
+
+  // Selection of a charging station when a vehicle enqueues. Nested in the vehicle updates.
+  LowestCount,
+
+  // Pseudo-random number draws. Nested in the vehicle time steps.
+  RandomDraw,
+
+  // Logging of the time steps.
+  Output,
+
+  // Writing of the results file.
+  WriteResults,
+};
+
+// Number of profiled phases.
+inline constexpr std::size_t ProfilePhaseCount = 8;
+
+// Returns the name of a profiled phase.
+inline constexpr std::string_view ProfilePhaseName(const ProfilePhase phase) noexcept {
+  switch (phase) {
+    case ProfilePhase::ComputeTimeStep:
+      return "ComputeTimeStep";
+    case ProfilePhase::UpdateVehiclesAtStart:
+      return "UpdateVehiclesAtStart";
+    case ProfilePhase::PerformTimeStep:
+      return "PerformTimeStep";
+    case ProfilePhase::UpdateVehiclesAtEnd:
+      return "UpdateVehiclesAtEnd";
+    case ProfilePhase::LowestCount:
+      return "LowestCount";
+    case ProfilePhase::RandomDraw:
+      return "RandomDraw";
+    case ProfilePhase::Output:
+      return "Output";
+    case ProfilePhase::WriteResults:
+      return "WriteResults";
+  }
+  return "Unknown";
+}
+
+// Returns whether a profiled phase is nested in other phases.
+inline constexpr bool ProfilePhaseIsNested(const ProfilePhase phase) noexcept {
+  return phase == ProfilePhase::LowestCount || phase == ProfilePhase::RandomDraw;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_PROFILE_PHASE_HPP
@@ -0,0 +1,239 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_PROFILER_HPP
+#define DEMO_INCLUDE_PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#include "Logger.hpp"
+#include "PerfCounters.hpp"
+#include "ProfilePhase.hpp"
+#include "Timeline.hpp"
+
+namespace Demo {
+
+// Counters of the simulation that are tallied by the profiler.
+enum class ProfileCounter : int8_t {
+  // Number of time steps taken.
+  Steps,
+
+  // Number of time steps computed with a length of zero, which stop the simulation.
+  ZeroLengthSteps,
+
+  // Number of vehicles whose time step was performed through their own objects rather than in bulk,
+  // summed over all time steps.
+  VehiclesTouched,
+
+  // Number of vehicles whose status was updated, summed over both updates of all time steps.
+  VehiclesUpdated,
+
+  // Number of vehicles enqueued at charging stations.
+  Enqueues,
+
+  // Number of vehicles dequeued from charging stations.
+  Dequeues,
+};
+
+// Number of profiled counters.
+inline constexpr std::size_t ProfileCounterCount = 6;
+
+// Accumulates the time spent in each phase of the simulation and tallies counters of its work.
+// The simulation is single-threaded, so the profiler is not synchronized. The profiler is only fed
+// by the DEMO_PROFILE_SCOPE and DEMO_PROFILE_COUNT macros, which compile to nothing unless
+// DEMO_PROFILE is defined, so production builds pay nothing for it.
+class Profiler {
+public:
+  Profiler() noexcept = default;
+
+  // Adds a given time in nanoseconds to a given phase and counts one call of that phase.
+  void AddTime(const ProfilePhase phase, const int64_t nanoseconds) noexcept {
+    nanoseconds_[static_cast<std::size_t>(phase)] += nanoseconds;
+    ++calls_[static_cast<std::size_t>(phase)];
+  }
+
+  // Adds a given amount to a given counter.
+  void Count(const ProfileCounter counter, const uint64_t amount = 1) noexcept {
+    counters_[static_cast<std::size_t>(counter)] += amount;
+  }
+
+  // Total time in nanoseconds spent in a given phase.
+  int64_t Nanoseconds(const ProfilePhase phase) const noexcept {
+    return nanoseconds_[static_cast<std::size_t>(phase)];
+  }
+
+  // Number of calls of a given phase.
+  uint64_t Calls(const ProfilePhase phase) const noexcept {
+    return calls_[static_cast<std::size_t>(phase)];
+  }
+
+  // Value of a given counter.
+  uint64_t Counter(const ProfileCounter counter) const noexcept {
+    return counters_[static_cast<std::size_t>(counter)];
+  }
+
+  // Total time in nanoseconds spent in the phases that are not nested in other phases.
+  int64_t TotalNanoseconds() const noexcept {
+    int64_t total = 0;
+    for (std::size_t index = 0; index < ProfilePhaseCount; ++index) {
+      if (!ProfilePhaseIsNested(static_cast<ProfilePhase>(index))) {
+        total += nanoseconds_[index];
+      }
+    }
+    return total;
+  }
+
+  // Clears all times and counters.
+  void Reset() noexcept {
+    nanoseconds_.fill(0);
+    calls_.fill(0);
+    counters_.fill(0);
+  }
+
+  // Logs a table of the time spent in each phase followed by the counters.
+  void Print() const noexcept {
+    const int64_t total = TotalNanoseconds();
+    char buffer[128];
+    Log(LogLevel::Information) << "Profile:";
+    std::snprintf(buffer, sizeof(buffer), "  %-24s %12s %12s %11s %7s", "Phase", "Calls",
+                  "Total (ms)", "Mean (ns)", "Share");
+    Log(LogLevel::Information) << buffer;
+    for (std::size_t index = 0; index < ProfilePhaseCount; ++index) {
+      const ProfilePhase phase = static_cast<ProfilePhase>(index);
+      const std::string_view name = ProfilePhaseName(phase);
+      std::snprintf(buffer, sizeof(buffer), "  %s%-*.*s %12llu %12.3f %11.1f %6.1f%%",
+                    ProfilePhaseIsNested(phase) ? "  " : "",
+                    ProfilePhaseIsNested(phase) ? 22 : 24, static_cast<int>(name.size()),
+                    name.data(), static_cast<unsigned long long>(calls_[index]),
+                    static_cast<double>(nanoseconds_[index]) * 1.0E-6,
+                    calls_[index] > 0 ? static_cast<double>(nanoseconds_[index])
+                                            / static_cast<double>(calls_[index]) :
+                                        0.0,
+                    total > 0 ? 100.0 * static_cast<double>(nanoseconds_[index])
+                                    / static_cast<double>(total) :
+                                0.0);
+      Log(LogLevel::Information) << buffer;
+    }
+    const uint64_t steps = Counter(ProfileCounter::Steps);
+    Log(LogLevel::Information) << "Counters:";
+    Log(LogLevel::Information) << "- Steps taken: " << steps;
+    Log(LogLevel::Information)
+        << "- Zero-length steps: " << Counter(ProfileCounter::ZeroLengthSteps);
+    Log(LogLevel::Information)
+        << "- Vehicles touched per step: "
+        << (steps > 0 ? static_cast<double>(Counter(ProfileCounter::VehiclesTouched))
+                            / static_cast<double>(steps) :
+                        0.0);
+    Log(LogLevel::Information)
+        << "- Vehicles updated per step: "
+        << (steps > 0 ? static_cast<double>(Counter(ProfileCounter::VehiclesUpdated))
+                            / static_cast<double>(steps) :
+                        0.0);
+    Log(LogLevel::Information) << "- Enqueues: " << Counter(ProfileCounter::Enqueues);
+    Log(LogLevel::Information) << "- Dequeues: " << Counter(ProfileCounter::Dequeues);
+  }
+
+private:
+  std::array<int64_t, ProfilePhaseCount> nanoseconds_{};
+
+  std::array<uint64_t, ProfilePhaseCount> calls_{};
+
+  std::array<uint64_t, ProfileCounterCount> counters_{};
+};
+
+// Returns the profiler shared by this program.
+inline Profiler& GlobalProfiler() noexcept {
+  static Profiler profiler;
+  return profiler;
+}
+
+// Times the scope in which it exists and adds the time to a given phase of the profiler shared by
+// this program when destroyed. The span is also recorded in the timeline shared by this program if
+// that timeline is recording, and the hardware performance counters of the scope are added to the
+// phase if they are being measured.
+class ScopedPhaseTimer {
+public:
+  ScopedPhaseTimer(const ProfilePhase phase) noexcept
+    : phase_(phase), perf_counters_active_(GlobalPerfCounters().Active()) {
+    if (perf_counters_active_) {
+      perf_counters_start_ = GlobalPerfCounters().Read();
+    }
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer& other) = delete;
+
+  ScopedPhaseTimer& operator=(const ScopedPhaseTimer& other) = delete;
+
+  ~ScopedPhaseTimer() noexcept {
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    if (perf_counters_active_) {
+      GlobalPerfCounters().Add(phase_, perf_counters_start_, GlobalPerfCounters().Read());
+    }
+    GlobalProfiler().AddTime(
+        phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+    GlobalTimeline().Record(phase_, start_, end);
+  }
+
+private:
+  ProfilePhase phase_;
+
+  // Whether the hardware performance counters are measured for this scope.
+  bool perf_counters_active_;
+
+  PerfCounterValues perf_counters_start_{};
+
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Whether this program is compiled with the profiler enabled.
+#ifdef DEMO_PROFILE
+inline constexpr bool ProfilingEnabled = true;
+#else
+inline constexpr bool ProfilingEnabled = false;
+#endif
+
+}  // namespace Demo
+
+#define DEMO_PROFILE_CONCATENATE_DETAIL(prefix, line) prefix##line
+#define DEMO_PROFILE_CONCATENATE(prefix, line) DEMO_PROFILE_CONCATENATE_DETAIL(prefix, line)
+
+// Times the enclosing scope as a given phase, such as DEMO_PROFILE_SCOPE(LowestCount), and counts
+// a given amount on a given counter, such as DEMO_PROFILE_COUNT(Enqueues, 1). Both expand to
+// nothing unless DEMO_PROFILE is defined, which is done by configuring with -DDEMO_PROFILE=ON.
+#ifdef DEMO_PROFILE
+#define DEMO_PROFILE_SCOPE(phase)                                                          \
+  const ::Demo::ScopedPhaseTimer DEMO_PROFILE_CONCATENATE(demo_profile_scope_, __LINE__)( \
+      ::Demo::ProfilePhase::phase)
+#define DEMO_PROFILE_COUNT(counter, amount) \
+  ::Demo::GlobalProfiler().Count(::Demo::ProfileCounter::counter, amount)
+#else
+#define DEMO_PROFILE_SCOPE(phase) static_cast<void>(0)
+#define DEMO_PROFILE_COUNT(counter, amount) static_cast<void>(0)
+#endif
+
+#endif  // DEMO_INCLUDE_PROFILER_HPP
@@ -0,0 +1,102 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "Arguments.hpp"
+#include "Logger.hpp"
+#include "ResultsFileWriter.hpp"
+#include "TransitionLogReader.hpp"
+#include "TransitionLogReplay.hpp"
+
+namespace {
+
+// Prints the usage information of the replay program.
+void PrintUsage(const std::string& executable_name) noexcept {
+  Demo::Log(Demo::LogLevel::Information)
+      << "Usage: " << executable_name << " " << Demo::Arguments::TransitionLogPattern << " ["
+      << Demo::Arguments::ResultsPattern << "] [" << Demo::Arguments::ThreadsPattern << "]";
+  Demo::Log(Demo::LogLevel::Information)
+      << "Recomputes the statistics of a past simulation from its binary transition log.";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::filesystem::path transition_log;
+  std::filesystem::path results;
+  std::size_t thread_count = 0;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == Demo::Arguments::TransitionLogKey && index + 1 < argc) {
+      transition_log = argv[++index];
+    } else if (argument == Demo::Arguments::ResultsKey && index + 1 < argc) {
+      results = argv[++index];
+    } else if (argument == Demo::Arguments::ThreadsKey && index + 1 < argc) {
+      thread_count = static_cast<std::size_t>(std::max(std::atoi(argv[++index]), 0));
+    } else {
+      if (argument != Demo::Arguments::Help) {
+        Demo::Log(Demo::LogLevel::Error) << "Unrecognized argument: " << argument;
+      }
+      PrintUsage(argv[0]);
+      return argument == Demo::Arguments::Help ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  if (transition_log.empty()) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  const Demo::TransitionLogReader reader{transition_log};
+  if (!reader.IsValid()) {
+    return EXIT_FAILURE;
+  }
+
+  const Demo::TransitionLogReplay replay{reader, thread_count};
+  if (!replay.IsValid()) {
+    return EXIT_FAILURE;
+  }
+
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  Demo::Log(Demo::LogLevel::Information)
+      << "Replayed " << reader.RecordCount() << " transitions of " << reader.Vehicles().size()
+      << " vehicles in " << reader.Blocks().size() << " blocks (" << reader.Size()
+      << " bytes) using " << replay.ThreadCount() << " threads in " << seconds << " s.";
+
+  Demo::Log(Demo::LogLevel::Information)
+      << "The replayed simulation ended at: " << replay.EndTime().Print(PhQ::Unit::Time::Hour);
+
+  const Demo::ResultsFileWriter results_file_writer{
+      results, reader.Models(), replay.Aggregate()};
+
+  return EXIT_SUCCESS;
+}
@@ -23,9 +23,8 @@
 #ifndef DEMO_INCLUDE_RESULTS_FILE_WRITER_HPP
 #define DEMO_INCLUDE_RESULTS_FILE_WRITER_HPP
 
-#include <iostream>
-
 #include "AggregateStatistics.hpp"
+#include "Logger.hpp"
 #include "String.hpp"
 #include "TextFileWriter.hpp"
 #include "VehicleModels.hpp"
@@ -58,7 +57,7 @@ public:
     }
 
     if (!path_.empty()) {
-      std::cout << "Wrote the results to: " << path_.string() << std::endl;
+      Log(LogLevel::Information) << "Wrote the results to: " << path_.string();
     }
   }
 
@@ -155,31 +154,59 @@ private:
     return ReplaceSpacesWithUnderscores(vehicle_model.ModelNameEnglish());
   }
 
-  // Returns the printed mean flight duration of a statistics object.
+  // Returns the printed mean flight duration of a statistics object, or a dash if the flight
+  // metrics are not tracked.
   std::string PrintMeanFlightDuration(const Statistics& statistics) const noexcept {
-    return statistics.MeanFlightDuration().Print(PhQ::Unit::Time::Hour);
+    if constexpr (Statistics::TracksFlights) {
+      return statistics.MeanFlightDuration().Print(PhQ::Unit::Time::Hour);
+    } else {
+      return untracked_;
+    }
   }
 
-  // Returns the printed mean flight distance of a statistics object.
+  // Returns the printed mean flight distance of a statistics object, or a dash if the flight
+  // metrics are not tracked.
   std::string PrintMeanFlightDistance(const Statistics& statistics) const noexcept {
-    return statistics.MeanFlightDistance().Print(PhQ::Unit::Length::Mile);
+    if constexpr (Statistics::TracksFlights) {
+      return statistics.MeanFlightDistance().Print(PhQ::Unit::Length::Mile);
+    } else {
+      return untracked_;
+    }
   }
 
-  // Returns the printed mean charging duration of a statistics object.
+  // Returns the printed mean charging duration of a statistics object, or a dash if the charging
+  // session metrics are not tracked.
   std::string PrintMeanChargingDuration(const Statistics& statistics) const noexcept {
-    return statistics.MeanChargingDuration().Print(PhQ::Unit::Time::Hour);
+    if constexpr (Statistics::TracksChargingSessions) {
+      return statistics.MeanChargingDuration().Print(PhQ::Unit::Time::Hour);
+    } else {
+      return untracked_;
+    }
   }
 
-  // Returns the printed total flight passenger distance of a statistics object.
+  // Returns the printed total flight passenger distance of a statistics object, or a dash if the
+  // flight metrics are not tracked.
   std::string PrintTotalFlightPassengerDistance(const Statistics& statistics) const noexcept {
-    return statistics.TotalFlightPassengerDistance().Print(PhQ::Unit::Length::Mile);
+    if constexpr (Statistics::TracksFlights) {
+      return statistics.TotalFlightPassengerDistance().Print(PhQ::Unit::Length::Mile);
+    } else {
+      return untracked_;
+    }
   }
 
-  // Returns the printed total fault count of a statistics object.
+  // Returns the printed total fault count of a statistics object, or a dash if the fault metrics
+  // are not tracked.
   std::string PrintTotalFaultCount(const Statistics& statistics) const noexcept {
-    return std::to_string(statistics.TotalFaultCount());
+    if constexpr (Statistics::TracksFaults) {
+      return std::to_string(statistics.TotalFaultCount());
+    } else {
+      return untracked_;
+    }
   }
 
+  // Printed value of a metric that is not tracked.
+  const std::string untracked_{"-"};
+
   const std::string indent_{"  "};
 
   std::string manufacturer_{"#Manufacturer"};
@@ -0,0 +1,143 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_RING_BUFFER_HPP
+#define DEMO_INCLUDE_RING_BUFFER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Demo {
+
+// First-in first-out queue stored in a contiguous circular buffer. Unlike std::deque, it allocates
+// nothing until its first element is pushed, and it only allocates when it grows beyond its largest
+// size so far, so a queue that has reached its working size never allocates again. Its capacity is
+// always zero or a power of two.
+template <typename Value, typename Allocator = std::allocator<Value>>
+class RingBuffer {
+public:
+  using allocator_type = Allocator;
+
+  // Constructs an empty queue without allocating.
+  RingBuffer() noexcept = default;
+
+  // Constructs an empty queue that allocates with a given allocator, without allocating.
+  explicit RingBuffer(const Allocator& allocator) noexcept : data_(allocator) {}
+
+  // Returns whether this queue is empty.
+  bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Returns the number of elements in this queue.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Returns the number of elements that this queue can hold without allocating.
+  std::size_t Capacity() const noexcept {
+    return data_.size();
+  }
+
+  // Returns the element at the front of this queue. This queue must not be empty.
+  const Value& Front() const noexcept {
+    return data_[head_];
+  }
+
+  // Returns the element at a given position from the front of this queue. The position must be
+  // less than the size of this queue.
+  const Value& operator[](const std::size_t position) const noexcept {
+    return data_[(head_ + position) & (data_.size() - 1)];
+  }
+
+  // Pushes a given element at the back of this queue, doubling its capacity if it is full.
+  void PushBack(const Value& value) noexcept {
+    if (size_ == data_.size()) {
+      Grow(data_.empty() ? MinimumCapacity : 2 * data_.size());
+    }
+    data_[(head_ + size_) & (data_.size() - 1)] = value;
+    ++size_;
+  }
+
+  // Removes the element at the front of this queue. Does nothing if this queue is empty.
+  void PopFront() noexcept {
+    if (size_ == 0) {
+      return;
+    }
+    head_ = (head_ + 1) & (data_.size() - 1);
+    --size_;
+  }
+
+  // Removes the element at a given position from the front of this queue by shifting the elements
+  // behind it forward. The position must be less than the size of this queue.
+  void Erase(const std::size_t position) noexcept {
+    for (std::size_t index = position; index + 1 < size_; ++index) {
+      data_[(head_ + index) & (data_.size() - 1)] =
+          std::move(data_[(head_ + index + 1) & (data_.size() - 1)]);
+    }
+    --size_;
+  }
+
+  // Removes all elements from this queue without releasing its capacity.
+  void Clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // Ensures that this queue can hold at least a given number of elements without allocating.
+  void Reserve(const std::size_t capacity) noexcept {
+    if (capacity > data_.size()) {
+      std::size_t new_capacity = MinimumCapacity;
+      while (new_capacity < capacity) {
+        new_capacity *= 2;
+      }
+      Grow(new_capacity);
+    }
+  }
+
+private:
+  // Smallest non-zero capacity.
+  static constexpr std::size_t MinimumCapacity = 4;
+
+  // Moves the elements into a new buffer of a given capacity, which is a power of two.
+  void Grow(const std::size_t capacity) noexcept {
+    std::vector<Value, Allocator> data(capacity, data_.get_allocator());
+    for (std::size_t position = 0; position < size_; ++position) {
+      data[position] = std::move(data_[(head_ + position) & (data_.size() - 1)]);
+    }
+    data_.swap(data);
+    head_ = 0;
+  }
+
+  std::vector<Value, Allocator> data_;
+
+  // Index of the front element in the buffer.
+  std::size_t head_ = 0;
+
+  std::size_t size_ = 0;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_RING_BUFFER_HPP
@@ -0,0 +1,337 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_ROSTER_HPP
+#define DEMO_INCLUDE_ROSTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ByteOrder.hpp"
+#include "ChargingStationId.hpp"
+#include "FileWriter.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include "VehicleId.hpp"
+#include "VehicleModelId.hpp"
+
+namespace Demo {
+
+// Formats of a roster file.
+enum class RosterFormat : int8_t {
+  // Text file with one vehicle per line, as comma-separated values.
+  Csv,
+
+  // Binary file with one fixed-width record per vehicle.
+  Binary,
+};
+
+// Magic bytes at the beginning of a binary roster file.
+inline constexpr std::array<uint8_t, 8> RosterMagic{'J', 'O', 'B', 'Y', 'R', 'S', 'T', '1'};
+
+// Version of the binary roster file format.
+inline constexpr uint8_t RosterVersion = 1;
+
+// Size in bytes of the header of a binary roster file: the magic bytes, the version byte, seven
+// bytes of padding, and the number of records as a little-endian 64-bit integer.
+inline constexpr std::size_t RosterHeaderSize = 24;
+
+// Size in bytes of each record of a binary roster file: the vehicle ID, the vehicle model ID, the
+// initial state of charge, and the home charging station ID, or -1 if there is none, each as a
+// little-endian 64-bit value.
+inline constexpr std::size_t RosterRecordSize = 32;
+
+// Header line of a CSV roster file.
+inline constexpr std::string_view RosterCsvHeader{"id,model_id,battery,home_station"};
+
+// Vehicle listed in a roster.
+struct RosterEntry {
+  VehicleId id = 0;
+
+  VehicleModelId model_id = 0;
+
+  // Initial state of charge of the vehicle's battery, as a fraction of its capacity from 0 to 1.
+  double battery = 1.0;
+
+  // ID of the charging station at which the vehicle charges whenever it can, or std::nullopt if the
+  // vehicle charges at whichever charging station has the shortest queue.
+  std::optional<ChargingStationId> home_charging_station_id;
+
+  constexpr bool operator==(const RosterEntry& other) const noexcept {
+    return id == other.id && model_id == other.model_id && battery == other.battery
+           && home_charging_station_id == other.home_charging_station_id;
+  }
+};
+
+// Roster of the vehicles of a fleet, read from a CSV or binary roster file. The file is
+// memory-mapped and its rows are decoded in place on demand, independently of one another, so
+// they can be decoded in parallel straight into the storage of the fleet.
+//
+// A binary roster file begins with the RosterMagic bytes and has fixed-width records, so its rows
+// are located without reading them. A CSV roster file has one vehicle per line, with the fields of
+// RosterCsvHeader, which may be given as its first line; the home charging station may be empty.
+// The lines of a CSV roster file are located on construction by a scan for line feeds that tests
+// sixteen bytes at a time with SSE2 where available; empty lines are skipped.
+class Roster {
+public:
+  // Maps the roster file at the given path and locates its rows. The format is detected from the
+  // file's first bytes.
+  explicit Roster(const std::filesystem::path& path) noexcept : file_(path) {
+    if (!file_.IsOpen()) {
+      return;
+    }
+    const uint8_t* const data = file_.Data();
+    const std::size_t size = file_.Size();
+    if (size >= RosterMagic.size() && std::equal(RosterMagic.begin(), RosterMagic.end(), data)) {
+      format_ = RosterFormat::Binary;
+      const std::size_t record_count = (size - std::min(size, RosterHeaderSize)) / RosterRecordSize;
+      if (size < RosterHeaderSize || data[RosterMagic.size()] != RosterVersion
+          || size != RosterHeaderSize + record_count * RosterRecordSize
+          || LoadLittleEndian<uint64_t>(data + 16) != record_count) {
+        Log(LogLevel::Error) << "Not a valid roster file: " << path.string();
+        return;
+      }
+      size_ = record_count;
+    } else {
+      format_ = RosterFormat::Csv;
+      FindLines(data, size);
+      if (!line_offsets_.empty() && !IsRowStart(data[line_offsets_.front()])) {
+        line_offsets_.erase(line_offsets_.begin());
+      }
+      size_ = line_offsets_.size();
+    }
+    valid_ = true;
+  }
+
+  // Returns whether the roster file was read successfully.
+  bool IsValid() const noexcept {
+    return valid_;
+  }
+
+  // Path to the roster file.
+  const std::filesystem::path& Path() const noexcept {
+    return file_.Path();
+  }
+
+  // Format of the roster file.
+  RosterFormat Format() const noexcept {
+    return format_;
+  }
+
+  // Number of rows of the roster, each of which lists one vehicle.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Decodes the row at a given index, which must be less than the number of rows. Returns
+  // std::nullopt if the row is malformed or its state of charge or home charging station ID is
+  // out of range.
+  std::optional<RosterEntry> Row(const std::size_t index) const noexcept {
+    std::optional<RosterEntry> entry =
+        format_ == RosterFormat::Binary ? DecodeRecord(index) : ParseLine(index);
+    if (entry.has_value()
+        && (!(entry->battery >= 0.0 && entry->battery <= 1.0)
+            || entry->home_charging_station_id.value_or(0) < 0)) {
+      return std::nullopt;
+    }
+    return entry;
+  }
+
+private:
+  // Returns whether a given character can begin a row, as opposed to a header line.
+  static constexpr bool IsRowStart(const uint8_t character) noexcept {
+    return (character >= '0' && character <= '9') || character == '-';
+  }
+
+  // Records the offset of each non-empty line of a given text.
+  void FindLines(const uint8_t* const data, const std::size_t size) noexcept {
+    std::size_t line_start = 0;
+    const auto end_line = [&](const std::size_t line_end) {
+      if (line_end > line_start && !(line_end == line_start + 1 && data[line_start] == '\r')) {
+        line_offsets_.push_back(line_start);
+      }
+      line_start = line_end + 1;
+    };
+    std::size_t offset = 0;
+#if defined(__SSE2__)
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    for (; offset + 16 <= size; offset += 16) {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+      uint32_t mask =
+          static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, line_feed)));
+      while (mask != 0) {
+        end_line(offset + static_cast<std::size_t>(__builtin_ctz(mask)));
+        mask &= mask - 1;
+      }
+    }
+#endif
+    for (; offset < size; ++offset) {
+      if (data[offset] == '\n') {
+        end_line(offset);
+      }
+    }
+    end_line(size);
+  }
+
+  // Decodes the binary record at a given index.
+  std::optional<RosterEntry> DecodeRecord(const std::size_t index) const noexcept {
+    const uint8_t* const record = file_.Data() + RosterHeaderSize + index * RosterRecordSize;
+    RosterEntry entry;
+    entry.id = LoadLittleEndian<int64_t>(record);
+    entry.model_id = LoadLittleEndian<int64_t>(record + 8);
+    entry.battery = LoadLittleEndianDouble(record + 16);
+    const int64_t home_charging_station_id = LoadLittleEndian<int64_t>(record + 24);
+    if (home_charging_station_id != -1) {
+      entry.home_charging_station_id = home_charging_station_id;
+    }
+    return entry;
+  }
+
+  // Parses the CSV line at a given index in place.
+  std::optional<RosterEntry> ParseLine(const std::size_t index) const noexcept {
+    const char* current = reinterpret_cast<const char*>(file_.Data()) + line_offsets_[index];
+    const char* const end = reinterpret_cast<const char*>(file_.Data()) + file_.Size();
+    RosterEntry entry;
+    if (!ParseField(current, end, entry.id) || !Skip(current, end, ',')
+        || !ParseField(current, end, entry.model_id) || !Skip(current, end, ',')
+        || !ParseField(current, end, entry.battery)) {
+      return std::nullopt;
+    }
+    if (Skip(current, end, ',') && current < end && IsRowStart(static_cast<uint8_t>(*current))) {
+      ChargingStationId home_charging_station_id = 0;
+      if (!ParseField(current, end, home_charging_station_id)) {
+        return std::nullopt;
+      }
+      entry.home_charging_station_id = home_charging_station_id;
+    }
+    Skip(current, end, '\r');
+    if (current != end && *current != '\n') {
+      return std::nullopt;
+    }
+    return entry;
+  }
+
+  // Parses a number at a given position in a text and advances the position past it. Returns false
+  // if there is no number at that position.
+  template <typename Number>
+  static bool ParseField(const char*& current, const char* const end, Number& value) noexcept {
+    const std::from_chars_result result = std::from_chars(current, end, value);
+    if (result.ec != std::errc()) {
+      return false;
+    }
+    current = result.ptr;
+    return true;
+  }
+
+  // Advances a given position in a text past a given character if it is there. Returns whether it
+  // was there.
+  static bool Skip(const char*& current, const char* const end, const char character) noexcept {
+    if (current < end && *current == character) {
+      ++current;
+      return true;
+    }
+    return false;
+  }
+
+  MappedFile file_;
+
+  RosterFormat format_ = RosterFormat::Csv;
+
+  // Offset of the first byte of each row of a CSV roster file.
+  std::vector<std::size_t> line_offsets_;
+
+  std::size_t size_ = 0;
+
+  bool valid_ = false;
+};
+
+// File writer for writing a roster to a CSV or binary roster file.
+class RosterFileWriter : public FileWriter {
+public:
+  // Creates and opens a file at the given path, writes the given roster entries to it in a given
+  // format, and closes the file.
+  RosterFileWriter(const std::filesystem::path& path, const std::vector<RosterEntry>& entries,
+                   const RosterFormat format)
+    : FileWriter(path) {
+    if (!stream_.is_open()) {
+      return;
+    }
+    if (format == RosterFormat::Binary) {
+      WriteBinary(entries);
+    } else {
+      WriteCsv(entries);
+    }
+    Log(LogLevel::Information) << "Wrote a roster of " << entries.size()
+                               << " vehicles to: " << path_.string();
+  }
+
+private:
+  // Writes the header and the fixed-width records of a binary roster file.
+  void WriteBinary(const std::vector<RosterEntry>& entries) noexcept {
+    std::array<uint8_t, RosterHeaderSize> header{};
+    std::copy(RosterMagic.begin(), RosterMagic.end(), header.begin());
+    header[RosterMagic.size()] = RosterVersion;
+    StoreLittleEndian<uint64_t>(entries.size(), header.data() + 16);
+    stream_.write(reinterpret_cast<const char*>(header.data()), header.size());
+    std::array<uint8_t, RosterRecordSize> record{};
+    for (const RosterEntry& entry : entries) {
+      StoreLittleEndian<int64_t>(entry.id, record.data());
+      StoreLittleEndian<int64_t>(entry.model_id, record.data() + 8);
+      StoreLittleEndian(entry.battery, record.data() + 16);
+      StoreLittleEndian<int64_t>(entry.home_charging_station_id.value_or(-1), record.data() + 24);
+      stream_.write(reinterpret_cast<const char*>(record.data()), record.size());
+    }
+  }
+
+  // Writes the header line and one line per vehicle of a CSV roster file. The states of charge are
+  // written with the fewest digits that read back exactly.
+  void WriteCsv(const std::vector<RosterEntry>& entries) noexcept {
+    stream_ << RosterCsvHeader << '\n';
+    std::array<char, 32> battery;
+    for (const RosterEntry& entry : entries) {
+      const std::to_chars_result result =
+          std::to_chars(battery.data(), battery.data() + battery.size(), entry.battery);
+      stream_ << entry.id << ',' << entry.model_id << ','
+              << std::string_view(battery.data(), result.ptr - battery.data()) << ',';
+      if (entry.home_charging_station_id.has_value()) {
+        stream_ << entry.home_charging_station_id.value();
+      }
+      stream_ << '\n';
+    }
+  }
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_ROSTER_HPP
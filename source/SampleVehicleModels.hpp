@@ -23,81 +23,69 @@
 #ifndef DEMO_INCLUDE_SAMPLE_VEHICLE_MODELS_HPP
 #define DEMO_INCLUDE_SAMPLE_VEHICLE_MODELS_HPP
 
-#include <iostream>
+#include <array>
 
+#include "Logger.hpp"
+#include "VehicleModelCatalog.hpp"
 #include "VehicleModels.hpp"
 
 namespace Demo {
 
-VehicleModels GenerateSampleVehicleModels() noexcept {
-  VehicleModels vehicle_models;
-
-  vehicle_models.Insert(std::make_shared<VehicleModel>(
-      /*id=*/0,
-      /*manufacturer_name_english=*/"Alpha Company",
-      /*model_name_english=*/"Alpha Model",
-      /*passenger_count=*/4,
-      /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
-      /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
-      /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
-      /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
-      /*transport_energy_consumption=*/
-      PhQ::TransportEnergyConsumption(
-          1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
-
-  vehicle_models.Insert(std::make_shared<VehicleModel>(
-      /*id=*/1,
-      /*manufacturer_name_english=*/"Bravo Company",
-      /*model_name_english=*/"Bravo Model",
-      /*passenger_count=*/5,
-      /*cruise_speed=*/PhQ::Speed(100.0, PhQ::Unit::Speed::MilePerHour),
-      /*battery_capacity=*/PhQ::Energy(100.0, PhQ::Unit::Energy::KilowattHour),
-      /*charging_duration=*/PhQ::Time(0.2, PhQ::Unit::Time::Hour),
-      /*fault_rate=*/PhQ::Frequency(0.1, PhQ::Unit::Frequency::PerHour),
-      /*transport_energy_consumption=*/
-      PhQ::TransportEnergyConsumption(
-          1.5, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
+// Catalog of the sample vehicle models. Being known at build time, it can be used to generate
+// kernels specialized for each sample vehicle model; see CatalogKernels.hpp.
+inline constexpr std::array<VehicleModelSpec, 5> SampleVehicleModelCatalog{{
+    {/*id=*/0,
+     /*manufacturer_name_english=*/"Alpha Company",
+     /*model_name_english=*/"Alpha Model",
+     /*passenger_count=*/4,
+     /*cruise_speed_miles_per_hour=*/120.0,
+     /*battery_capacity_kilowatt_hours=*/320.0,
+     /*charging_duration_hours=*/0.6,
+     /*fault_rate_per_hour=*/0.25,
+     /*energy_use_kilowatt_hours_per_mile=*/1.6},
+    {/*id=*/1,
+     /*manufacturer_name_english=*/"Bravo Company",
+     /*model_name_english=*/"Bravo Model",
+     /*passenger_count=*/5,
+     /*cruise_speed_miles_per_hour=*/100.0,
+     /*battery_capacity_kilowatt_hours=*/100.0,
+     /*charging_duration_hours=*/0.2,
+     /*fault_rate_per_hour=*/0.1,
+     /*energy_use_kilowatt_hours_per_mile=*/1.5},
+    {/*id=*/2,
+     /*manufacturer_name_english=*/"Charlie Company",
+     /*model_name_english=*/"Charlie Model",
+     /*passenger_count=*/3,
+     /*cruise_speed_miles_per_hour=*/160.0,
+     /*battery_capacity_kilowatt_hours=*/220.0,
+     /*charging_duration_hours=*/0.8,
+     /*fault_rate_per_hour=*/0.05,
+     /*energy_use_kilowatt_hours_per_mile=*/2.2},
+    {/*id=*/3,
+     /*manufacturer_name_english=*/"Delta Company",
+     /*model_name_english=*/"Delta Model",
+     /*passenger_count=*/2,
+     /*cruise_speed_miles_per_hour=*/90.0,
+     /*battery_capacity_kilowatt_hours=*/120.0,
+     /*charging_duration_hours=*/0.62,
+     /*fault_rate_per_hour=*/0.22,
+     /*energy_use_kilowatt_hours_per_mile=*/0.8},
+    {/*id=*/4,
+     /*manufacturer_name_english=*/"Echo Company",
+     /*model_name_english=*/"Echo Model",
+     /*passenger_count=*/2,
+     /*cruise_speed_miles_per_hour=*/30.0,
+     /*battery_capacity_kilowatt_hours=*/150.0,
+     /*charging_duration_hours=*/0.3,
+     /*fault_rate_per_hour=*/0.61,
+     /*energy_use_kilowatt_hours_per_mile=*/5.8},
+}};
 
-  vehicle_models.Insert(std::make_shared<VehicleModel>(
-      /*id=*/2,
-      /*manufacturer_name_english=*/"Charlie Company",
-      /*model_name_english=*/"Charlie Model",
-      /*passenger_count=*/3,
-      /*cruise_speed=*/PhQ::Speed(160.0, PhQ::Unit::Speed::MilePerHour),
-      /*battery_capacity=*/PhQ::Energy(220.0, PhQ::Unit::Energy::KilowattHour),
-      /*charging_duration=*/PhQ::Time(0.8, PhQ::Unit::Time::Hour),
-      /*fault_rate=*/PhQ::Frequency(0.05, PhQ::Unit::Frequency::PerHour),
-      /*transport_energy_consumption=*/
-      PhQ::TransportEnergyConsumption(
-          2.2, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
-
-  vehicle_models.Insert(std::make_shared<VehicleModel>(
-      /*id=*/3,
-      /*manufacturer_name_english=*/"Delta Company",
-      /*model_name_english=*/"Delta Model",
-      /*passenger_count=*/2,
-      /*cruise_speed=*/PhQ::Speed(90.0, PhQ::Unit::Speed::MilePerHour),
-      /*battery_capacity=*/PhQ::Energy(120.0, PhQ::Unit::Energy::KilowattHour),
-      /*charging_duration=*/PhQ::Time(0.62, PhQ::Unit::Time::Hour),
-      /*fault_rate=*/PhQ::Frequency(0.22, PhQ::Unit::Frequency::PerHour),
-      /*transport_energy_consumption=*/
-      PhQ::TransportEnergyConsumption(
-          0.8, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
-
-  vehicle_models.Insert(std::make_shared<VehicleModel>(
-      /*id=*/4,
-      /*manufacturer_name_english=*/"Echo Company",
-      /*model_name_english=*/"Echo Model",
-      /*passenger_count=*/2,
-      /*cruise_speed=*/PhQ::Speed(30.0, PhQ::Unit::Speed::MilePerHour),
-      /*battery_capacity=*/PhQ::Energy(150.0, PhQ::Unit::Energy::KilowattHour),
-      /*charging_duration=*/PhQ::Time(0.3, PhQ::Unit::Time::Hour),
-      /*fault_rate=*/PhQ::Frequency(0.61, PhQ::Unit::Frequency::PerHour),
-      /*transport_energy_consumption=*/
-      PhQ::TransportEnergyConsumption(
-          5.8, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
+VehicleModels GenerateSampleVehicleModels() noexcept {
+  VehicleModels vehicle_models = VehicleModelsFromCatalog(SampleVehicleModelCatalog);
 
-  std::cout << "Generated " << vehicle_models.Size() << " sample vehicle models." << std::endl;
+  Log(LogLevel::Information) << "Generated " << vehicle_models.Size()
+                             << " sample vehicle models.";
 
   return vehicle_models;
 }
@@ -0,0 +1,193 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Arguments.hpp"
+#include "Logger.hpp"
+#include "SampleVehicleModels.hpp"
+#include "ScalingStudy.hpp"
+
+namespace {
+
+// Smallest number of vehicles in the sweep.
+constexpr int64_t MinimumVehicles = 100;
+
+// Default largest number of vehicles in the sweep.
+constexpr int64_t DefaultMaximumVehicles = 10'000'000;
+
+// Smallest number of charging stations in the sweep.
+constexpr int64_t MinimumChargingStations = 1;
+
+// Default largest number of charging stations in the sweep.
+constexpr int64_t DefaultMaximumChargingStations = 10'000;
+
+// Default number of grid points per decade of both sweeps.
+constexpr int32_t DefaultPointsPerDecade = 1;
+
+// Default simulated time duration of each point in hours.
+constexpr double DefaultDurationHours = 3.0;
+
+// Default wall time limit of each point in seconds.
+constexpr double DefaultTimeLimitSeconds = 10.0;
+
+// Exponent above which the wall time is reported as growing super-linearly with the fleet size.
+constexpr double SuperLinearExponent = 1.1;
+
+// Prints the usage information of the scaling study program.
+void PrintUsage(const std::string& executable_name) noexcept {
+  Demo::Log(Demo::LogLevel::Information)
+      << "Usage: " << executable_name << " [" << Demo::Arguments::MaxVehiclesPattern << "] ["
+      << Demo::Arguments::MaxChargingStationsPattern << "] ["
+      << Demo::Arguments::PointsPerDecadePattern << "] [" << Demo::Arguments::DurationPattern
+      << "] [" << Demo::Arguments::TimeLimitPattern << "] [" << Demo::Arguments::SeedPattern
+      << "] [" << Demo::Arguments::OutputPattern << "] [" << Demo::Arguments::MaxExponentPattern
+      << "]";
+  Demo::Log(Demo::LogLevel::Information)
+      << "Sweeps the numbers of vehicles from " << MinimumVehicles << " and of charging stations "
+      << "from " << MinimumChargingStations << " over logarithmic grids, measures each point, and "
+         "fits the empirical complexity exponents of the wall time. Fails if the vehicle exponent "
+         "exceeds the maximum exponent, when one is given.";
+}
+
+// Logs a fitted complexity.
+void LogFit(const std::string& name, const std::optional<Demo::ScalingFit>& fit) noexcept {
+  if (!fit.has_value()) {
+    Demo::Log(Demo::LogLevel::Warning) << name << ": not enough points to fit an exponent.";
+    return;
+  }
+  Demo::Log(Demo::LogLevel::Information)
+      << name << " ~ vehicles^" << fit->vehicle_exponent << " * charging_stations^"
+      << fit->charging_station_exponent << " (R^2 = " << fit->r_squared << ")";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int64_t maximum_vehicles = DefaultMaximumVehicles;
+  int64_t maximum_charging_stations = DefaultMaximumChargingStations;
+  int32_t points_per_decade = DefaultPointsPerDecade;
+  double duration_hours = DefaultDurationHours;
+  double time_limit_seconds = DefaultTimeLimitSeconds;
+  uint64_t seed = 0;
+  std::filesystem::path output;
+  std::optional<double> maximum_exponent;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == Demo::Arguments::MaxVehiclesKey && index + 1 < argc) {
+      maximum_vehicles = std::max<int64_t>(std::atoll(argv[++index]), MinimumVehicles);
+    } else if (argument == Demo::Arguments::MaxChargingStationsKey && index + 1 < argc) {
+      maximum_charging_stations =
+          std::max<int64_t>(std::atoll(argv[++index]), MinimumChargingStations);
+    } else if (argument == Demo::Arguments::PointsPerDecadeKey && index + 1 < argc) {
+      points_per_decade = std::max(std::atoi(argv[++index]), 1);
+    } else if (argument == Demo::Arguments::DurationKey && index + 1 < argc) {
+      duration_hours = std::max(std::atof(argv[++index]), 0.0);
+    } else if (argument == Demo::Arguments::TimeLimitKey && index + 1 < argc) {
+      time_limit_seconds = std::max(std::atof(argv[++index]), 0.0);
+    } else if (argument == Demo::Arguments::SeedKey && index + 1 < argc) {
+      seed = std::strtoull(argv[++index], nullptr, 10);
+    } else if (argument == Demo::Arguments::OutputKey && index + 1 < argc) {
+      output = argv[++index];
+    } else if (argument == Demo::Arguments::MaxExponentKey && index + 1 < argc) {
+      maximum_exponent = std::atof(argv[++index]);
+    } else {
+      if (argument != Demo::Arguments::Help) {
+        Demo::Log(Demo::LogLevel::Error) << "Unrecognized argument: " << argument;
+      }
+      PrintUsage(argv[0]);
+      return argument == Demo::Arguments::Help ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  const Demo::VehicleModels vehicle_models = [] {
+    const Demo::ScopedLogLevel quiet_logging{Demo::LogLevel::Warning};
+    return Demo::GenerateSampleVehicleModels();
+  }();
+  const PhQ::Time<> duration{duration_hours, PhQ::Unit::Time::Hour};
+
+  if (!Demo::ResetPeakResidentSetSize()) {
+    Demo::Log(Demo::LogLevel::Warning)
+        << "The peak resident set size cannot be reset on this system, so each point reports the "
+           "peak of all points so far.";
+  }
+
+  Demo::Log(Demo::LogLevel::Information) << "Scaling study:";
+  std::vector<Demo::ScalingPoint> points;
+  for (const int64_t charging_station_count : Demo::LogarithmicGrid(
+           MinimumChargingStations, maximum_charging_stations, points_per_decade)) {
+    for (const int64_t vehicle_count :
+         Demo::LogarithmicGrid(MinimumVehicles, maximum_vehicles, points_per_decade)) {
+      const Demo::ScalingPoint point = Demo::MeasureScalingPoint(
+          vehicle_count, charging_station_count, duration, vehicle_models, seed,
+          time_limit_seconds);
+      Demo::Log(Demo::LogLevel::Information)
+          << "- " << point.vehicles << " vehicles, " << point.charging_stations
+          << " charging stations: " << point.wall_seconds << " s for " << point.simulated_hours
+          << " h" << (point.truncated ? " (time limit)" : "") << ", " << point.events_per_second
+          << " events/s, " << point.peak_resident_bytes / (1024 * 1024) << " MiB peak, "
+          << point.bytes_per_vehicle << " B/vehicle";
+      points.push_back(point);
+    }
+  }
+
+  const std::optional<Demo::ScalingFit> wall_time_fit =
+      Demo::FitScaling(points, [](const Demo::ScalingPoint& point) {
+        return point.wall_seconds_per_simulated_hour;
+      });
+  const std::optional<Demo::ScalingFit> time_per_event_fit =
+      Demo::FitScaling(points, [](const Demo::ScalingPoint& point) {
+        return point.events_per_second > 0.0 ? 1.0 / point.events_per_second : 0.0;
+      });
+  LogFit("Wall time per simulated hour", wall_time_fit);
+  LogFit("Wall time per event", time_per_event_fit);
+
+  if (!output.empty()) {
+    std::ofstream stream(output);
+    if (!stream.is_open()) {
+      Demo::Log(Demo::LogLevel::Error) << "Could not open the file: " << output.string();
+      return EXIT_FAILURE;
+    }
+    stream << Demo::ScalingStudyToJson(points, wall_time_fit, time_per_event_fit);
+    Demo::Log(Demo::LogLevel::Information) << "Wrote the scaling study to: " << output.string();
+  }
+
+  if (wall_time_fit.has_value() && wall_time_fit->vehicle_exponent > SuperLinearExponent) {
+    Demo::Log(Demo::LogLevel::Warning)
+        << "The wall time grows super-linearly with the number of vehicles.";
+  }
+  if (maximum_exponent.has_value() && wall_time_fit.has_value()
+      && wall_time_fit->vehicle_exponent > maximum_exponent.value()) {
+    Demo::Log(Demo::LogLevel::Error)
+        << "The vehicle exponent " << wall_time_fit->vehicle_exponent
+        << " exceeds the maximum exponent " << maximum_exponent.value() << ".";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,299 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_SCALING_STUDY_HPP
+#define DEMO_INCLUDE_SCALING_STUDY_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ChargingStations.hpp"
+#include "EventCountingObserver.hpp"
+#include "Logger.hpp"
+#include "ProcessMemory.hpp"
+#include "Simulation.hpp"
+#include "VehicleModels.hpp"
+#include "Vehicles.hpp"
+
+namespace Demo {
+
+// Returns the values of a logarithmic grid from a given minimum to a given maximum, both inclusive,
+// with a given number of points per decade. Values are rounded to integers and duplicates are
+// removed, so the grid may contain fewer points than requested at its low end.
+inline std::vector<int64_t> LogarithmicGrid(
+    const int64_t minimum, const int64_t maximum, const int32_t points_per_decade) noexcept {
+  std::vector<int64_t> grid;
+  if (minimum <= 0 || maximum < minimum || points_per_decade <= 0) {
+    return grid;
+  }
+  const double start = std::log10(static_cast<double>(minimum));
+  const double end = std::log10(static_cast<double>(maximum));
+  for (int32_t index = 0;; ++index) {
+    const double exponent = start + static_cast<double>(index) / points_per_decade;
+    if (exponent > end + 1.0E-9) {
+      break;
+    }
+    const int64_t value =
+        std::min(static_cast<int64_t>(std::llround(std::pow(10.0, exponent))), maximum);
+    if (grid.empty() || value > grid.back()) {
+      grid.push_back(value);
+    }
+  }
+  if (grid.back() < maximum) {
+    grid.push_back(maximum);
+  }
+  return grid;
+}
+
+// Number of time steps performed between two checks of the wall time limit of a scaling study.
+// The vehicles are brought up to date after each batch, so a batch amortizes that cost over many
+// time steps while still honoring the time limit closely.
+inline constexpr std::size_t ScalingStudyStepBatch = 64;
+
+// Measurement of one point of a scaling study, which is one simulation of a given number of
+// vehicles and charging stations.
+struct ScalingPoint {
+  int64_t vehicles = 0;
+
+  int64_t charging_stations = 0;
+
+  // Simulated time in hours. Less than the requested duration if the simulation reached its time
+  // limit first.
+  double simulated_hours = 0.0;
+
+  // Wall time spent running the simulation in seconds, excluding the construction of the fleet.
+  double wall_seconds = 0.0;
+
+  // Number of vehicle events that occurred, such as takeoffs, landings, and charging sessions.
+  uint64_t events = 0;
+
+  // Number of time steps performed.
+  std::size_t time_steps = 0;
+
+  double events_per_second = 0.0;
+
+  // Wall time in seconds per simulated hour. This is the cost that is fitted to obtain the
+  // complexity exponents, since it is comparable between truncated and complete simulations.
+  double wall_seconds_per_simulated_hour = 0.0;
+
+  // Peak resident set size of the process in bytes during this measurement.
+  std::size_t peak_resident_bytes = 0;
+
+  // Growth of the resident set size caused by constructing the fleet and the charging stations,
+  // divided by the number of vehicles.
+  double bytes_per_vehicle = 0.0;
+
+  // Whether the simulation was stopped by the time limit before its duration elapsed.
+  bool truncated = false;
+};
+
+// Measures one point of a scaling study by simulating a given number of vehicles and charging
+// stations for a given duration, or until a given wall time limit in seconds is reached, whichever
+// happens first. The simulation is advanced in batches of ScalingStudyStepBatch time steps so that
+// the time limit is honored even for very large fleets.
+inline ScalingPoint MeasureScalingPoint(
+    const int64_t vehicle_count, const int64_t charging_station_count,
+    const PhQ::Time<>& duration, const VehicleModels& vehicle_models, const uint64_t seed,
+    const double time_limit_seconds) noexcept {
+  const ScopedLogLevel quiet_logging{LogLevel::Warning};
+
+  ScalingPoint point;
+  point.vehicles = vehicle_count;
+  point.charging_stations = charging_station_count;
+
+  ReleaseFreeMemory();
+  ResetPeakResidentSetSize();
+  const std::size_t initial_resident_bytes = CurrentResidentSetSize();
+  {
+    std::mt19937_64 random_generator(seed);
+    Vehicles vehicles{static_cast<int32_t>(vehicle_count), vehicle_models, random_generator};
+    ChargingStations charging_stations{static_cast<int32_t>(charging_station_count)};
+    const std::size_t fleet_resident_bytes = CurrentResidentSetSize();
+    if (vehicle_count > 0 && fleet_resident_bytes > initial_resident_bytes) {
+      point.bytes_per_vehicle = static_cast<double>(fleet_resident_bytes - initial_resident_bytes)
+                                / static_cast<double>(vehicle_count);
+    }
+
+    Simulation<EventCountingObserver> simulation{
+        duration, vehicles, charging_stations, random_generator};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (simulation.StepEvents(ScalingStudyStepBatch) > 0) {
+      point.wall_seconds =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (point.wall_seconds >= time_limit_seconds && !simulation.Finished()) {
+        point.truncated = true;
+        break;
+      }
+    }
+    point.wall_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    point.simulated_hours = simulation.ElapsedTime().Value(PhQ::Unit::Time::Hour);
+    point.events = simulation.Observer().events;
+    point.time_steps = simulation.TimeStepCount();
+  }
+  point.peak_resident_bytes = PeakResidentSetSize();
+
+  if (point.wall_seconds > 0.0) {
+    point.events_per_second = static_cast<double>(point.events) / point.wall_seconds;
+  }
+  if (point.simulated_hours > 0.0) {
+    point.wall_seconds_per_simulated_hour = point.wall_seconds / point.simulated_hours;
+  }
+  return point;
+}
+
+// Empirical complexity of a scaling study, obtained by fitting the power law
+// cost = coefficient * vehicles ^ vehicle_exponent * charging_stations ^ charging_station_exponent
+// to the measured points by least squares in logarithmic space.
+struct ScalingFit {
+  double coefficient = 0.0;
+
+  double vehicle_exponent = 0.0;
+
+  // Zero if the study does not vary the number of charging stations.
+  double charging_station_exponent = 0.0;
+
+  // Coefficient of determination of the fit in logarithmic space.
+  double r_squared = 0.0;
+};
+
+// Fits the empirical complexity of a given cost as a function of the numbers of vehicles and
+// charging stations of the given points. Points with a non-positive cost are ignored. Returns
+// std::nullopt if the points do not span at least two vehicle counts.
+template <typename CostFunction>
+inline std::optional<ScalingFit> FitScaling(
+    const std::vector<ScalingPoint>& points, const CostFunction& cost) noexcept {
+  // Observations in logarithmic space: vehicles, charging stations, and cost.
+  std::vector<std::array<double, 3>> observations;
+  for (const ScalingPoint& point : points) {
+    const double value = cost(point);
+    if (point.vehicles > 0 && point.charging_stations > 0 && value > 0.0) {
+      observations.push_back({std::log(static_cast<double>(point.vehicles)),
+                              std::log(static_cast<double>(point.charging_stations)),
+                              std::log(value)});
+    }
+  }
+  if (observations.size() < 2) {
+    return std::nullopt;
+  }
+
+  // Center the observations so that the intercept decouples from the exponents.
+  std::array<double, 3> mean{0.0, 0.0, 0.0};
+  for (const std::array<double, 3>& observation : observations) {
+    for (std::size_t index = 0; index < 3; ++index) {
+      mean[index] += observation[index] / static_cast<double>(observations.size());
+    }
+  }
+  double vv = 0.0;
+  double vs = 0.0;
+  double ss = 0.0;
+  double vc = 0.0;
+  double sc = 0.0;
+  double cc = 0.0;
+  for (const std::array<double, 3>& observation : observations) {
+    const double v = observation[0] - mean[0];
+    const double s = observation[1] - mean[1];
+    const double c = observation[2] - mean[2];
+    vv += v * v;
+    vs += v * s;
+    ss += s * s;
+    vc += v * c;
+    sc += s * c;
+    cc += c * c;
+  }
+  if (vv <= 1.0E-12) {
+    return std::nullopt;
+  }
+
+  ScalingFit fit;
+  const double determinant = vv * ss - vs * vs;
+  if (ss > 1.0E-12 && determinant > 1.0E-12 * vv * ss) {
+    fit.vehicle_exponent = (vc * ss - sc * vs) / determinant;
+    fit.charging_station_exponent = (sc * vv - vc * vs) / determinant;
+  } else {
+    fit.vehicle_exponent = vc / vv;
+  }
+  fit.coefficient = std::exp(mean[2] - fit.vehicle_exponent * mean[0]
+                             - fit.charging_station_exponent * mean[1]);
+
+  double residual = 0.0;
+  for (const std::array<double, 3>& observation : observations) {
+    const double error = observation[2] - mean[2]
+                         - fit.vehicle_exponent * (observation[0] - mean[0])
+                         - fit.charging_station_exponent * (observation[1] - mean[1]);
+    residual += error * error;
+  }
+  fit.r_squared = cc > 0.0 ? 1.0 - residual / cc : 1.0;
+  return fit;
+}
+
+// Formats the points and fits of a scaling study as a JSON document.
+inline std::string ScalingStudyToJson(
+    const std::vector<ScalingPoint>& points, const std::optional<ScalingFit>& wall_time_fit,
+    const std::optional<ScalingFit>& time_per_event_fit) noexcept {
+  std::string json{"{\n  \"points\": [\n"};
+  char buffer[512];
+  for (std::size_t index = 0; index < points.size(); ++index) {
+    const ScalingPoint& point = points[index];
+    std::snprintf(
+        buffer, sizeof(buffer),
+        "    {\"vehicles\": %lld, \"charging_stations\": %lld, \"simulated_hours\": %.6g, "
+        "\"wall_seconds\": %.6g, \"events\": %llu, \"time_steps\": %llu, "
+        "\"events_per_second\": %.6g, \"wall_seconds_per_simulated_hour\": %.6g, "
+        "\"peak_resident_bytes\": %llu, \"bytes_per_vehicle\": %.6g, \"truncated\": %s}%s\n",
+        static_cast<long long>(point.vehicles), static_cast<long long>(point.charging_stations),
+        point.simulated_hours, point.wall_seconds, static_cast<unsigned long long>(point.events),
+        static_cast<unsigned long long>(point.time_steps), point.events_per_second,
+        point.wall_seconds_per_simulated_hour,
+        static_cast<unsigned long long>(point.peak_resident_bytes), point.bytes_per_vehicle,
+        point.truncated ? "true" : "false", index + 1 < points.size() ? "," : "");
+    json += buffer;
+  }
+  json += "  ]";
+  const auto append_fit = [&](const char* const name, const std::optional<ScalingFit>& fit) {
+    if (fit.has_value()) {
+      std::snprintf(buffer, sizeof(buffer),
+                    ",\n  \"%s\": {\"coefficient\": %.6g, \"vehicle_exponent\": %.4f, "
+                    "\"charging_station_exponent\": %.4f, \"r_squared\": %.4f}",
+                    name, fit->coefficient, fit->vehicle_exponent, fit->charging_station_exponent,
+                    fit->r_squared);
+      json += buffer;
+    }
+  };
+  append_fit("wall_time_fit", wall_time_fit);
+  append_fit("time_per_event_fit", time_per_event_fit);
+  json += "\n}\n";
+  return json;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_SCALING_STUDY_HPP
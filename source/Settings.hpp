@@ -25,13 +25,17 @@
 
 #include <cstdlib>
 #include <filesystem>
-#include <iostream>
 #include <optional>
 #include <PhQ/Time.hpp>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "Arguments.hpp"
+#include "FleetComposition.hpp"
+#include "FlightRecorder.hpp"
+#include "Logger.hpp"
+#include "LogLevel.hpp"
 #include "Program.hpp"
 #include "String.hpp"
 
@@ -43,9 +47,11 @@ public:
   // Constructs settings with all parameters initialized to zero.
   Settings() noexcept = default;
 
-  // Constructs settings from command-line arguments.
+  // Constructs settings from command-line arguments and configures the program's logger
+  // accordingly.
   Settings(const int argc, char* argv[]) noexcept : executable_name_(argv[0]) {
     ParseArguments(argc, argv);
+    ConfigureLogger();
     PrintHeader();
     PrintCommand();
     PrintSettings();
@@ -66,6 +72,36 @@ public:
     return duration_;
   }
 
+  // Relative weights of the vehicle models of the fleet, in the order of the vehicle models, or an
+  // empty list, in which case each vehicle model is equally likely.
+  const std::vector<double>& FleetMix() const noexcept {
+    return fleet_mix_;
+  }
+
+  // Whether the number of vehicles of each vehicle model exactly follows the fleet mix rather than
+  // being drawn at random.
+  constexpr bool FleetMixExact() const noexcept {
+    return fleet_mix_exact_;
+  }
+
+  // Number of threads used to construct the fleet, or zero, in which case one thread per hardware
+  // thread is used. The fleet does not depend on the number of threads.
+  constexpr std::size_t Threads() const noexcept {
+    return threads_;
+  }
+
+  // Path to the CSV or binary roster file of the fleet, or an empty path if the fleet is randomly
+  // generated.
+  const std::filesystem::path& Roster() const noexcept {
+    return roster_;
+  }
+
+  // Path to the CSV catalog file of the vehicle models, or an empty path if the sample vehicle
+  // models are used.
+  const std::filesystem::path& VehicleModelCatalog() const noexcept {
+    return vehicle_model_catalog_;
+  }
+
   const std::filesystem::path& Results() const noexcept {
     return results_;
   }
@@ -76,23 +112,82 @@ public:
     return seed_;
   }
 
+  // Path to the log file, or an empty path if log messages are written to the console.
+  const std::filesystem::path& LogFile() const noexcept {
+    return log_file_;
+  }
+
+  // Level of the log messages that are emitted.
+  constexpr Demo::LogLevel LogLevel() const noexcept {
+    return log_level_;
+  }
+
+  // Maximum sustained number of informational log messages per second, or zero if unlimited.
+  constexpr double LogRateLimit() const noexcept {
+    return log_rate_limit_;
+  }
+
+  // Path to the binary event trace file, or an empty path if no event trace is recorded.
+  const std::filesystem::path& Trace() const noexcept {
+    return trace_;
+  }
+
+  // One in every this number of vehicles is sampled in the binary event trace.
+  constexpr int64_t TraceSampling() const noexcept {
+    return trace_sampling_;
+  }
+
+  // Path to the binary transition log file, or an empty path if no transition log is recorded.
+  const std::filesystem::path& TransitionLog() const noexcept {
+    return transition_log_;
+  }
+
+  // Path to the flight recorder file, or an empty path if the flight recorder is disabled.
+  const std::filesystem::path& FlightRecorder() const noexcept {
+    return flight_recorder_;
+  }
+
+  // Number of most recent events kept by the flight recorder.
+  constexpr int64_t FlightRecorderCapacity() const noexcept {
+    return flight_recorder_capacity_;
+  }
+
+  // Path to the Chrome trace event timeline file, or an empty path if no timeline is recorded.
+  const std::filesystem::path& Timeline() const noexcept {
+    return timeline_;
+  }
+
+  // Path to the hardware performance counters report file, or an empty path if the hardware
+  // performance counters are not measured.
+  const std::filesystem::path& PerfCounters() const noexcept {
+    return perf_counters_;
+  }
+
 private:
-  // Prints the program header information to the console.
+  // Prints the program header information.
   void PrintHeader() const noexcept {
-    std::cout << Program::Title << std::endl;
-    std::cout << Program::Description << std::endl;
-    std::cout << "Version: " << Program::CompilationDateAndTime << std::endl;
+    Log(Demo::LogLevel::Information) << Program::Title;
+    Log(Demo::LogLevel::Information) << Program::Description;
+    Log(Demo::LogLevel::Information) << "Version: " << Program::CompilationDateAndTime;
   }
 
-  // Prints the program usage information to the console.
+  // Prints the program usage information.
   void PrintUsage() const noexcept {
     const std::string indent{"  "};
 
-    std::cout << "Usage:" << std::endl;
+    Log(Demo::LogLevel::Information) << "Usage:";
 
-    std::cout << indent << executable_name_ << " " << Arguments::VehiclesPattern << " "
-              << Arguments::ChargingStationsPattern << " " << Arguments::DurationPattern << " ["
-              << Arguments::ResultsPattern << "] [" << Arguments::SeedPattern << "]" << std::endl;
+    Log(Demo::LogLevel::Information)
+        << indent << executable_name_ << " " << Arguments::VehiclesPattern << " "
+        << Arguments::ChargingStationsPattern << " " << Arguments::DurationPattern << " ["
+        << Arguments::FleetMixPattern << "] [" << Arguments::FleetMixExactKey << "] ["
+        << Arguments::ThreadsPattern << "] [" << Arguments::RosterPattern << "] ["
+        << Arguments::VehicleModelsPattern << "] [" << Arguments::ResultsPattern << "] [" << Arguments::SeedPattern << "] ["
+        << Arguments::LogFilePattern << "] [" << Arguments::LogLevelPattern << "] ["
+        << Arguments::LogRateLimitPattern << "] [" << Arguments::TracePattern << "] ["
+        << Arguments::TraceSamplingPattern << "] [" << Arguments::TransitionLogPattern << "] ["
+        << Arguments::FlightRecorderPattern << "] [" << Arguments::FlightRecorderCapacityPattern
+        << "] [" << Arguments::TimelinePattern << "] [" << Arguments::PerfCountersPattern << "]";
 
     // Compute the padding length of the argument patterns.
     const std::size_t length{std::max({
@@ -100,29 +195,117 @@ private:
         Arguments::VehiclesPattern.length(),
         Arguments::ChargingStationsPattern.length(),
         Arguments::DurationPattern.length(),
+        Arguments::FleetMixPattern.length(),
+        Arguments::FleetMixExactKey.length(),
+        Arguments::ThreadsPattern.length(),
+        Arguments::RosterPattern.length(),
+        Arguments::VehicleModelsPattern.length(),
         Arguments::ResultsPattern.length(),
         Arguments::SeedPattern.length(),
+        Arguments::LogFilePattern.length(),
+        Arguments::LogLevelPattern.length(),
+        Arguments::LogRateLimitPattern.length(),
+        Arguments::TracePattern.length(),
+        Arguments::TraceSamplingPattern.length(),
+        Arguments::TransitionLogPattern.length(),
+        Arguments::FlightRecorderPattern.length(),
+        Arguments::FlightRecorderCapacityPattern.length(),
+        Arguments::TimelinePattern.length(),
+        Arguments::PerfCountersPattern.length(),
     })};
 
-    std::cout << "Arguments:" << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::Help, length) << indent
-              << "Displays this information and exits." << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::VehiclesPattern, length) << indent
-              << "Number of vehicles in the simulation. Required." << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::ChargingStationsPattern, length) << indent
-              << "Number of charging stations in the simulation. Required." << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::DurationPattern, length) << indent
-              << "Time duration of the simulation in hours. Required." << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::ResultsPattern, length) << indent
-              << "Path to the results file to be written. Optional." << std::endl;
-
-    std::cout << indent << PadToLength(Arguments::SeedPattern, length) << indent
-              << "Seed value for pseudo-random number generation. Optional." << std::endl;
+    Log(Demo::LogLevel::Information) << "Arguments:";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::Help, length) << indent
+        << "Displays this information and exits.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::VehiclesPattern, length) << indent
+        << "Number of vehicles in the simulation. Required.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::ChargingStationsPattern, length) << indent
+        << "Number of charging stations in the simulation. Required.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::DurationPattern, length) << indent
+        << "Time duration of the simulation in hours. Required.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::FleetMixPattern, length) << indent
+        << "Comma-separated relative weights of the vehicle models, such as 60,20,10,5,5. "
+           "Optional. If omitted, each vehicle model is equally likely.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::FleetMixExactKey, length) << indent
+        << "Generates exactly the fleet mix's share of vehicles of each vehicle model. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::ThreadsPattern, length) << indent
+        << "Number of threads used to construct the fleet. Optional. Defaults to one per hardware "
+           "thread.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::RosterPattern, length) << indent
+        << "Path to a CSV or binary roster of the fleet's vehicles. Optional. If given, the fleet "
+           "is loaded from it instead of being randomly generated.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::VehicleModelsPattern, length) << indent
+        << "Path to a CSV catalog of the vehicle models. Optional. If omitted, the sample vehicle "
+           "models are used.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::ResultsPattern, length) << indent
+        << "Path to the results file to be written. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::SeedPattern, length) << indent
+        << "Seed value for pseudo-random number generation. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::LogFilePattern, length) << indent
+        << "Path to the log file to be written. Optional. If omitted, logs to the console.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::LogLevelPattern, length) << indent
+        << "Log level: error, warning, information, or debug. Optional. Defaults to information.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::LogRateLimitPattern, length) << indent
+        << "Maximum number of informational log messages per second. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::TracePattern, length) << indent
+        << "Path to the binary event trace file to be written. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::TraceSamplingPattern, length) << indent
+        << "Records the events of one in every this number of vehicles. Optional. Defaults to 1.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::TransitionLogPattern, length) << indent
+        << "Path to the binary transition log file to be written for replay. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::FlightRecorderPattern, length) << indent
+        << "Path to the flight recorder file of the most recent events. Optional.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::FlightRecorderCapacityPattern, length) << indent
+        << "Number of most recent events kept by the flight recorder. Optional. At most "
+        << MaximumFlightRecorderCapacity << ".";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::TimelinePattern, length) << indent
+        << "Path to the Chrome trace event timeline file to be written. Optional. Requires a "
+           "build configured with -DDEMO_PROFILE=ON.";
+
+    Log(Demo::LogLevel::Information)
+        << indent << PadToLength(Arguments::PerfCountersPattern, length) << indent
+        << "Path to the hardware performance counters report to be written. Optional. Requires a "
+           "build configured with -DDEMO_PROFILE=ON.";
   }
 
   // Parses the command-line arguments.
@@ -150,15 +333,77 @@ private:
       } else if (argv[index] == Arguments::DurationKey && AtLeastOneMoreArgument(index, argc)) {
         duration_ = {std::max(std::atof(argv[index + 1]), 0.0), PhQ::Unit::Time::Hour};
         ++index;
+      } else if (argv[index] == Arguments::FleetMixKey && AtLeastOneMoreArgument(index, argc)
+                 && ParseWeights(argv[index + 1]).has_value()) {
+        fleet_mix_ = ParseWeights(argv[index + 1]).value();
+        ++index;
+      } else if (argv[index] == Arguments::FleetMixExactKey) {
+        fleet_mix_exact_ = true;
+      } else if (argv[index] == Arguments::ThreadsKey && AtLeastOneMoreArgument(index, argc)) {
+        threads_ = static_cast<std::size_t>(std::max<int64_t>(std::atoll(argv[index + 1]), 0));
+        ++index;
+      } else if (argv[index] == Arguments::RosterKey && AtLeastOneMoreArgument(index, argc)) {
+        roster_ = argv[index + 1];
+        ++index;
+      } else if (argv[index] == Arguments::VehicleModelsKey
+                 && AtLeastOneMoreArgument(index, argc)) {
+        vehicle_model_catalog_ = argv[index + 1];
+        ++index;
       } else if (argv[index] == Arguments::ResultsKey && AtLeastOneMoreArgument(index, argc)) {
         results_ = argv[index + 1];
         ++index;
       } else if (argv[index] == Arguments::SeedKey && AtLeastOneMoreArgument(index, argc)) {
         seed_ = std::atoi(argv[index + 1]);
         ++index;
+      } else if (argv[index] == Arguments::LogFileKey && AtLeastOneMoreArgument(index, argc)) {
+        log_file_ = argv[index + 1];
+        ++index;
+      } else if (argv[index] == Arguments::LogLevelKey && AtLeastOneMoreArgument(index, argc)
+                 && ParseLogLevel(argv[index + 1]).has_value()) {
+        log_level_ = ParseLogLevel(argv[index + 1]).value();
+        ++index;
+      } else if (
+          argv[index] == Arguments::LogRateLimitKey && AtLeastOneMoreArgument(index, argc)) {
+        log_rate_limit_ = std::max(std::atof(argv[index + 1]), 0.0);
+        ++index;
+      } else if (argv[index] == Arguments::TraceKey && AtLeastOneMoreArgument(index, argc)) {
+        trace_ = argv[index + 1];
+        ++index;
+      } else if (
+          argv[index] == Arguments::TraceSamplingKey && AtLeastOneMoreArgument(index, argc)) {
+        trace_sampling_ = std::max<int64_t>(std::atoll(argv[index + 1]), 1);
+        ++index;
+      } else if (
+          argv[index] == Arguments::TransitionLogKey && AtLeastOneMoreArgument(index, argc)) {
+        transition_log_ = argv[index + 1];
+        ++index;
+      } else if (
+          argv[index] == Arguments::FlightRecorderKey && AtLeastOneMoreArgument(index, argc)) {
+        flight_recorder_ = argv[index + 1];
+        ++index;
+      } else if (argv[index] == Arguments::FlightRecorderCapacityKey
+                 && AtLeastOneMoreArgument(index, argc)) {
+        flight_recorder_capacity_ =
+            std::max<int64_t>(std::strtoll(argv[index + 1], nullptr, 10), 1);
+        if (static_cast<uint64_t>(flight_recorder_capacity_) > MaximumFlightRecorderCapacity) {
+          PrintHeader();
+          Log(Demo::LogLevel::Error)
+              << "The flight recorder capacity must not exceed " << MaximumFlightRecorderCapacity
+              << " entries: " << argv[index + 1];
+          PrintUsage();
+          exit(EXIT_FAILURE);
+        }
+        ++index;
+      } else if (argv[index] == Arguments::TimelineKey && AtLeastOneMoreArgument(index, argc)) {
+        timeline_ = argv[index + 1];
+        ++index;
+      } else if (
+          argv[index] == Arguments::PerfCountersKey && AtLeastOneMoreArgument(index, argc)) {
+        perf_counters_ = argv[index + 1];
+        ++index;
       } else {
         PrintHeader();
-        std::cout << "Unrecognized argument: " << argv[index] << std::endl;
+        Log(Demo::LogLevel::Error) << "Unrecognized argument: " << argv[index];
         PrintUsage();
         exit(EXIT_FAILURE);
       }
@@ -170,39 +415,134 @@ private:
     return index + 1 < argument_count;
   }
 
-  // Prints the command to the console.
+  // Configures the program's logger according to these settings.
+  void ConfigureLogger() const noexcept {
+    Logger& logger = GlobalLogger();
+    logger.SetLevel(log_level_);
+    if (log_rate_limit_ > 0.0) {
+      logger.SetRateLimit(Demo::LogLevel::Information, log_rate_limit_, LogRateLimitBurst);
+      logger.SetRateLimit(Demo::LogLevel::Debug, log_rate_limit_, LogRateLimitBurst);
+    }
+    if (!log_file_.empty() && !logger.SetFile(log_file_)) {
+      Log(Demo::LogLevel::Error) << "Could not open the log file: " << log_file_.string();
+    }
+  }
+
+  // Prints the command.
   void PrintCommand() const noexcept {
-    std::cout
+    Log(Demo::LogLevel::Information)
         << "Command: " << executable_name_ << " " << Arguments::VehiclesKey << " " << vehicles_
         << " " << Arguments::ChargingStationsKey << " " << charging_stations_ << " "
         << Arguments::DurationKey << " " << duration_.Value(PhQ::Unit::Time::Hour)
+        << (!fleet_mix_.empty() ? " " + Arguments::FleetMixKey + " " + PrintWeights() : "")
+        << (fleet_mix_exact_ ? " " + Arguments::FleetMixExactKey : "")
+        << (threads_ > 0 ? " " + Arguments::ThreadsKey + " " + std::to_string(threads_) : "")
+        << (!roster_.empty() ? " " + Arguments::RosterKey + " " + roster_.string() : "")
+        << (!vehicle_model_catalog_.empty() ?
+                " " + Arguments::VehicleModelsKey + " " + vehicle_model_catalog_.string() :
+                "")
         << (!results_.empty() ? " " + Arguments::ResultsKey + " " + results_.string() : "")
         << (seed_.has_value() ? " " + Arguments::SeedKey + " " + std::to_string(seed_.value()) : "")
-        << std::endl;
+        << (!log_file_.empty() ? " " + Arguments::LogFileKey + " " + log_file_.string() : "")
+        << (log_level_ != Demo::LogLevel::Information ?
+                " " + Arguments::LogLevelKey + " " + std::string{LogLevelName(log_level_)} :
+                "")
+        << (log_rate_limit_ > 0.0 ?
+                " " + Arguments::LogRateLimitKey + " " + std::to_string(log_rate_limit_) :
+                "")
+        << (!trace_.empty() ? " " + Arguments::TraceKey + " " + trace_.string() : "")
+        << (trace_sampling_ != 1 ?
+                " " + Arguments::TraceSamplingKey + " " + std::to_string(trace_sampling_) :
+                "")
+        << (!transition_log_.empty() ?
+                " " + Arguments::TransitionLogKey + " " + transition_log_.string() :
+                "")
+        << (!flight_recorder_.empty() ?
+                " " + Arguments::FlightRecorderKey + " " + flight_recorder_.string() :
+                "")
+        << (flight_recorder_capacity_ != DefaultFlightRecorderCapacity ?
+                " " + Arguments::FlightRecorderCapacityKey + " "
+                    + std::to_string(flight_recorder_capacity_) :
+                "")
+        << (!timeline_.empty() ? " " + Arguments::TimelineKey + " " + timeline_.string() : "")
+        << (!perf_counters_.empty() ?
+                " " + Arguments::PerfCountersKey + " " + perf_counters_.string() :
+                "");
   }
 
-  // Prints the settings to the console.
+  // Prints the settings.
   void PrintSettings() const noexcept {
-    std::cout << "- The number of vehicles in the simulation is: " << vehicles_ << std::endl;
-    std::cout << "- The number of charging stations in the simulation is: " << charging_stations_
-              << std::endl;
-    std::cout << "- The time duration of the simulation is: "
-              << duration_.Print(PhQ::Unit::Time::Hour) << std::endl;
+    Log(Demo::LogLevel::Information)
+        << "- The number of vehicles in the simulation is: " << vehicles_;
+    Log(Demo::LogLevel::Information)
+        << "- The number of charging stations in the simulation is: " << charging_stations_;
+    Log(Demo::LogLevel::Information)
+        << "- The time duration of the simulation is: " << duration_.Print(PhQ::Unit::Time::Hour);
+    if (!fleet_mix_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The relative weights of the vehicle models are: " << PrintWeights()
+          << (fleet_mix_exact_ ? " (exact)" : " (sampled)");
+    }
+    if (!roster_.empty()) {
+      Log(Demo::LogLevel::Information) << "- The fleet will be loaded from the roster: " << roster_;
+    }
+    if (!vehicle_model_catalog_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The vehicle models will be read from the catalog: " << vehicle_model_catalog_;
+    }
     if (results_.empty()) {
-      std::cout << "- The simulation results will not be written to a file." << std::endl;
+      Log(Demo::LogLevel::Information)
+          << "- The simulation results will not be written to a file.";
     } else {
-      std::cout << "- The simulation results will be written to: " << results_ << std::endl;
+      Log(Demo::LogLevel::Information)
+          << "- The simulation results will be written to: " << results_;
     }
     if (seed_.has_value()) {
-      std::cout << "- The seed value for pseudo-random number generation is : " << seed_.value()
-                << std::endl;
+      Log(Demo::LogLevel::Information)
+          << "- The seed value for pseudo-random number generation is : " << seed_.value();
     } else {
-      std::cout << "- The seed value for random number generation will be "
-                   "randomized."
-                << std::endl;
+      Log(Demo::LogLevel::Information)
+          << "- The seed value for random number generation will be randomized.";
+    }
+    if (!trace_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The binary event trace will be written to: " << trace_ << " (one in every "
+          << trace_sampling_ << " vehicles)";
+    }
+    if (!transition_log_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The binary transition log will be written to: " << transition_log_;
+    }
+    if (!flight_recorder_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The flight recorder will keep the last " << flight_recorder_capacity_
+          << " events in: " << flight_recorder_;
     }
+    if (!timeline_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The timeline of the simulation phases will be written to: " << timeline_;
+    }
+    if (!perf_counters_.empty()) {
+      Log(Demo::LogLevel::Information)
+          << "- The hardware performance counters of the simulation phases will be written to: "
+          << perf_counters_;
+    }
+  }
+
+  // Prints the fleet mix as a comma-separated list of weights.
+  std::string PrintWeights() const noexcept {
+    std::string text;
+    for (std::size_t index = 0; index < fleet_mix_.size(); ++index) {
+      std::ostringstream stream;
+      stream << fleet_mix_[index];
+      text += (index > 0 ? "," : "") + stream.str();
+    }
+    return text;
   }
 
+  // Number of informational log messages that may be emitted in a burst when rate limiting.
+  static constexpr std::size_t LogRateLimitBurst = 100;
+
   std::string executable_name_;
 
   int32_t vehicles_ = 0;
@@ -211,9 +551,39 @@ private:
 
   PhQ::Time<> duration_ = PhQ::Time<>::Zero();
 
+  std::vector<double> fleet_mix_;
+
+  bool fleet_mix_exact_ = false;
+
+  std::size_t threads_ = 0;
+
+  std::filesystem::path roster_;
+
+  std::filesystem::path vehicle_model_catalog_;
+
   std::filesystem::path results_;
 
   std::optional<int64_t> seed_;
+
+  std::filesystem::path log_file_;
+
+  Demo::LogLevel log_level_ = Demo::LogLevel::Information;
+
+  double log_rate_limit_ = 0.0;
+
+  std::filesystem::path trace_;
+
+  int64_t trace_sampling_ = 1;
+
+  std::filesystem::path transition_log_;
+
+  std::filesystem::path flight_recorder_;
+
+  int64_t flight_recorder_capacity_ = DefaultFlightRecorderCapacity;
+
+  std::filesystem::path timeline_;
+
+  std::filesystem::path perf_counters_;
 };
 
 }  // namespace Demo
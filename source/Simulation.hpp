@@ -23,96 +23,245 @@
 #ifndef DEMO_INCLUDE_SIMULATION_HPP
 #define DEMO_INCLUDE_SIMULATION_HPP
 
-#include <map>
+#include <algorithm>
 #include <random>
+#include <utility>
 
+#include "BatchSampler.hpp"
 #include "ChargingStations.hpp"
+#include "FleetState.hpp"
+#include "Profiler.hpp"
+#include "SimulationObserver.hpp"
 #include "Statistics.hpp"
 #include "Vehicles.hpp"
 
 namespace Demo {
 
-// A vehicle fleet simulation.
+// A vehicle fleet simulation. The simulation is advanced incrementally by calling Run, RunUntil, or
+// StepEvents. Events such as takeoffs, landings, and charging sessions are reported to an observer
+// of the given type, which is dispatched statically. The default observer ignores all events.
+template <typename ObserverType = SimulationObserver>
 class Simulation {
 public:
-  // Constructs and runs a simulation.
+  // Constructs a simulation of a given time duration over a given collection of vehicles and
+  // charging stations. Does not run the simulation. The given vehicles and charging stations must
+  // outlive this simulation. The faults of the vehicles are drawn from a batch sampler seeded by
+  // one draw of the given random generator.
   Simulation(const PhQ::Time<>& duration, Vehicles& vehicles, ChargingStations& charging_stations,
-             std::mt19937_64& random_generator) noexcept {
-    if (elapsed_time_ < duration) {
-      std::cout << "Time steps:" << std::endl;
-    }
+             std::mt19937_64& random_generator, ObserverType observer = ObserverType()) noexcept
+    : duration_(duration), vehicles_(vehicles), charging_stations_(charging_stations),
+      fault_sampler_(random_generator), observer_(std::move(observer)) {}
 
-    while (elapsed_time_ < duration) {
-      time_step_ = ComputeTimeStep(duration, vehicles);
+  // Total time duration of this simulation.
+  const PhQ::Time<>& Duration() const noexcept {
+    return duration_;
+  }
 
-      if (time_step_ <= PhQ::Time<>::Zero()) {
-        break;
-      }
+  // Current number of time steps in this simulation.
+  std::size_t TimeStepCount() const noexcept {
+    return time_step_count_;
+  }
 
-      ++time_step_count_;
+  // Most recent time step of this simulation.
+  const PhQ::Time<>& TimeStep() const noexcept {
+    return time_step_;
+  }
 
-      elapsed_time_ += time_step_;
+  // Current elapsed time in this simulation.
+  const PhQ::Time<>& ElapsedTime() const noexcept {
+    return elapsed_time_;
+  }
 
-      PrintTimeStepInformation();
+  // Returns whether this simulation has finished, either because its time duration has elapsed or
+  // because no further progress can be made.
+  bool Finished() const noexcept {
+    return stalled_ || elapsed_time_ >= duration_;
+  }
+
+  // Observer of this simulation.
+  const ObserverType& Observer() const noexcept {
+    return observer_;
+  }
+
+  // Observer of this simulation.
+  ObserverType& MutableObserver() noexcept {
+    return observer_;
+  }
+
+  // Runs this simulation until it finishes. Returns the number of time steps performed.
+  std::size_t Run() noexcept {
+    return RunUntil(duration_);
+  }
 
-      RunTimeStep(vehicles, charging_stations, random_generator);
+  // Runs this simulation until a given elapsed time is reached or until the simulation finishes,
+  // whichever happens first. Time steps are shortened as needed so that the given elapsed time is
+  // never exceeded. Returns the number of time steps performed.
+  std::size_t RunUntil(const PhQ::Time<>& time) noexcept {
+    const PhQ::Time limit = std::min(time, duration_);
+    std::size_t count = 0;
+    while (!Finished() && elapsed_time_ < limit && Step(limit)) {
+      ++count;
     }
+    FlushFleetState();
+    return count;
+  }
+
+  // Performs up to a given number of time steps. Each time step advances this simulation to its
+  // next event, which is the next status change of any vehicle. Returns the number of time steps
+  // performed, which is less than the given number if the simulation finishes first. The vehicles
+  // are brought up to date once per call rather than once per time step, so performing many time
+  // steps per call is cheaper.
+  std::size_t StepEvents(const std::size_t count) noexcept {
+    std::size_t performed = 0;
+    while (performed < count && !Finished() && Step(duration_)) {
+      ++performed;
+    }
+    FlushFleetState();
+    return performed;
+  }
+
+  // Brings a given vehicle into service at the current elapsed time, between two time steps. The
+  // vehicle takes part in the next time step. Returns true if the vehicle was successfully
+  // inserted, or false if it is nullptr or if its vehicle ID is already in service.
+  bool Commission(const std::shared_ptr<Vehicle> vehicle) noexcept {
+    return vehicles_.Insert(vehicle);
+  }
+
+  // Withdraws the vehicle of a given vehicle ID from service at the current elapsed time, between
+  // two time steps. If it is flying, it first lands, so that its flight ends. If it is charging or
+  // waiting to charge, it first leaves its charging station, so that no charging station queue
+  // refers to it afterwards. The vehicle keeps its statistics and
+  // battery, so the same vehicle can later be commissioned again. Until then, it stays among the
+  // retired vehicles of the fleet, so its statistics still count towards the aggregate statistics.
+  // Returns the withdrawn vehicle, or nullptr if that vehicle ID is not in service.
+  std::shared_ptr<Vehicle> Retire(const VehicleId id) noexcept {
+    const std::shared_ptr<Vehicle> vehicle = vehicles_.At(id);
+
+    if (vehicle == nullptr) {
+      return nullptr;
+    }
+
+    vehicle->Withdraw(charging_stations_, elapsed_time_, observer_);
+    vehicles_.Remove(id);
+
+    return vehicle;
   }
 
 private:
-  // Prints the current time step information to the console.
-  void PrintTimeStepInformation() const noexcept {
-    std::cout << "- Time step " << time_step_count_
-              << ": increment = " << time_step_.Print(PhQ::Unit::Time::Minute)
-              << ", elapsed = " << elapsed_time_.Print(PhQ::Unit::Time::Minute) << std::endl;
-  }
-
-  // Runs the current time step of this simulation. TODO: Consider using multithreading to operate
-  // on all vehicles in parallel, and make sure the relevant operations are performed atomically
-  // when appropriate.
-  void RunTimeStep(Vehicles& vehicles, ChargingStations& charging_stations,
-                   std::mt19937_64& random_generator) noexcept {
-    // Update all vehicles at the beginning of the time step.
-    UpdateAllVehicles(vehicles, charging_stations);
-
-    // Perform the time step on each vehicle.
-    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
-      if (vehicle != nullptr) {
-        vehicle->PerformTimeStep(time_step_, charging_stations, random_generator);
-      }
+  // Performs one time step without exceeding a given elapsed time. Returns false if no time step
+  // could be performed because the simulation cannot progress any further.
+  bool Step(const PhQ::Time<>& limit) noexcept {
+    time_step_ = ComputeTimeStep(limit);
+
+    if (time_step_ <= PhQ::Time<>::Zero()) {
+      DEMO_PROFILE_COUNT(ZeroLengthSteps, 1);
+      stalled_ = elapsed_time_ < limit;
+      return false;
     }
 
-    // Update all vehicles at the end of the time step.
-    UpdateAllVehicles(vehicles, charging_stations);
+    ++time_step_count_;
+    DEMO_PROFILE_COUNT(Steps, 1);
+
+    const PhQ::Time start_time = elapsed_time_;
+
+    elapsed_time_ += time_step_;
+
+    observer_.OnTimeStep(time_step_count_, time_step_, elapsed_time_);
+
+    RunTimeStep(start_time);
+
+    return true;
   }
 
-  // Updates all vehicles either at the beginning or at the end of a time step.
-  void UpdateAllVehicles(Vehicles& vehicles, ChargingStations& charging_stations) noexcept {
-    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
-      if (vehicle != nullptr) {
-        vehicle->Update(charging_stations);
+  // Runs the current time step of this simulation, which begins at a given time. TODO: Consider
+  // using multithreading to operate on all vehicles in parallel, and make sure the relevant
+  // operations are performed atomically when appropriate.
+  void RunTimeStep(const PhQ::Time<>& start_time) noexcept {
+    // Select the vehicles whose status may change during this time step. The status of every other
+    // vehicle is unaffected by the updates, so only the selected vehicles are updated, and every
+    // other vehicle flies or charges throughout the time step.
+    fleet_state_.Select(time_step_.Value());
+
+    // Update the selected vehicles at the beginning of the time step.
+    {
+      DEMO_PROFILE_SCOPE(UpdateVehiclesAtStart);
+      UpdateSelectedVehicles(start_time);
+    }
+
+    // Perform the time step on each selected vehicle, and on every other vehicle in bulk.
+    {
+      DEMO_PROFILE_SCOPE(PerformTimeStep);
+      const std::size_t count = fleet_state_.SelectedCount();
+      for (std::size_t position = 0; position < count; ++position) {
+        fleet_state_.Selected(position).PerformTimeStep(
+            time_step_, charging_stations_, fault_sampler_, start_time, observer_);
       }
+      DEMO_PROFILE_COUNT(VehiclesTouched, count);
+      fleet_state_.Advance(time_step_.Value(), fault_sampler_, start_time, observer_);
+    }
+
+    // Update the selected vehicles at the end of the time step.
+    {
+      DEMO_PROFILE_SCOPE(UpdateVehiclesAtEnd);
+      UpdateSelectedVehicles(elapsed_time_);
     }
+
+    fleet_state_.Deselect();
   }
 
-  // Computes the largest possible time step given the states of all the vehicles.
-  PhQ::Time<> ComputeTimeStep(
-      const PhQ::Time<>& duration, const Vehicles& vehicles) const noexcept {
-    PhQ::Time time_step = duration - elapsed_time_;
+  // Updates the vehicles selected for the current time step, in the order of the fleet, either at
+  // the beginning or at the end of the time step.
+  void UpdateSelectedVehicles(const PhQ::Time<>& time) noexcept {
+    const std::size_t count = fleet_state_.SelectedCount();
+    for (std::size_t position = 0; position < count; ++position) {
+      fleet_state_.Selected(position).Update(charging_stations_, time, observer_);
+    }
+    DEMO_PROFILE_COUNT(VehiclesUpdated, count);
+  }
 
-    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
-      if (vehicle != nullptr) {
-        const PhQ::Time vehicle_time_step = vehicle->DurationToNextStatusChange();
+  // Computes the largest possible time step given the states of all the vehicles and a given
+  // elapsed time that must not be exceeded. The states of all vehicles are gathered into contiguous
+  // arrays only when vehicles were commissioned or retired since the last time step, and the time
+  // duration to each vehicle's next status change and its minimum are computed from these arrays.
+  PhQ::Time<> ComputeTimeStep(const PhQ::Time<>& limit) noexcept {
+    DEMO_PROFILE_SCOPE(ComputeTimeStep);
 
-        if (vehicle_time_step < time_step) {
-          time_step = vehicle_time_step;
-        }
-      }
+    if (!fleet_state_.Current(vehicles_)) {
+      fleet_state_.Gather(vehicles_);
     }
 
-    return time_step;
+    return PhQ::Time<>(
+        fleet_state_.Reduce((limit - elapsed_time_).Value()), PhQ::Unit::Time::Second);
+  }
+
+  // Brings the vehicles up to date with the state of the fleet accumulated over the time steps, so
+  // that they can be inspected, commissioned, or retired between calls. During the time steps, only
+  // the vehicles passed to the observer are up to date, as documented by SimulationObserver.
+  void FlushFleetState() noexcept {
+    if (fleet_state_.Current(vehicles_)) {
+      fleet_state_.Flush();
+    }
   }
 
+  // Total time duration of the simulation.
+  PhQ::Time<> duration_ = PhQ::Time<>::Zero();
+
+  // Vehicles in the simulation.
+  Vehicles& vehicles_;
+
+  // Charging stations in the simulation.
+  ChargingStations& charging_stations_;
+
+  // Sampler from which the faults of the vehicles are drawn. Its uniform variates are generated in
+  // bulk for the whole fleet.
+  BatchSampler fault_sampler_;
+
+  // Observer of the simulation's events.
+  ObserverType observer_;
+
+  // Whether the simulation stopped early because no vehicle can make any further progress.
+  bool stalled_ = false;
+
   // Current number of time steps in the simulation.
   std::size_t time_step_count_ = 0;
 
@@ -121,6 +270,9 @@ private:
 
   // Current elapsed time in the simulation.
   PhQ::Time<> elapsed_time_ = PhQ::Time<>::Zero();
+
+  // State of the vehicles of the simulation that persists across time steps.
+  FleetState fleet_state_;
 };
 
 }  // namespace Demo
@@ -0,0 +1,78 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_SIMULATION_OBSERVER_HPP
+#define DEMO_INCLUDE_SIMULATION_OBSERVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <PhQ/Time.hpp>
+
+namespace Demo {
+
+class Vehicle;
+
+// Observer of a vehicle fleet simulation that ignores all events. This is the default observer of a
+// simulation. Custom observers derive from this class and hide the methods corresponding to the
+// events that they are interested in. Observers are dispatched statically: the simulation calls the
+// methods of its observer type directly, so these empty methods are inlined away and an unobserved
+// simulation pays nothing for them.
+// The vehicle passed to a method is up to date when the method is called: its status, battery, and
+// statistics are those at that point of the simulation. Other vehicles of the fleet are not: during
+// a call to Simulation::Run, RunUntil, or StepEvents, a vehicle that flies or charges throughout a
+// time step keeps its state in the fleet state of the simulation, which is written back to its
+// object only when the vehicle next changes status or faults, or when that call returns. Observers
+// must therefore only inspect the vehicle passed to them, and inspect the rest of the fleet between
+// calls.
+class SimulationObserver {
+public:
+  // Called when a time step of the simulation begins. The given elapsed time is the time at the end
+  // of this time step. The vehicles are not necessarily up to date when this method is called.
+  void OnTimeStep(const std::size_t /*time_step_count*/, const PhQ::Time<>& /*time_step*/,
+                  const PhQ::Time<>& /*elapsed_time*/) noexcept {}
+
+  // Called when a vehicle takes off at a given time.
+  void OnTakeoff(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {}
+
+  // Called when a vehicle lands at a given time.
+  void OnLanding(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {}
+
+  // Called when a vehicle enqueues at a charging station at a given time. The vehicle's charging
+  // station ID is set when this method is called.
+  void OnEnqueue(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {}
+
+  // Called when a vehicle begins charging at its charging station at a given time.
+  void OnChargeStart(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {}
+
+  // Called when a vehicle finishes charging at a given time, just before it dequeues from its
+  // charging station. The vehicle's charging station ID is still set when this method is called.
+  void OnChargeEnd(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {}
+
+  // Called when one or more faults occur in a vehicle during a time step that begins at a given
+  // time.
+  void OnFault(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/,
+               const int64_t /*fault_count*/) noexcept {}
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_SIMULATION_OBSERVER_HPP
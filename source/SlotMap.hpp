@@ -0,0 +1,265 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_SLOT_MAP_HPP
+#define DEMO_INCLUDE_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Demo {
+
+// Stable handle to a value of a slot map. A handle names a slot and the generation of that slot
+// when the value was inserted. Once the value is erased, the generation of its slot is incremented,
+// so the handle no longer finds anything, even after the slot is reused by another value.
+struct SlotHandle {
+  // Index of the slot.
+  uint32_t slot = std::numeric_limits<uint32_t>::max();
+
+  // Generation of the slot when the value was inserted.
+  uint32_t generation = 0;
+
+  constexpr bool operator==(const SlotHandle& other) const noexcept {
+    return slot == other.slot && generation == other.generation;
+  }
+
+  constexpr bool operator!=(const SlotHandle& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+// Container of values that are inserted and erased in constant time and are referred to by stable
+// handles. The values are stored densely in insertion order, so iterating over them is as fast as
+// iterating over a vector, except that erasing a value moves the last value into its place. Each
+// slot records the position of its value in the dense storage and its generation, and each value
+// records its slot. Erased slots are kept in a free list and reused by later insertions, so a slot
+// map that has reached its working size never allocates again.
+template <typename Value, typename Allocator = std::allocator<Value>>
+class SlotMap {
+private:
+  // Slot of a value. While the slot is free, its position is the next free slot.
+  struct Slot {
+    uint32_t position = 0;
+
+    uint32_t generation = 0;
+  };
+
+  using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+  using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>;
+
+public:
+  using allocator_type = Allocator;
+
+  using iterator = typename std::vector<Value, Allocator>::iterator;
+
+  using const_iterator = typename std::vector<Value, Allocator>::const_iterator;
+
+  // Constructs an empty slot map without allocating.
+  SlotMap() noexcept = default;
+
+  // Constructs an empty slot map that allocates with a given allocator, without allocating.
+  explicit SlotMap(const Allocator& allocator) noexcept
+    : values_(allocator), value_slots_(IndexAllocator(allocator)),
+      slots_(SlotAllocator(allocator)) {}
+
+  // Returns whether this slot map is empty.
+  bool Empty() const noexcept {
+    return values_.empty();
+  }
+
+  // Returns the number of values in this slot map.
+  std::size_t Size() const noexcept {
+    return values_.size();
+  }
+
+  // Returns the number of slots of this slot map, including free slots.
+  std::size_t SlotCount() const noexcept {
+    return slots_.size();
+  }
+
+  // Ensures that this slot map can hold a given number of values without allocating.
+  void Reserve(const std::size_t count) noexcept {
+    values_.reserve(count);
+    value_slots_.reserve(count);
+    slots_.reserve(count);
+  }
+
+  // Returns the slot that the next inserted value will occupy.
+  uint32_t NextSlot() const noexcept {
+    return free_slot_ != NoSlot ? free_slot_ : static_cast<uint32_t>(slots_.size());
+  }
+
+  // Inserts a given value at the end of the dense storage and returns its handle.
+  SlotHandle Insert(Value value) noexcept {
+    uint32_t slot = free_slot_;
+    if (slot != NoSlot) {
+      free_slot_ = slots_[slot].position;
+    } else {
+      slot = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
+    }
+    slots_[slot].position = static_cast<uint32_t>(values_.size());
+    values_.push_back(std::move(value));
+    value_slots_.push_back(slot);
+    return {slot, slots_[slot].generation};
+  }
+
+  // Appends a given number of default-constructed values in fresh slots numbered like their
+  // positions, which lets the values be assigned in parallel through operator[] afterwards. This
+  // slot map must have no free slots.
+  void Resize(const std::size_t count) noexcept {
+    const std::size_t size = values_.size();
+    const std::size_t first_slot = slots_.size();
+    values_.resize(size + count);
+    value_slots_.resize(size + count);
+    slots_.resize(first_slot + count);
+    for (std::size_t offset = 0; offset < count; ++offset) {
+      slots_[first_slot + offset].position = static_cast<uint32_t>(size + offset);
+      value_slots_[size + offset] = static_cast<uint32_t>(first_slot + offset);
+    }
+  }
+
+  // Erases the value of a given handle by moving the last value into its place. Returns true if
+  // the value was erased, or false if the handle does not refer to a value of this slot map.
+  bool Erase(const SlotHandle handle) noexcept {
+    if (!Contains(handle)) {
+      return false;
+    }
+    const uint32_t position = slots_[handle.slot].position;
+    const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+    if (position != last) {
+      values_[position] = std::move(values_[last]);
+      value_slots_[position] = value_slots_[last];
+      slots_[value_slots_[position]].position = position;
+    }
+    values_.pop_back();
+    value_slots_.pop_back();
+    ++slots_[handle.slot].generation;
+    slots_[handle.slot].position = free_slot_;
+    free_slot_ = handle.slot;
+    return true;
+  }
+
+  // Erases all values and slots of this slot map without releasing its capacity. Handles to its
+  // former values must no longer be used, since their slots may be renumbered.
+  void Clear() noexcept {
+    values_.clear();
+    value_slots_.clear();
+    slots_.clear();
+    free_slot_ = NoSlot;
+  }
+
+  // Returns whether a given handle refers to a value of this slot map.
+  bool Contains(const SlotHandle handle) const noexcept {
+    return handle.slot < slots_.size() && slots_[handle.slot].generation == handle.generation
+           && slots_[handle.slot].position < values_.size()
+           && value_slots_[slots_[handle.slot].position] == handle.slot;
+  }
+
+  // Returns the value of a given handle, or nullptr if the handle does not refer to a value of this
+  // slot map.
+  Value* Find(const SlotHandle handle) noexcept {
+    return Contains(handle) ? &values_[slots_[handle.slot].position] : nullptr;
+  }
+
+  // Returns the value of a given handle, or nullptr if the handle does not refer to a value of this
+  // slot map.
+  const Value* Find(const SlotHandle handle) const noexcept {
+    return Contains(handle) ? &values_[slots_[handle.slot].position] : nullptr;
+  }
+
+  // Returns the handle of the value in a given slot, whether or not that slot is occupied.
+  SlotHandle HandleOfSlot(const uint32_t slot) const noexcept {
+    if (slot < slots_.size()) {
+      return {slot, slots_[slot].generation};
+    }
+    return {};
+  }
+
+  // Returns the handle of the value at a given position of the dense storage. The position must be
+  // less than the size of this slot map.
+  SlotHandle HandleAt(const std::size_t position) const noexcept {
+    const uint32_t slot = value_slots_[position];
+    return {slot, slots_[slot].generation};
+  }
+
+  // Returns the value at a given position of the dense storage. The position must be less than the
+  // size of this slot map.
+  Value& operator[](const std::size_t position) noexcept {
+    return values_[position];
+  }
+
+  // Returns the value at a given position of the dense storage. The position must be less than the
+  // size of this slot map.
+  const Value& operator[](const std::size_t position) const noexcept {
+    return values_[position];
+  }
+
+  iterator begin() noexcept {
+    return values_.begin();
+  }
+
+  iterator end() noexcept {
+    return values_.end();
+  }
+
+  const_iterator begin() const noexcept {
+    return values_.begin();
+  }
+
+  const_iterator end() const noexcept {
+    return values_.end();
+  }
+
+  const_iterator cbegin() const noexcept {
+    return values_.cbegin();
+  }
+
+  const_iterator cend() const noexcept {
+    return values_.cend();
+  }
+
+private:
+  // Marks the end of the free list.
+  static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+  // Values in dense storage.
+  std::vector<Value, Allocator> values_;
+
+  // Slot of each value in dense storage.
+  std::vector<uint32_t, IndexAllocator> value_slots_;
+
+  // Position and generation of each slot.
+  std::vector<Slot, SlotAllocator> slots_;
+
+  // First free slot, or NoSlot if every slot is occupied.
+  uint32_t free_slot_ = NoSlot;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_SLOT_MAP_HPP
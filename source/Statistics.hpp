@@ -23,179 +23,315 @@
 #ifndef DEMO_INCLUDE_STATISTICS_HPP
 #define DEMO_INCLUDE_STATISTICS_HPP
 
+#include <cstdint>
 #include <PhQ/Length.hpp>
 #include <PhQ/Time.hpp>
 
 namespace Demo {
 
-// Statistics of a vehicle or collection of vehicles.
+// Metrics tracked by a set of statistics, as bit flags that can be combined with operator|.
+enum class StatisticsMetrics : uint8_t {
+  // Total count, duration, distance, and passenger-distance of flights.
+  Flights = 1 << 0,
+
+  // Total count and duration of charging sessions.
+  ChargingSessions = 1 << 1,
+
+  // Total count of faults.
+  Faults = 1 << 2,
+
+  // All of the above.
+  All = Flights | ChargingSessions | Faults,
+};
+
+// Combines two sets of statistics metrics.
+inline constexpr StatisticsMetrics operator|(
+    const StatisticsMetrics left, const StatisticsMetrics right) noexcept {
+  return static_cast<StatisticsMetrics>(static_cast<uint8_t>(left) | static_cast<uint8_t>(right));
+}
+
+// Returns whether a given set of statistics metrics includes all metrics of another given set.
+inline constexpr bool Includes(
+    const StatisticsMetrics metrics, const StatisticsMetrics included) noexcept {
+  return (static_cast<uint8_t>(metrics) & static_cast<uint8_t>(included))
+         == static_cast<uint8_t>(included);
+}
+
+namespace Internal {
+
+// Totals of the flight metrics of a set of statistics. Empty if these metrics are not tracked.
+template <bool Tracked>
+struct FlightTotals {};
+
+template <>
+struct FlightTotals<true> {
+  int64_t total_flight_count_ = 0;
+
+  PhQ::Time<> total_flight_duration_ = PhQ::Time<>::Zero();
+
+  PhQ::Length<> total_flight_distance_ = PhQ::Length<>::Zero();
+
+  PhQ::Length<> total_flight_passenger_distance_ = PhQ::Length<>::Zero();
+};
+
+// Totals of the charging session metrics of a set of statistics. Empty if these metrics are not
+// tracked.
+template <bool Tracked>
+struct ChargingSessionTotals {};
+
+template <>
+struct ChargingSessionTotals<true> {
+  int64_t total_charging_session_count_ = 0;
+
+  PhQ::Time<> total_charging_duration_ = PhQ::Time<>::Zero();
+};
+
+// Total of the fault metrics of a set of statistics. Empty if these metrics are not tracked.
+template <bool Tracked>
+struct FaultTotals {};
+
+template <>
+struct FaultTotals<true> {
+  int64_t total_fault_count_ = 0;
+};
+
+}  // namespace Internal
+
+// Statistics of a vehicle or collection of vehicles that track a given compile-time set of
+// metrics. Only the totals of the tracked metrics are stored, in base classes that are empty for
+// the other metrics, and only they are updated: the modifiers of the other metrics do nothing and
+// their accessors return zero. Means are not stored but derived from the totals when they are
+// read, so updates never divide.
 // TODO: This could use a Protocol Buffer schema.
-class Statistics {
+template <StatisticsMetrics Metrics>
+class BasicStatistics
+  : private Internal::FlightTotals<Includes(Metrics, StatisticsMetrics::Flights)>,
+    private Internal::ChargingSessionTotals<Includes(Metrics, StatisticsMetrics::ChargingSessions)>,
+    private Internal::FaultTotals<Includes(Metrics, StatisticsMetrics::Faults)> {
 public:
+  // Whether these statistics track the flight metrics.
+  static constexpr bool TracksFlights = Includes(Metrics, StatisticsMetrics::Flights);
+
+  // Whether these statistics track the charging session metrics.
+  static constexpr bool TracksChargingSessions =
+      Includes(Metrics, StatisticsMetrics::ChargingSessions);
+
+  // Whether these statistics track the fault metrics.
+  static constexpr bool TracksFaults = Includes(Metrics, StatisticsMetrics::Faults);
+
   // Default constructor. Initializes all properties to zero.
-  constexpr Statistics() noexcept = default;
+  constexpr BasicStatistics() noexcept = default;
+
+  // Constructs statistics from given totals. Totals of metrics that are not tracked are ignored.
+  BasicStatistics(const int64_t total_flight_count, const PhQ::Time<>& total_flight_duration,
+                  const PhQ::Length<>& total_flight_distance,
+                  const PhQ::Length<>& total_flight_passenger_distance,
+                  const int64_t total_charging_session_count,
+                  const PhQ::Time<>& total_charging_duration,
+                  const int64_t total_fault_count) noexcept {
+    if constexpr (TracksFlights) {
+      this->total_flight_count_ = total_flight_count;
+      this->total_flight_duration_ = total_flight_duration;
+      this->total_flight_distance_ = total_flight_distance;
+      this->total_flight_passenger_distance_ = total_flight_passenger_distance;
+    }
+    if constexpr (TracksChargingSessions) {
+      this->total_charging_session_count_ = total_charging_session_count;
+      this->total_charging_duration_ = total_charging_duration;
+    }
+    if constexpr (TracksFaults) {
+      this->total_fault_count_ = total_fault_count;
+    }
+  }
 
   // Total count of flights.
   constexpr int64_t TotalFlightCount() const noexcept {
-    return total_flight_count_;
+    if constexpr (TracksFlights) {
+      return this->total_flight_count_;
+    } else {
+      return 0;
+    }
   }
 
   // Total duration of all flights.
-  constexpr const PhQ::Time<>& TotalFlightDuration() const noexcept {
-    return total_flight_duration_;
+  constexpr PhQ::Time<> TotalFlightDuration() const noexcept {
+    if constexpr (TracksFlights) {
+      return this->total_flight_duration_;
+    } else {
+      return PhQ::Time<>::Zero();
+    }
   }
 
   // Total distance of all flights.
-  constexpr const PhQ::Length<>& TotalFlightDistance() const noexcept {
-    return total_flight_distance_;
+  constexpr PhQ::Length<> TotalFlightDistance() const noexcept {
+    if constexpr (TracksFlights) {
+      return this->total_flight_distance_;
+    } else {
+      return PhQ::Length<>::Zero();
+    }
   }
 
   // Total passenger-distance of all flights. This is the product of the passenger count and the
   // total flight distance.
-  constexpr const PhQ::Length<>& TotalFlightPassengerDistance() const noexcept {
-    return total_flight_passenger_distance_;
+  constexpr PhQ::Length<> TotalFlightPassengerDistance() const noexcept {
+    if constexpr (TracksFlights) {
+      return this->total_flight_passenger_distance_;
+    } else {
+      return PhQ::Length<>::Zero();
+    }
   }
 
   // Arithmetic mean of the duration of all flights. This is the total flight duration divided by
-  // the number of flights.
-  constexpr const PhQ::Time<>& MeanFlightDuration() const noexcept {
-    return mean_flight_duration_;
+  // the number of flights, or zero if there are no flights.
+  constexpr PhQ::Time<> MeanFlightDuration() const noexcept {
+    return TotalFlightCount() > 0 ? TotalFlightDuration() / TotalFlightCount() :
+                                    PhQ::Time<>::Zero();
   }
 
   // Arithmetic mean of the distance of all flights. This is the total flight distance divided by
-  // the number of flights.
-  constexpr const PhQ::Length<>& MeanFlightDistance() const noexcept {
-    return mean_flight_distance_;
+  // the number of flights, or zero if there are no flights.
+  constexpr PhQ::Length<> MeanFlightDistance() const noexcept {
+    return TotalFlightCount() > 0 ? TotalFlightDistance() / TotalFlightCount() :
+                                    PhQ::Length<>::Zero();
   }
 
   // Total count of charging sessions.
   constexpr int64_t TotalChargingSessionCount() const noexcept {
-    return total_charging_session_count_;
+    if constexpr (TracksChargingSessions) {
+      return this->total_charging_session_count_;
+    } else {
+      return 0;
+    }
   }
 
   // Total duration of all charging sessions.
-  constexpr const PhQ::Time<>& TotalChargingDuration() const noexcept {
-    return total_charging_duration_;
+  constexpr PhQ::Time<> TotalChargingDuration() const noexcept {
+    if constexpr (TracksChargingSessions) {
+      return this->total_charging_duration_;
+    } else {
+      return PhQ::Time<>::Zero();
+    }
   }
 
   // Arithmetic mean of the duration of all charging sessions. This is the total duration of all
-  // charging sessions divided by the number of charging sessions.
-  constexpr const PhQ::Time<>& MeanChargingDuration() const noexcept {
-    return mean_charging_duration_;
+  // charging sessions divided by the number of charging sessions, or zero if there are no charging
+  // sessions.
+  constexpr PhQ::Time<> MeanChargingDuration() const noexcept {
+    return TotalChargingSessionCount() > 0 ?
+               TotalChargingDuration() / TotalChargingSessionCount() :
+               PhQ::Time<>::Zero();
   }
 
   // Total count of faults.
   constexpr int64_t TotalFaultCount() const noexcept {
-    return total_fault_count_;
+    if constexpr (TracksFaults) {
+      return this->total_fault_count_;
+    } else {
+      return 0;
+    }
   }
 
-  // Increments the total flight count by one and recalculates dependent statistics.
+  // Increments the total flight count by one.
   void IncrementTotalFlightCount() noexcept {
-    ++total_flight_count_;
-
-    mean_flight_duration_ = total_flight_duration_ / total_flight_count_;
-
-    mean_flight_distance_ = total_flight_distance_ / total_flight_count_;
+    if constexpr (TracksFlights) {
+      ++this->total_flight_count_;
+    }
   }
 
-  // Modifies the total flight duration and distance by given differences and recalculates dependent
-  // statistics.
+  // Modifies the total flight duration, distance, and passenger-distance by given differences.
   void ModifyTotalFlightDurationAndDistance(
       const int32_t passenger_count, const PhQ::Time<>& duration_difference,
       const PhQ::Length<>& distance_difference) noexcept {
-    total_flight_duration_ += duration_difference;
-
-    mean_flight_duration_ = total_flight_duration_ / total_flight_count_;
-
-    total_flight_distance_ += distance_difference;
-
-    mean_flight_distance_ = total_flight_distance_ / total_flight_count_;
+    if constexpr (TracksFlights) {
+      this->total_flight_duration_ += duration_difference;
+      this->total_flight_distance_ += distance_difference;
+      this->total_flight_passenger_distance_ +=
+          static_cast<double>(passenger_count) * distance_difference;
+    }
+  }
 
-    total_flight_passenger_distance_ += static_cast<double>(passenger_count) * distance_difference;
+  // Modifies the total flight duration, distance, and passenger-distance by given differences.
+  void ModifyTotalFlightDurationAndDistance(
+      const PhQ::Time<>& duration_difference, const PhQ::Length<>& distance_difference,
+      const PhQ::Length<>& passenger_distance_difference) noexcept {
+    if constexpr (TracksFlights) {
+      this->total_flight_duration_ += duration_difference;
+      this->total_flight_distance_ += distance_difference;
+      this->total_flight_passenger_distance_ += passenger_distance_difference;
+    }
   }
 
-  // Increments the total charging session count by one and recalculates dependent statistics.
+  // Increments the total charging session count by one.
   void IncrementTotalChargingSessionCount() noexcept {
-    ++total_charging_session_count_;
-
-    mean_charging_duration_ = total_charging_duration_ / total_charging_session_count_;
+    if constexpr (TracksChargingSessions) {
+      ++this->total_charging_session_count_;
+    }
   }
 
-  // Modifies the total charging session duration by a given difference and recalculates dependent
-  // statistics.
+  // Modifies the total charging session duration by a given difference.
   void ModifyTotalChargingSessionDuration(const PhQ::Time<>& duration_difference) noexcept {
-    total_charging_duration_ += duration_difference;
-
-    mean_charging_duration_ = total_charging_duration_ / total_charging_session_count_;
+    if constexpr (TracksChargingSessions) {
+      this->total_charging_duration_ += duration_difference;
+    }
   }
 
   // Modifies the total fault count by a given difference.
   void ModifyTotalFaultCount(const int64_t difference) noexcept {
-    total_fault_count_ += difference;
+    if constexpr (TracksFaults) {
+      this->total_fault_count_ += difference;
+    }
   }
 
-  // Aggregates data from another set of statistics into this set of statistics.
-  void Aggregate(const Statistics& other) noexcept {
-    total_flight_count_ += other.total_flight_count_;
-
-    total_flight_duration_ += other.total_flight_duration_;
-
-    total_flight_distance_ += other.total_flight_distance_;
-
-    total_flight_passenger_distance_ += other.total_flight_passenger_distance_;
-
-    mean_flight_duration_ = total_flight_duration_ / total_flight_count_;
-
-    mean_flight_distance_ = total_flight_distance_ / total_flight_count_;
-
-    total_charging_session_count_ += other.total_charging_session_count_;
-
-    total_charging_duration_ += other.total_charging_duration_;
-
-    mean_charging_duration_ = total_charging_duration_ / total_charging_session_count_;
-
-    total_fault_count_ += other.total_fault_count_;
+  // Aggregates data from another set of statistics into this set of statistics. Only the metrics
+  // tracked by both sets are aggregated.
+  template <StatisticsMetrics OtherMetrics>
+  void Aggregate(const BasicStatistics<OtherMetrics>& other) noexcept {
+    if constexpr (TracksFlights && BasicStatistics<OtherMetrics>::TracksFlights) {
+      this->total_flight_count_ += other.TotalFlightCount();
+      this->total_flight_duration_ += other.TotalFlightDuration();
+      this->total_flight_distance_ += other.TotalFlightDistance();
+      this->total_flight_passenger_distance_ += other.TotalFlightPassengerDistance();
+    }
+    if constexpr (TracksChargingSessions && BasicStatistics<OtherMetrics>::TracksChargingSessions) {
+      this->total_charging_session_count_ += other.TotalChargingSessionCount();
+      this->total_charging_duration_ += other.TotalChargingDuration();
+    }
+    if constexpr (TracksFaults && BasicStatistics<OtherMetrics>::TracksFaults) {
+      this->total_fault_count_ += other.TotalFaultCount();
+    }
   }
 
-  constexpr bool operator==(const Statistics& other) const noexcept {
-    return total_flight_count_ == other.total_flight_count_
-           && total_flight_duration_ == other.total_flight_duration_
-           && total_flight_distance_ == other.total_flight_distance_
-           && total_flight_passenger_distance_ == other.total_flight_passenger_distance_
-           && mean_flight_duration_ == other.mean_flight_duration_
-           && mean_flight_distance_ == other.mean_flight_distance_
-           && total_charging_session_count_ == other.total_charging_session_count_
-           && total_charging_duration_ == other.total_charging_duration_
-           && mean_charging_duration_ == other.mean_charging_duration_
-           && total_fault_count_ == other.total_fault_count_;
+  constexpr bool operator==(const BasicStatistics& other) const noexcept {
+    return TotalFlightCount() == other.TotalFlightCount()
+           && TotalFlightDuration() == other.TotalFlightDuration()
+           && TotalFlightDistance() == other.TotalFlightDistance()
+           && TotalFlightPassengerDistance() == other.TotalFlightPassengerDistance()
+           && TotalChargingSessionCount() == other.TotalChargingSessionCount()
+           && TotalChargingDuration() == other.TotalChargingDuration()
+           && TotalFaultCount() == other.TotalFaultCount();
   }
 
-  constexpr bool operator!=(const Statistics& other) const noexcept {
+  constexpr bool operator!=(const BasicStatistics& other) const noexcept {
     return !(*this == other);
   }
-
-private:
-  int64_t total_flight_count_ = 0;
-
-  PhQ::Time<> total_flight_duration_ = PhQ::Time<>::Zero();
-
-  PhQ::Length<> total_flight_distance_ = PhQ::Length<>::Zero();
-
-  PhQ::Length<> total_flight_passenger_distance_ = PhQ::Length<>::Zero();
-
-  PhQ::Time<> mean_flight_duration_ = PhQ::Time<>::Zero();
-
-  PhQ::Length<> mean_flight_distance_ = PhQ::Length<>::Zero();
-
-  int64_t total_charging_session_count_ = 0;
-
-  PhQ::Time<> total_charging_duration_ = PhQ::Time<>::Zero();
-
-  PhQ::Time<> mean_charging_duration_ = PhQ::Time<>::Zero();
-
-  int64_t total_fault_count_ = 0;
 };
 
+// Metrics tracked by the statistics of the vehicles of the simulation and reported in the results.
+// All metrics are tracked unless DEMO_STATISTICS_METRICS is defined as a combination of the bit
+// flags of StatisticsMetrics, which is done for the main executable by configuring with
+// -DDEMO_STATISTICS_METRICS=<flags>. The metrics that are not tracked take no memory in each
+// vehicle and are not reported.
+#if defined(DEMO_STATISTICS_METRICS)
+inline constexpr StatisticsMetrics VehicleStatisticsMetrics =
+    static_cast<StatisticsMetrics>(DEMO_STATISTICS_METRICS);
+#else
+inline constexpr StatisticsMetrics VehicleStatisticsMetrics = StatisticsMetrics::All;
+#endif
+
+// Statistics of the vehicles of the simulation, which track the metrics of
+// VehicleStatisticsMetrics.
+using Statistics = BasicStatistics<VehicleStatisticsMetrics>;
+
 }  // namespace Demo
 
 #endif  // DEMO_INCLUDE_STATISTICS_HPP
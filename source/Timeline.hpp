@@ -0,0 +1,238 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TIMELINE_HPP
+#define DEMO_INCLUDE_TIMELINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "Logger.hpp"
+#include "ProfilePhase.hpp"
+
+namespace Demo {
+
+// Span of time spent in a profiled phase by one thread. Times are in nanoseconds since the timeline
+// started.
+struct TimelineSpan {
+  ProfilePhase phase = ProfilePhase::ComputeTimeStep;
+
+  int64_t start_nanoseconds = 0;
+
+  int64_t duration_nanoseconds = 0;
+};
+
+// Records the spans of the profiled phases of each thread and exports them in the Chrome trace
+// event format, which can be loaded in chrome://tracing or in the Perfetto user interface. Each
+// thread records into its own buffer, which is preallocated when the thread records its first span,
+// so recording a span neither locks nor allocates. Spans that do not fit in a full buffer are
+// counted and dropped. The spans are only written out once recording has stopped, so that writing
+// does not perturb the timings.
+class Timeline {
+public:
+  // Default maximum number of spans recorded by each thread.
+  static constexpr std::size_t DefaultCapacity = 1 << 20;
+
+  Timeline() noexcept = default;
+
+  Timeline(const Timeline& other) = delete;
+
+  Timeline& operator=(const Timeline& other) = delete;
+
+  // Discards any previous spans and starts recording, with up to a given number of spans per
+  // thread. Must not be called while other threads are recording.
+  void Start(const std::size_t capacity_per_thread = DefaultCapacity) noexcept {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.clear();
+    capacity_ = std::max<std::size_t>(capacity_per_thread, 1);
+    origin_ = std::chrono::steady_clock::now();
+    generation_.store(NextGeneration().fetch_add(1) + 1, std::memory_order_release);
+    active_.store(true, std::memory_order_release);
+  }
+
+  // Stops recording. Spans recorded so far are kept until the timeline is started again.
+  void Stop() noexcept {
+    active_.store(false, std::memory_order_release);
+  }
+
+  // Whether this timeline is recording.
+  bool Active() const noexcept {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  // Records a span of a given phase on the calling thread if this timeline is recording.
+  void Record(const ProfilePhase phase, const std::chrono::steady_clock::time_point start,
+              const std::chrono::steady_clock::time_point end) noexcept {
+    if (!Active()) {
+      return;
+    }
+    ThreadBuffer& buffer = LocalBuffer();
+    if (buffer.spans.size() < buffer.spans.capacity()) {
+      buffer.spans.push_back(
+          {phase,
+           std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin_).count(),
+           std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()});
+    } else {
+      ++buffer.dropped;
+    }
+  }
+
+  // Number of threads that recorded at least one span.
+  std::size_t ThreadCount() const noexcept {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.size();
+  }
+
+  // Number of spans recorded by all threads.
+  std::size_t SpanCount() const noexcept {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+      count += buffer->spans.size();
+    }
+    return count;
+  }
+
+  // Number of spans dropped by all threads because their buffers were full.
+  std::size_t DroppedCount() const noexcept {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+      count += buffer->dropped;
+    }
+    return count;
+  }
+
+  // Writes the recorded spans to a given stream as a Chrome trace event JSON document. Each thread
+  // appears as its own track. Should only be called once the recording threads are done.
+  void WriteJson(std::ostream& stream) const noexcept {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    char buffer[192];
+    stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& thread_buffer : buffers_) {
+      std::snprintf(buffer, sizeof(buffer),
+                    "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                    "\"args\": {\"name\": \"Thread %u\"}}",
+                    first ? "" : ",", thread_buffer->index, thread_buffer->index);
+      stream << buffer;
+      first = false;
+      for (const TimelineSpan& span : thread_buffer->spans) {
+        const std::string_view name = ProfilePhaseName(span.phase);
+        std::snprintf(buffer, sizeof(buffer),
+                      ",\n{\"name\": \"%.*s\", \"cat\": \"simulation\", \"ph\": \"X\", "
+                      "\"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u}",
+                      static_cast<int>(name.size()), name.data(),
+                      static_cast<double>(span.start_nanoseconds) * 1.0E-3,
+                      static_cast<double>(span.duration_nanoseconds) * 1.0E-3,
+                      thread_buffer->index);
+        stream << buffer;
+      }
+    }
+    stream << "\n]}\n";
+  }
+
+  // Writes the recorded spans to a file at a given path as a Chrome trace event JSON document.
+  // Returns false if the file could not be written.
+  bool Write(const std::filesystem::path& path) const noexcept {
+    std::ofstream stream(path);
+    if (!stream.is_open()) {
+      Log(LogLevel::Error) << "Could not open the timeline file: " << path.string();
+      return false;
+    }
+    WriteJson(stream);
+    if (!stream.good()) {
+      Log(LogLevel::Error) << "Could not write the timeline file: " << path.string();
+      return false;
+    }
+    return true;
+  }
+
+private:
+  // Spans recorded by one thread.
+  struct ThreadBuffer {
+    // Index of the thread in the order in which threads recorded their first span.
+    uint32_t index = 0;
+
+    std::vector<TimelineSpan> spans;
+
+    std::size_t dropped = 0;
+  };
+
+  // Source of the generations of all timelines, which distinguish each recording so that the
+  // buffers of the threads are registered again whenever any timeline is started.
+  static std::atomic<uint64_t>& NextGeneration() noexcept {
+    static std::atomic<uint64_t> generation{0};
+    return generation;
+  }
+
+  // Returns the buffer of the calling thread, registering and preallocating it if this is the
+  // thread's first span of the current recording.
+  ThreadBuffer& LocalBuffer() noexcept {
+    thread_local ThreadBuffer* buffer = nullptr;
+    thread_local uint64_t generation = 0;
+    const uint64_t current_generation = generation_.load(std::memory_order_acquire);
+    if (buffer == nullptr || generation != current_generation) {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      std::unique_ptr<ThreadBuffer> new_buffer = std::make_unique<ThreadBuffer>();
+      new_buffer->index = static_cast<uint32_t>(buffers_.size());
+      new_buffer->spans.reserve(capacity_);
+      buffer = new_buffer.get();
+      buffers_.push_back(std::move(new_buffer));
+      generation = current_generation;
+    }
+    return *buffer;
+  }
+
+  mutable std::mutex mutex_;
+
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  std::size_t capacity_ = DefaultCapacity;
+
+  std::chrono::steady_clock::time_point origin_ = std::chrono::steady_clock::now();
+
+  std::atomic<uint64_t> generation_{0};
+
+  std::atomic<bool> active_{false};
+};
+
+// Returns the timeline shared by this program.
+inline Timeline& GlobalTimeline() noexcept {
+  static Timeline timeline;
+  return timeline;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TIMELINE_HPP
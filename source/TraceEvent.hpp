@@ -0,0 +1,175 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRACE_EVENT_HPP
+#define DEMO_INCLUDE_TRACE_EVENT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "ChargingStationId.hpp"
+#include "Varint.hpp"
+#include "VehicleId.hpp"
+
+namespace Demo {
+
+// Magic bytes at the beginning of a binary event trace file.
+inline constexpr std::array<uint8_t, 8> TraceMagic{'J', 'O', 'B', 'Y', 'T', 'R', 'C', '1'};
+
+// Version of the binary event trace file format.
+inline constexpr uint8_t TraceVersion = 1;
+
+// Kind of event recorded in a binary event trace.
+enum class TraceEvent : uint8_t {
+  Takeoff,
+  Landing,
+  Enqueue,
+  ChargeStart,
+  ChargeEnd,
+  Fault,
+};
+
+// Number of kinds of events recorded in a binary event trace.
+inline constexpr uint8_t TraceEventCount = 6;
+
+// Returns the name of a kind of trace event.
+inline std::string_view TraceEventName(const TraceEvent event) noexcept {
+  switch (event) {
+    case TraceEvent::Takeoff:
+      return "Takeoff";
+    case TraceEvent::Landing:
+      return "Landing";
+    case TraceEvent::Enqueue:
+      return "Enqueue";
+    case TraceEvent::ChargeStart:
+      return "ChargeStart";
+    case TraceEvent::ChargeEnd:
+      return "ChargeEnd";
+    case TraceEvent::Fault:
+      return "Fault";
+  }
+  return "Unknown";
+}
+
+// Returns whether a kind of trace event records the ID of the vehicle's charging station.
+inline constexpr bool TraceEventHasChargingStation(const TraceEvent event) noexcept {
+  return event == TraceEvent::Enqueue || event == TraceEvent::ChargeStart
+         || event == TraceEvent::ChargeEnd;
+}
+
+// Single event of a binary event trace. Times are stored in integer nanoseconds since the start of
+// the simulation so that they can be delta-encoded exactly.
+struct TraceRecord {
+  TraceEvent event = TraceEvent::Takeoff;
+
+  int64_t time_nanoseconds = 0;
+
+  VehicleId vehicle_id = 0;
+
+  // ID of the vehicle's charging station. Only meaningful for enqueue and charge events.
+  ChargingStationId charging_station_id = 0;
+
+  // Number of faults. Only meaningful for fault events.
+  int64_t fault_count = 0;
+};
+
+// Equality operator for trace records. Ignores fields that are not meaningful for the event.
+inline bool operator==(const TraceRecord& left, const TraceRecord& right) noexcept {
+  return left.event == right.event && left.time_nanoseconds == right.time_nanoseconds
+         && left.vehicle_id == right.vehicle_id
+         && (!TraceEventHasChargingStation(left.event)
+             || left.charging_station_id == right.charging_station_id)
+         && (left.event != TraceEvent::Fault || left.fault_count == right.fault_count);
+}
+
+// Inequality operator for trace records.
+inline bool operator!=(const TraceRecord& left, const TraceRecord& right) noexcept {
+  return !(left == right);
+}
+
+// Maximum number of bytes of an encoded trace record: one byte for the kind of event and up to
+// three variable-length integers.
+inline constexpr std::size_t MaximumTraceRecordSize = 1 + 3 * MaximumVarintSize;
+
+// Encodes a trace record as one byte for the kind of event, followed by the zigzag-encoded time
+// difference from a given previous time in nanoseconds, the zigzag-encoded vehicle ID, and then
+// either the zigzag-encoded charging station ID for enqueue and charge events or the fault count
+// for fault events. Writes at most MaximumTraceRecordSize bytes starting at the given destination
+// and returns a pointer past the last byte written.
+inline uint8_t* EncodeTraceRecord(const TraceRecord& record,
+                                  const int64_t previous_time_nanoseconds,
+                                  uint8_t* destination) noexcept {
+  *destination++ = static_cast<uint8_t>(record.event);
+  destination = EncodeVarint(
+      ZigZagEncode(record.time_nanoseconds - previous_time_nanoseconds), destination);
+  destination = EncodeVarint(ZigZagEncode(record.vehicle_id), destination);
+  if (TraceEventHasChargingStation(record.event)) {
+    destination = EncodeVarint(ZigZagEncode(record.charging_station_id), destination);
+  } else if (record.event == TraceEvent::Fault) {
+    destination = EncodeVarint(static_cast<uint64_t>(record.fault_count), destination);
+  }
+  return destination;
+}
+
+// Decodes a trace record encoded by EncodeTraceRecord from the bytes in the range [begin, end),
+// given the time in nanoseconds of the previous record. On success, returns the decoded record and
+// advances the given pointer past the decoded bytes. Returns std::nullopt if the bytes are not a
+// valid trace record.
+inline std::optional<TraceRecord> DecodeTraceRecord(
+    const uint8_t*& begin, const uint8_t* end, const int64_t previous_time_nanoseconds) noexcept {
+  const uint8_t* current = begin;
+  if (current >= end || *current >= TraceEventCount) {
+    return std::nullopt;
+  }
+  TraceRecord record;
+  record.event = static_cast<TraceEvent>(*current++);
+  const std::optional<uint64_t> time_difference = DecodeVarint(current, end);
+  if (!time_difference.has_value()) {
+    return std::nullopt;
+  }
+  record.time_nanoseconds = previous_time_nanoseconds + ZigZagDecode(time_difference.value());
+  const std::optional<uint64_t> vehicle_id = DecodeVarint(current, end);
+  if (!vehicle_id.has_value()) {
+    return std::nullopt;
+  }
+  record.vehicle_id = ZigZagDecode(vehicle_id.value());
+  if (TraceEventHasChargingStation(record.event) || record.event == TraceEvent::Fault) {
+    const std::optional<uint64_t> value = DecodeVarint(current, end);
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    if (record.event == TraceEvent::Fault) {
+      record.fault_count = static_cast<int64_t>(value.value());
+    } else {
+      record.charging_station_id = ZigZagDecode(value.value());
+    }
+  }
+  begin = current;
+  return record;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRACE_EVENT_HPP
@@ -0,0 +1,122 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRACE_READER_HPP
+#define DEMO_INCLUDE_TRACE_READER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include "Logger.hpp"
+#include "TraceEvent.hpp"
+#include "Varint.hpp"
+
+namespace Demo {
+
+// Reads the records of a binary trace file written by TraceRecorder, one at a time.
+class TraceReader {
+public:
+  // Reads the binary trace file at the given path and validates its header.
+  TraceReader(const std::filesystem::path& path) noexcept {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) {
+      Log(LogLevel::Error) << "Could not open the file: " << path.string();
+      return;
+    }
+    data_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    const uint8_t* const end = data_.data() + data_.size();
+    current_ = data_.data();
+    if (data_.size() < TraceMagic.size() + 1
+        || !std::equal(TraceMagic.begin(), TraceMagic.end(), current_)
+        || current_[TraceMagic.size()] != TraceVersion) {
+      Log(LogLevel::Error) << "Not a binary trace file: " << path.string();
+      return;
+    }
+    current_ += TraceMagic.size() + 1;
+    const std::optional<uint64_t> sampling_interval = DecodeVarint(current_, end);
+    if (!sampling_interval.has_value()) {
+      Log(LogLevel::Error) << "Not a binary trace file: " << path.string();
+      return;
+    }
+    sampling_interval_ = sampling_interval.value();
+    valid_ = true;
+  }
+
+  // Returns whether the trace file has a valid header and no invalid record has been read so far.
+  bool IsValid() const noexcept {
+    return valid_;
+  }
+
+  // One in every this number of vehicles was sampled when the trace was recorded.
+  uint64_t SamplingInterval() const noexcept {
+    return sampling_interval_;
+  }
+
+  // Reads the next record. Returns std::nullopt at the end of the trace or if the next record is
+  // not valid, in which case this reader is marked as not valid.
+  std::optional<TraceRecord> Next() noexcept {
+    if (!valid_) {
+      return std::nullopt;
+    }
+    const uint8_t* const end = data_.data() + data_.size();
+    if (current_ == end) {
+      return std::nullopt;
+    }
+    const std::optional<TraceRecord> record =
+        DecodeTraceRecord(current_, end, previous_time_nanoseconds_);
+    if (!record.has_value()) {
+      valid_ = false;
+      return std::nullopt;
+    }
+    previous_time_nanoseconds_ = record->time_nanoseconds;
+    return record;
+  }
+
+  // Reads all remaining records.
+  std::vector<TraceRecord> ReadAll() noexcept {
+    std::vector<TraceRecord> records;
+    for (std::optional<TraceRecord> record = Next(); record.has_value(); record = Next()) {
+      records.push_back(record.value());
+    }
+    return records;
+  }
+
+private:
+  std::vector<uint8_t> data_;
+
+  const uint8_t* current_ = nullptr;
+
+  uint64_t sampling_interval_ = 1;
+
+  int64_t previous_time_nanoseconds_ = 0;
+
+  bool valid_ = false;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRACE_READER_HPP
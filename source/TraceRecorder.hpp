@@ -0,0 +1,203 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRACE_RECORDER_HPP
+#define DEMO_INCLUDE_TRACE_RECORDER_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <PhQ/Time.hpp>
+
+#include "AsyncBinaryFileWriter.hpp"
+#include "Logger.hpp"
+#include "SimulationObserver.hpp"
+#include "TraceEvent.hpp"
+#include "Varint.hpp"
+#include "Vehicle.hpp"
+
+namespace Demo {
+
+// Records the events of a vehicle fleet simulation to a compact binary trace file. The file begins
+// with the TraceMagic bytes, the TraceVersion byte, and the sampling interval as a variable-length
+// integer, followed by a sequence of records encoded by EncodeTraceRecord, where each record's time
+// is relative to the previous record's time. Records are buffered in memory and written to the file
+// from a background thread, so recording an event costs only a few bytes of encoding. To limit the
+// size of the trace for large fleets, only one in every N vehicles can be sampled, where the
+// sampled vehicles are chosen deterministically by hashing their IDs.
+class TraceRecorder {
+public:
+  // Creates a binary trace file at the given path that records the events of one in every given
+  // number of vehicles.
+  TraceRecorder(const std::filesystem::path& path, const uint64_t sampling_interval = 1) noexcept
+    : writer_(path), sampling_interval_(sampling_interval > 0 ? sampling_interval : 1) {
+    uint8_t* const begin = writer_.Reserve(TraceMagic.size() + 1 + MaximumVarintSize);
+    if (begin == nullptr) {
+      return;
+    }
+    uint8_t* end = begin;
+    for (const uint8_t byte : TraceMagic) {
+      *end++ = byte;
+    }
+    *end++ = TraceVersion;
+    end = EncodeVarint(sampling_interval_, end);
+    writer_.Commit(end);
+  }
+
+  TraceRecorder(const TraceRecorder& other) = delete;
+
+  TraceRecorder& operator=(const TraceRecorder& other) = delete;
+
+  // Destructor. Writes all remaining records to the file.
+  ~TraceRecorder() noexcept {
+    if (writer_.IsOpen()) {
+      Log(LogLevel::Information) << "Wrote " << record_count_ << " trace events ("
+                                 << writer_.Size() << " bytes) to: " << writer_.Path().string();
+    }
+  }
+
+  // Path to the trace file.
+  const std::filesystem::path& Path() const noexcept {
+    return writer_.Path();
+  }
+
+  // Returns whether the trace file is open.
+  bool IsOpen() const noexcept {
+    return writer_.IsOpen();
+  }
+
+  // One in every this number of vehicles is sampled.
+  uint64_t SamplingInterval() const noexcept {
+    return sampling_interval_;
+  }
+
+  // Number of events recorded so far.
+  uint64_t RecordCount() const noexcept {
+    return record_count_;
+  }
+
+  // Returns whether the events of the vehicle with a given ID are recorded.
+  bool Samples(const VehicleId id) const noexcept {
+    if (sampling_interval_ == 1) {
+      return true;
+    }
+    // Mix the bits of the ID so that the sampled vehicles are spread evenly even if the IDs are
+    // sequential.
+    uint64_t hash = static_cast<uint64_t>(id) + 0x9E3779B97F4A7C15;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+    hash = hash ^ (hash >> 31);
+    return hash % sampling_interval_ == 0;
+  }
+
+  // Records an event. Does not check whether the event's vehicle is sampled.
+  void Record(const TraceRecord& record) noexcept {
+    uint8_t* const begin = writer_.Reserve(MaximumTraceRecordSize);
+    if (begin == nullptr) {
+      return;
+    }
+    writer_.Commit(EncodeTraceRecord(record, previous_time_nanoseconds_, begin));
+    previous_time_nanoseconds_ = record.time_nanoseconds;
+    ++record_count_;
+  }
+
+  // Records an event of a given kind for a given vehicle at a given time if the vehicle is sampled.
+  void Record(const TraceEvent event, const PhQ::Time<>& time, const Vehicle& vehicle,
+              const int64_t fault_count = 0) noexcept {
+    if (!Samples(vehicle.Id())) {
+      return;
+    }
+    TraceRecord record;
+    record.event = event;
+    record.time_nanoseconds = std::llround(time.Value() * 1.0E9);
+    record.vehicle_id = vehicle.Id();
+    record.charging_station_id = vehicle.ChargingStationId().value_or(0);
+    record.fault_count = fault_count;
+    Record(record);
+  }
+
+private:
+  AsyncBinaryFileWriter writer_;
+
+  const uint64_t sampling_interval_;
+
+  int64_t previous_time_nanoseconds_ = 0;
+
+  uint64_t record_count_ = 0;
+};
+
+// Simulation observer that records events to a binary trace through a trace recorder. The trace
+// recorder is not owned by this observer. If no trace recorder is given, nothing is recorded.
+class TraceObserver : public SimulationObserver {
+public:
+  // Creates an observer that records events through a given trace recorder, which may be null.
+  TraceObserver(TraceRecorder* const recorder = nullptr) noexcept : recorder_(recorder) {}
+
+  // Trace recorder of this observer. May be null.
+  TraceRecorder* Recorder() const noexcept {
+    return recorder_;
+  }
+
+  void OnTakeoff(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::Takeoff, time, vehicle);
+    }
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::Landing, time, vehicle);
+    }
+  }
+
+  void OnEnqueue(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::Enqueue, time, vehicle);
+    }
+  }
+
+  void OnChargeStart(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::ChargeStart, time, vehicle);
+    }
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::ChargeEnd, time, vehicle);
+    }
+  }
+
+  void OnFault(const PhQ::Time<>& time, const Vehicle& vehicle,
+               const int64_t fault_count) noexcept {
+    if (recorder_ != nullptr) {
+      recorder_->Record(TraceEvent::Fault, time, vehicle, fault_count);
+    }
+  }
+
+private:
+  TraceRecorder* recorder_ = nullptr;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRACE_RECORDER_HPP
@@ -0,0 +1,297 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRANSITION_LOG_HPP
+#define DEMO_INCLUDE_TRANSITION_LOG_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <PhQ/Time.hpp>
+#include <string_view>
+#include <vector>
+
+#include "AsyncBinaryFileWriter.hpp"
+#include "ByteOrder.hpp"
+#include "Logger.hpp"
+#include "SimulationObserver.hpp"
+#include "TraceEvent.hpp"
+#include "Varint.hpp"
+#include "Vehicle.hpp"
+#include "VehicleModels.hpp"
+#include "Vehicles.hpp"
+
+namespace Demo {
+
+// Magic bytes at the beginning of a binary transition log file.
+inline constexpr std::array<uint8_t, 8> TransitionLogMagic{'J', 'O', 'B', 'Y', 'T', 'L', 'G', '1'};
+
+// Version of the binary transition log file format.
+inline constexpr uint8_t TransitionLogVersion = 1;
+
+// Size in bytes of the header of each block of a binary transition log: the payload size and the
+// record count as 32-bit integers and the base time in nanoseconds as a 64-bit integer, all in
+// little-endian byte order.
+inline constexpr std::size_t TransitionLogBlockHeaderSize = 16;
+
+// Default size in bytes of each block of a binary transition log, including its header.
+inline constexpr std::size_t DefaultTransitionLogBlockSize = 1 << 16;
+
+// Writes the state transitions of the vehicles of a simulation to a binary transition log file,
+// from which the statistics of the simulation can later be recomputed without re-simulating. The
+// file begins with the TransitionLogMagic bytes, the TransitionLogVersion byte, and a catalog of
+// the vehicle models and of the vehicles of the simulation. It continues with a sequence of
+// blocks, each of which begins with a header of TransitionLogBlockHeaderSize bytes followed by a
+// payload of records encoded by EncodeTraceRecord. The time of the first record of each block is
+// relative to the block's base time, so every block can be decoded independently of the others.
+// The log ends with an empty block whose base time is the time at which the simulation ended.
+// Blocks are written to the file from a background thread.
+class TransitionLogWriter {
+public:
+  // Creates a binary transition log file at the given path and writes the catalog of the given
+  // vehicle models and vehicles to it.
+  TransitionLogWriter(const std::filesystem::path& path, const VehicleModels& vehicle_models,
+                      const Vehicles& vehicles,
+                      const std::size_t block_size = DefaultTransitionLogBlockSize) noexcept
+    : writer_(path, std::max(block_size, TransitionLogBlockHeaderSize + MaximumTraceRecordSize)) {
+    if (!writer_.IsOpen()) {
+      return;
+    }
+    WriteCatalog(vehicle_models, vehicles);
+    // Begin the first block at the beginning of a new writer block.
+    writer_.SubmitBlock();
+  }
+
+  TransitionLogWriter(const TransitionLogWriter& other) = delete;
+
+  TransitionLogWriter& operator=(const TransitionLogWriter& other) = delete;
+
+  // Destructor. Closes the log at the time of the last record if it was not already closed.
+  ~TransitionLogWriter() noexcept {
+    Close(PhQ::Time<>(static_cast<double>(previous_time_nanoseconds_) * 1.0E-9,
+                      PhQ::Unit::Time::Second));
+  }
+
+  // Path to the transition log file.
+  const std::filesystem::path& Path() const noexcept {
+    return writer_.Path();
+  }
+
+  // Returns whether the transition log file is open.
+  bool IsOpen() const noexcept {
+    return writer_.IsOpen();
+  }
+
+  // Number of records written so far.
+  uint64_t RecordCount() const noexcept {
+    return record_count_;
+  }
+
+  // Number of blocks written so far, excluding the final empty block.
+  uint64_t BlockCount() const noexcept {
+    return block_count_;
+  }
+
+  // Records a state transition.
+  void Record(const TraceRecord& record) noexcept {
+    if (!writer_.IsOpen() || closed_) {
+      return;
+    }
+    if (block_header_ == nullptr || writer_.Remaining() < MaximumTraceRecordSize) {
+      FinishBlock();
+      BeginBlock(record.time_nanoseconds);
+    }
+    uint8_t* const begin = writer_.Reserve(MaximumTraceRecordSize);
+    uint8_t* const end = EncodeTraceRecord(record, previous_time_nanoseconds_, begin);
+    writer_.Commit(end);
+    block_payload_size_ += static_cast<uint32_t>(end - begin);
+    ++block_record_count_;
+    previous_time_nanoseconds_ = record.time_nanoseconds;
+    ++record_count_;
+  }
+
+  // Records a state transition of a given kind for a given vehicle at a given time.
+  void Record(const TraceEvent event, const PhQ::Time<>& time, const Vehicle& vehicle,
+              const int64_t fault_count = 0) noexcept {
+    TraceRecord record;
+    record.event = event;
+    record.time_nanoseconds = std::llround(time.Value() * 1.0E9);
+    record.vehicle_id = vehicle.Id();
+    record.charging_station_id = vehicle.ChargingStationId().value_or(0);
+    record.fault_count = fault_count;
+    Record(record);
+  }
+
+  // Writes the remaining records and the final empty block, which records a given time at which
+  // the simulation ended. Further records are ignored.
+  void Close(const PhQ::Time<>& end_time) noexcept {
+    if (!writer_.IsOpen() || closed_) {
+      return;
+    }
+    FinishBlock();
+    BeginBlock(std::llround(end_time.Value() * 1.0E9));
+    FinishBlock();
+    --block_count_;
+    closed_ = true;
+    Log(LogLevel::Information) << "Wrote " << record_count_ << " transitions in " << block_count_
+                               << " blocks to: " << writer_.Path().string();
+  }
+
+private:
+  // Writes an unsigned variable-length integer.
+  void WriteVarint(const uint64_t value) noexcept {
+    uint8_t* const begin = writer_.Reserve(MaximumVarintSize);
+    writer_.Commit(EncodeVarint(value, begin));
+  }
+
+  // Writes a double-precision floating-point number.
+  void WriteDouble(const double value) noexcept {
+    uint8_t bytes[sizeof(double)];
+    StoreLittleEndian(value, bytes);
+    writer_.Write(bytes, sizeof(bytes));
+  }
+
+  // Writes a string as its length followed by its characters.
+  void WriteString(const std::string_view text) noexcept {
+    WriteVarint(text.size());
+    writer_.Write(text.data(), text.size());
+  }
+
+  // Writes the catalog of vehicle models and vehicles. Quantities are written in SI units.
+  void WriteCatalog(const VehicleModels& vehicle_models, const Vehicles& vehicles) noexcept {
+    writer_.Write(TransitionLogMagic.data(), TransitionLogMagic.size());
+    writer_.Write(&TransitionLogVersion, 1);
+
+    WriteVarint(vehicle_models.Size());
+    for (const std::shared_ptr<const VehicleModel>& model : vehicle_models) {
+      WriteVarint(ZigZagEncode(model->Id()));
+      WriteString(model->ManufacturerNameEnglish());
+      WriteString(model->ModelNameEnglish());
+      WriteVarint(static_cast<uint64_t>(model->PassengerCount()));
+      WriteDouble(model->CruiseSpeed().Value());
+      WriteDouble(model->BatteryCapacity().Value());
+      WriteDouble(model->ChargingDuration().Value());
+      WriteDouble(model->MeanFaultRate().Value());
+      WriteDouble(model->TransportEnergyConsumption().Value());
+    }
+
+    WriteVarint(vehicles.Size());
+    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+      WriteVarint(ZigZagEncode(vehicle->Id()));
+      WriteVarint(ZigZagEncode(vehicle->Model() != nullptr ? vehicle->Model()->Id() : -1));
+    }
+  }
+
+  // Begins a new block with a given base time by reserving room for its header in the current
+  // writer block.
+  void BeginBlock(const int64_t base_time_nanoseconds) noexcept {
+    block_header_ = writer_.Reserve(TransitionLogBlockHeaderSize);
+    writer_.Commit(block_header_ + TransitionLogBlockHeaderSize);
+    StoreLittleEndian<int64_t>(base_time_nanoseconds, block_header_ + 8);
+    block_payload_size_ = 0;
+    block_record_count_ = 0;
+    previous_time_nanoseconds_ = base_time_nanoseconds;
+  }
+
+  // Fills in the header of the current block, if any, and hands the block over to the background
+  // thread. The header is still in memory at this point because each block fills at most one
+  // writer block.
+  void FinishBlock() noexcept {
+    if (block_header_ == nullptr) {
+      return;
+    }
+    StoreLittleEndian<uint32_t>(block_payload_size_, block_header_);
+    StoreLittleEndian<uint32_t>(block_record_count_, block_header_ + 4);
+    writer_.SubmitBlock();
+    block_header_ = nullptr;
+    ++block_count_;
+  }
+
+  AsyncBinaryFileWriter writer_;
+
+  // Header of the current block, or nullptr if no block has begun.
+  uint8_t* block_header_ = nullptr;
+
+  uint32_t block_payload_size_ = 0;
+
+  uint32_t block_record_count_ = 0;
+
+  int64_t previous_time_nanoseconds_ = 0;
+
+  uint64_t record_count_ = 0;
+
+  uint64_t block_count_ = 0;
+
+  bool closed_ = false;
+};
+
+// Simulation observer that records the state transitions of vehicles through a transition log
+// writer. The writer is not owned by this observer. If no writer is given, nothing is recorded.
+class TransitionLogObserver : public SimulationObserver {
+public:
+  // Creates an observer that records transitions through a given writer, which may be null.
+  TransitionLogObserver(TransitionLogWriter* const writer = nullptr) noexcept : writer_(writer) {}
+
+  // Transition log writer of this observer. May be null.
+  TransitionLogWriter* Writer() const noexcept {
+    return writer_;
+  }
+
+  void OnTakeoff(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (writer_ != nullptr) {
+      writer_->Record(TraceEvent::Takeoff, time, vehicle);
+    }
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (writer_ != nullptr) {
+      writer_->Record(TraceEvent::Landing, time, vehicle);
+    }
+  }
+
+  void OnChargeStart(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (writer_ != nullptr) {
+      writer_->Record(TraceEvent::ChargeStart, time, vehicle);
+    }
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    if (writer_ != nullptr) {
+      writer_->Record(TraceEvent::ChargeEnd, time, vehicle);
+    }
+  }
+
+  void OnFault(const PhQ::Time<>& time, const Vehicle& vehicle,
+               const int64_t fault_count) noexcept {
+    if (writer_ != nullptr) {
+      writer_->Record(TraceEvent::Fault, time, vehicle, fault_count);
+    }
+  }
+
+private:
+  TransitionLogWriter* writer_ = nullptr;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRANSITION_LOG_HPP
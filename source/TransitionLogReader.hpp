@@ -0,0 +1,256 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRANSITION_LOG_READER_HPP
+#define DEMO_INCLUDE_TRANSITION_LOG_READER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <PhQ/Energy.hpp>
+#include <PhQ/Frequency.hpp>
+#include <PhQ/Speed.hpp>
+#include <PhQ/Time.hpp>
+#include <PhQ/TransportEnergyConsumption.hpp>
+#include <string_view>
+#include <vector>
+
+#include "ByteOrder.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include "TraceEvent.hpp"
+#include "TransitionLog.hpp"
+#include "Varint.hpp"
+#include "VehicleId.hpp"
+#include "VehicleModelId.hpp"
+#include "VehicleModels.hpp"
+
+namespace Demo {
+
+// Vehicle listed in the catalog of a binary transition log.
+struct TransitionLogVehicle {
+  VehicleId id = 0;
+
+  // ID of the vehicle's model, or -1 if the vehicle has no model.
+  VehicleModelId model_id = 0;
+};
+
+// Block of a binary transition log. Points directly into the memory-mapped file.
+struct TransitionLogBlock {
+  // First byte of the block's payload.
+  const uint8_t* begin = nullptr;
+
+  // Byte past the end of the block's payload.
+  const uint8_t* end = nullptr;
+
+  uint32_t record_count = 0;
+
+  int64_t base_time_nanoseconds = 0;
+};
+
+// Reads a binary transition log file written by TransitionLogWriter. The file is memory-mapped and
+// its catalog and block headers are read on construction; the records of each block are decoded
+// in place on demand, independently of the other blocks, so blocks can be decoded in parallel.
+class TransitionLogReader {
+public:
+  // Maps the binary transition log file at the given path and reads its catalog and block headers.
+  TransitionLogReader(const std::filesystem::path& path) noexcept : file_(path) {
+    if (!file_.IsOpen()) {
+      return;
+    }
+    const uint8_t* current = file_.Data();
+    const uint8_t* const end = file_.Data() + file_.Size();
+    if (!ReadCatalog(current, end)) {
+      Log(LogLevel::Error) << "Not a valid transition log file: " << path.string();
+      return;
+    }
+    ReadBlockHeaders(current, end);
+    if (!end_time_nanoseconds_.has_value()) {
+      Log(LogLevel::Warning) << "The transition log file is truncated: " << path.string();
+    }
+    valid_ = true;
+  }
+
+  // Returns whether the transition log file was read successfully.
+  bool IsValid() const noexcept {
+    return valid_;
+  }
+
+  // Size of the transition log file in bytes.
+  std::size_t Size() const noexcept {
+    return file_.Size();
+  }
+
+  // Vehicle models listed in the catalog.
+  const VehicleModels& Models() const noexcept {
+    return models_;
+  }
+
+  // Vehicles listed in the catalog.
+  const std::vector<TransitionLogVehicle>& Vehicles() const noexcept {
+    return vehicles_;
+  }
+
+  // Blocks of records, in order, excluding the final empty block.
+  const std::vector<TransitionLogBlock>& Blocks() const noexcept {
+    return blocks_;
+  }
+
+  // Total number of records in all blocks.
+  uint64_t RecordCount() const noexcept {
+    return record_count_;
+  }
+
+  // Time in nanoseconds at which the simulation ended, or std::nullopt if the log is truncated.
+  const std::optional<int64_t>& EndTimeNanoseconds() const noexcept {
+    return end_time_nanoseconds_;
+  }
+
+  // Decodes the records of a given block in order and calls a given function with each of them.
+  // Returns false if the block is corrupt, in which case the function may have been called with
+  // some of its records.
+  template <typename Function>
+  static bool DecodeBlock(const TransitionLogBlock& block, Function&& function) noexcept {
+    const uint8_t* current = block.begin;
+    int64_t previous_time_nanoseconds = block.base_time_nanoseconds;
+    for (uint32_t index = 0; index < block.record_count; ++index) {
+      const std::optional<TraceRecord> record =
+          DecodeTraceRecord(current, block.end, previous_time_nanoseconds);
+      if (!record.has_value()) {
+        return false;
+      }
+      previous_time_nanoseconds = record->time_nanoseconds;
+      function(record.value());
+    }
+    return current == block.end;
+  }
+
+private:
+  // Reads the magic bytes, version, and catalog. Advances the given pointer past them.
+  bool ReadCatalog(const uint8_t*& current, const uint8_t* const end) noexcept {
+    if (static_cast<std::size_t>(end - current) < TransitionLogMagic.size() + 1
+        || !std::equal(TransitionLogMagic.begin(), TransitionLogMagic.end(), current)
+        || current[TransitionLogMagic.size()] != TransitionLogVersion) {
+      return false;
+    }
+    current += TransitionLogMagic.size() + 1;
+
+    const std::optional<uint64_t> model_count = DecodeVarint(current, end);
+    if (!model_count.has_value()) {
+      return false;
+    }
+    for (uint64_t index = 0; index < model_count.value(); ++index) {
+      const std::optional<uint64_t> id = DecodeVarint(current, end);
+      const std::optional<std::string_view> manufacturer_name = ReadString(current, end);
+      const std::optional<std::string_view> model_name = ReadString(current, end);
+      const std::optional<uint64_t> passenger_count = DecodeVarint(current, end);
+      if (!id.has_value() || !manufacturer_name.has_value() || !model_name.has_value()
+          || !passenger_count.has_value()
+          || static_cast<std::size_t>(end - current) < 5 * sizeof(double)) {
+        return false;
+      }
+      models_.Insert(std::make_shared<const VehicleModel>(
+          ZigZagDecode(id.value()), manufacturer_name.value(), model_name.value(),
+          static_cast<int32_t>(passenger_count.value()),
+          PhQ::Speed<>(LoadLittleEndianDouble(current), PhQ::Unit::Speed::MetrePerSecond),
+          PhQ::Energy<>(LoadLittleEndianDouble(current + 8), PhQ::Unit::Energy::Joule),
+          PhQ::Time<>(LoadLittleEndianDouble(current + 16), PhQ::Unit::Time::Second),
+          PhQ::Frequency<>(LoadLittleEndianDouble(current + 24), PhQ::Unit::Frequency::Hertz),
+          PhQ::TransportEnergyConsumption<>(LoadLittleEndianDouble(current + 32),
+                                            PhQ::Unit::TransportEnergyConsumption::JoulePerMetre)));
+      current += 5 * sizeof(double);
+    }
+
+    const std::optional<uint64_t> vehicle_count = DecodeVarint(current, end);
+    if (!vehicle_count.has_value()
+        || vehicle_count.value() > static_cast<uint64_t>(end - current) / 2) {
+      return false;
+    }
+    vehicles_.reserve(vehicle_count.value());
+    for (uint64_t index = 0; index < vehicle_count.value(); ++index) {
+      const std::optional<uint64_t> id = DecodeVarint(current, end);
+      const std::optional<uint64_t> model_id = DecodeVarint(current, end);
+      if (!id.has_value() || !model_id.has_value()) {
+        return false;
+      }
+      vehicles_.push_back({ZigZagDecode(id.value()), ZigZagDecode(model_id.value())});
+    }
+    return true;
+  }
+
+  // Reads a string written as its length followed by its characters. The returned string points
+  // into the memory-mapped file.
+  static std::optional<std::string_view> ReadString(
+      const uint8_t*& current, const uint8_t* const end) noexcept {
+    const std::optional<uint64_t> length = DecodeVarint(current, end);
+    if (!length.has_value() || length.value() > static_cast<uint64_t>(end - current)) {
+      return std::nullopt;
+    }
+    const std::string_view text{reinterpret_cast<const char*>(current), length.value()};
+    current += length.value();
+    return text;
+  }
+
+  // Reads the block headers until the final empty block. Stops at the first incomplete block, which
+  // only occurs if the file is truncated.
+  void ReadBlockHeaders(const uint8_t* current, const uint8_t* const end) noexcept {
+    while (static_cast<std::size_t>(end - current) >= TransitionLogBlockHeaderSize) {
+      TransitionLogBlock block;
+      const uint32_t payload_size = LoadLittleEndian<uint32_t>(current);
+      block.record_count = LoadLittleEndian<uint32_t>(current + 4);
+      block.base_time_nanoseconds = LoadLittleEndian<int64_t>(current + 8);
+      current += TransitionLogBlockHeaderSize;
+      if (payload_size > static_cast<std::size_t>(end - current)) {
+        return;
+      }
+      if (block.record_count == 0) {
+        end_time_nanoseconds_ = block.base_time_nanoseconds;
+        return;
+      }
+      block.begin = current;
+      block.end = current + payload_size;
+      current = block.end;
+      record_count_ += block.record_count;
+      blocks_.push_back(block);
+    }
+  }
+
+  MappedFile file_;
+
+  VehicleModels models_;
+
+  std::vector<TransitionLogVehicle> vehicles_;
+
+  std::vector<TransitionLogBlock> blocks_;
+
+  uint64_t record_count_ = 0;
+
+  std::optional<int64_t> end_time_nanoseconds_;
+
+  bool valid_ = false;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRANSITION_LOG_READER_HPP
@@ -0,0 +1,295 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_TRANSITION_LOG_REPLAY_HPP
+#define DEMO_INCLUDE_TRANSITION_LOG_REPLAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <PhQ/Length.hpp>
+#include <PhQ/Time.hpp>
+#include <thread>
+#include <vector>
+
+#include "AggregateStatistics.hpp"
+#include "Statistics.hpp"
+#include "TraceEvent.hpp"
+#include "TransitionLogReader.hpp"
+#include "VehicleId.hpp"
+#include "VehicleIdIndex.hpp"
+
+namespace Demo {
+
+// Recomputes the statistics of each vehicle and the aggregate statistics of each vehicle model of
+// a past simulation from its binary transition log, without re-simulating. Blocks are decoded in
+// parallel. Every recorded quantity is accumulated as a per-vehicle sum: for example, the total
+// flight duration of a vehicle is the sum of its landing times minus the sum of its takeoff times,
+// plus the end time of the simulation if it is still flying at the end. Since sums do not depend on
+// the order in which they are accumulated, each block can be decoded by any thread without regard
+// for flights and charging sessions that span several blocks.
+class TransitionLogReplay {
+public:
+  // Replays the transition log of a given reader using a given number of threads. If the number of
+  // threads is zero, uses one thread per hardware thread.
+  TransitionLogReplay(const TransitionLogReader& reader, std::size_t thread_count = 0) noexcept
+    : reader_(reader) {
+    if (!reader_.IsValid()) {
+      return;
+    }
+    if (thread_count == 0) {
+      thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    thread_count_ = std::min(thread_count, std::max<std::size_t>(reader_.Blocks().size(), 1));
+
+    IndexVehicles();
+
+    const std::size_t vehicle_count = reader_.Vehicles().size();
+    sums_ = std::make_unique<std::atomic<int64_t>[]>(vehicle_count * SumCount);
+    for (std::size_t index = 0; index < vehicle_count * SumCount; ++index) {
+      sums_[index].store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<int64_t> last_times_nanoseconds(thread_count_, 0);
+    if (thread_count_ == 1) {
+      DecodeBlocks(last_times_nanoseconds[0]);
+    } else {
+      std::vector<std::thread> threads;
+      threads.reserve(thread_count_);
+      for (std::size_t index = 0; index < thread_count_; ++index) {
+        threads.emplace_back([this, &last_times_nanoseconds, index] {
+          DecodeBlocks(last_times_nanoseconds[index]);
+        });
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+
+    if (!valid_.load(std::memory_order_relaxed)) {
+      Log(LogLevel::Error) << "The transition log contains a corrupt block.";
+      return;
+    }
+
+    end_time_nanoseconds_ = reader_.EndTimeNanoseconds().value_or(
+        *std::max_element(last_times_nanoseconds.begin(), last_times_nanoseconds.end()));
+
+    ComputeStatistics();
+  }
+
+  TransitionLogReplay(const TransitionLogReplay& other) = delete;
+
+  TransitionLogReplay& operator=(const TransitionLogReplay& other) = delete;
+
+  // Returns whether the transition log was replayed successfully.
+  bool IsValid() const noexcept {
+    return reader_.IsValid() && valid_.load(std::memory_order_relaxed);
+  }
+
+  // Number of threads used to decode the blocks of the transition log.
+  std::size_t ThreadCount() const noexcept {
+    return thread_count_;
+  }
+
+  // Time at which the replayed simulation ended.
+  PhQ::Time<> EndTime() const noexcept {
+    return {static_cast<double>(end_time_nanoseconds_) * 1.0E-9, PhQ::Unit::Time::Second};
+  }
+
+  // Statistics of each vehicle, in the same order as the vehicles of the transition log's catalog.
+  const std::vector<Statistics>& VehicleStatistics() const noexcept {
+    return vehicle_statistics_;
+  }
+
+  // Returns the statistics of the vehicle with a given ID, or std::nullopt if that vehicle is not
+  // in the transition log's catalog.
+  std::optional<Statistics> At(const VehicleId id) const noexcept {
+    const std::optional<std::size_t> index = Index(id);
+    if (!index.has_value() || index.value() >= vehicle_statistics_.size()) {
+      return std::nullopt;
+    }
+    return vehicle_statistics_[index.value()];
+  }
+
+  // Aggregate statistics of each vehicle model.
+  const AggregateStatistics& Aggregate() const noexcept {
+    return aggregate_statistics_;
+  }
+
+private:
+  // Per-vehicle sums accumulated from the records.
+  enum Sum : std::size_t {
+    FlightTimeSum,
+    OpenFlightCount,
+    FlightCount,
+    ChargingTimeSum,
+    OpenChargingSessionCount,
+    ChargingSessionCount,
+    FaultCount,
+    SumCount,
+  };
+
+  // Builds the index of vehicle IDs to their index in the catalog. If the IDs are 0, 1, 2, and so
+  // on, which is the case for generated fleets, the index stays dense and IDs are used as indices.
+  void IndexVehicles() noexcept {
+    const std::vector<TransitionLogVehicle>& vehicles = reader_.Vehicles();
+    for (std::size_t index = 0; index < vehicles.size(); ++index) {
+      vehicle_ids_to_indices_.Insert(vehicles[index].id, index);
+    }
+  }
+
+  // Returns the index in the catalog of the vehicle with a given ID, or std::nullopt if not found.
+  std::optional<std::size_t> Index(const VehicleId id) const noexcept {
+    return vehicle_ids_to_indices_.Find(id);
+  }
+
+  // Adds a given value to one of the sums of the vehicle at a given index.
+  void Add(const std::size_t index, const Sum sum, const int64_t value) noexcept {
+    sums_[index * SumCount + sum].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  // Returns one of the sums of the vehicle at a given index.
+  int64_t Get(const std::size_t index, const Sum sum) const noexcept {
+    return sums_[index * SumCount + sum].load(std::memory_order_relaxed);
+  }
+
+  // Accumulates a record into the sums of its vehicle.
+  void Accumulate(const TraceRecord& record) noexcept {
+    const std::optional<std::size_t> index = Index(record.vehicle_id);
+    if (!index.has_value()) {
+      return;
+    }
+    switch (record.event) {
+      case TraceEvent::Takeoff:
+        Add(index.value(), FlightTimeSum, -record.time_nanoseconds);
+        Add(index.value(), OpenFlightCount, 1);
+        Add(index.value(), FlightCount, 1);
+        break;
+      case TraceEvent::Landing:
+        Add(index.value(), FlightTimeSum, record.time_nanoseconds);
+        Add(index.value(), OpenFlightCount, -1);
+        break;
+      case TraceEvent::ChargeStart:
+        Add(index.value(), ChargingTimeSum, -record.time_nanoseconds);
+        Add(index.value(), OpenChargingSessionCount, 1);
+        Add(index.value(), ChargingSessionCount, 1);
+        break;
+      case TraceEvent::ChargeEnd:
+        Add(index.value(), ChargingTimeSum, record.time_nanoseconds);
+        Add(index.value(), OpenChargingSessionCount, -1);
+        break;
+      case TraceEvent::Fault:
+        Add(index.value(), FaultCount, record.fault_count);
+        break;
+      case TraceEvent::Enqueue:
+        break;
+    }
+  }
+
+  // Decodes blocks until none remain. Each call takes the next block that no other thread has
+  // taken. Stores the time of the last record decoded by this call.
+  void DecodeBlocks(int64_t& last_time_nanoseconds) noexcept {
+    const std::vector<TransitionLogBlock>& blocks = reader_.Blocks();
+    for (std::size_t index = next_block_.fetch_add(1, std::memory_order_relaxed);
+         index < blocks.size(); index = next_block_.fetch_add(1, std::memory_order_relaxed)) {
+      const bool decoded =
+          TransitionLogReader::DecodeBlock(blocks[index], [&](const TraceRecord& record) {
+            Accumulate(record);
+            last_time_nanoseconds = std::max(last_time_nanoseconds, record.time_nanoseconds);
+          });
+      if (!decoded) {
+        valid_.store(false, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Computes the statistics of each vehicle from its sums and aggregates them by vehicle model.
+  void ComputeStatistics() noexcept {
+    const std::vector<TransitionLogVehicle>& vehicles = reader_.Vehicles();
+    vehicle_statistics_.resize(vehicles.size());
+    for (std::size_t index = 0; index < vehicles.size(); ++index) {
+      const std::shared_ptr<const VehicleModel> model =
+          reader_.Models().At(vehicles[index].model_id);
+      if (model == nullptr) {
+        continue;
+      }
+      Statistics& statistics = vehicle_statistics_[index];
+
+      const int64_t flight_count = Get(index, FlightCount);
+      for (int64_t count = 0; count < flight_count; ++count) {
+        statistics.IncrementTotalFlightCount();
+      }
+      if (flight_count > 0) {
+        const PhQ::Time<> duration = Duration(
+            Get(index, FlightTimeSum) + Get(index, OpenFlightCount) * end_time_nanoseconds_);
+        statistics.ModifyTotalFlightDurationAndDistance(
+            model->PassengerCount(), duration, model->CruiseSpeed() * duration);
+      }
+
+      const int64_t charging_session_count = Get(index, ChargingSessionCount);
+      for (int64_t count = 0; count < charging_session_count; ++count) {
+        statistics.IncrementTotalChargingSessionCount();
+      }
+      if (charging_session_count > 0) {
+        statistics.ModifyTotalChargingSessionDuration(
+            Duration(Get(index, ChargingTimeSum)
+                     + Get(index, OpenChargingSessionCount) * end_time_nanoseconds_));
+      }
+
+      statistics.ModifyTotalFaultCount(Get(index, FaultCount));
+
+      aggregate_statistics_.Aggregate(model->Id(), statistics);
+    }
+  }
+
+  // Converts a time duration in nanoseconds to a time duration.
+  static PhQ::Time<> Duration(const int64_t nanoseconds) noexcept {
+    return {static_cast<double>(nanoseconds) * 1.0E-9, PhQ::Unit::Time::Second};
+  }
+
+  const TransitionLogReader& reader_;
+
+  std::size_t thread_count_ = 1;
+
+  // Index of vehicle IDs to their index in the catalog.
+  VehicleIdIndex<> vehicle_ids_to_indices_;
+
+  // Sums of each vehicle, SumCount consecutive sums per vehicle.
+  std::unique_ptr<std::atomic<int64_t>[]> sums_;
+
+  // Index of the next block to decode.
+  std::atomic<std::size_t> next_block_{0};
+
+  std::atomic<bool> valid_{true};
+
+  int64_t end_time_nanoseconds_ = 0;
+
+  std::vector<Statistics> vehicle_statistics_;
+
+  AggregateStatistics aggregate_statistics_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_TRANSITION_LOG_REPLAY_HPP
@@ -0,0 +1,79 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_VARINT_HPP
+#define DEMO_INCLUDE_VARINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace Demo {
+
+// Maximum number of bytes of an encoded 64-bit variable-length integer.
+inline constexpr std::size_t MaximumVarintSize = 10;
+
+// Maps a signed integer to an unsigned integer such that values of small magnitude, whether
+// positive or negative, map to small unsigned values: 0, -1, 1, -2, 2, ... map to 0, 1, 2, 3, 4.
+inline constexpr uint64_t ZigZagEncode(const int64_t value) noexcept {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+// Inverse of ZigZagEncode.
+inline constexpr int64_t ZigZagDecode(const uint64_t value) noexcept {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Encodes an unsigned integer as a variable-length integer of 7 bits per byte, least significant
+// group first, where the high bit of each byte indicates that more bytes follow. Writes at most
+// MaximumVarintSize bytes starting at the given destination and returns a pointer past the last
+// byte written.
+inline uint8_t* EncodeVarint(uint64_t value, uint8_t* destination) noexcept {
+  while (value >= 0x80) {
+    *destination++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *destination++ = static_cast<uint8_t>(value);
+  return destination;
+}
+
+// Decodes a variable-length integer from the bytes in the range [begin, end). On success, returns
+// the decoded value and advances the given pointer past the decoded bytes. Returns std::nullopt if
+// the range ends before the variable-length integer does or if it is longer than
+// MaximumVarintSize bytes.
+inline std::optional<uint64_t> DecodeVarint(const uint8_t*& begin, const uint8_t* end) noexcept {
+  uint64_t value = 0;
+  const uint8_t* current = begin;
+  for (unsigned shift = 0; shift < 7 * MaximumVarintSize && current < end; shift += 7) {
+    const uint8_t byte = *current++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      begin = current;
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_VARINT_HPP
@@ -23,30 +23,65 @@
 #ifndef DEMO_INCLUDE_VEHICLE_HPP
 #define DEMO_INCLUDE_VEHICLE_HPP
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <random>
+#include <utility>
 
+#include "BatchSampler.hpp"
 #include "ChargingStations.hpp"
+#include "Profiler.hpp"
+#include "SimulationObserver.hpp"
 #include "Statistics.hpp"
 #include "VehicleId.hpp"
 #include "VehicleModel.hpp"
+#include "VehicleModelTable.hpp"
 #include "VehicleStatus.hpp"
 
 namespace Demo {
 
-// An individual vehicle of a given vehicle model.
+// An individual vehicle of a given vehicle model. The vehicle refers to its model by its index in
+// a vehicle model table, which it shares with the other vehicles of its collection of vehicle
+// models, and reads the model's hot parameters from that table. The vehicle does not own the
+// table, which must outlive it.
 class Vehicle {
 public:
   // Default constructor. Initializes all properties to zero.
   constexpr Vehicle() noexcept = default;
 
-  // Constructs a vehicle with a given ID and vehicle model.
-  Vehicle(const VehicleId& id, const std::shared_ptr<const VehicleModel> model) noexcept
-    : id_(id), model_(model) {
+  // Constructs a vehicle with a given ID and vehicle model. The vehicle refers to the vehicle model
+  // table that all vehicles constructed from this vehicle model share.
+  Vehicle(const VehicleId& id, const std::shared_ptr<const VehicleModel>& model) noexcept
+    : Vehicle(id, SharedVehicleModelTable(model), model == nullptr ? NoVehicleModel : 0) {}
+
+  // Constructs a vehicle with a given ID and the vehicle model at a given index in a given vehicle
+  // model table, which must outlive the vehicle.
+  Vehicle(const VehicleId& id, const VehicleModelTable* const model_table,
+          const VehicleModelIndex model_index) noexcept
+    : id_(id), model_index_(ValidModelIndex(model_table, model_index)),
+      model_table_(model_index_ == NoVehicleModel ? nullptr : model_table) {
     // Initialize the vehicle to a fully-charged battery.
-    if (model != nullptr) {
-      battery_ = model->BatteryCapacity();
+    if (model_index_ != NoVehicleModel) {
+      battery_ = PhQ::Energy<>(ModelParameters().battery_capacity, PhQ::Unit::Energy::Joule);
+    }
+  }
+
+  // Constructs a vehicle with a given ID, the vehicle model at a given index in a given vehicle
+  // model table, which must outlive the vehicle, a given initial state of charge of its battery as
+  // a fraction of its capacity, and a given home charging station, at which the vehicle charges
+  // whenever that charging station exists, or std::nullopt, in which case the vehicle charges at
+  // whichever charging station has the shortest queue.
+  Vehicle(const VehicleId& id, const VehicleModelTable* const model_table,
+          const VehicleModelIndex model_index, const double state_of_charge,
+          const std::optional<Demo::ChargingStationId>& home_charging_station_id) noexcept
+    : id_(id), model_index_(ValidModelIndex(model_table, model_index)),
+      model_table_(model_index_ == NoVehicleModel ? nullptr : model_table),
+      home_charging_station_id_(home_charging_station_id.value_or(NoHomeChargingStation)) {
+    if (model_index_ != NoVehicleModel) {
+      battery_ = PhQ::Energy<>(
+          std::clamp(state_of_charge, 0.0, 1.0) * ModelParameters().battery_capacity,
+          PhQ::Unit::Energy::Joule);
     }
   }
 
@@ -55,9 +90,29 @@ public:
     return id_;
   }
 
-  // Vehicle model of this vehicle.
+  // Vehicle model of this vehicle, or nullptr if this vehicle has no vehicle model.
   std::shared_ptr<const VehicleModel> Model() const noexcept {
-    return model_;
+    if (model_index_ == NoVehicleModel) {
+      return nullptr;
+    }
+    return model_table_->Model(model_index_);
+  }
+
+  // Vehicle model table in which this vehicle finds its vehicle model, or nullptr if this vehicle
+  // has no vehicle model.
+  constexpr const VehicleModelTable* ModelTable() const noexcept {
+    return model_table_;
+  }
+
+  // Index of the vehicle model of this vehicle in its vehicle model table, or NoVehicleModel if
+  // this vehicle has no vehicle model.
+  constexpr VehicleModelIndex ModelIndex() const noexcept {
+    return model_index_;
+  }
+
+  // Hot parameters of the vehicle model of this vehicle, which must have one.
+  const VehicleModelParameters& ModelParameters() const noexcept {
+    return model_table_->Parameters(model_index_);
   }
 
   // Current status of this vehicle.
@@ -71,6 +126,15 @@ public:
     return charging_station_id_;
   }
 
+  // Returns the ID of the home charging station of this vehicle, or std::nullopt if this vehicle
+  // has none.
+  constexpr std::optional<Demo::ChargingStationId> HomeChargingStationId() const noexcept {
+    if (home_charging_station_id_ == NoHomeChargingStation) {
+      return std::nullopt;
+    }
+    return home_charging_station_id_;
+  }
+
   // Current remaining energy in the battery of this vehicle.
   constexpr const PhQ::Energy<>& Battery() const noexcept {
     return battery_;
@@ -84,48 +148,55 @@ public:
   // Current range of this vehicle. This is the maximum distance that this vehicle can travel given
   // its current battery charge.
   PhQ::Length<> Range() const noexcept {
-    if (model_ == nullptr) {
+    if (model_index_ == NoVehicleModel) {
       return PhQ::Length<>::Zero();
     }
 
-    if (model_->TransportEnergyConsumption() <= PhQ::TransportEnergyConsumption<>::Zero()) {
+    const VehicleModelParameters& parameters = ModelParameters();
+
+    if (parameters.transport_energy_consumption <= 0.0) {
       return PhQ::Length<>::Zero();
     }
 
-    return battery_ / model_->TransportEnergyConsumption();
+    return PhQ::Length<>(
+        battery_.Value() / parameters.transport_energy_consumption, PhQ::Unit::Length::Metre);
   }
 
   // Current endurance of this vehicle. This is the maximum time duration that this vehicle can
   // remain in flight given its current battery charge.
   PhQ::Time<> Endurance() const noexcept {
-    if (model_ == nullptr) {
+    if (model_index_ == NoVehicleModel) {
       return PhQ::Time<>::Zero();
     }
 
-    if (model_->CruiseSpeed() <= PhQ::Speed<>::Zero()) {
+    const VehicleModelParameters& parameters = ModelParameters();
+
+    if (parameters.cruise_speed <= 0.0) {
       return PhQ::Time<>::Zero();
     }
 
-    return Range() / model_->CruiseSpeed();
+    return PhQ::Time<>(Range().Value() / parameters.cruise_speed, PhQ::Unit::Time::Second);
   }
 
   // Current time duration to fully charge this vehicle's battery given its current battery charge.
   PhQ::Time<> DurationToFullCharge() const noexcept {
-    if (model_ == nullptr) {
+    if (model_index_ == NoVehicleModel) {
       return PhQ::Time<>::Zero();
     }
 
-    if (battery_ >= model_->BatteryCapacity()) {
+    const VehicleModelParameters& parameters = ModelParameters();
+
+    if (battery_.Value() >= parameters.battery_capacity) {
       return PhQ::Time<>::Zero();
     }
 
-    if (model_->ChargingRate() <= PhQ::Power<>::Zero()) {
+    if (parameters.charging_rate <= 0.0) {
       return PhQ::Time<>::Zero();
     }
 
-    const PhQ::Energy energy_to_full_charge = model_->BatteryCapacity() - battery_;
+    const double energy_to_full_charge = parameters.battery_capacity - battery_.Value();
 
-    return energy_to_full_charge / model_->ChargingRate();
+    return PhQ::Time<>(energy_to_full_charge / parameters.charging_rate, PhQ::Unit::Time::Second);
   }
 
   // Returns the time duration to the next status change of this vehicle.
@@ -150,91 +221,180 @@ public:
   // each vehicle once at the beginning of each time step of the simulation and once at the end of
   // each time step of the simulation.
   void Update(ChargingStations& charging_stations) noexcept {
+    SimulationObserver observer;
+    Update(charging_stations, PhQ::Time<>::Zero(), observer);
+  }
+
+  // Updates the current vehicle's status and related properties at a given time of the simulation
+  // and notifies a given observer of any resulting status changes.
+  template <typename Observer>
+  void Update(
+      ChargingStations& charging_stations, const PhQ::Time<>& time, Observer& observer) noexcept {
     switch (status_) {
       case VehicleStatus::OnStandby:
         if (battery_ > PhQ::Energy<>::Zero()) {
-          Takeoff();
+          Takeoff(time, observer);
         } else {
-          EnqueueAtChargingStationIfNotAlready(charging_stations);
+          EnqueueAtChargingStationIfNotAlready(charging_stations, time, observer);
           if (CanBeginCharging(charging_stations)) {
-            BeginCharging();
+            BeginCharging(time, observer);
           }
         }
         break;
       case VehicleStatus::WaitingToCharge:
         if (CanBeginCharging(charging_stations)) {
-          BeginCharging();
+          BeginCharging(time, observer);
         }
         break;
       case VehicleStatus::Charging:
-        if (battery_ >= model_->BatteryCapacity()) {
-          battery_ = model_->BatteryCapacity();
-          DequeueFromChargingStation(charging_stations);
-          Takeoff();
+        if (battery_.Value() >= ModelParameters().battery_capacity) {
+          battery_ = PhQ::Energy<>(ModelParameters().battery_capacity, PhQ::Unit::Energy::Joule);
+          DequeueFromChargingStation(charging_stations, time, observer);
+          Takeoff(time, observer);
         }
         break;
       case VehicleStatus::Flying:
         if (battery_ <= PhQ::Energy<>::Zero()) {
           battery_ = PhQ::Energy<>::Zero();
-          Land();
-          EnqueueAtChargingStationIfNotAlready(charging_stations);
+          Land(time, observer);
+          EnqueueAtChargingStationIfNotAlready(charging_stations, time, observer);
         }
         break;
     }
   }
 
+  // Withdraws this vehicle from service at a given time of the simulation, as when it is retired or
+  // pulled for maintenance. If it is flying, it lands, and a given observer is notified of the
+  // landing, which ends its flight. If it is charging or waiting to charge, it leaves its charging
+  // station, and the observer is notified of the end of its charging session. The vehicle is then
+  // on standby with its current battery, so that it can later return to service.
+  template <typename Observer>
+  void Withdraw(
+      ChargingStations& charging_stations, const PhQ::Time<>& time, Observer& observer) noexcept {
+    if (status_ == VehicleStatus::Flying) {
+      Land(time, observer);
+    }
+
+    if (charging_station_id_.has_value()) {
+      const std::shared_ptr<ChargingStation> charging_station =
+          charging_stations.At(charging_station_id_.value());
+
+      if (charging_station != nullptr) {
+        if (status_ == VehicleStatus::Charging) {
+          observer.OnChargeEnd(time, *this);
+        }
+        charging_station->Remove(id_);
+      }
+
+      charging_station_id_.reset();
+    }
+
+    status_ = VehicleStatus::OnStandby;
+  }
+
   // Proceeds forward in time during a time step of the simulation. If the given time duration is
   // greater than the time duration to the next status change, it is reduced to match this duration.
-  // This method should be called once for each vehicle at each time step of the simulation.
+  // This method should be called once for each vehicle at each time step of the simulation. Faults
+  // are drawn from a given random source, which is either a standard random generator or a batch
+  // sampler.
+  template <typename RandomSource>
   void PerformTimeStep(const PhQ::Time<>& duration, ChargingStations& charging_stations,
-                       std::mt19937_64& random_generator) noexcept {
+                       RandomSource& random_generator) noexcept {
+    SimulationObserver observer;
+    PerformTimeStep(duration, charging_stations, random_generator, PhQ::Time<>::Zero(), observer);
+  }
+
+  // Proceeds forward in time during a time step of the simulation that begins at a given time and
+  // notifies a given observer of any resulting status changes.
+  template <typename RandomSource, typename Observer>
+  void PerformTimeStep(const PhQ::Time<>& duration, ChargingStations& charging_stations,
+                       RandomSource& random_generator, const PhQ::Time<>& time,
+                       Observer& observer) noexcept {
     const PhQ::Time effective_duration = std::min(duration, DurationToNextStatusChange());
     switch (status_) {
       case VehicleStatus::OnStandby:
         if (battery_ > PhQ::Energy<>::Zero()) {
-          Takeoff();
-          Fly(effective_duration, random_generator);
+          Takeoff(time, observer);
+          Fly(effective_duration, random_generator, time, observer);
         } else {
-          EnqueueAtChargingStationIfNotAlready(charging_stations);
+          EnqueueAtChargingStationIfNotAlready(charging_stations, time, observer);
         }
         break;
       case VehicleStatus::WaitingToCharge:
         if (CanBeginCharging(charging_stations)) {
-          BeginCharging();
-          Charge(effective_duration, random_generator);
+          BeginCharging(time, observer);
+          Charge(effective_duration, random_generator, time, observer);
         }
         break;
       case VehicleStatus::Charging:
-        Charge(effective_duration, random_generator);
+        Charge(effective_duration, random_generator, time, observer);
         break;
       case VehicleStatus::Flying:
-        Fly(effective_duration, random_generator);
+        Fly(effective_duration, random_generator, time, observer);
         break;
     }
   }
 
+  // Sets the battery of this vehicle and adds given flight and charging totals to its statistics.
+  // Used to write back time steps during which this vehicle flew or charged without changing status,
+  // which were applied in bulk to a copy of its state, as by FleetState.
+  void ApplyTimeSteps(const PhQ::Energy<>& battery, const PhQ::Time<>& flight_duration,
+                      const PhQ::Length<>& flight_distance,
+                      const PhQ::Length<>& flight_passenger_distance,
+                      const PhQ::Time<>& charging_duration) noexcept {
+    battery_ = battery;
+    statistics_.ModifyTotalFlightDurationAndDistance(
+        flight_duration, flight_distance, flight_passenger_distance);
+    statistics_.ModifyTotalChargingSessionDuration(charging_duration);
+  }
+
+  // Records a given number of faults of this vehicle that were drawn at a given time of the
+  // simulation, as by FleetState, and notifies a given observer of them if there are any.
+  template <typename Observer>
+  void RecordFaults(const PhQ::Time<>& time, const int64_t count, Observer& observer) noexcept {
+    statistics_.ModifyTotalFaultCount(count);
+
+    if (count > 0) {
+      observer.OnFault(time, *this, count);
+    }
+  }
+
 private:
   // This vehicle takes off and begins flying.
-  void Takeoff() noexcept {
+  template <typename Observer>
+  void Takeoff(const PhQ::Time<>& time, Observer& observer) noexcept {
     status_ = VehicleStatus::Flying;
     statistics_.IncrementTotalFlightCount();
+    observer.OnTakeoff(time, *this);
   }
 
   // This vehicle lands.
-  void Land() noexcept {
+  template <typename Observer>
+  void Land(const PhQ::Time<>& time, Observer& observer) noexcept {
     status_ = VehicleStatus::OnStandby;
+    observer.OnLanding(time, *this);
   }
 
-  // This vehicle enqueues at a charging station if it is not already.
-  void EnqueueAtChargingStationIfNotAlready(ChargingStations& charging_stations) noexcept {
+  // This vehicle enqueues at a charging station if it is not already: at its home charging station
+  // if it has one that exists, or else at the charging station with the shortest queue.
+  template <typename Observer>
+  void EnqueueAtChargingStationIfNotAlready(
+      ChargingStations& charging_stations, const PhQ::Time<>& time, Observer& observer) noexcept {
     if (!charging_station_id_.has_value()) {
-      const std::shared_ptr<ChargingStation> best_charging_station =
-          charging_stations.LowestCount();
+      std::shared_ptr<ChargingStation> best_charging_station =
+          home_charging_station_id_ != NoHomeChargingStation ?
+              charging_stations.At(home_charging_station_id_) :
+              nullptr;
+
+      if (best_charging_station == nullptr) {
+        best_charging_station = charging_stations.LowestCount();
+      }
 
       if (best_charging_station != nullptr) {
         best_charging_station->Enqueue(id_);
         charging_station_id_ = best_charging_station->Id();
         status_ = VehicleStatus::WaitingToCharge;
+        observer.OnEnqueue(time, *this);
       }
     }
   }
@@ -255,33 +415,40 @@ private:
   }
 
   // This vehicle begins charging at its current charging station.
-  void BeginCharging() noexcept {
+  template <typename Observer>
+  void BeginCharging(const PhQ::Time<>& time, Observer& observer) noexcept {
     status_ = VehicleStatus::Charging;
     statistics_.IncrementTotalChargingSessionCount();
+    observer.OnChargeStart(time, *this);
   }
 
   // This vehicle charges its battery at its current charging station.
-  void Charge(const PhQ::Time<>& duration, std::mt19937_64& random_generator) noexcept {
+  template <typename RandomSource, typename Observer>
+  void Charge(const PhQ::Time<>& duration, RandomSource& random_generator, const PhQ::Time<>& time,
+              Observer& observer) noexcept {
     status_ = VehicleStatus::Charging;
 
-    if (model_ == nullptr) {
+    if (model_index_ == NoVehicleModel) {
       return;
     }
 
-    battery_ += model_->ChargingRate() * duration;
+    battery_.MutableValue() += ModelParameters().charging_rate * duration.Value();
 
     statistics_.ModifyTotalChargingSessionDuration(duration);
 
-    RandomlyGenerateFaults(duration, random_generator);
+    RandomlyGenerateFaults(duration, random_generator, time, observer);
   }
 
   // This vehicle stops charging at its current charging station and dequeues from it.
-  void DequeueFromChargingStation(ChargingStations& charging_stations) noexcept {
+  template <typename Observer>
+  void DequeueFromChargingStation(
+      ChargingStations& charging_stations, const PhQ::Time<>& time, Observer& observer) noexcept {
     if (charging_station_id_.has_value()) {
       const std::shared_ptr<ChargingStation> charging_station =
           charging_stations.At(charging_station_id_.value());
 
       if (charging_station != nullptr) {
+        observer.OnChargeEnd(time, *this);
         charging_station->Dequeue();
         charging_station_id_.reset();
       }
@@ -289,47 +456,81 @@ private:
   }
 
   // This vehicle flies for a given time duration.
-  void Fly(const PhQ::Time<>& duration, std::mt19937_64& random_generator) noexcept {
+  template <typename RandomSource, typename Observer>
+  void Fly(const PhQ::Time<>& duration, RandomSource& random_generator, const PhQ::Time<>& time,
+           Observer& observer) noexcept {
     status_ = VehicleStatus::Flying;
 
-    if (model_ == nullptr) {
+    if (model_index_ == NoVehicleModel) {
       return;
     }
 
-    const PhQ::Length distance = model_->CruiseSpeed() * duration;
+    const VehicleModelParameters& parameters = ModelParameters();
+
+    const PhQ::Length distance{
+        parameters.cruise_speed * duration.Value(), PhQ::Unit::Length::Metre};
 
-    battery_ -= model_->TransportPowerUsage() * duration;
+    battery_.MutableValue() -= parameters.transport_power_usage * duration.Value();
 
-    statistics_.ModifyTotalFlightDurationAndDistance(model_->PassengerCount(), duration, distance);
+    statistics_.ModifyTotalFlightDurationAndDistance(
+        parameters.passenger_count, duration, distance);
 
-    RandomlyGenerateFaults(duration, random_generator);
+    RandomlyGenerateFaults(duration, random_generator, time, observer);
   }
 
   // Given a time duration, randomly generates faults during this time according to this vehicle
-  // model's mean fault rate using a random Poisson process.
-  void RandomlyGenerateFaults(
-      const PhQ::Time<>& duration, std::mt19937_64& random_generator) noexcept {
-    if (model_ == nullptr) {
+  // model's mean fault rate using a random Poisson process. The number of faults is drawn from a
+  // given random source, which is either a standard random generator or a batch sampler.
+  template <typename RandomSource, typename Observer>
+  void RandomlyGenerateFaults(const PhQ::Time<>& duration, RandomSource& random_generator,
+                              const PhQ::Time<>& time, Observer& observer) noexcept {
+    if (model_index_ == NoVehicleModel) {
       return;
     }
 
-    const double expected_faults_during_this_duration = duration * model_->MeanFaultRate();
+    const double expected_faults_during_this_duration =
+        duration.Value() * ModelParameters().mean_fault_rate;
 
-    std::poisson_distribution<int64_t> distribution(expected_faults_during_this_duration);
+    int64_t faults_during_this_duration = 0;
+    {
+      DEMO_PROFILE_SCOPE(RandomDraw);
+      faults_during_this_duration =
+          DrawPoisson(expected_faults_during_this_duration, random_generator);
+    }
+
+    RecordFaults(time, faults_during_this_duration, observer);
+  }
 
-    const int64_t faults_during_this_duration = distribution(random_generator);
+  // Marks a vehicle without a home charging station.
+  static constexpr Demo::ChargingStationId NoHomeChargingStation = -1;
 
-    statistics_.ModifyTotalFaultCount(faults_during_this_duration);
+  // Returns a given index if it is valid in a given vehicle model table, or NoVehicleModel
+  // otherwise.
+  static VehicleModelIndex ValidModelIndex(
+      const VehicleModelTable* const model_table, const VehicleModelIndex model_index) noexcept {
+    if (model_table == nullptr || model_index < 0
+        || static_cast<std::size_t>(model_index) >= model_table->Size()) {
+      return NoVehicleModel;
+    }
+    return model_index;
   }
 
   VehicleId id_ = 0;
 
-  std::shared_ptr<const VehicleModel> model_;
+  VehicleModelIndex model_index_ = NoVehicleModel;
+
+  // Vehicle model table of this vehicle, which it does not own, or nullptr if this vehicle has no
+  // vehicle model.
+  const VehicleModelTable* model_table_ = nullptr;
 
   VehicleStatus status_ = VehicleStatus::OnStandby;
 
   std::optional<Demo::ChargingStationId> charging_station_id_;
 
+  // Home charging station ID, or NoHomeChargingStation. Stored without std::optional, which would
+  // take twice the space.
+  Demo::ChargingStationId home_charging_station_id_ = NoHomeChargingStation;
+
   PhQ::Energy<> battery_ = PhQ::Energy<>::Zero();
 
   Demo::Statistics statistics_;
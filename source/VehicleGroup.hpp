@@ -0,0 +1,210 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_VEHICLE_GROUP_HPP
+#define DEMO_INCLUDE_VEHICLE_GROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BatchSampler.hpp"
+#include "FleetKernels.hpp"
+#include "Statistics.hpp"
+#include "Vehicle.hpp"
+#include "VehicleId.hpp"
+#include "VehicleModelTable.hpp"
+
+namespace Demo {
+
+// Group of vehicles in the same status whose batteries and statistics are stored as
+// structure-of-arrays of raw values in SI units, so that a time step of the whole group is applied
+// by a single SIMD kernel. Values are converted to and from physical quantities only when vehicles
+// are inserted and when their state is read.
+class VehicleGroup {
+public:
+  // Constructs an empty group.
+  VehicleGroup() noexcept = default;
+
+  // Constructs an empty group whose time steps are applied by the kernels of a given table, which
+  // must outlive this group. The kernels of CatalogKernels apply only to groups whose vehicles all
+  // have the vehicle model for which they are specialized.
+  explicit VehicleGroup(const FleetKernelTable& kernels) noexcept : kernels_(&kernels) {}
+
+  // Returns whether this group is empty.
+  bool Empty() const noexcept {
+    return ids_.empty();
+  }
+
+  // Returns the number of vehicles in this group.
+  std::size_t Size() const noexcept {
+    return ids_.size();
+  }
+
+  // Inserts a copy of the state of a given vehicle at the back of this group. Returns true if the
+  // vehicle was inserted, or false if it has no vehicle model.
+  bool Insert(const Vehicle& vehicle) noexcept {
+    if (vehicle.ModelIndex() == NoVehicleModel) {
+      return false;
+    }
+
+    const VehicleModelParameters& parameters = vehicle.ModelParameters();
+    const Demo::Statistics& statistics = vehicle.Statistics();
+
+    ids_.push_back(vehicle.Id());
+    battery_.push_back(vehicle.Battery().Value());
+    transport_power_usage_.push_back(parameters.transport_power_usage);
+    cruise_speed_.push_back(parameters.cruise_speed);
+    passenger_count_.push_back(static_cast<double>(parameters.passenger_count));
+    charging_rate_.push_back(parameters.charging_rate);
+    mean_fault_rate_.push_back(parameters.mean_fault_rate);
+    expected_faults_.push_back(0.0);
+    faults_.push_back(0);
+    flight_count_.push_back(statistics.TotalFlightCount());
+    flight_duration_.push_back(statistics.TotalFlightDuration().Value());
+    flight_distance_.push_back(statistics.TotalFlightDistance().Value());
+    flight_passenger_distance_.push_back(statistics.TotalFlightPassengerDistance().Value());
+    charging_session_count_.push_back(statistics.TotalChargingSessionCount());
+    charging_duration_.push_back(statistics.TotalChargingDuration().Value());
+    fault_count_.push_back(statistics.TotalFaultCount());
+    return true;
+  }
+
+  // ID of the vehicle at a given position in this group.
+  VehicleId Id(const std::size_t position) const noexcept {
+    return ids_[position];
+  }
+
+  // Remaining battery energy of the vehicle at a given position in this group.
+  PhQ::Energy<> Battery(const std::size_t position) const noexcept {
+    return PhQ::Energy<>(battery_[position], PhQ::Unit::Energy::Joule);
+  }
+
+  // Statistics of the vehicle at a given position in this group.
+  Demo::Statistics Statistics(const std::size_t position) const noexcept {
+    return Demo::Statistics(
+        flight_count_[position], PhQ::Time<>(flight_duration_[position], PhQ::Unit::Time::Second),
+        PhQ::Length<>(flight_distance_[position], PhQ::Unit::Length::Metre),
+        PhQ::Length<>(flight_passenger_distance_[position], PhQ::Unit::Length::Metre),
+        charging_session_count_[position],
+        PhQ::Time<>(charging_duration_[position], PhQ::Unit::Time::Second),
+        fault_count_[position]);
+  }
+
+  // Flies all vehicles of this group for a given time duration.
+  void Fly(const PhQ::Time<>& duration) noexcept {
+    kernels_->fly(Flight(), duration.Value());
+  }
+
+  // Charges all vehicles of this group for a given time duration.
+  void Charge(const PhQ::Time<>& duration) noexcept {
+    kernels_->charge(Charging(), duration.Value());
+  }
+
+  // Randomly generates faults on all vehicles of this group during a given time duration according
+  // to their vehicle models' mean fault rates. The means of the vehicles' Poisson distributions are
+  // computed by a single SIMD kernel, and then the faults of the whole group are drawn in one batch
+  // from a given batch sampler. This draws the same faults as Vehicle::RandomlyGenerateFaults would
+  // for each vehicle in turn from the same sampler. Returns the total number of faults generated.
+  int64_t RandomlyGenerateFaults(const PhQ::Time<>& duration, BatchSampler& sampler) noexcept {
+    kernels_->fault(Faults(), duration.Value());
+    sampler.Poisson(expected_faults_.data(), ids_.size(), faults_.data());
+    int64_t total = 0;
+    for (std::size_t index = 0; index < ids_.size(); ++index) {
+      fault_count_[index] += faults_[index];
+      total += faults_[index];
+    }
+    return total;
+  }
+
+  // Structure-of-arrays view of this group for the flight kernels.
+  FlightArrays Flight() noexcept {
+    FlightArrays arrays;
+    arrays.count = ids_.size();
+    arrays.battery = battery_.data();
+    arrays.transport_power_usage = transport_power_usage_.data();
+    arrays.cruise_speed = cruise_speed_.data();
+    arrays.passenger_count = passenger_count_.data();
+    arrays.flight_duration = flight_duration_.data();
+    arrays.flight_distance = flight_distance_.data();
+    arrays.flight_passenger_distance = flight_passenger_distance_.data();
+    return arrays;
+  }
+
+  // Structure-of-arrays view of this group for the charging kernels.
+  ChargingArrays Charging() noexcept {
+    ChargingArrays arrays;
+    arrays.count = ids_.size();
+    arrays.battery = battery_.data();
+    arrays.charging_rate = charging_rate_.data();
+    arrays.charging_duration = charging_duration_.data();
+    return arrays;
+  }
+
+  // Structure-of-arrays view of this group for the fault sampling kernels.
+  FaultArrays Faults() noexcept {
+    FaultArrays arrays;
+    arrays.count = ids_.size();
+    arrays.mean_fault_rate = mean_fault_rate_.data();
+    arrays.expected_faults = expected_faults_.data();
+    return arrays;
+  }
+
+private:
+  const FleetKernelTable* kernels_ = &GlobalFleetKernels();
+
+  std::vector<VehicleId> ids_;
+
+  std::vector<double> battery_;
+
+  std::vector<double> transport_power_usage_;
+
+  std::vector<double> cruise_speed_;
+
+  std::vector<double> passenger_count_;
+
+  std::vector<double> charging_rate_;
+
+  std::vector<double> mean_fault_rate_;
+
+  std::vector<double> expected_faults_;
+
+  std::vector<int64_t> faults_;
+
+  std::vector<int64_t> flight_count_;
+
+  std::vector<double> flight_duration_;
+
+  std::vector<double> flight_distance_;
+
+  std::vector<double> flight_passenger_distance_;
+
+  std::vector<int64_t> charging_session_count_;
+
+  std::vector<double> charging_duration_;
+
+  std::vector<int64_t> fault_count_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_VEHICLE_GROUP_HPP
@@ -0,0 +1,156 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_VEHICLE_ID_INDEX_HPP
+#define DEMO_INCLUDE_VEHICLE_ID_INDEX_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include "FlatHashMap.hpp"
+#include "VehicleId.hpp"
+
+namespace Demo {
+
+// Index of vehicle IDs to the positions of the vehicles in a list. As long as every vehicle ID
+// equals its position, which is the case when vehicle IDs are assigned densely from zero, the
+// index is dense: it stores nothing, and a lookup is a bounds check. The first vehicle ID that
+// breaks this switches the index to a flat hash map of all the vehicle IDs, which serves sparse
+// external vehicle IDs.
+template <typename Allocator = std::allocator<VehicleId>>
+class VehicleIdIndex {
+public:
+  using allocator_type = Allocator;
+
+  // Constructs an empty dense index without allocating.
+  VehicleIdIndex() noexcept = default;
+
+  // Constructs an empty dense index whose hash map allocates with a given allocator, without
+  // allocating.
+  explicit VehicleIdIndex(const Allocator& allocator) noexcept : positions_(allocator) {}
+
+  // Returns whether this index is dense, in which case every vehicle ID equals its position.
+  bool Dense() const noexcept {
+    return dense_;
+  }
+
+  // Returns the number of vehicle IDs in this index.
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Prepares this index to hold a given number of vehicle IDs without growing again. Does not
+  // allocate while this index is dense.
+  void Reserve(const std::size_t count) noexcept {
+    if (!dense_) {
+      positions_.Reserve(count);
+    }
+  }
+
+  // Inserts a given vehicle ID at a given position. Returns true if the vehicle ID was inserted, or
+  // false if it was already in this index, in which case its position is unchanged. This index
+  // stays dense as long as each inserted vehicle ID equals both its position and the number of
+  // vehicle IDs already in this index.
+  bool Insert(const VehicleId id, const std::size_t position) noexcept {
+    if (dense_) {
+      if (id >= 0 && static_cast<std::size_t>(id) < size_) {
+        return false;
+      }
+      if (id == static_cast<VehicleId>(size_) && position == size_) {
+        ++size_;
+        return true;
+      }
+      MakeSparse();
+    }
+    if (!positions_.Insert(id, position)) {
+      return false;
+    }
+    ++size_;
+    return true;
+  }
+
+  // Erases a given vehicle ID from this index. Returns true if the vehicle ID was erased, or false
+  // if it was not in this index. Erasing a vehicle ID makes this index sparse.
+  bool Erase(const VehicleId id) noexcept {
+    if (!Contains(id)) {
+      return false;
+    }
+    if (dense_) {
+      MakeSparse();
+    }
+    positions_.Erase(id);
+    --size_;
+    return true;
+  }
+
+  // Returns the position of a given vehicle ID, or std::nullopt if it is not in this index.
+  std::optional<std::size_t> Find(const VehicleId id) const noexcept {
+    if (dense_) {
+      if (id >= 0 && static_cast<std::size_t>(id) < size_) {
+        return static_cast<std::size_t>(id);
+      }
+      return std::nullopt;
+    }
+    const std::size_t* const position = positions_.Find(id);
+    if (position != nullptr) {
+      return *position;
+    }
+    return std::nullopt;
+  }
+
+  // Returns whether a given vehicle ID is in this index.
+  bool Contains(const VehicleId id) const noexcept {
+    return Find(id).has_value();
+  }
+
+  // Removes all vehicle IDs from this index, which becomes dense again, without releasing the
+  // capacity of its hash map.
+  void Clear() noexcept {
+    positions_.Clear();
+    size_ = 0;
+    dense_ = true;
+  }
+
+private:
+  // Moves the vehicle IDs of this dense index into its hash map.
+  void MakeSparse() noexcept {
+    positions_.Reserve(2 * size_ + 1);
+    for (std::size_t position = 0; position < size_; ++position) {
+      positions_.Insert(static_cast<VehicleId>(position), position);
+    }
+    dense_ = false;
+  }
+
+  // Whether every vehicle ID equals its position.
+  bool dense_ = true;
+
+  // Number of vehicle IDs.
+  std::size_t size_ = 0;
+
+  // Positions of the vehicle IDs, used once this index is no longer dense.
+  FlatHashMap<VehicleId, std::size_t, Allocator> positions_;
+};
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_VEHICLE_ID_INDEX_HPP
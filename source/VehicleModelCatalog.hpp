@@ -0,0 +1,207 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_VEHICLE_MODEL_CATALOG_HPP
+#define DEMO_INCLUDE_VEHICLE_MODEL_CATALOG_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <PhQ/Energy.hpp>
+#include <PhQ/Frequency.hpp>
+#include <PhQ/Speed.hpp>
+#include <PhQ/Time.hpp>
+#include <PhQ/TransportEnergyConsumption.hpp>
+#include <string_view>
+#include <system_error>
+
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include "VehicleModel.hpp"
+#include "VehicleModelId.hpp"
+#include "VehicleModelTable.hpp"
+#include "VehicleModels.hpp"
+
+namespace Demo {
+
+// Header line of a CSV vehicle model catalog file.
+inline constexpr std::string_view VehicleModelCatalogCsvHeader{
+    "id,manufacturer,model,passenger_count,cruise_speed_mph,battery_capacity_kwh,"
+    "charging_duration_hours,fault_rate_per_hour,energy_use_kwh_per_mile"};
+
+// Entry of a vehicle model catalog, in the units in which catalogs are written. This is a literal
+// type, so a catalog known at build time can be a constexpr array of entries, from which the hot
+// parameters of each vehicle model are computed at compile time.
+struct VehicleModelSpec {
+  VehicleModelId id = 0;
+
+  std::string_view manufacturer_name_english;
+
+  std::string_view model_name_english;
+
+  int32_t passenger_count = 0;
+
+  double cruise_speed_miles_per_hour = 0.0;
+
+  double battery_capacity_kilowatt_hours = 0.0;
+
+  double charging_duration_hours = 0.0;
+
+  double fault_rate_per_hour = 0.0;
+
+  double energy_use_kilowatt_hours_per_mile = 0.0;
+
+  // Constructs the vehicle model of this entry.
+  std::shared_ptr<const VehicleModel> ToVehicleModel() const noexcept {
+    return std::make_shared<VehicleModel>(
+        id, manufacturer_name_english, model_name_english, passenger_count,
+        PhQ::Speed(cruise_speed_miles_per_hour, PhQ::Unit::Speed::MilePerHour),
+        PhQ::Energy(battery_capacity_kilowatt_hours, PhQ::Unit::Energy::KilowattHour),
+        PhQ::Time(charging_duration_hours, PhQ::Unit::Time::Hour),
+        PhQ::Frequency(fault_rate_per_hour, PhQ::Unit::Frequency::PerHour),
+        PhQ::TransportEnergyConsumption(
+            energy_use_kilowatt_hours_per_mile,
+            PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile));
+  }
+
+  // Hot parameters of the vehicle model of this entry as raw values in SI units, computed as by
+  // VehicleModel and VehicleModelTable::Register, but at compile time for a constexpr entry. Unit
+  // conversions may differ from those of the vehicle model in the last bit.
+  constexpr VehicleModelParameters Parameters() const noexcept {
+    constexpr double MetresPerMile = 1609.344;
+    constexpr double SecondsPerHour = 3600.0;
+    constexpr double JoulesPerKilowattHour = 3.6e6;
+    VehicleModelParameters parameters;
+    parameters.cruise_speed =
+        std::max(cruise_speed_miles_per_hour, 0.0) * MetresPerMile / SecondsPerHour;
+    parameters.battery_capacity =
+        std::max(battery_capacity_kilowatt_hours, 0.0) * JoulesPerKilowattHour;
+    parameters.transport_energy_consumption =
+        std::max(energy_use_kilowatt_hours_per_mile, 0.0) * JoulesPerKilowattHour / MetresPerMile;
+    parameters.transport_power_usage =
+        parameters.cruise_speed * parameters.transport_energy_consumption;
+    const double charging_duration = std::max(charging_duration_hours, 0.0) * SecondsPerHour;
+    parameters.charging_rate =
+        charging_duration > 0.0 ? parameters.battery_capacity / charging_duration : 0.0;
+    parameters.mean_fault_rate = std::max(fault_rate_per_hour, 0.0) / SecondsPerHour;
+    parameters.passenger_count = std::max(passenger_count, 0);
+    return parameters;
+  }
+};
+
+// Constructs a collection of the vehicle models of the entries of a given catalog, in order.
+// Entries whose vehicle model ID repeats an earlier entry's are skipped.
+template <typename Catalog>
+VehicleModels VehicleModelsFromCatalog(const Catalog& catalog) noexcept {
+  VehicleModels vehicle_models;
+  for (const VehicleModelSpec& spec : catalog) {
+    vehicle_models.Insert(spec.ToVehicleModel());
+  }
+  return vehicle_models;
+}
+
+// Reads the vehicle models of a CSV vehicle model catalog file at a given path. The file has one
+// vehicle model per line, with the fields of VehicleModelCatalogCsvHeader, which may be given as
+// its first line; names cannot contain commas, and empty lines are skipped. The file is
+// memory-mapped and parsed in place. Returns an empty collection and logs an error if the file
+// cannot be read, if a line is malformed, or if two lines have the same vehicle model ID.
+inline VehicleModels ReadVehicleModelCatalog(
+    const std::filesystem::path& path) noexcept {
+  const MappedFile file{path};
+  if (!file.IsOpen()) {
+    return VehicleModels{};
+  }
+
+  const char* current = reinterpret_cast<const char*>(file.Data());
+  const char* const end = current + file.Size();
+
+  // Parses a number at the current position and the comma or line ending that follows it.
+  const auto parse_number = [&](auto& value, const bool last) {
+    const std::from_chars_result result = std::from_chars(current, end, value);
+    if (result.ec != std::errc()) {
+      return false;
+    }
+    current = result.ptr;
+    if (last) {
+      current += current < end && *current == '\r' ? 1 : 0;
+      return current == end || *current == '\n';
+    }
+    return current < end && *current++ == ',';
+  };
+
+  // Reads the text at the current position up to the next comma.
+  const auto parse_text = [&](std::string_view& text) {
+    const char* const comma = std::find(current, end, ',');
+    if (comma == end) {
+      return false;
+    }
+    text = std::string_view(current, static_cast<std::size_t>(comma - current));
+    current = comma + 1;
+    return text.find('\n') == std::string_view::npos;
+  };
+
+  VehicleModels vehicle_models;
+  std::size_t line = 0;
+  while (current < end) {
+    ++line;
+    if (*current == '\n' || *current == '\r') {
+      current = std::find(current, end, '\n');
+      current += current < end ? 1 : 0;
+      continue;
+    }
+    if (line == 1 && !((*current >= '0' && *current <= '9') || *current == '-')) {
+      current = std::find(current, end, '\n');
+      current += current < end ? 1 : 0;
+      continue;
+    }
+    VehicleModelSpec spec;
+    if (!parse_number(spec.id, false) || !parse_text(spec.manufacturer_name_english)
+        || !parse_text(spec.model_name_english) || !parse_number(spec.passenger_count, false)
+        || !parse_number(spec.cruise_speed_miles_per_hour, false)
+        || !parse_number(spec.battery_capacity_kilowatt_hours, false)
+        || !parse_number(spec.charging_duration_hours, false)
+        || !parse_number(spec.fault_rate_per_hour, false)
+        || !parse_number(spec.energy_use_kilowatt_hours_per_mile, true)) {
+      Log(LogLevel::Error) << "Line " << line << " of the vehicle model catalog file "
+                           << path.string() << " is malformed.";
+      return VehicleModels{};
+    }
+    if (!vehicle_models.Insert(spec.ToVehicleModel())) {
+      Log(LogLevel::Error) << "Line " << line << " of the vehicle model catalog file "
+                           << path.string() << " repeats the vehicle model ID " << spec.id << ".";
+      return VehicleModels{};
+    }
+    current += current < end ? 1 : 0;
+  }
+
+  Log(LogLevel::Information) << "Read " << vehicle_models.Size()
+                             << " vehicle models from the catalog: " << path.string();
+
+  return vehicle_models;
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_VEHICLE_MODEL_CATALOG_HPP
@@ -0,0 +1,170 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef DEMO_INCLUDE_VEHICLE_MODEL_TABLE_HPP
+#define DEMO_INCLUDE_VEHICLE_MODEL_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Logger.hpp"
+#include "VehicleModel.hpp"
+
+namespace Demo {
+
+// Position of a vehicle model in the vehicle model table. Small so that vehicles stay compact. Not
+// to be confused with VehicleModelId, which is chosen by the catalog of vehicle models.
+using VehicleModelIndex = int16_t;
+
+// Index of no vehicle model.
+inline constexpr VehicleModelIndex NoVehicleModel = -1;
+
+// Parameters of a vehicle model that vehicles read at every time step, stored as raw values in SI
+// units. They are copied from the vehicle model so that they do not share cache lines with its
+// names, and they fit in a single cache line.
+struct alignas(64) VehicleModelParameters {
+  // Cruise speed in metres per second.
+  double cruise_speed = 0.0;
+
+  // Transport power usage in watts.
+  double transport_power_usage = 0.0;
+
+  // Transport energy consumption in joules per metre.
+  double transport_energy_consumption = 0.0;
+
+  // Charging rate in watts.
+  double charging_rate = 0.0;
+
+  // Battery capacity in joules.
+  double battery_capacity = 0.0;
+
+  // Mean fault rate in hertz.
+  double mean_fault_rate = 0.0;
+
+  int32_t passenger_count = 0;
+};
+
+// Table of the vehicle models used by vehicles, split into a packed table of hot parameters and a
+// table of the cold vehicle models themselves, both indexed by VehicleModelIndex. Vehicles refer
+// to their model by its index in this table and a plain pointer to the table rather than by a
+// shared pointer. Each collection of vehicle models owns its table, and each collection of
+// vehicles keeps the table of its vehicles alive, so a table must outlive the vehicles that refer
+// to it.
+class VehicleModelTable {
+public:
+  // Maximum number of vehicle models.
+  static constexpr std::size_t Capacity = std::numeric_limits<VehicleModelIndex>::max();
+
+  // Constructs an empty table.
+  VehicleModelTable() noexcept = default;
+
+  // Returns the index of a given vehicle model, adding it to this table if it is not already in
+  // it. Returns NoVehicleModel if the vehicle model is nullptr or if this table is full. Must not
+  // be called while vehicles are reading their parameters from this table.
+  VehicleModelIndex Register(const std::shared_ptr<const VehicleModel>& model) noexcept {
+    if (model == nullptr) {
+      return NoVehicleModel;
+    }
+
+    const std::unordered_map<const VehicleModel*, VehicleModelIndex>::const_iterator found =
+        indices_.find(model.get());
+    if (found != indices_.cend()) {
+      return found->second;
+    }
+
+    if (models_.size() >= Capacity) {
+      Log(LogLevel::Error) << "Cannot register more than " << Capacity << " vehicle models.";
+      return NoVehicleModel;
+    }
+
+    const VehicleModelIndex index = static_cast<VehicleModelIndex>(models_.size());
+    VehicleModelParameters parameters;
+    parameters.cruise_speed = model->CruiseSpeed().Value();
+    parameters.transport_power_usage = model->TransportPowerUsage().Value();
+    parameters.transport_energy_consumption = model->TransportEnergyConsumption().Value();
+    parameters.charging_rate = model->ChargingRate().Value();
+    parameters.battery_capacity = model->BatteryCapacity().Value();
+    parameters.mean_fault_rate = model->MeanFaultRate().Value();
+    parameters.passenger_count = model->PassengerCount();
+    parameters_.push_back(parameters);
+    models_.push_back(model);
+    indices_.emplace(model.get(), index);
+    return index;
+  }
+
+  // Number of vehicle models in this table.
+  std::size_t Size() const noexcept {
+    return models_.size();
+  }
+
+  // Hot parameters of the vehicle model at a given index, which must be valid.
+  const VehicleModelParameters& Parameters(const VehicleModelIndex index) const noexcept {
+    return parameters_[static_cast<std::size_t>(index)];
+  }
+
+  // Vehicle model at a given index, or nullptr if the index is NoVehicleModel or out of range.
+  std::shared_ptr<const VehicleModel> Model(const VehicleModelIndex index) const noexcept {
+    if (index < 0 || static_cast<std::size_t>(index) >= models_.size()) {
+      return nullptr;
+    }
+    return models_[static_cast<std::size_t>(index)];
+  }
+
+private:
+  std::vector<VehicleModelParameters> parameters_;
+
+  std::vector<std::shared_ptr<const VehicleModel>> models_;
+
+  // Map of registered vehicle models to their indices.
+  std::unordered_map<const VehicleModel*, VehicleModelIndex> indices_;
+};
+
+// Returns the vehicle model table that holds only a given vehicle model, or nullptr if the vehicle
+// model is nullptr. All callers with the same vehicle model share one table, which lives until the
+// end of the program, so vehicles constructed from a bare vehicle model can refer to it. Tables
+// are never modified once returned, so vehicles read them without locking.
+inline const VehicleModelTable* SharedVehicleModelTable(
+    const std::shared_ptr<const VehicleModel>& model) noexcept {
+  if (model == nullptr) {
+    return nullptr;
+  }
+
+  static std::mutex mutex;
+  static std::unordered_map<const VehicleModel*, std::unique_ptr<VehicleModelTable>> tables;
+
+  const std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<VehicleModelTable>& table = tables[model.get()];
+  if (table == nullptr) {
+    table = std::make_unique<VehicleModelTable>();
+    table->Register(model);
+  }
+  return table.get();
+}
+
+}  // namespace Demo
+
+#endif  // DEMO_INCLUDE_VEHICLE_MODEL_TABLE_HPP
@@ -28,11 +28,14 @@
 #include <random>
 #include <vector>
 
+#include "Logger.hpp"
 #include "VehicleModel.hpp"
+#include "VehicleModelTable.hpp"
 
 namespace Demo {
 
-// Collection of vehicle models.
+// Collection of vehicle models. The collection also keeps a table of its vehicle models, in the same
+// order, which the vehicles of these vehicle models share to read their hot parameters.
 class VehicleModels {
 public:
   // Constructs an empty collection of vehicle models.
@@ -71,22 +74,43 @@ public:
   }
 
   // Attempts to insert a new vehicle model into the collection. Returns true if the new vehicle
-  // model was successfully inserted, or false otherwise.
+  // model was successfully inserted, or false otherwise. If the vehicle model table of this
+  // collection is shared with vehicles or with copies of this collection, it is copied first, so
+  // that they are unaffected.
   bool Insert(std::shared_ptr<const VehicleModel> model) noexcept {
     if (model == nullptr) {
       return false;
     }
 
+    if (vehicle_models_.size() >= VehicleModelTable::Capacity) {
+      Log(LogLevel::Error) << "Cannot insert more than " << VehicleModelTable::Capacity
+                           << " vehicle models.";
+      return false;
+    }
+
     const std::pair<std::map<VehicleModelId, std::size_t>::const_iterator, bool> result =
         vehicle_model_ids_to_indices_.emplace(model->Id(), vehicle_models_.size());
 
     if (result.second) {
+      if (table_ == nullptr) {
+        table_ = std::make_shared<VehicleModelTable>();
+      } else if (table_.use_count() > 1) {
+        table_ = std::make_shared<VehicleModelTable>(*table_);
+      }
+      table_->Register(model);
       vehicle_models_.push_back(model);
     }
 
     return result.second;
   }
 
+  // Table of the vehicle models of this collection, in the order of insertion into the collection,
+  // or nullptr if the collection is empty. Collections of vehicles keep the table that their
+  // vehicles are constructed with, and the vehicles themselves only point to it.
+  std::shared_ptr<const VehicleModelTable> Table() const noexcept {
+    return table_;
+  }
+
   // Returns the vehicle model corresponding to a given vehicle model ID, or nullptr if that
   // vehicle model ID is not found in this collection.
   std::shared_ptr<const VehicleModel> At(const VehicleModelId id) const noexcept {
@@ -100,15 +124,31 @@ public:
     return nullptr;
   }
 
+  // Returns the vehicle model at a given index in the order of insertion into the collection, or
+  // nullptr if the index is out of range.
+  std::shared_ptr<const VehicleModel> AtIndex(const std::size_t index) const noexcept {
+    if (index < vehicle_models_.size()) {
+      return vehicle_models_[index];
+    }
+
+    return nullptr;
+  }
+
+  // Returns the index of a random vehicle model from the collection. The collection must not be
+  // empty.
+  std::size_t RandomIndex(std::mt19937_64& random_generator) const noexcept {
+    std::uniform_int_distribution<std::size_t> random_distribution(0, Size() - 1);
+
+    return random_distribution(random_generator);
+  }
+
   // Returns a random vehicle model from the collection, or nullptr if the collection is empty.
   std::shared_ptr<const VehicleModel> Random(std::mt19937_64& random_generator) const noexcept {
     if (Empty()) {
       return nullptr;
     }
 
-    std::uniform_int_distribution<std::size_t> random_distribution(0, Size() - 1);
-
-    return vehicle_models_[random_distribution(random_generator)];
+    return vehicle_models_[RandomIndex(random_generator)];
   }
 
 private:
@@ -119,6 +159,9 @@ private:
   // more vehicle models are used, this implementation should instead use a hash map rather than a
   // binary tree map.
   std::map<VehicleModelId, std::size_t> vehicle_model_ids_to_indices_;
+
+  // Table of the vehicle models in the vector, in the same order.
+  std::shared_ptr<VehicleModelTable> table_;
 };
 
 }  // namespace Demo
@@ -23,97 +23,271 @@
 #ifndef DEMO_INCLUDE_VEHICLES_HPP
 #define DEMO_INCLUDE_VEHICLES_HPP
 
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <random>
-#include <unordered_map>
 #include <vector>
 
+#include "FlatHashMap.hpp"
+#include "FleetComposition.hpp"
+#include "Logger.hpp"
+#include "MemoryAccounting.hpp"
+#include "Parallel.hpp"
+#include "Roster.hpp"
+#include "SlotMap.hpp"
 #include "Vehicle.hpp"
+#include "VehicleIdIndex.hpp"
+#include "VehicleModelTable.hpp"
 #include "VehicleModels.hpp"
 
 namespace Demo {
 
-// Collection of vehicles.
+// Collection of vehicles. Vehicles can be inserted and removed at any time, including between the
+// time steps of a running simulation, in constant time. The vehicles are stored contiguously, so
+// iterating over them stays dense, and each vehicle is also reachable through a stable handle that
+// no longer finds anything once the vehicle is removed.
 class Vehicles {
+private:
+  // Contiguous list of vehicles in a slot map, whose memory is accounted for.
+  using VehicleList =
+      SlotMap<std::shared_ptr<Vehicle>,
+              TrackingAllocator<std::shared_ptr<Vehicle>, MemorySubsystem::VehicleList>>;
+
+  // Index of vehicle IDs to the slots of the vehicles in the list, whose memory is accounted for.
+  using VehicleIndex =
+      VehicleIdIndex<TrackingAllocator<VehicleId, MemorySubsystem::VehicleIndex>>;
+
 public:
+  // Vehicles removed from this collection, by vehicle ID. A vehicle ID can repeat if different
+  // vehicles with the same vehicle ID were removed.
+  using RetiredVehicles = std::pmr::multimap<VehicleId, std::shared_ptr<Vehicle>>;
+
   // Constructs an empty collection of vehicles.
   Vehicles() noexcept = default;
 
+  // Constructs an empty collection of vehicles that draws its memory from a given memory resource,
+  // which must outlive this collection.
+  explicit Vehicles(std::pmr::memory_resource* const resource) noexcept
+    : vehicle_model_ids_to_counts_(resource), vehicles_(VehicleList::allocator_type(resource)),
+      vehicle_ids_to_indices_(VehicleIndex::allocator_type(resource)), retired_(resource) {}
+
   // Constructs a collection of vehicles by randomly generating a given number of vehicles from a
-  // collection of available vehicle models.
+  // collection of available vehicle models, each of which is equally likely. The collection and its
+  // vehicles draw their memory from a given memory resource, which must outlive them. The vehicles
+  // are constructed using up to a given number of threads, as described by Generate.
   Vehicles(const int32_t count, const VehicleModels& vehicle_models,
-           std::mt19937_64& random_generator) noexcept {
-    VehicleId id = 0;
-
-    for (int32_t vehicle_index = 0; vehicle_index < count; ++vehicle_index) {
-      const std::shared_ptr<const VehicleModel> vehicle_model =
-          vehicle_models.Random(random_generator);
+           std::mt19937_64& random_generator,
+           std::pmr::memory_resource* const resource = std::pmr::get_default_resource(),
+           const std::size_t thread_count = 1) noexcept
+    : Vehicles(resource) {
+    std::vector<uint32_t> vehicle_model_indices;
+    if (!vehicle_models.Empty()) {
+      vehicle_model_indices.resize(static_cast<std::size_t>(std::max(count, 0)));
+      for (uint32_t& vehicle_model_index : vehicle_model_indices) {
+        vehicle_model_index = static_cast<uint32_t>(vehicle_models.RandomIndex(random_generator));
+      }
+    }
 
-      if (vehicle_model != nullptr) {
-        const std::pair<std::map<VehicleModelId, std::size_t>::iterator, bool> result =
-            vehicle_model_ids_to_counts_.emplace(vehicle_model->Id(), 1);
+    Generate(vehicle_model_indices, vehicle_models, resource, thread_count);
+  }
 
-        if (!result.second) {
-          ++result.first->second;
-        }
+  // Constructs a collection of vehicles by randomly generating a given number of vehicles from a
+  // collection of available vehicle models according to a given fleet composition, whose weights
+  // are in the order of the collection of vehicle models. The collection and its vehicles draw
+  // their memory from a given memory resource, which must outlive them. The vehicle models are
+  // drawn and the vehicles are constructed using up to a given number of threads, and the resulting
+  // fleet does not depend on the number of threads.
+  Vehicles(const int32_t count, const VehicleModels& vehicle_models,
+           const FleetComposition& composition, std::mt19937_64& random_generator,
+           std::pmr::memory_resource* const resource = std::pmr::get_default_resource(),
+           const std::size_t thread_count = 1) noexcept
+    : Vehicles(resource) {
+    if (composition.Size() != vehicle_models.Size() || !composition.Valid()) {
+      Log(LogLevel::Error) << "The fleet composition has " << composition.Size()
+                           << " weights, but it must have one non-negative weight for each of the "
+                           << vehicle_models.Size() << " vehicle models and a positive total.";
+      return;
+    }
 
-        Insert(std::make_shared<Vehicle>(id, vehicle_model));
+    Generate(composition.Draw(
+                 static_cast<std::size_t>(std::max(count, 0)), random_generator, thread_count),
+             vehicle_models, resource, thread_count);
+  }
 
-        ++id;
-      }
+  // Constructs a collection of vehicles from the rows of a given roster, in order, whose vehicle
+  // model IDs are resolved in a collection of available vehicle models. The collection and its
+  // vehicles draw their memory from a given memory resource, which must outlive them. The rows are
+  // decoded and the vehicles are constructed using up to a given number of threads, as described
+  // by Load. If the roster is invalid, any of its rows is malformed or refers to an unknown vehicle
+  // model, or two of its rows have the same vehicle ID, an error is logged and the collection is
+  // empty.
+  Vehicles(const Roster& roster, const VehicleModels& vehicle_models,
+           std::pmr::memory_resource* const resource = std::pmr::get_default_resource(),
+           const std::size_t thread_count = 1) noexcept
+    : Vehicles(resource) {
+    if (roster.IsValid()) {
+      Load(roster, vehicle_models, resource, thread_count);
     }
-
-    PrintVehicleModelCounts(vehicle_models);
   }
 
   // Returns whether the collection is empty.
   bool Empty() const noexcept {
-    return vehicles_.empty();
+    return vehicles_.Empty();
   }
 
   // Returns the number of vehicles in the collection.
   std::size_t Size() const noexcept {
-    return vehicles_.size();
+    return vehicles_.Size();
   }
 
-  // Attempts to insert a new vehicle into the collection. Returns true if the new vehicle was
-  // successfully inserted, or false otherwise.
+  // Attempts to insert a new vehicle into the collection and counts it towards its vehicle model.
+  // If the vehicle was removed from this collection earlier, it is no longer retired. Returns true
+  // if the new vehicle was successfully inserted, or false otherwise. Takes constant time, plus
+  // logarithmic time in the number of vehicle models and of retired vehicles.
   bool Insert(const std::shared_ptr<Vehicle> vehicle) noexcept {
-    if (vehicle == nullptr) {
+    if (vehicle == nullptr
+        || !vehicle_ids_to_indices_.Insert(vehicle->Id(), vehicles_.NextSlot())) {
       return false;
     }
 
-    const std::pair<std::unordered_map<VehicleId, std::size_t>::const_iterator, bool> result =
-        vehicle_ids_to_indices_.emplace(vehicle->Id(), vehicles_.size());
+    vehicles_.Insert(vehicle);
+    ++version_;
 
-    if (result.second) {
-      vehicles_.push_back(vehicle);
+    if (vehicle->Model() != nullptr) {
+      ++vehicle_model_ids_to_counts_[vehicle->Model()->Id()];
     }
 
-    return result.second;
+    const std::pair<RetiredVehicles::iterator, RetiredVehicles::iterator> range =
+        retired_.equal_range(vehicle->Id());
+    for (RetiredVehicles::iterator retired = range.first; retired != range.second; ++retired) {
+      if (retired->second == vehicle) {
+        retired_.erase(retired);
+        break;
+      }
+    }
+
+    return true;
+  }
+
+  // Attempts to remove the vehicle corresponding to a given vehicle ID from the collection. The
+  // last vehicle of the collection takes its place in the order of iteration. The vehicle is no
+  // longer counted towards its vehicle model, but it is kept among the retired vehicles, so that
+  // its statistics still count towards the aggregate statistics of the fleet. Returns true if the
+  // vehicle was successfully removed, or false if that vehicle ID is not found in this collection.
+  // Takes constant time, plus logarithmic time in the number of vehicle models and of retired
+  // vehicles, except that the first removal from a collection whose vehicle IDs are dense builds
+  // the hash map of its vehicle IDs.
+  bool Remove(const VehicleId id) noexcept {
+    const std::optional<std::size_t> slot = vehicle_ids_to_indices_.Find(id);
+
+    if (!slot.has_value()) {
+      return false;
+    }
+
+    const SlotHandle handle = vehicles_.HandleOfSlot(static_cast<uint32_t>(slot.value()));
+    const std::shared_ptr<Vehicle> vehicle = *vehicles_.Find(handle);
+
+    if (vehicle->Model() != nullptr) {
+      const std::pmr::map<VehicleModelId, std::size_t>::iterator count =
+          vehicle_model_ids_to_counts_.find(vehicle->Model()->Id());
+      if (count != vehicle_model_ids_to_counts_.end() && --count->second == 0) {
+        vehicle_model_ids_to_counts_.erase(count);
+      }
+    }
+
+    retired_.emplace(id, vehicle);
+
+    vehicles_.Erase(handle);
+    vehicle_ids_to_indices_.Erase(id);
+    ++version_;
+
+    return true;
+  }
+
+  // Version of the membership of this collection, which changes whenever a vehicle is inserted or
+  // removed. Used to detect that copies of the state of the vehicles are out of date.
+  uint64_t Version() const noexcept {
+    return version_;
+  }
+
+  // Returns the number of vehicles of a given vehicle model ID in this collection.
+  std::size_t VehicleModelCount(const VehicleModelId id) const noexcept {
+    const std::pmr::map<VehicleModelId, std::size_t>::const_iterator count =
+        vehicle_model_ids_to_counts_.find(id);
+
+    if (count != vehicle_model_ids_to_counts_.cend()) {
+      return count->second;
+    }
+
+    return 0;
+  }
+
+  // Vehicles removed from this collection and not inserted again since.
+  const RetiredVehicles& Retired() const noexcept {
+    return retired_;
   }
 
   // Returns whether a given vehicle ID exists in this collection.
   bool Exists(const VehicleId id) const noexcept {
-    return vehicle_ids_to_indices_.find(id) != vehicle_ids_to_indices_.cend();
+    return vehicle_ids_to_indices_.Contains(id);
   }
 
   // Returns the vehicle corresponding to a given vehicle ID, or nullptr if that vehicle ID is not
-  // found in this collection.
+  // found in this collection. When the vehicle IDs are dense, as they are when the vehicles are
+  // randomly generated, this is a bounds check and a single load from the list.
   std::shared_ptr<Vehicle> At(const VehicleId id) const noexcept {
-    const std::unordered_map<VehicleId, std::size_t>::const_iterator id_and_index =
-        vehicle_ids_to_indices_.find(id);
+    const std::shared_ptr<Vehicle>* const vehicle = vehicles_.Find(Handle(id));
 
-    if (id_and_index != vehicle_ids_to_indices_.cend()) {
-      return vehicles_[id_and_index->second];
+    if (vehicle != nullptr) {
+      return *vehicle;
     }
 
     return nullptr;
   }
 
+  // Returns a pointer to the vehicle corresponding to a given vehicle ID, or nullptr if that
+  // vehicle ID is not found in this collection. Unlike At, does not copy the shared pointer, whose
+  // atomic reference count costs more than the lookup itself on hot paths.
+  Vehicle* Find(const VehicleId id) const noexcept {
+    return Find(Handle(id));
+  }
+
+  // Returns the stable handle of the vehicle corresponding to a given vehicle ID, or a handle that
+  // finds nothing if that vehicle ID is not found in this collection. The handle keeps finding the
+  // same vehicle while other vehicles are inserted and removed, and finds nothing once that vehicle
+  // is removed.
+  SlotHandle Handle(const VehicleId id) const noexcept {
+    const std::optional<std::size_t> slot = vehicle_ids_to_indices_.Find(id);
+
+    if (slot.has_value()) {
+      return vehicles_.HandleOfSlot(static_cast<uint32_t>(slot.value()));
+    }
+
+    return SlotHandle();
+  }
+
+  // Returns a pointer to the vehicle of a given stable handle, or nullptr if that vehicle has been
+  // removed from this collection.
+  Vehicle* Find(const SlotHandle handle) const noexcept {
+    const std::shared_ptr<Vehicle>* const vehicle = vehicles_.Find(handle);
+
+    if (vehicle != nullptr) {
+      return vehicle->get();
+    }
+
+    return nullptr;
+  }
+
+  // Returns whether the vehicle IDs of this collection are dense, that is, whether each vehicle ID
+  // equals the slot of its vehicle in the collection.
+  bool DenseIds() const noexcept {
+    return vehicle_ids_to_indices_.Dense();
+  }
+
   // Returns a random vehicle from the collection, or nullptr if the collection is empty.
   std::shared_ptr<Vehicle> Random(std::mt19937_64& random_generator) const noexcept {
     if (Empty()) {
@@ -125,9 +299,9 @@ public:
     return vehicles_[distribution(random_generator)];
   }
 
-  struct iterator : public std::vector<std::shared_ptr<Vehicle>>::iterator {
-    iterator(const std::vector<std::shared_ptr<Vehicle>>::iterator i) noexcept
-      : std::vector<std::shared_ptr<Vehicle>>::iterator(i) {}
+  struct iterator : public VehicleList::iterator {
+    iterator(const VehicleList::iterator i) noexcept
+      : VehicleList::iterator(i) {}
   };
 
   iterator begin() noexcept {
@@ -138,9 +312,9 @@ public:
     return iterator(vehicles_.end());
   }
 
-  struct const_iterator : public std::vector<std::shared_ptr<Vehicle>>::const_iterator {
-    const_iterator(const std::vector<std::shared_ptr<Vehicle>>::const_iterator i) noexcept
-      : std::vector<std::shared_ptr<Vehicle>>::const_iterator(i) {}
+  struct const_iterator : public VehicleList::const_iterator {
+    const_iterator(const VehicleList::const_iterator i) noexcept
+      : VehicleList::const_iterator(i) {}
   };
 
   const_iterator begin() const noexcept {
@@ -160,13 +334,155 @@ public:
   }
 
 private:
-  // Prints the number of vehicles of each vehicle model to the console.
+  // Number of consecutive vehicles constructed together by one thread.
+  static constexpr std::size_t ChunkSize = std::size_t{1} << 14;
+
+  // Generates one vehicle of each of given vehicle model indices in a collection of vehicle models,
+  // with consecutive vehicle IDs starting at zero, and logs the number of vehicles of each vehicle
+  // model. The list of vehicles is sized once, and the vehicles are constructed in chunks of
+  // ChunkSize vehicles using up to a given number of threads, each chunk counting its vehicles per
+  // vehicle model. The vehicle ID index and the per-model counts are then built in one pass each.
+  // More than one thread is used only with the new-delete memory resource, because other memory
+  // resources such as arenas are generally not thread-safe.
+  void Generate(const std::vector<uint32_t>& vehicle_model_indices,
+                const VehicleModels& vehicle_models, std::pmr::memory_resource* const resource,
+                const std::size_t thread_count) noexcept {
+    const std::size_t count = vehicle_model_indices.size();
+
+    // The vehicles are constructed directly from their indices in the vehicle model table of the
+    // collection of vehicle models, without touching the shared vehicle models. This collection
+    // keeps the table alive, and its vehicles only point to it.
+    model_table_ = vehicle_models.Table();
+    const VehicleModelTable* const model_table = model_table_.get();
+
+    vehicles_.Resize(count);
+    const std::size_t chunk_count = (count + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<std::size_t>> chunk_counts(
+        chunk_count, std::vector<std::size_t>(vehicle_models.Size(), 0));
+    const TrackingAllocator<Vehicle, MemorySubsystem::Vehicles> allocator(resource);
+
+    ParallelFor(chunk_count,
+                resource->is_equal(*std::pmr::new_delete_resource()) ? thread_count : 1,
+                [&](const std::size_t chunk) {
+                  const std::size_t end = std::min((chunk + 1) * ChunkSize, count);
+                  for (std::size_t position = chunk * ChunkSize; position < end; ++position) {
+                    const uint32_t vehicle_model_index = vehicle_model_indices[position];
+                    vehicles_[position] = std::allocate_shared<Vehicle>(
+                        allocator, static_cast<VehicleId>(position), model_table,
+                        static_cast<VehicleModelIndex>(vehicle_model_index));
+                    ++chunk_counts[chunk][vehicle_model_index];
+                  }
+                });
+
+    vehicle_ids_to_indices_.Reserve(count);
+    for (std::size_t position = 0; position < count; ++position) {
+      vehicle_ids_to_indices_.Insert(static_cast<VehicleId>(position), position);
+    }
+
+    CountVehicleModels(chunk_counts, vehicle_models);
+  }
+
+  // Constructs one vehicle for each row of a given roster, in order, resolving the vehicle model ID
+  // of each row in a collection of vehicle models, and logs the number of vehicles of each vehicle
+  // model. As in Generate, the list of vehicles is sized once and the rows are decoded in place and
+  // their vehicles constructed in chunks of ChunkSize rows using up to a given number of threads,
+  // each chunk noting its first row that cannot be loaded. The vehicle ID index is then built in
+  // one pass, which detects duplicate vehicle IDs. On error, the collection is left empty.
+  void Load(const Roster& roster, const VehicleModels& vehicle_models,
+            std::pmr::memory_resource* const resource, const std::size_t thread_count) noexcept {
+    const std::size_t count = roster.Size();
+
+    // Index the vehicle model IDs once, so that each row resolves its vehicle model with a flat
+    // hash map lookup to the vehicle model's index in the collection and in its vehicle model
+    // table, which are the same. As in Generate, this collection keeps the table alive.
+    model_table_ = vehicle_models.Table();
+    const VehicleModelTable* const model_table = model_table_.get();
+    FlatHashMap<VehicleModelId, std::size_t> vehicle_model_ids_to_indices;
+    vehicle_model_ids_to_indices.Reserve(vehicle_models.Size());
+    for (std::size_t index = 0; index < vehicle_models.Size(); ++index) {
+      vehicle_model_ids_to_indices.Insert(vehicle_models.AtIndex(index)->Id(), index);
+    }
+
+    vehicles_.Resize(count);
+    const std::size_t chunk_count = (count + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<std::size_t>> chunk_counts(
+        chunk_count, std::vector<std::size_t>(vehicle_models.Size(), 0));
+    std::vector<std::size_t> chunk_errors(chunk_count, count);
+    const TrackingAllocator<Vehicle, MemorySubsystem::Vehicles> allocator(resource);
+
+    ParallelFor(chunk_count,
+                resource->is_equal(*std::pmr::new_delete_resource()) ? thread_count : 1,
+                [&](const std::size_t chunk) {
+                  const std::size_t end = std::min((chunk + 1) * ChunkSize, count);
+                  for (std::size_t position = chunk * ChunkSize; position < end; ++position) {
+                    const std::optional<RosterEntry> entry = roster.Row(position);
+                    const std::size_t* const vehicle_model_index =
+                        entry.has_value() ? vehicle_model_ids_to_indices.Find(entry->model_id) :
+                                            nullptr;
+                    if (vehicle_model_index == nullptr) {
+                      chunk_errors[chunk] = position;
+                      return;
+                    }
+                    vehicles_[position] = std::allocate_shared<Vehicle>(
+                        allocator, entry->id, model_table,
+                        static_cast<VehicleModelIndex>(*vehicle_model_index), entry->battery,
+                        entry->home_charging_station_id);
+                    ++chunk_counts[chunk][*vehicle_model_index];
+                  }
+                });
+
+    const std::size_t error = *std::min_element(chunk_errors.cbegin(), chunk_errors.cend());
+    if (error < count) {
+      if (roster.Row(error).has_value()) {
+        Log(LogLevel::Error) << "Row " << error + 1 << " of the roster file "
+                             << roster.Path().string() << " refers to an unknown vehicle model.";
+      } else {
+        Log(LogLevel::Error) << "Row " << error + 1 << " of the roster file "
+                             << roster.Path().string() << " is malformed.";
+      }
+      vehicles_.Clear();
+      return;
+    }
+
+    vehicle_ids_to_indices_.Reserve(count);
+    for (std::size_t position = 0; position < count; ++position) {
+      if (!vehicle_ids_to_indices_.Insert(vehicles_[position]->Id(), position)) {
+        Log(LogLevel::Error) << "Row " << position + 1 << " of the roster file "
+                             << roster.Path().string() << " repeats the vehicle ID "
+                             << vehicles_[position]->Id() << ".";
+        vehicles_.Clear();
+        vehicle_ids_to_indices_.Clear();
+        return;
+      }
+    }
+
+    CountVehicleModels(chunk_counts, vehicle_models);
+  }
+
+  // Totals given per-chunk counts of the vehicles of each vehicle model, in the order of a
+  // collection of vehicle models, and logs the number of vehicles of each vehicle model.
+  void CountVehicleModels(const std::vector<std::vector<std::size_t>>& chunk_counts,
+                          const VehicleModels& vehicle_models) noexcept {
+    for (std::size_t index = 0; index < vehicle_models.Size(); ++index) {
+      std::size_t total = 0;
+      for (const std::vector<std::size_t>& counts : chunk_counts) {
+        total += counts[index];
+      }
+      if (total > 0) {
+        vehicle_model_ids_to_counts_.emplace(vehicle_models.AtIndex(index)->Id(), total);
+      }
+    }
+
+    PrintVehicleModelCounts(vehicle_models);
+  }
+
+  // Logs the number of vehicles of each vehicle model.
   void PrintVehicleModelCounts(const VehicleModels& vehicle_models) const noexcept {
     if (vehicle_model_ids_to_counts_.empty()) {
       return;
     }
 
-    std::cout << "Vehicle models in this simulation:" << std::endl;
+    Log(LogLevel::Information) << "Vehicle models in this simulation:";
 
     for (const std::pair<const VehicleModelId, std::size_t>& vehicle_model_id_and_count :
          vehicle_model_ids_to_counts_) {
@@ -174,21 +490,32 @@ private:
           vehicle_models.At(vehicle_model_id_and_count.first);
 
       if (vehicle_model != nullptr) {
-        std::cout << "- " << vehicle_model->ManufacturerNameEnglish() << ", "
-                  << vehicle_model->ModelNameEnglish() << ": " << vehicle_model_id_and_count.second
-                  << " vehicles" << std::endl;
+        Log(LogLevel::Information)
+            << "- " << vehicle_model->ManufacturerNameEnglish() << ", "
+            << vehicle_model->ModelNameEnglish() << ": " << vehicle_model_id_and_count.second
+            << " vehicles";
       }
     }
   }
 
+  // Vehicle model table of the generated or loaded vehicles, kept alive for as long as this
+  // collection, or nullptr. Declared first so that it is released after the vehicles.
+  std::shared_ptr<const VehicleModelTable> model_table_;
+
   // Map of vehicle model IDs to the count of vehicles of that model.
-  std::map<VehicleModelId, std::size_t> vehicle_model_ids_to_counts_;
+  std::pmr::map<VehicleModelId, std::size_t> vehicle_model_ids_to_counts_;
 
   // Vehicles in this simulation.
-  std::vector<std::shared_ptr<Vehicle>> vehicles_;
+  VehicleList vehicles_;
 
   // Map of vehicle IDs to the index of the corresponding vehicle in the vector.
-  std::unordered_map<VehicleId, std::size_t> vehicle_ids_to_indices_;
+  VehicleIndex vehicle_ids_to_indices_;
+
+  // Vehicles removed from this collection, which keep their statistics.
+  RetiredVehicles retired_;
+
+  // Version of the membership of this collection.
+  uint64_t version_ = 0;
 };
 
 }  // namespace Demo
@@ -0,0 +1,153 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/BatchSampler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+// Sample mean and variance of a given set of values.
+template <typename Value>
+std::pair<double, double> MeanAndVariance(const std::vector<Value>& values) {
+  double sum = 0.0;
+  for (const Value value : values) {
+    sum += static_cast<double>(value);
+  }
+  const double mean = sum / static_cast<double>(values.size());
+  double squares = 0.0;
+  for (const Value value : values) {
+    squares += (static_cast<double>(value) - mean) * (static_cast<double>(value) - mean);
+  }
+  return {mean, squares / static_cast<double>(values.size() - 1)};
+}
+
+TEST(BatchSampler, Uniform) {
+  BatchSampler sampler{0};
+  std::vector<double> values(100003);
+  sampler.Uniform(values.data(), values.size());
+  for (const double value : values) {
+    EXPECT_GE(value, 0.0);
+    EXPECT_LT(value, 1.0);
+  }
+  const std::pair<double, double> mean_and_variance = MeanAndVariance(values);
+  EXPECT_NEAR(mean_and_variance.first, 0.5, 0.01);
+  EXPECT_NEAR(mean_and_variance.second, 1.0 / 12.0, 0.01);
+}
+
+TEST(BatchSampler, Deterministic) {
+  BatchSampler first{7};
+  BatchSampler second{7};
+  BatchSampler other{8};
+  std::vector<double> values(1000);
+  second.Uniform(values.data(), values.size());
+  bool different = false;
+  for (const double value : values) {
+    EXPECT_EQ(first.Uniform(), value);
+    different = different || other.Uniform() != value;
+  }
+  EXPECT_TRUE(different);
+}
+
+TEST(BatchSampler, StandardDistributions) {
+  BatchSampler sampler{1};
+  std::uniform_int_distribution<int> distribution(1, 6);
+  for (int64_t draw = 0; draw < 1000; ++draw) {
+    const int value = distribution(sampler);
+    EXPECT_GE(value, 1);
+    EXPECT_LE(value, 6);
+  }
+}
+
+TEST(BatchSampler, Exponential) {
+  BatchSampler sampler{2};
+  const std::vector<double> rates(200000, 4.0);
+  std::vector<double> values(rates.size());
+  sampler.Exponential(rates.data(), rates.size(), values.data());
+  for (const double value : values) {
+    EXPECT_GE(value, 0.0);
+  }
+  const std::pair<double, double> mean_and_variance = MeanAndVariance(values);
+  EXPECT_NEAR(mean_and_variance.first, 0.25, 0.005);
+  EXPECT_NEAR(mean_and_variance.second, 0.0625, 0.003);
+}
+
+TEST(BatchSampler, PoissonTable) {
+  for (const double mean : {0.0, 0.001, 0.1, 1.0, 3.0}) {
+    const double exp_minus_mean = std::exp(-mean);
+    for (double uniform = 0.0; uniform < 1.0; uniform += 0.001) {
+      const int64_t count = PoissonTableCount(mean, exp_minus_mean, uniform);
+      const int64_t expected = PoissonSearch(mean, exp_minus_mean, uniform);
+      if (expected < PoissonTableTerms) {
+        EXPECT_EQ(count, expected);
+      } else {
+        EXPECT_EQ(count, PoissonTableTerms);
+      }
+    }
+  }
+}
+
+TEST(BatchSampler, Poisson) {
+  for (const double mean : {0.0, 0.002, 0.3, 2.0, 7.0, 25.0}) {
+    BatchSampler sampler{3};
+    const std::vector<double> means(200000, mean);
+    std::vector<int64_t> values(means.size());
+    sampler.Poisson(means.data(), means.size(), values.data());
+    for (const int64_t value : values) {
+      EXPECT_GE(value, 0);
+    }
+    const std::pair<double, double> mean_and_variance = MeanAndVariance(values);
+    const double tolerance = 0.02 * mean + 0.001;
+    EXPECT_NEAR(mean_and_variance.first, mean, tolerance);
+    EXPECT_NEAR(mean_and_variance.second, mean, 2.0 * tolerance);
+  }
+}
+
+TEST(BatchSampler, PoissonBatchMatchesSingleDraws) {
+  std::vector<double> means(2000);
+  for (std::size_t index = 0; index < means.size(); ++index) {
+    means[index] = 0.001 * static_cast<double>(index % 3000);
+  }
+  BatchSampler batch{4};
+  BatchSampler single{4};
+  std::vector<int64_t> values(means.size());
+  batch.Poisson(means.data(), means.size(), values.data());
+  int64_t total = 0;
+  for (std::size_t index = 0; index < means.size(); ++index) {
+    EXPECT_EQ(values[index], single.Poisson(means[index]));
+    total += values[index];
+  }
+  EXPECT_GT(total, 0);
+}
+
+}  // namespace
+
+}  // namespace Demo
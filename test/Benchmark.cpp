@@ -0,0 +1,129 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Benchmark.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Demo {
+
+namespace {
+
+TEST(Benchmark, Runner) {
+  BenchmarkRunner runner{"Selected", /*minimum_time=*/0.001, /*repetitions=*/3};
+
+  int64_t calls = 0;
+  runner.Run("Selected/Benchmark", [&](const uint64_t iterations, BenchmarkTimer& /*timer*/) {
+    ++calls;
+    uint64_t sum = 0;
+    for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+      sum += iteration;
+      DoNotOptimize(sum);
+    }
+    return 2 * iterations;
+  });
+  runner.Run("Other/Benchmark", [&](const uint64_t iterations, BenchmarkTimer& /*timer*/) {
+    ++calls;
+    return iterations;
+  });
+
+  // At least one calibration call and one call per repetition.
+  EXPECT_GE(calls, 4);
+  ASSERT_EQ(runner.Results().size(), 1);
+  const BenchmarkResult& result = runner.Results()[0];
+  EXPECT_EQ(result.name, "Selected/Benchmark");
+  EXPECT_GT(result.operations, 0);
+  EXPECT_EQ(result.operations % 2, 0);
+  EXPECT_GT(result.nanoseconds_per_operation, 0.0);
+  EXPECT_NEAR(result.operations_per_second * result.nanoseconds_per_operation, 1.0E9, 1.0);
+}
+
+TEST(Benchmark, Timer) {
+  BenchmarkTimer timer;
+  timer.Start();
+  timer.Pause();
+  volatile uint64_t sum = 0;
+  for (uint64_t iteration = 0; iteration < 10000000; ++iteration) {
+    sum = sum + iteration;
+  }
+  timer.Resume();
+  EXPECT_LT(timer.Stop(), 0.001);
+}
+
+TEST(Benchmark, Json) {
+  std::vector<BenchmarkResult> results(2);
+  results[0].name = "First/Benchmark";
+  results[0].operations = 1000;
+  results[0].nanoseconds_per_operation = 12.5;
+  results[0].operations_per_second = 8.0E7;
+  results[1].name = "Second/Benchmark";
+  results[1].operations = 10;
+  results[1].nanoseconds_per_operation = 1.25E6;
+  results[1].operations_per_second = 800.0;
+
+  const std::string json = BenchmarkResultsToJson(results);
+  EXPECT_NE(json.find("\"name\": \"First/Benchmark\""), std::string::npos);
+  EXPECT_NE(json.find("\"ns_per_op\": 12.5"), std::string::npos);
+  EXPECT_NE(json.find("\"ops_per_second\": 8e+07"), std::string::npos);
+
+  const std::optional<std::vector<BenchmarkResult>> parsed = ParseBenchmarkJson(json);
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(parsed->size(), 2);
+  EXPECT_EQ(parsed.value()[0].name, "First/Benchmark");
+  EXPECT_DOUBLE_EQ(parsed.value()[0].nanoseconds_per_operation, 12.5);
+  EXPECT_EQ(parsed.value()[1].name, "Second/Benchmark");
+  EXPECT_DOUBLE_EQ(parsed.value()[1].nanoseconds_per_operation, 1.25E6);
+
+  EXPECT_TRUE(ParseBenchmarkJson("{}").has_value());
+  EXPECT_TRUE(ParseBenchmarkJson("{}")->empty());
+  EXPECT_FALSE(ParseBenchmarkJson("{\"name\": \"Broken\"}").has_value());
+}
+
+TEST(Benchmark, Compare) {
+  std::vector<BenchmarkResult> baseline(2);
+  baseline[0].name = "Faster";
+  baseline[0].nanoseconds_per_operation = 100.0;
+  baseline[1].name = "Slower";
+  baseline[1].nanoseconds_per_operation = 100.0;
+
+  std::vector<BenchmarkResult> results(3);
+  results[0].name = "Faster";
+  results[0].nanoseconds_per_operation = 105.0;
+  results[1].name = "Slower";
+  results[1].nanoseconds_per_operation = 120.0;
+  results[2].name = "New";
+  results[2].nanoseconds_per_operation = 1.0;
+
+  const std::vector<BenchmarkComparison> comparisons =
+      CompareBenchmarks(results, baseline, /*threshold=*/0.1);
+  ASSERT_EQ(comparisons.size(), 2);
+  EXPECT_EQ(comparisons[0].name, "Faster");
+  EXPECT_DOUBLE_EQ(comparisons[0].ratio, 1.05);
+  EXPECT_FALSE(comparisons[0].regression);
+  EXPECT_EQ(comparisons[1].name, "Slower");
+  EXPECT_DOUBLE_EQ(comparisons[1].ratio, 1.2);
+  EXPECT_TRUE(comparisons[1].regression);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,161 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/CatalogKernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../source/ChargingStations.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Vehicle.hpp"
+#include "../source/VehicleGroup.hpp"
+
+namespace Demo {
+
+namespace {
+
+using SampleCatalogKernels = CatalogKernels<SampleVehicleModelCatalog>;
+
+// Inserts a few vehicles of a given vehicle model into each of two given groups.
+void InsertVehicles(const std::shared_ptr<const VehicleModel>& model, VehicleGroup& first,
+                    VehicleGroup& second) {
+  ChargingStations charging_stations{1};
+  for (VehicleId id = 0; id < 7; ++id) {
+    Vehicle vehicle{id, model};
+    vehicle.Update(charging_stations);
+    first.Insert(vehicle);
+    second.Insert(vehicle);
+  }
+}
+
+// Expects two groups of vehicles to have the same state up to rounding.
+void ExpectEqual(const VehicleGroup& left, const VehicleGroup& right) {
+  ASSERT_EQ(left.Size(), right.Size());
+  for (std::size_t position = 0; position < left.Size(); ++position) {
+    EXPECT_DOUBLE_EQ(left.Battery(position).Value(), right.Battery(position).Value());
+    const Statistics left_statistics = left.Statistics(position);
+    const Statistics right_statistics = right.Statistics(position);
+    EXPECT_DOUBLE_EQ(left_statistics.TotalFlightDuration().Value(),
+                     right_statistics.TotalFlightDuration().Value());
+    EXPECT_DOUBLE_EQ(left_statistics.TotalFlightDistance().Value(),
+                     right_statistics.TotalFlightDistance().Value());
+    EXPECT_DOUBLE_EQ(left_statistics.TotalFlightPassengerDistance().Value(),
+                     right_statistics.TotalFlightPassengerDistance().Value());
+    EXPECT_DOUBLE_EQ(left_statistics.TotalChargingDuration().Value(),
+                     right_statistics.TotalChargingDuration().Value());
+    EXPECT_EQ(left_statistics.TotalFaultCount(), right_statistics.TotalFaultCount());
+  }
+}
+
+TEST(CatalogKernels, Find) {
+  // The parameters of the vehicle models constructed at run time match those computed at compile
+  // time up to rounding.
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  for (std::size_t index = 0; index < vehicle_models.Size(); ++index) {
+    const VehicleModelId id = vehicle_models.AtIndex(index)->Id();
+    const VehicleModelParameters& parameters =
+        vehicle_models.Table()->Parameters(static_cast<VehicleModelIndex>(index));
+    const FleetKernelTable* kernels = SampleCatalogKernels::Find(id, parameters);
+    ASSERT_NE(kernels, nullptr);
+    EXPECT_EQ(kernels, SampleCatalogKernels::Find(id, parameters));
+  }
+  EXPECT_NE(SampleCatalogKernels::Find(0, SampleVehicleModelCatalog[0].Parameters()),
+            SampleCatalogKernels::Find(1, SampleVehicleModelCatalog[1].Parameters()));
+  EXPECT_EQ(SampleCatalogKernels::Find(111, SampleVehicleModelCatalog[0].Parameters()), nullptr);
+
+  // A vehicle model that reuses the ID of an entry with different parameters does not match it.
+  VehicleModelSpec spec = SampleVehicleModelCatalog[0];
+  spec.battery_capacity_kilowatt_hours *= 2.0;
+  EXPECT_EQ(SampleCatalogKernels::Find(spec.id, spec.Parameters()), nullptr);
+  spec = SampleVehicleModelCatalog[0];
+  spec.passenger_count += 1;
+  EXPECT_EQ(SampleCatalogKernels::Find(spec.id, spec.Parameters()), nullptr);
+}
+
+TEST(CatalogKernels, MatchesGenericKernels) {
+  const PhQ::Time duration{1.0, PhQ::Unit::Time::Minute};
+  for (const VehicleModelSpec& spec : SampleVehicleModelCatalog) {
+    VehicleGroup generic;
+    VehicleGroup specialized{*SampleCatalogKernels::Find(spec.id, spec.Parameters())};
+    InsertVehicles(spec.ToVehicleModel(), generic, specialized);
+
+    BatchSampler generic_sampler{0};
+    BatchSampler specialized_sampler{0};
+    for (int64_t step = 0; step < 10; ++step) {
+      generic.Fly(duration);
+      specialized.Fly(duration);
+      generic.RandomlyGenerateFaults(duration, generic_sampler);
+      specialized.RandomlyGenerateFaults(duration, specialized_sampler);
+    }
+    for (int64_t step = 0; step < 5; ++step) {
+      generic.Charge(duration);
+      specialized.Charge(duration);
+    }
+    ExpectEqual(generic, specialized);
+  }
+}
+
+TEST(CatalogKernels, NextEvent) {
+  constexpr VehicleModelParameters parameters = SampleVehicleModelCatalog[2].Parameters();
+  const FleetKernelTable& kernels =
+      *SampleCatalogKernels::Find(SampleVehicleModelCatalog[2].id, parameters);
+
+  const std::vector<VehicleStatus> status{
+      VehicleStatus::Flying, VehicleStatus::Charging, VehicleStatus::OnStandby,
+      VehicleStatus::OnStandby, VehicleStatus::WaitingToCharge};
+  std::vector<double> battery{0.5 * parameters.battery_capacity, 0.25 * parameters.battery_capacity,
+                              parameters.battery_capacity, 0.0, 0.0};
+  const std::size_t count = status.size();
+  const std::vector<double> battery_capacity(count, parameters.battery_capacity);
+  const std::vector<double> charging_rate(count, parameters.charging_rate);
+  const std::vector<double> transport_energy_consumption(
+      count, parameters.transport_energy_consumption);
+  const std::vector<double> cruise_speed(count, parameters.cruise_speed);
+  std::vector<double> generic_durations(count);
+  std::vector<double> specialized_durations(count);
+
+  EventArrays arrays;
+  arrays.count = count;
+  arrays.status = status.data();
+  arrays.battery = battery.data();
+  arrays.battery_capacity = battery_capacity.data();
+  arrays.charging_rate = charging_rate.data();
+  arrays.transport_energy_consumption = transport_energy_consumption.data();
+  arrays.cruise_speed = cruise_speed.data();
+
+  arrays.durations = generic_durations.data();
+  const double generic_minimum = NextEventKernelScalar(arrays, 1.0e9);
+  arrays.durations = specialized_durations.data();
+  const double specialized_minimum = kernels.next_event(arrays, 1.0e9);
+
+  EXPECT_DOUBLE_EQ(generic_minimum, specialized_minimum);
+  for (std::size_t index = 0; index < count; ++index) {
+    EXPECT_DOUBLE_EQ(generic_durations[index], specialized_durations[index]);
+  }
+}
+
+}  // namespace
+
+}  // namespace Demo
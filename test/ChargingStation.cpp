@@ -95,6 +95,23 @@ TEST(ChargingStation, Dequeue) {
   EXPECT_FALSE(station.Dequeue());
 }
 
+TEST(ChargingStation, Remove) {
+  ChargingStation station;
+  EXPECT_FALSE(station.Remove(111));
+  station.Enqueue(111);
+  station.Enqueue(222);
+  station.Enqueue(333);
+  EXPECT_TRUE(station.Remove(222));
+  EXPECT_FALSE(station.Remove(222));
+  EXPECT_FALSE(station.Exists(222));
+  EXPECT_EQ(station.Count(), 2);
+  EXPECT_TRUE(station.Remove(111));
+  EXPECT_EQ(station.Front(), 333);
+  EXPECT_TRUE(station.Enqueue(222));
+  EXPECT_TRUE(station.Dequeue());
+  EXPECT_EQ(station.Front(), 222);
+}
+
 }  // namespace
 
 }  // namespace Demo
@@ -0,0 +1,111 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FlatHashMap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+namespace Demo {
+
+namespace {
+
+TEST(FlatHashMap, Empty) {
+  FlatHashMap<int64_t, std::size_t> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Capacity(), 0);
+  EXPECT_EQ(map.Find(111), nullptr);
+  EXPECT_FALSE(map.Erase(111));
+  map.Insert(111, 1);
+  EXPECT_FALSE(map.Empty());
+}
+
+TEST(FlatHashMap, InsertFindErase) {
+  FlatHashMap<int64_t, std::size_t> map;
+  EXPECT_TRUE(map.Insert(111, 1));
+  EXPECT_FALSE(map.Insert(111, 2));
+  EXPECT_TRUE(map.Insert(222, 2));
+  EXPECT_EQ(map.Size(), 2);
+  ASSERT_NE(map.Find(111), nullptr);
+  EXPECT_EQ(*map.Find(111), 1);
+  ASSERT_NE(map.Find(222), nullptr);
+  EXPECT_EQ(*map.Find(222), 2);
+  EXPECT_FALSE(map.Contains(333));
+  EXPECT_TRUE(map.Erase(111));
+  EXPECT_FALSE(map.Erase(111));
+  EXPECT_FALSE(map.Contains(111));
+  EXPECT_TRUE(map.Contains(222));
+  EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(FlatHashMap, Reserve) {
+  FlatHashMap<int64_t, std::size_t> map;
+  map.Reserve(100);
+  const std::size_t capacity = map.Capacity();
+  EXPECT_GE(capacity, 200);
+  for (int64_t key = 0; key < 100; ++key) {
+    map.Insert(key, static_cast<std::size_t>(key));
+  }
+  EXPECT_EQ(map.Capacity(), capacity);
+}
+
+TEST(FlatHashMap, MatchesStandardMap) {
+  std::mt19937_64 random_generator(0);
+  std::uniform_int_distribution<int64_t> distribution(0, 200);
+  FlatHashMap<int64_t, std::size_t> map;
+  std::unordered_map<int64_t, std::size_t> reference;
+  for (std::size_t iteration = 0; iteration < 20000; ++iteration) {
+    const int64_t key = distribution(random_generator);
+    if (iteration % 3 == 0) {
+      ASSERT_EQ(map.Erase(key), reference.erase(key) == 1);
+    } else {
+      ASSERT_EQ(map.Insert(key, iteration), reference.emplace(key, iteration).second);
+    }
+    ASSERT_EQ(map.Size(), reference.size());
+  }
+  for (int64_t key = 0; key <= 200; ++key) {
+    const std::unordered_map<int64_t, std::size_t>::const_iterator found = reference.find(key);
+    if (found == reference.cend()) {
+      EXPECT_EQ(map.Find(key), nullptr);
+    } else {
+      ASSERT_NE(map.Find(key), nullptr);
+      EXPECT_EQ(*map.Find(key), found->second);
+    }
+  }
+}
+
+TEST(FlatHashMap, Clear) {
+  FlatHashMap<int64_t, std::size_t> map;
+  map.Insert(111, 1);
+  map.Insert(222, 2);
+  const std::size_t capacity = map.Capacity();
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_FALSE(map.Contains(111));
+  EXPECT_EQ(map.Capacity(), capacity);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,94 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FlatHashSet.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_set>
+
+namespace Demo {
+
+namespace {
+
+TEST(FlatHashSet, Empty) {
+  FlatHashSet<int64_t> set;
+  EXPECT_TRUE(set.Empty());
+  EXPECT_EQ(set.Capacity(), 0);
+  EXPECT_FALSE(set.Contains(111));
+  EXPECT_FALSE(set.Erase(111));
+  set.Insert(111);
+  EXPECT_FALSE(set.Empty());
+}
+
+TEST(FlatHashSet, InsertContainsErase) {
+  FlatHashSet<int64_t> set;
+  EXPECT_TRUE(set.Insert(111));
+  EXPECT_FALSE(set.Insert(111));
+  EXPECT_TRUE(set.Insert(222));
+  EXPECT_EQ(set.Size(), 2);
+  EXPECT_TRUE(set.Contains(111));
+  EXPECT_TRUE(set.Contains(222));
+  EXPECT_FALSE(set.Contains(333));
+  EXPECT_TRUE(set.Erase(111));
+  EXPECT_FALSE(set.Erase(111));
+  EXPECT_FALSE(set.Contains(111));
+  EXPECT_TRUE(set.Contains(222));
+  EXPECT_EQ(set.Size(), 1);
+}
+
+TEST(FlatHashSet, MatchesStandardSet) {
+  std::mt19937_64 random_generator(0);
+  std::uniform_int_distribution<int64_t> distribution(0, 200);
+  FlatHashSet<int64_t> set;
+  std::unordered_set<int64_t> reference;
+  for (int64_t iteration = 0; iteration < 20000; ++iteration) {
+    const int64_t key = distribution(random_generator);
+    if (iteration % 3 == 0) {
+      ASSERT_EQ(set.Erase(key), reference.erase(key) == 1);
+    } else {
+      ASSERT_EQ(set.Insert(key), reference.insert(key).second);
+    }
+    ASSERT_EQ(set.Size(), reference.size());
+  }
+  for (int64_t key = 0; key <= 200; ++key) {
+    EXPECT_EQ(set.Contains(key), reference.count(key) == 1);
+  }
+}
+
+TEST(FlatHashSet, Clear) {
+  FlatHashSet<int64_t> set;
+  for (int64_t key = 0; key < 100; ++key) {
+    set.Insert(key);
+  }
+  const std::size_t capacity = set.Capacity();
+  EXPECT_GE(capacity, 200);
+  set.Clear();
+  EXPECT_TRUE(set.Empty());
+  EXPECT_FALSE(set.Contains(50));
+  EXPECT_EQ(set.Capacity(), capacity);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,144 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FleetComposition.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+TEST(FleetComposition, AliasTable) {
+  const std::vector<double> weights{6.0, 0.0, 3.0, 1.0};
+  const AliasTable table{weights};
+  EXPECT_EQ(table.Size(), 4);
+
+  // Drawing from an evenly spaced grid of uniform variates reproduces the weights.
+  constexpr std::size_t draws = 100000;
+  std::vector<std::size_t> counts(weights.size(), 0);
+  for (std::size_t draw = 0; draw < draws; ++draw) {
+    ++counts[table.Draw((static_cast<double>(draw) + 0.5) / static_cast<double>(draws))];
+  }
+  EXPECT_NEAR(static_cast<double>(counts[0]), 0.6 * draws, 10.0);
+  EXPECT_EQ(counts[1], 0);
+  EXPECT_NEAR(static_cast<double>(counts[2]), 0.3 * draws, 10.0);
+  EXPECT_NEAR(static_cast<double>(counts[3]), 0.1 * draws, 10.0);
+}
+
+TEST(FleetComposition, Valid) {
+  EXPECT_FALSE(FleetComposition().Valid());
+  EXPECT_FALSE(FleetComposition({0.0, 0.0}).Valid());
+  EXPECT_FALSE(FleetComposition({1.0, -1.0}).Valid());
+  EXPECT_FALSE(FleetComposition({1.0, std::numeric_limits<double>::infinity()}).Valid());
+  EXPECT_FALSE(FleetComposition({1.0, std::numeric_limits<double>::quiet_NaN()}).Valid());
+  EXPECT_TRUE(FleetComposition({0.0, 1.0}).Valid());
+  EXPECT_TRUE(FleetComposition::Uniform(5).Valid());
+}
+
+TEST(FleetComposition, Apportion) {
+  const FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}};
+  EXPECT_EQ(composition.Apportion(1000), std::vector<std::size_t>({600, 200, 100, 50, 50}));
+  EXPECT_EQ(composition.Apportion(0), std::vector<std::size_t>({0, 0, 0, 0, 0}));
+  EXPECT_EQ(composition.Apportion(7), std::vector<std::size_t>({4, 2, 1, 0, 0}));
+  EXPECT_EQ(FleetComposition::Uniform(3).Apportion(4), std::vector<std::size_t>({2, 1, 1}));
+}
+
+TEST(FleetComposition, Sampled) {
+  const FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}};
+  std::mt19937_64 random_generator(0);
+  const std::vector<uint32_t> indices = composition.Draw(200000, random_generator);
+  ASSERT_EQ(indices.size(), 200000);
+
+  std::vector<std::size_t> counts(composition.Size(), 0);
+  for (const uint32_t index : indices) {
+    ASSERT_LT(index, composition.Size());
+    ++counts[index];
+  }
+  EXPECT_NEAR(static_cast<double>(counts[0]) / 200000.0, 0.60, 0.005);
+  EXPECT_NEAR(static_cast<double>(counts[1]) / 200000.0, 0.20, 0.005);
+  EXPECT_NEAR(static_cast<double>(counts[2]) / 200000.0, 0.10, 0.005);
+  EXPECT_NEAR(static_cast<double>(counts[3]) / 200000.0, 0.05, 0.005);
+  EXPECT_NEAR(static_cast<double>(counts[4]) / 200000.0, 0.05, 0.005);
+
+  // The same seed draws the same fleet.
+  std::mt19937_64 same_random_generator(0);
+  EXPECT_EQ(composition.Draw(200000, same_random_generator), indices);
+}
+
+TEST(FleetComposition, ThreadCount) {
+  const FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}};
+  const std::size_t count = 3 * FleetComposition::ChunkSize + 17;
+  std::mt19937_64 random_generator(0);
+  const std::vector<uint32_t> indices = composition.Draw(count, random_generator, 1);
+  for (const std::size_t thread_count : {0, 2, 3, 8}) {
+    std::mt19937_64 same_random_generator(0);
+    EXPECT_EQ(composition.Draw(count, same_random_generator, thread_count), indices);
+  }
+}
+
+TEST(FleetComposition, Exact) {
+  const FleetComposition composition{{60.0, 20.0, 10.0, 5.0, 5.0}, FleetCompositionMode::Exact};
+  std::mt19937_64 random_generator(0);
+  const std::vector<uint32_t> indices = composition.Draw(1000, random_generator);
+  ASSERT_EQ(indices.size(), 1000);
+
+  std::vector<std::size_t> counts(composition.Size(), 0);
+  for (const uint32_t index : indices) {
+    ++counts[index];
+  }
+  EXPECT_EQ(counts, composition.Apportion(1000));
+
+  // The vehicle models are shuffled rather than grouped.
+  EXPECT_NE(std::vector<uint32_t>(indices.begin(), indices.begin() + 600),
+            std::vector<uint32_t>(600, 0));
+}
+
+TEST(FleetComposition, Invalid) {
+  std::mt19937_64 random_generator(0);
+  EXPECT_TRUE(FleetComposition({0.0, 0.0}).Draw(10, random_generator).empty());
+}
+
+TEST(FleetComposition, ParseWeights) {
+  EXPECT_EQ(ParseWeights("60,20,10,5,5"), std::vector<double>({60.0, 20.0, 10.0, 5.0, 5.0}));
+  EXPECT_EQ(ParseWeights("0.5"), std::vector<double>({0.5}));
+  EXPECT_EQ(ParseWeights("1,0"), std::vector<double>({1.0, 0.0}));
+  EXPECT_EQ(ParseWeights(""), std::nullopt);
+  EXPECT_EQ(ParseWeights("0,0"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,-1"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,,2"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,a"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,2,"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,inf"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1,nan"), std::nullopt);
+  EXPECT_EQ(ParseWeights("1e999"), std::nullopt);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,349 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FleetKernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+// Randomly generated state of a group of vehicles, whose size is not a multiple of any SIMD width.
+struct RandomState {
+  explicit RandomState(const std::size_t count) {
+    std::mt19937_64 random_generator(0);
+    std::uniform_real_distribution<double> distribution(0.0, 100.0);
+    for (std::vector<double>* array :
+         {&battery, &transport_power_usage, &cruise_speed, &passenger_count, &flight_duration,
+          &flight_distance, &flight_passenger_distance, &charging_rate, &charging_duration}) {
+      array->resize(count);
+      for (double& value : *array) {
+        value = distribution(random_generator);
+      }
+    }
+  }
+
+  FlightArrays Flight() {
+    FlightArrays arrays;
+    arrays.count = battery.size();
+    arrays.battery = battery.data();
+    arrays.transport_power_usage = transport_power_usage.data();
+    arrays.cruise_speed = cruise_speed.data();
+    arrays.passenger_count = passenger_count.data();
+    arrays.flight_duration = flight_duration.data();
+    arrays.flight_distance = flight_distance.data();
+    arrays.flight_passenger_distance = flight_passenger_distance.data();
+    return arrays;
+  }
+
+  ChargingArrays Charging() {
+    ChargingArrays arrays;
+    arrays.count = battery.size();
+    arrays.battery = battery.data();
+    arrays.charging_rate = charging_rate.data();
+    arrays.charging_duration = charging_duration.data();
+    return arrays;
+  }
+
+  std::vector<double> battery;
+
+  std::vector<double> transport_power_usage;
+
+  std::vector<double> cruise_speed;
+
+  std::vector<double> passenger_count;
+
+  std::vector<double> flight_duration;
+
+  std::vector<double> flight_distance;
+
+  std::vector<double> flight_passenger_distance;
+
+  std::vector<double> charging_rate;
+
+  std::vector<double> charging_duration;
+};
+
+// Instruction sets supported by this processor, from narrowest to widest.
+std::vector<InstructionSet> SupportedInstructionSets() {
+  std::vector<InstructionSet> instruction_sets;
+  for (const InstructionSet instruction_set :
+       {InstructionSet::Scalar, InstructionSet::Sse42, InstructionSet::Avx2,
+        InstructionSet::Avx512}) {
+    if (instruction_set <= DetectInstructionSet()) {
+      instruction_sets.push_back(instruction_set);
+    }
+  }
+  return instruction_sets;
+}
+
+void ExpectEqual(const std::vector<double>& left, const std::vector<double>& right) {
+  ASSERT_EQ(left.size(), right.size());
+  for (std::size_t index = 0; index < left.size(); ++index) {
+    EXPECT_DOUBLE_EQ(left[index], right[index]);
+  }
+}
+
+TEST(FleetKernels, FlyScalar) {
+  RandomState state{3};
+  const double battery = state.battery[1];
+  const double flight_duration = state.flight_duration[1];
+  const double flight_distance = state.flight_distance[1];
+  const double flight_passenger_distance = state.flight_passenger_distance[1];
+  FlyKernelScalar(state.Flight(), 2.0);
+  EXPECT_DOUBLE_EQ(state.battery[1], battery - 2.0 * state.transport_power_usage[1]);
+  EXPECT_DOUBLE_EQ(state.flight_duration[1], flight_duration + 2.0);
+  EXPECT_DOUBLE_EQ(state.flight_distance[1], flight_distance + 2.0 * state.cruise_speed[1]);
+  EXPECT_DOUBLE_EQ(
+      state.flight_passenger_distance[1],
+      flight_passenger_distance + state.passenger_count[1] * 2.0 * state.cruise_speed[1]);
+}
+
+TEST(FleetKernels, ChargeScalar) {
+  RandomState state{3};
+  const double battery = state.battery[2];
+  const double charging_duration = state.charging_duration[2];
+  ChargeKernelScalar(state.Charging(), 0.5);
+  EXPECT_DOUBLE_EQ(state.battery[2], battery + 0.5 * state.charging_rate[2]);
+  EXPECT_DOUBLE_EQ(state.charging_duration[2], charging_duration + 0.5);
+}
+
+TEST(FleetKernels, FaultScalar) {
+  RandomState state{3};
+  std::vector<double> expected_faults(3);
+  FaultArrays arrays;
+  arrays.count = 3;
+  arrays.mean_fault_rate = state.charging_rate.data();
+  arrays.expected_faults = expected_faults.data();
+  FaultKernelScalar(arrays, 0.5);
+  EXPECT_DOUBLE_EQ(expected_faults[0], 0.5 * state.charging_rate[0]);
+  EXPECT_DOUBLE_EQ(expected_faults[2], 0.5 * state.charging_rate[2]);
+}
+
+TEST(FleetKernels, MinimumScalar) {
+  const std::vector<double> values{4.0, 2.0, 3.0};
+  EXPECT_EQ(MinimumKernelScalar(values.data(), values.size(), 5.0), 2.0);
+  EXPECT_EQ(MinimumKernelScalar(values.data(), values.size(), 1.0), 1.0);
+  EXPECT_EQ(MinimumKernelScalar(values.data(), 0, 5.0), 5.0);
+}
+
+TEST(FleetKernels, FlyMatchesScalar) {
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    const FleetKernelTable kernels = FleetKernelsFor(instruction_set);
+    EXPECT_EQ(kernels.instruction_set, instruction_set);
+    RandomState scalar{1003};
+    RandomState simd{1003};
+    for (int64_t step = 0; step < 10; ++step) {
+      FlyKernelScalar(scalar.Flight(), 0.25);
+      kernels.fly(simd.Flight(), 0.25);
+    }
+    ExpectEqual(simd.battery, scalar.battery);
+    ExpectEqual(simd.flight_duration, scalar.flight_duration);
+    ExpectEqual(simd.flight_distance, scalar.flight_distance);
+    ExpectEqual(simd.flight_passenger_distance, scalar.flight_passenger_distance);
+  }
+}
+
+TEST(FleetKernels, ChargeMatchesScalar) {
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    const FleetKernelTable kernels = FleetKernelsFor(instruction_set);
+    RandomState scalar{1003};
+    RandomState simd{1003};
+    for (int64_t step = 0; step < 10; ++step) {
+      ChargeKernelScalar(scalar.Charging(), 0.25);
+      kernels.charge(simd.Charging(), 0.25);
+    }
+    ExpectEqual(simd.battery, scalar.battery);
+    ExpectEqual(simd.charging_duration, scalar.charging_duration);
+  }
+}
+
+TEST(FleetKernels, FaultIsScalar) {
+  // The expected fault counts are one multiplication per vehicle, so every instruction set uses the
+  // scalar kernel.
+  using FaultKernelPointer = void (*)(const FaultArrays&, double) noexcept;
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    EXPECT_EQ(FleetKernelsFor(instruction_set).fault,
+              static_cast<FaultKernelPointer>(&FaultKernelScalar));
+  }
+}
+
+TEST(FleetKernels, MinimumMatchesScalar) {
+  const RandomState state{1003};
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    const FleetKernelTable kernels = FleetKernelsFor(instruction_set);
+    // Check every count up to a few SIMD widths so that the minimum falls both in the SIMD part and
+    // in the scalar tail.
+    for (std::size_t count = 0; count < 40; ++count) {
+      EXPECT_EQ(kernels.minimum(state.battery.data(), count, 1000.0),
+                MinimumKernelScalar(state.battery.data(), count, 1000.0));
+    }
+    EXPECT_EQ(kernels.minimum(state.battery.data(), state.battery.size(), 1000.0),
+              MinimumKernelScalar(state.battery.data(), state.battery.size(), 1000.0));
+    EXPECT_EQ(kernels.minimum(state.battery.data(), state.battery.size(), -1.0), -1.0);
+  }
+}
+
+// Randomly generated states of a group of vehicles for the next event kernels, with every status,
+// empty and full batteries, and vehicles without a vehicle model.
+struct RandomEvents {
+  explicit RandomEvents(const std::size_t count) {
+    std::mt19937_64 random_generator(1);
+    std::uniform_real_distribution<double> distribution(1.0, 100.0);
+    std::uniform_int_distribution<int> statuses(0, 3);
+    for (std::size_t index = 0; index < count; ++index) {
+      status.push_back(static_cast<VehicleStatus>(statuses(random_generator)));
+      battery_capacity.push_back(distribution(random_generator));
+      battery.push_back(index % 5 == 0 ? 0.0 :
+                        index % 7 == 0 ? battery_capacity.back() :
+                                         0.5 * battery_capacity.back());
+      charging_rate.push_back(distribution(random_generator));
+      transport_energy_consumption.push_back(distribution(random_generator));
+      cruise_speed.push_back(distribution(random_generator));
+      if (index % 11 == 0) {
+        battery_capacity.back() = 0.0;
+        charging_rate.back() = 0.0;
+        transport_energy_consumption.back() = 0.0;
+        cruise_speed.back() = 0.0;
+      }
+    }
+    durations.resize(count);
+  }
+
+  EventArrays Arrays() {
+    EventArrays arrays;
+    arrays.count = status.size();
+    arrays.status = status.data();
+    arrays.battery = battery.data();
+    arrays.battery_capacity = battery_capacity.data();
+    arrays.charging_rate = charging_rate.data();
+    arrays.transport_energy_consumption = transport_energy_consumption.data();
+    arrays.cruise_speed = cruise_speed.data();
+    arrays.durations = durations.data();
+    return arrays;
+  }
+
+  std::vector<VehicleStatus> status;
+
+  std::vector<double> battery;
+
+  std::vector<double> battery_capacity;
+
+  std::vector<double> charging_rate;
+
+  std::vector<double> transport_energy_consumption;
+
+  std::vector<double> cruise_speed;
+
+  std::vector<double> durations;
+};
+
+TEST(FleetKernels, NextEventScalar) {
+  RandomEvents events{1003};
+  const double minimum = NextEventKernelScalar(events.Arrays(), 1.0e9);
+  for (std::size_t index = 0; index < events.status.size(); ++index) {
+    const double battery = events.battery[index];
+    const double capacity = events.battery_capacity[index];
+    double expected = 0.0;
+    const bool in_flight = events.status[index] == VehicleStatus::Flying
+                           || (events.status[index] == VehicleStatus::OnStandby && battery > 0.0);
+    if (in_flight && events.cruise_speed[index] > 0.0) {
+      expected = battery / events.transport_energy_consumption[index] / events.cruise_speed[index];
+    } else if (!in_flight && battery < capacity) {
+      expected = (capacity - battery) / events.charging_rate[index];
+    }
+    EXPECT_DOUBLE_EQ(events.durations[index], expected);
+  }
+  EXPECT_EQ(minimum, 0.0);
+}
+
+TEST(FleetKernels, NextEventMatchesScalar) {
+  RandomEvents scalar{1003};
+  // Drop the vehicles whose next status change is immediate so that the minimum is not zero.
+  for (std::size_t index = 0; index < scalar.status.size(); ++index) {
+    scalar.status[index] = VehicleStatus::Flying;
+    scalar.battery[index] = 1.0 + static_cast<double>(index % 13);
+    scalar.transport_energy_consumption[index] = 1.0 + static_cast<double>(index % 17);
+    scalar.cruise_speed[index] = 1.0 + static_cast<double>(index % 19);
+  }
+  const double expected = NextEventKernelScalar(scalar.Arrays(), 1.0e9);
+  EXPECT_GT(expected, 0.0);
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    RandomEvents simd = scalar;
+    EXPECT_EQ(FleetKernelsFor(instruction_set).next_event(simd.Arrays(), 1.0e9), expected);
+    ExpectEqual(simd.durations, scalar.durations);
+  }
+  RandomEvents mixed_scalar{1003};
+  NextEventKernelScalar(mixed_scalar.Arrays(), 1.0e9);
+  for (const InstructionSet instruction_set : SupportedInstructionSets()) {
+    RandomEvents simd{1003};
+    FleetKernelsFor(instruction_set).next_event(simd.Arrays(), 1.0e9);
+    ExpectEqual(simd.durations, mixed_scalar.durations);
+  }
+}
+
+TEST(FleetKernels, SelectEvents) {
+  RandomEvents events{1003};
+  NextEventKernel(events.Arrays(), 1.0e9);
+  std::vector<std::size_t> positions(events.status.size());
+  const std::size_t count = SelectEventsKernel(events.Arrays(), 0.5, positions.data());
+  std::size_t position = 0;
+  for (std::size_t index = 0; index < events.status.size(); ++index) {
+    if (events.durations[index] <= 0.5 || events.status[index] == VehicleStatus::OnStandby
+        || events.status[index] == VehicleStatus::WaitingToCharge) {
+      ASSERT_LT(position, count);
+      EXPECT_EQ(positions[position], index);
+      ++position;
+    }
+  }
+  EXPECT_EQ(position, count);
+}
+
+TEST(FleetKernels, Dispatch) {
+  EXPECT_EQ(GlobalFleetKernels().instruction_set, DetectInstructionSet());
+  EXPECT_EQ(FleetKernelInstructionSet(), InstructionSetName(DetectInstructionSet()));
+  EXPECT_EQ(InstructionSetName(InstructionSet::Scalar), "Scalar");
+  EXPECT_EQ(InstructionSetName(InstructionSet::Sse42), "SSE4.2");
+  EXPECT_EQ(InstructionSetName(InstructionSet::Avx2), "AVX2");
+  EXPECT_EQ(InstructionSetName(InstructionSet::Avx512), "AVX-512");
+}
+
+TEST(FleetKernels, EmptyGroup) {
+  const FlightArrays flight;
+  FlyKernel(flight, 1.0);
+  const ChargingArrays charging;
+  ChargeKernel(charging, 1.0);
+  const FaultArrays faults;
+  FaultKernel(faults, 1.0);
+  EXPECT_EQ(MinimumKernel(nullptr, 0, 1.0), 1.0);
+  const EventArrays events;
+  EXPECT_EQ(NextEventKernel(events, 1.0), 1.0);
+  EXPECT_EQ(SelectEventsKernel(events, 1.0, nullptr), 0);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,400 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FleetState.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../source/ChargingStations.hpp"
+#include "../source/MemoryAccounting.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/VehicleModelCatalog.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Vehicle models without faults, so that a simulation does not depend on its random draws.
+constexpr std::array<VehicleModelSpec, 3> FaultlessCatalog{{
+    {1, "Alpha", "One", 4, 120.0, 320.0, 0.6, 0.0, 1.6},
+    {2, "Bravo", "Two", 5, 100.0, 100.0, 0.2, 0.0, 1.5},
+    {3, "Charlie", "Three", 3, 160.0, 220.0, 0.8, 0.0, 2.2},
+}};
+
+// Advances a fleet to its next event as the simulation did before its state persisted across time
+// steps: every vehicle performs every time step through its own object. Returns false if the fleet
+// cannot progress any further.
+// Events are reported to a given observer.
+template <typename Observer>
+bool ReferenceStep(Vehicles& vehicles, ChargingStations& charging_stations,
+                   std::mt19937_64& random_generator, PhQ::Time<>& elapsed_time,
+                   const PhQ::Time<>& duration, Observer& observer) noexcept {
+  double time_step = (duration - elapsed_time).Value();
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    time_step = std::min(time_step, vehicle->DurationToNextStatusChange().Value());
+  }
+  if (time_step <= 0.0) {
+    return false;
+  }
+
+  const double threshold = time_step * (1.0 + FleetState::Tolerance) + FleetState::Tolerance;
+  std::vector<Vehicle*> selected;
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    if (vehicle->DurationToNextStatusChange().Value() <= threshold
+        || vehicle->Status() == VehicleStatus::OnStandby
+        || vehicle->Status() == VehicleStatus::WaitingToCharge) {
+      selected.push_back(vehicle.get());
+    }
+  }
+
+  const PhQ::Time start_time = elapsed_time;
+  const PhQ::Time<> step{time_step, PhQ::Unit::Time::Second};
+  elapsed_time += step;
+  for (Vehicle* const vehicle : selected) {
+    vehicle->Update(charging_stations, start_time, observer);
+  }
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    vehicle->PerformTimeStep(step, charging_stations, random_generator, start_time, observer);
+  }
+  for (Vehicle* const vehicle : selected) {
+    vehicle->Update(charging_stations, elapsed_time, observer);
+  }
+  return true;
+}
+
+// Observer that counts the faults reported during a simulation.
+struct FaultCountingObserver : public SimulationObserver {
+  void OnFault(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/,
+               const int64_t count) noexcept {
+    faults += count;
+  }
+
+  int64_t faults = 0;
+};
+
+// State of a vehicle as seen by an observer when it is notified of an event of that vehicle.
+struct ObservedEvent {
+  int32_t event = 0;
+
+  VehicleId id = 0;
+
+  double time = 0.0;
+
+  VehicleStatus status = VehicleStatus::OnStandby;
+
+  double battery = 0.0;
+
+  int64_t flight_count = 0;
+
+  double flight_duration = 0.0;
+
+  double flight_distance = 0.0;
+
+  double charging_duration = 0.0;
+};
+
+// Observer that records the state of each vehicle that it is notified of.
+struct RecordingObserver : public SimulationObserver {
+  void OnTakeoff(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    Record(0, time, vehicle);
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    Record(1, time, vehicle);
+  }
+
+  void OnEnqueue(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    Record(2, time, vehicle);
+  }
+
+  void OnChargeStart(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    Record(3, time, vehicle);
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    Record(4, time, vehicle);
+  }
+
+  void Record(const int32_t event, const PhQ::Time<>& time, const Vehicle& vehicle) noexcept {
+    events.push_back({event, vehicle.Id(), time.Value(), vehicle.Status(), vehicle.Battery().Value(),
+                      vehicle.Statistics().TotalFlightCount(),
+                      vehicle.Statistics().TotalFlightDuration().Value(),
+                      vehicle.Statistics().TotalFlightDistance().Value(),
+                      vehicle.Statistics().TotalChargingDuration().Value()});
+  }
+
+  std::vector<ObservedEvent> events;
+};
+
+// Expects two values to be equal up to the rounding of sums accumulated in a different order.
+void ExpectClose(const double actual, const double expected) {
+  EXPECT_NEAR(actual, expected, 1.0e-9 * std::max(std::abs(expected), 1.0));
+}
+
+TEST(FleetState, Empty) {
+  const Vehicles vehicles;
+  FleetState fleet_state;
+  EXPECT_FALSE(fleet_state.Current(vehicles));
+  fleet_state.Gather(vehicles);
+  EXPECT_TRUE(fleet_state.Current(vehicles));
+  EXPECT_EQ(fleet_state.Size(), 0);
+  EXPECT_EQ(fleet_state.Reduce(5.0), 5.0);
+  EXPECT_EQ(fleet_state.Select(5.0), 0);
+  EXPECT_EQ(fleet_state.SelectedCount(), 0);
+}
+
+TEST(FleetState, Current) {
+  std::mt19937_64 random_generator(3);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{10, vehicle_models, random_generator};
+
+  FleetState fleet_state;
+  fleet_state.Gather(vehicles);
+  EXPECT_TRUE(fleet_state.Current(vehicles));
+
+  // Any change of the membership of the fleet requires the state to be gathered again.
+  const std::shared_ptr<Vehicle> vehicle = vehicles.At(0);
+  ASSERT_NE(vehicle, nullptr);
+  EXPECT_TRUE(vehicles.Remove(0));
+  EXPECT_FALSE(fleet_state.Current(vehicles));
+  fleet_state.Gather(vehicles);
+  EXPECT_EQ(fleet_state.Size(), 9);
+  EXPECT_TRUE(vehicles.Insert(vehicle));
+  EXPECT_FALSE(fleet_state.Current(vehicles));
+
+  const Vehicles other;
+  EXPECT_FALSE(fleet_state.Current(other));
+}
+
+TEST(FleetState, Memory) {
+  const MemoryAccount& account = GlobalMemoryAccounting().Account(MemorySubsystem::FleetState);
+  const std::size_t live = account.Live();
+  {
+    std::mt19937_64 random_generator(3);
+    const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+    const Vehicles vehicles{100, vehicle_models, random_generator};
+    FleetState fleet_state;
+    fleet_state.Gather(vehicles);
+
+    // Each vehicle has at least its pointer and its battery in the arrays.
+    EXPECT_GE(account.Live() - live, 100 * (sizeof(Vehicle*) + sizeof(double)));
+  }
+
+  // Everything is released when the fleet state is destroyed.
+  EXPECT_EQ(account.Live(), live);
+}
+
+TEST(FleetState, Kernels) {
+  std::mt19937_64 random_generator(3);
+
+  // The vehicles of the sample vehicle models use the kernels specialized for their vehicle model.
+  const VehicleModels sample_vehicle_models = GenerateSampleVehicleModels();
+  Vehicles sample_vehicles{20, sample_vehicle_models, random_generator};
+  FleetState fleet_state;
+  fleet_state.Gather(sample_vehicles);
+  for (std::size_t position = 0; position < fleet_state.Size(); ++position) {
+    const Vehicle& vehicle = fleet_state.At(position);
+    EXPECT_EQ(&fleet_state.Kernels(position),
+              CatalogKernels<SampleVehicleModelCatalog>::Find(
+                  vehicle.Model()->Id(), vehicle.ModelParameters()));
+  }
+
+  // A vehicle model that reuses the ID of a sample vehicle model with different parameters uses the
+  // kernels of this processor.
+  std::array<VehicleModelSpec, 1> catalog{SampleVehicleModelCatalog[0]};
+  catalog[0].cruise_speed_miles_per_hour *= 2.0;
+  const VehicleModels vehicle_models = VehicleModelsFromCatalog(catalog);
+  Vehicles vehicles{5, vehicle_models, random_generator};
+  fleet_state.Gather(vehicles);
+  for (std::size_t position = 0; position < fleet_state.Size(); ++position) {
+    EXPECT_EQ(&fleet_state.Kernels(position), &GlobalFleetKernels());
+  }
+}
+
+TEST(FleetState, MatchesVehicles) {
+  std::mt19937_64 random_generator(3);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{50, vehicle_models, random_generator};
+  ChargingStations charging_stations{2};
+
+  // Advance the fleet so that its vehicles are in a mix of statuses.
+  Simulation simulation{
+      PhQ::Time(10.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator};
+  simulation.StepEvents(60);
+
+  FleetState fleet_state;
+  fleet_state.Gather(vehicles);
+  ASSERT_EQ(fleet_state.Size(), vehicles.Size());
+  const double minimum = fleet_state.Reduce(std::numeric_limits<double>::max());
+
+  double expected_minimum = std::numeric_limits<double>::max();
+  for (std::size_t position = 0; position < fleet_state.Size(); ++position) {
+    const double duration = fleet_state.At(position).DurationToNextStatusChange().Value();
+    EXPECT_DOUBLE_EQ(fleet_state.Duration(position), duration);
+    expected_minimum = std::min(expected_minimum, duration);
+  }
+  EXPECT_DOUBLE_EQ(minimum, expected_minimum);
+
+  // The selected vehicles are, in the order of the fleet, those that attain the minimum and those
+  // whose status depends on the charging station queues.
+  const std::size_t count = fleet_state.Select(minimum);
+  EXPECT_EQ(fleet_state.SelectedCount(), count);
+  std::size_t position = 0;
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    const VehicleStatus status = vehicle->Status();
+    const bool expected = vehicle->DurationToNextStatusChange().Value() == minimum
+                          || status == VehicleStatus::OnStandby
+                          || status == VehicleStatus::WaitingToCharge;
+    if (expected) {
+      ASSERT_LT(position, count);
+      EXPECT_EQ(&fleet_state.Selected(position), vehicle.get());
+      ++position;
+    }
+  }
+  EXPECT_EQ(position, count);
+  EXPECT_GT(count, 0);
+  EXPECT_LT(count, vehicles.Size());
+}
+
+TEST(FleetState, MatchesReference) {
+  const VehicleModels vehicle_models = VehicleModelsFromCatalog(FaultlessCatalog);
+  const PhQ::Time duration{6.0, PhQ::Unit::Time::Hour};
+
+  std::mt19937_64 random_generator(7);
+  Vehicles vehicles{40, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation simulation{duration, vehicles, charging_stations, random_generator};
+
+  std::mt19937_64 reference_random_generator(7);
+  Vehicles reference_vehicles{40, vehicle_models, reference_random_generator};
+  ChargingStations reference_charging_stations{3};
+  PhQ::Time reference_elapsed_time = PhQ::Time<>::Zero();
+  SimulationObserver reference_observer;
+
+  // Step both fleets in batches, so that the state of the simulation persists across time steps
+  // and is only brought up to date at the end of each batch.
+  while (!simulation.Finished()) {
+    const std::size_t count = simulation.StepEvents(10);
+    ASSERT_GT(count, 0);
+    for (std::size_t step = 0; step < count; ++step) {
+      ASSERT_TRUE(ReferenceStep(reference_vehicles, reference_charging_stations,
+                                reference_random_generator, reference_elapsed_time, duration,
+                                reference_observer));
+    }
+    ExpectClose(simulation.ElapsedTime().Value(), reference_elapsed_time.Value());
+
+    for (const std::shared_ptr<Vehicle>& reference_vehicle : reference_vehicles) {
+      const std::shared_ptr<Vehicle> vehicle = vehicles.At(reference_vehicle->Id());
+      ASSERT_NE(vehicle, nullptr);
+      EXPECT_EQ(vehicle->Status(), reference_vehicle->Status());
+      ExpectClose(vehicle->Battery().Value(), reference_vehicle->Battery().Value());
+      const Statistics& statistics = vehicle->Statistics();
+      const Statistics& reference_statistics = reference_vehicle->Statistics();
+      EXPECT_EQ(statistics.TotalFlightCount(), reference_statistics.TotalFlightCount());
+      ExpectClose(statistics.TotalFlightDuration().Value(),
+                  reference_statistics.TotalFlightDuration().Value());
+      ExpectClose(statistics.TotalFlightDistance().Value(),
+                  reference_statistics.TotalFlightDistance().Value());
+      ExpectClose(statistics.TotalFlightPassengerDistance().Value(),
+                  reference_statistics.TotalFlightPassengerDistance().Value());
+      EXPECT_EQ(statistics.TotalChargingSessionCount(),
+                reference_statistics.TotalChargingSessionCount());
+      ExpectClose(statistics.TotalChargingDuration().Value(),
+                  reference_statistics.TotalChargingDuration().Value());
+      EXPECT_EQ(statistics.TotalFaultCount(), 0);
+    }
+  }
+  EXPECT_EQ(simulation.ElapsedTime(), duration);
+  EXPECT_GT(simulation.TimeStepCount(), 20);
+}
+
+TEST(FleetState, ObservedVehiclesAreCurrent) {
+  const VehicleModels vehicle_models = VehicleModelsFromCatalog(FaultlessCatalog);
+  const PhQ::Time duration{6.0, PhQ::Unit::Time::Hour};
+
+  std::mt19937_64 random_generator(11);
+  Vehicles vehicles{40, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation<RecordingObserver> simulation{duration, vehicles, charging_stations, random_generator};
+
+  std::mt19937_64 reference_random_generator(11);
+  Vehicles reference_vehicles{40, vehicle_models, reference_random_generator};
+  ChargingStations reference_charging_stations{3};
+  PhQ::Time reference_elapsed_time = PhQ::Time<>::Zero();
+  RecordingObserver reference_observer;
+
+  // The whole simulation is one call, so the vehicles are only brought up to date at its end, but
+  // each vehicle that the observer is notified of is in the same state as in the reference, in
+  // which every vehicle performs every time step through its own object.
+  simulation.Run();
+  while (ReferenceStep(reference_vehicles, reference_charging_stations, reference_random_generator,
+                       reference_elapsed_time, duration, reference_observer)) {}
+
+  const std::vector<ObservedEvent>& events = simulation.Observer().events;
+  const std::vector<ObservedEvent>& reference_events = reference_observer.events;
+  ASSERT_EQ(events.size(), reference_events.size());
+  EXPECT_GT(events.size(), 100);
+  for (std::size_t index = 0; index < events.size(); ++index) {
+    const ObservedEvent& event = events[index];
+    const ObservedEvent& reference_event = reference_events[index];
+    EXPECT_EQ(event.event, reference_event.event);
+    EXPECT_EQ(event.id, reference_event.id);
+    ExpectClose(event.time, reference_event.time);
+    EXPECT_EQ(event.status, reference_event.status);
+    ExpectClose(event.battery, reference_event.battery);
+    EXPECT_EQ(event.flight_count, reference_event.flight_count);
+    ExpectClose(event.flight_duration, reference_event.flight_duration);
+    ExpectClose(event.flight_distance, reference_event.flight_distance);
+    ExpectClose(event.charging_duration, reference_event.charging_duration);
+  }
+}
+
+TEST(FleetState, Faults) {
+  std::mt19937_64 random_generator(5);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{100, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation<FaultCountingObserver> simulation{
+      PhQ::Time(20.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator};
+  simulation.Run();
+
+  // The faults drawn in bulk for the vehicles that fly or charge throughout a time step are
+  // recorded by these vehicles and reported to the observer, as are those that the selected
+  // vehicles draw themselves.
+  int64_t faults = 0;
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    faults += vehicle->Statistics().TotalFaultCount();
+  }
+  EXPECT_GT(faults, 0);
+  EXPECT_EQ(simulation.Observer().faults, faults);
+}
+
+}  // namespace
+
+}  // namespace Demo
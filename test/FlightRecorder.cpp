@@ -0,0 +1,199 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/FlightRecorder.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "../source/FlightRecorderReader.hpp"
+#include "../source/Simulation.hpp"
+
+namespace Demo {
+
+namespace {
+
+std::shared_ptr<const VehicleModel> CreateVehicleModel() {
+  return std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model B",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(1.0, PhQ::Unit::Speed::MetrePerSecond),
+      /*battery_capacity=*/PhQ::Energy(1.0, PhQ::Unit::Energy::Joule),
+      /*charging_duration=*/PhQ::Time(1.0, PhQ::Unit::Time::Second),
+      /*fault_rate=*/PhQ::Frequency(1.0, PhQ::Unit::Frequency::Hertz),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(1.0, PhQ::Unit::TransportEnergyConsumption::JoulePerMetre));
+}
+
+TEST(FlightRecorder, Capacity) {
+  const std::filesystem::path path{"capacity.flight"};
+  const FlightRecorder recorder{path, 100};
+  ASSERT_TRUE(recorder.IsOpen());
+  EXPECT_EQ(recorder.Path(), path);
+  EXPECT_EQ(recorder.Capacity(), 128);
+  EXPECT_EQ(recorder.Count(), 0);
+  EXPECT_EQ(std::filesystem::file_size(path),
+            FlightRecorderHeaderSize + 128 * sizeof(FlightRecorderEntry));
+
+  const FlightRecorderReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.Capacity(), 128);
+  EXPECT_EQ(reader.Count(), 0);
+  EXPECT_TRUE(reader.Snapshot().empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST(FlightRecorder, Ring) {
+  const std::filesystem::path path{"ring.flight"};
+  {
+    FlightRecorder recorder{path, 16};
+    for (int64_t index = 0; index < 100; ++index) {
+      recorder.Record(FlightRecorderEvent::Fault, static_cast<double>(index), index, index % 3);
+    }
+    recorder.RecordTimeStep(7, PhQ::Time(1.0E-300, PhQ::Unit::Time::Second),
+                            PhQ::Time(2.0, PhQ::Unit::Time::Second));
+    EXPECT_EQ(recorder.Count(), 101);
+  }
+
+  // The file persists after the recorder is destroyed.
+  const FlightRecorderReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.Count(), 101);
+  const std::vector<FlightRecorderRecord> records = reader.Snapshot();
+  ASSERT_EQ(records.size(), 16);
+  for (std::size_t index = 0; index + 1 < records.size(); ++index) {
+    const int64_t expected = 85 + static_cast<int64_t>(index);
+    EXPECT_EQ(records[index].sequence, static_cast<uint64_t>(expected) + 1);
+    EXPECT_EQ(records[index].event, FlightRecorderEvent::Fault);
+    EXPECT_EQ(records[index].time, static_cast<double>(expected));
+    EXPECT_EQ(records[index].subject, expected);
+    EXPECT_EQ(records[index].value, expected % 3);
+  }
+  EXPECT_EQ(records.back().event, FlightRecorderEvent::TimeStep);
+  EXPECT_EQ(records.back().subject, 7);
+  EXPECT_EQ(records.back().time, 2.0);
+  EXPECT_EQ(records.back().TimeStepDuration(), 1.0E-300);
+
+  std::filesystem::remove(path);
+}
+
+TEST(FlightRecorder, ConcurrentReader) {
+  const std::filesystem::path path{"concurrent.flight"};
+  FlightRecorder recorder{path, 64};
+  const FlightRecorderReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int64_t index = 1; index <= 200000; ++index) {
+      recorder.Record(FlightRecorderEvent::Takeoff, static_cast<double>(index), index, -index);
+    }
+    done.store(true);
+  });
+
+  // Every entry that the reader copies must be consistent, even while it is being overwritten.
+  int64_t snapshot_count = 0;
+  while (!done.load() || snapshot_count == 0) {
+    uint64_t previous_sequence = 0;
+    for (const FlightRecorderRecord& record : reader.Snapshot()) {
+      EXPECT_GT(record.sequence, previous_sequence);
+      previous_sequence = record.sequence;
+      EXPECT_EQ(record.subject, static_cast<int64_t>(record.sequence));
+      EXPECT_EQ(record.value, -record.subject);
+      EXPECT_EQ(record.time, static_cast<double>(record.subject));
+    }
+    ++snapshot_count;
+  }
+  writer.join();
+
+  EXPECT_EQ(reader.Count(), 200000);
+  EXPECT_EQ(reader.Snapshot().size(), 64);
+
+  std::filesystem::remove(path);
+}
+
+TEST(FlightRecorder, Simulation) {
+  const std::filesystem::path path{"simulation.flight"};
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+
+  Vehicles vehicles;
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
+
+  ChargingStations charging_stations{1};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  FlightRecorder recorder{path, 1024};
+  Simulation<FlightRecorderObserver> simulation{
+      duration, vehicles, charging_stations, random_generator, FlightRecorderObserver{&recorder}};
+  simulation.Run();
+
+  const FlightRecorderReader reader{path};
+  const std::vector<FlightRecorderRecord> records = reader.Snapshot();
+  int64_t time_steps = 0;
+  int64_t takeoffs = 0;
+  int64_t enqueues = 0;
+  for (const FlightRecorderRecord& record : records) {
+    time_steps += record.event == FlightRecorderEvent::TimeStep ? 1 : 0;
+    takeoffs += record.event == FlightRecorderEvent::Takeoff ? 1 : 0;
+    if (record.event == FlightRecorderEvent::Enqueue) {
+      ++enqueues;
+      EXPECT_EQ(record.subject, 222);
+      EXPECT_EQ(record.value, 0);
+    }
+  }
+  EXPECT_EQ(time_steps, 5);
+  EXPECT_EQ(takeoffs, 3);
+  EXPECT_EQ(enqueues, 3);
+  EXPECT_EQ(records.back().event, FlightRecorderEvent::Enqueue);
+  EXPECT_EQ(records.back().time, 5.0);
+
+  std::filesystem::remove(path);
+}
+
+TEST(FlightRecorder, InvalidFile) {
+  const std::filesystem::path path{"invalid.flight"};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "NOTAFLIGHTRECORDERFILE";
+  }
+
+  const FlightRecorderReader reader{path};
+  EXPECT_FALSE(reader.IsValid());
+  EXPECT_EQ(reader.Count(), 0);
+  EXPECT_TRUE(reader.Snapshot().empty());
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+
+}  // namespace Demo
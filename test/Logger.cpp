@@ -0,0 +1,168 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Logger.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+std::vector<std::string> ReadLines(const std::filesystem::path& path) {
+  std::vector<std::string> lines;
+  std::ifstream file;
+  file.open(path);
+  if (file.is_open()) {
+    std::string line;
+    while (std::getline(file, line)) {
+      lines.push_back(line);
+    }
+  }
+  return lines;
+}
+
+TEST(Logger, LevelNames) {
+  EXPECT_EQ(ParseLogLevel("error"), LogLevel::Error);
+  EXPECT_EQ(ParseLogLevel("warning"), LogLevel::Warning);
+  EXPECT_EQ(ParseLogLevel("information"), LogLevel::Information);
+  EXPECT_EQ(ParseLogLevel("debug"), LogLevel::Debug);
+  EXPECT_EQ(ParseLogLevel("bogus"), std::nullopt);
+  EXPECT_EQ(LogLevelName(LogLevel::Warning), "warning");
+}
+
+TEST(Logger, Levels) {
+  const std::filesystem::path path{"logger_levels.log"};
+  Logger logger;
+  ASSERT_TRUE(logger.SetFile(path));
+  EXPECT_EQ(logger.Level(), LogLevel::Information);
+
+  logger.Log(LogLevel::Information, "first");
+  logger.Log(LogLevel::Debug, "hidden");
+  logger.Log(LogLevel::Warning, "second");
+  logger.SetLevel(LogLevel::Error);
+  logger.Log(LogLevel::Warning, "hidden");
+  logger.Log(LogLevel::Error, "third");
+  logger.Flush();
+
+  const std::vector<std::string> lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], "first");
+  EXPECT_EQ(lines[1], "Warning: second");
+  EXPECT_EQ(lines[2], "Error: third");
+}
+
+TEST(Logger, LongMessage) {
+  const std::filesystem::path path{"logger_long_message.log"};
+  Logger logger{16};
+  ASSERT_TRUE(logger.SetFile(path));
+
+  std::string text;
+  for (int index = 0; index < 1000; ++index) {
+    text.push_back(static_cast<char>('a' + index % 26));
+  }
+  logger.Log(LogLevel::Information, text);
+  logger.Log(LogLevel::Information, "short");
+  logger.Flush();
+
+  const std::vector<std::string> lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], text);
+  EXPECT_EQ(lines[1], "short");
+}
+
+TEST(Logger, RateLimit) {
+  const std::filesystem::path path{"logger_rate_limit.log"};
+  Logger logger;
+  ASSERT_TRUE(logger.SetFile(path));
+  logger.SetRateLimit(LogLevel::Information, 1.0e-6, 2);
+
+  for (int index = 0; index < 5; ++index) {
+    logger.Log(LogLevel::Information, "limited");
+  }
+  logger.Log(LogLevel::Warning, "unlimited");
+  logger.Flush();
+
+  EXPECT_EQ(logger.SuppressedCount(), 3);
+  const std::vector<std::string> lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[2], "Warning: unlimited");
+
+  logger.SetRateLimit(LogLevel::Information, 0.0, 0);
+  EXPECT_TRUE(logger.Admit(LogLevel::Information));
+}
+
+TEST(Logger, Message) {
+  const std::filesystem::path path{"logger_message.log"};
+  Logger logger;
+  ASSERT_TRUE(logger.SetFile(path));
+
+  LogMessage(logger, LogLevel::Information) << "count = " << 42 << ", ratio = " << 0.5;
+  LogMessage(logger, LogLevel::Debug) << "hidden";
+  logger.Flush();
+
+  const std::vector<std::string> lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines[0], "count = 42, ratio = 0.5");
+}
+
+TEST(Logger, ConcurrentProducers) {
+  const std::filesystem::path path{"logger_concurrent_producers.log"};
+  constexpr int thread_count = 4;
+  constexpr int message_count = 2000;
+  {
+    Logger logger{8};
+    ASSERT_TRUE(logger.SetFile(path));
+
+    std::vector<std::thread> threads;
+    for (int thread_index = 0; thread_index < thread_count; ++thread_index) {
+      threads.emplace_back([&logger, thread_index] {
+        for (int index = 0; index < message_count; ++index) {
+          logger.Log(LogLevel::Information, std::to_string(thread_index));
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  const std::vector<std::string> lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), thread_count * message_count);
+  std::vector<int> counts(thread_count, 0);
+  for (const std::string& line : lines) {
+    ASSERT_EQ(line.size(), 1);
+    ++counts[line[0] - '0'];
+  }
+  for (const int count : counts) {
+    EXPECT_EQ(count, message_count);
+  }
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,219 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/MemoryAccounting.hpp"
+
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "../source/AggregateStatistics.hpp"
+#include "../source/ChargingStations.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Vehicles.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Memory resource that counts the bytes that it allocates from the default memory resource.
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t live = 0;
+
+  std::size_t allocated = 0;
+
+private:
+  void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+    live += bytes;
+    allocated += bytes;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* const pointer, const std::size_t bytes,
+                     const std::size_t alignment) override {
+    live -= bytes;
+    std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(MemoryAccounting, Account) {
+  MemoryAccount account;
+  account.Allocate(100);
+  account.Allocate(50);
+  EXPECT_EQ(account.Live(), 150);
+  EXPECT_EQ(account.Peak(), 150);
+  account.Deallocate(100);
+  EXPECT_EQ(account.Live(), 50);
+  EXPECT_EQ(account.Peak(), 150);
+  account.Allocate(20);
+  EXPECT_EQ(account.Live(), 70);
+  EXPECT_EQ(account.Peak(), 150);
+  EXPECT_EQ(account.Allocations(), 3);
+}
+
+TEST(MemoryAccounting, TotalPeak) {
+  // The subsystems reach their peaks at different times, so the peak of all subsystems together is
+  // less than the sum of their peaks.
+  MemoryAccounting accounting;
+  accounting.Allocate(MemorySubsystem::Vehicles, 100);
+  accounting.Deallocate(MemorySubsystem::Vehicles, 100);
+  accounting.Allocate(MemorySubsystem::VehicleList, 60);
+  EXPECT_EQ(accounting.Account(MemorySubsystem::Vehicles).Peak(), 100);
+  EXPECT_EQ(accounting.Account(MemorySubsystem::VehicleList).Peak(), 60);
+  EXPECT_EQ(accounting.Total().Live(), 60);
+  EXPECT_EQ(accounting.TotalLive(), 60);
+  EXPECT_EQ(accounting.Total().Peak(), 100);
+  EXPECT_EQ(accounting.Total().Allocations(), 2);
+  accounting.Allocate(MemorySubsystem::Vehicles, 50);
+  EXPECT_EQ(accounting.Total().Peak(), 110);
+}
+
+TEST(MemoryAccounting, Names) {
+  EXPECT_EQ(MemorySubsystemName(MemorySubsystem::Vehicles), "Vehicles");
+  EXPECT_EQ(MemorySubsystemName(MemorySubsystem::VehicleIndex), "VehicleIndex");
+  EXPECT_EQ(MemorySubsystemName(MemorySubsystem::ChargingStationSets), "ChargingStationSets");
+  EXPECT_EQ(MemorySubsystemName(MemorySubsystem::FleetState), "FleetState");
+}
+
+TEST(MemoryAccounting, TrackingAllocator) {
+  const MemoryAccount& account =
+      GlobalMemoryAccounting().Account(MemorySubsystem::ChargingStationQueues);
+  const std::size_t live = account.Live();
+  {
+    std::vector<int64_t, TrackingAllocator<int64_t, MemorySubsystem::ChargingStationQueues>>
+        vector;
+    vector.reserve(1000);
+    EXPECT_EQ(account.Live(), live + 1000 * sizeof(int64_t));
+    EXPECT_GE(account.Peak(), live + 1000 * sizeof(int64_t));
+  }
+  EXPECT_EQ(account.Live(), live);
+
+  // Rebound allocators account for the same subsystem.
+  const TrackingAllocator<int64_t, MemorySubsystem::ChargingStationQueues> allocator;
+  const TrackingAllocator<char, MemorySubsystem::ChargingStationQueues> rebound{allocator};
+  EXPECT_TRUE(allocator == rebound);
+  EXPECT_EQ(allocator.Resource(), std::pmr::get_default_resource());
+}
+
+TEST(MemoryAccounting, TrackingAllocatorResource) {
+  CountingResource resource;
+  const TrackingAllocator<int64_t, MemorySubsystem::ChargingStationQueues> allocator{&resource};
+  {
+    std::vector<int64_t, TrackingAllocator<int64_t, MemorySubsystem::ChargingStationQueues>>
+        vector{allocator};
+    vector.reserve(1000);
+    EXPECT_EQ(resource.live, 1000 * sizeof(int64_t));
+  }
+  EXPECT_EQ(resource.live, 0);
+
+  // Allocators are equal if and only if their memory resources are equal.
+  const TrackingAllocator<char, MemorySubsystem::ChargingStationQueues> rebound{allocator};
+  EXPECT_EQ(rebound.Resource(), &resource);
+  EXPECT_TRUE(allocator == rebound);
+  const TrackingAllocator<int64_t, MemorySubsystem::ChargingStationQueues> default_allocator;
+  EXPECT_FALSE(allocator == default_allocator);
+}
+
+TEST(MemoryAccounting, Resource) {
+  MemoryAccounting& accounting = GlobalMemoryAccounting();
+  const std::size_t total_live = accounting.TotalLive();
+  CountingResource resource;
+  {
+    std::mt19937_64 random_generator(1);
+    const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+    const Vehicles vehicles{100, vehicle_models, random_generator, &resource};
+    ChargingStations charging_stations{4, &resource};
+    charging_stations.At(0)->Enqueue(7);
+    const AggregateStatistics aggregate_statistics{vehicles, &resource};
+
+    // All accounted memory is drawn from the resource, along with the maps of vehicle models.
+    EXPECT_GT(accounting.TotalLive(), total_live);
+    EXPECT_GT(resource.live, accounting.TotalLive() - total_live);
+  }
+  EXPECT_EQ(resource.live, 0);
+  EXPECT_EQ(accounting.TotalLive(), total_live);
+}
+
+TEST(MemoryAccounting, MonotonicArena) {
+  CountingResource upstream;
+  std::pmr::monotonic_buffer_resource arena{&upstream};
+  std::mt19937_64 random_generator(1);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  for (int64_t run = 0; run < 3; ++run) {
+    {
+      const Vehicles vehicles{100, vehicle_models, random_generator, &arena};
+      const ChargingStations charging_stations{4, &arena};
+      EXPECT_GT(upstream.live, 0);
+    }
+
+    // Destroying the containers returns nothing to the upstream resource until the arena is
+    // released, which returns everything at once.
+    EXPECT_GT(upstream.live, 0);
+    arena.release();
+    EXPECT_EQ(upstream.live, 0);
+  }
+}
+
+TEST(MemoryAccounting, Subsystems) {
+  MemoryAccounting& accounting = GlobalMemoryAccounting();
+  const std::size_t vehicles_live = accounting.Account(MemorySubsystem::Vehicles).Live();
+  const std::size_t list_live = accounting.Account(MemorySubsystem::VehicleList).Live();
+  const std::size_t index_live = accounting.Account(MemorySubsystem::VehicleIndex).Live();
+  const std::size_t stations_live = accounting.Account(MemorySubsystem::ChargingStations).Live();
+  const std::size_t map_live = accounting.Account(MemorySubsystem::ChargingStationMap).Live();
+  const std::size_t total_live = accounting.TotalLive();
+  {
+    std::mt19937_64 random_generator(1);
+    const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+    const Vehicles vehicles{100, vehicle_models, random_generator};
+    ChargingStations charging_stations{4};
+
+    // Each vehicle is allocated together with its shared pointer control block.
+    EXPECT_GE(accounting.Account(MemorySubsystem::Vehicles).Live() - vehicles_live,
+              100 * sizeof(Vehicle));
+    EXPECT_GE(accounting.Account(MemorySubsystem::VehicleList).Live() - list_live,
+              100 * sizeof(std::shared_ptr<Vehicle>));
+    // The vehicle IDs of a generated fleet are dense, so their index allocates nothing.
+    EXPECT_EQ(accounting.Account(MemorySubsystem::VehicleIndex).Live(), index_live);
+    EXPECT_GE(accounting.Account(MemorySubsystem::ChargingStations).Live() - stations_live,
+              4 * sizeof(ChargingStation));
+    EXPECT_GT(accounting.Account(MemorySubsystem::ChargingStationMap).Live(), map_live);
+
+    const std::size_t sets_live = accounting.Account(MemorySubsystem::ChargingStationSets).Live();
+    charging_stations.At(0)->Enqueue(7);
+    EXPECT_GT(accounting.Account(MemorySubsystem::ChargingStationSets).Live(), sets_live);
+    EXPECT_GT(accounting.TotalLive(), total_live);
+  }
+
+  // Everything is released when the vehicles and the charging stations are destroyed.
+  EXPECT_EQ(accounting.TotalLive(), total_live);
+}
+
+}  // namespace
+
+}  // namespace Demo
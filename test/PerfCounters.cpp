@@ -0,0 +1,123 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/PerfCounters.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "../source/ChargingStations.hpp"
+#include "../source/Profiler.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/Vehicles.hpp"
+
+namespace Demo {
+
+namespace {
+
+TEST(PerfCounters, Names) {
+  EXPECT_EQ(PerfCounterName(PerfCounter::Cycles), "cycles");
+  EXPECT_EQ(PerfCounterName(PerfCounter::Instructions), "instructions");
+  EXPECT_EQ(PerfCounterName(PerfCounter::CacheMisses), "cache_misses");
+  EXPECT_EQ(PerfCounterName(PerfCounter::BranchMisses), "branch_misses");
+}
+
+TEST(PerfCounters, Group) {
+  const PerfCounterGroup group;
+  const PerfCounterValues start = group.Read();
+  volatile uint64_t sum = 0;
+  for (uint64_t index = 0; index < 1000000; ++index) {
+    sum = sum + index;
+  }
+  const PerfCounterValues end = group.Read();
+  for (std::size_t index = 0; index < PerfCounterCount; ++index) {
+    const PerfCounter counter = static_cast<PerfCounter>(index);
+    if (group.Available(counter)) {
+      EXPECT_GE(end[index], start[index]);
+    } else {
+      // Unavailable counters read as zero.
+      EXPECT_EQ(end[index], 0);
+    }
+  }
+  if (group.Available(PerfCounter::Instructions)) {
+    EXPECT_GT(end[1] - start[1], 1000000);
+  }
+}
+
+TEST(PerfCounters, Add) {
+  PerfCounters perf_counters;
+  perf_counters.Add(ProfilePhase::ComputeTimeStep, {1, 2, 3, 4}, {11, 32, 4, 6});
+  perf_counters.Add(ProfilePhase::ComputeTimeStep, {0, 0, 0, 0}, {5, 5, 5, 5});
+  EXPECT_EQ(perf_counters.Calls(ProfilePhase::ComputeTimeStep), 2);
+  EXPECT_EQ(perf_counters.Total(ProfilePhase::ComputeTimeStep, PerfCounter::Cycles), 15);
+  EXPECT_EQ(perf_counters.Total(ProfilePhase::ComputeTimeStep, PerfCounter::Instructions), 35);
+  EXPECT_EQ(perf_counters.Total(ProfilePhase::ComputeTimeStep, PerfCounter::CacheMisses), 6);
+  EXPECT_EQ(perf_counters.Total(ProfilePhase::ComputeTimeStep, PerfCounter::BranchMisses), 7);
+  EXPECT_EQ(perf_counters.Calls(ProfilePhase::Output), 0);
+}
+
+TEST(PerfCounters, NotStarted) {
+  const PerfCounters perf_counters;
+  EXPECT_FALSE(perf_counters.Active());
+  EXPECT_FALSE(perf_counters.Available());
+  EXPECT_EQ(perf_counters.Read(), PerfCounterValues{});
+  const std::string json = perf_counters.ToJson();
+  EXPECT_NE(json.find("\"available\": false"), std::string::npos);
+  EXPECT_NE(json.find("\"cycles\": false"), std::string::npos);
+  EXPECT_NE(json.find("{\"name\": \"ComputeTimeStep\", \"calls\": 0, \"cycles\": null"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"ipc\": null"), std::string::npos);
+}
+
+TEST(PerfCounters, Simulation) {
+  std::mt19937_64 random_generator(3);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{20, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation simulation{
+      PhQ::Time(3.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator};
+
+  PerfCounters& perf_counters = GlobalPerfCounters();
+  const bool available = perf_counters.Start();
+  EXPECT_EQ(available, perf_counters.Available());
+  EXPECT_EQ(available, perf_counters.Active());
+  simulation.Run();
+  perf_counters.Stop();
+  EXPECT_FALSE(perf_counters.Active());
+
+  const std::string json = perf_counters.ToJson();
+  if (available) {
+    EXPECT_EQ(perf_counters.Calls(ProfilePhase::PerformTimeStep), simulation.TimeStepCount());
+    EXPECT_NE(json.find("\"available\": true"), std::string::npos);
+  } else {
+    // The fallback measures nothing but still reports every phase.
+    EXPECT_EQ(perf_counters.Calls(ProfilePhase::PerformTimeStep), 0);
+    EXPECT_NE(json.find("\"available\": false"), std::string::npos);
+  }
+  EXPECT_NE(json.find("\"name\": \"WriteResults\""), std::string::npos);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,123 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Profiler.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "../source/ChargingStations.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/Vehicles.hpp"
+
+namespace Demo {
+
+namespace {
+
+TEST(Profiler, Enabled) {
+  // This test is compiled with DEMO_PROFILE defined.
+  EXPECT_TRUE(ProfilingEnabled);
+}
+
+TEST(Profiler, AddTimeAndCount) {
+  Profiler profiler;
+  profiler.AddTime(ProfilePhase::ComputeTimeStep, 100);
+  profiler.AddTime(ProfilePhase::ComputeTimeStep, 50);
+  profiler.AddTime(ProfilePhase::PerformTimeStep, 200);
+  profiler.AddTime(ProfilePhase::LowestCount, 20);
+  profiler.Count(ProfileCounter::Steps);
+  profiler.Count(ProfileCounter::VehiclesTouched, 10);
+
+  EXPECT_EQ(profiler.Nanoseconds(ProfilePhase::ComputeTimeStep), 150);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::ComputeTimeStep), 2);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::Output), 0);
+  EXPECT_EQ(profiler.Counter(ProfileCounter::Steps), 1);
+  EXPECT_EQ(profiler.Counter(ProfileCounter::VehiclesTouched), 10);
+
+  // Nested phases are not added to the total.
+  EXPECT_EQ(profiler.TotalNanoseconds(), 350);
+
+  profiler.Reset();
+  EXPECT_EQ(profiler.TotalNanoseconds(), 0);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::ComputeTimeStep), 0);
+  EXPECT_EQ(profiler.Counter(ProfileCounter::Steps), 0);
+}
+
+TEST(Profiler, PhaseNames) {
+  EXPECT_EQ(ProfilePhaseName(ProfilePhase::ComputeTimeStep), "ComputeTimeStep");
+  EXPECT_EQ(ProfilePhaseName(ProfilePhase::LowestCount), "LowestCount");
+  EXPECT_EQ(ProfilePhaseName(ProfilePhase::Output), "Output");
+  EXPECT_TRUE(ProfilePhaseIsNested(ProfilePhase::RandomDraw));
+  EXPECT_FALSE(ProfilePhaseIsNested(ProfilePhase::PerformTimeStep));
+}
+
+TEST(Profiler, ScopedPhaseTimer) {
+  GlobalProfiler().Reset();
+  {
+    DEMO_PROFILE_SCOPE(Output);
+    DEMO_PROFILE_COUNT(Enqueues, 3);
+  }
+  EXPECT_EQ(GlobalProfiler().Calls(ProfilePhase::Output), 1);
+  EXPECT_GE(GlobalProfiler().Nanoseconds(ProfilePhase::Output), 0);
+  EXPECT_EQ(GlobalProfiler().Counter(ProfileCounter::Enqueues), 3);
+  GlobalProfiler().Reset();
+}
+
+TEST(Profiler, Simulation) {
+  std::mt19937_64 random_generator(11);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{20, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation simulation{
+      PhQ::Time(3.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator};
+
+  GlobalProfiler().Reset();
+  simulation.Run();
+  const Profiler& profiler = GlobalProfiler();
+
+  const uint64_t steps = simulation.TimeStepCount();
+  EXPECT_GT(steps, 0);
+  EXPECT_EQ(profiler.Counter(ProfileCounter::Steps), steps);
+  // Only the vehicles whose status may change are updated at the beginning and end of each step and
+  // perform it through their own objects. Every other vehicle is advanced in bulk.
+  EXPECT_GT(profiler.Counter(ProfileCounter::VehiclesTouched), 0);
+  EXPECT_LT(profiler.Counter(ProfileCounter::VehiclesTouched), steps * vehicles.Size());
+  EXPECT_EQ(profiler.Counter(ProfileCounter::VehiclesUpdated),
+            2 * profiler.Counter(ProfileCounter::VehiclesTouched));
+  EXPECT_EQ(profiler.Calls(ProfilePhase::UpdateVehiclesAtStart), steps);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::PerformTimeStep), steps);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::UpdateVehiclesAtEnd), steps);
+  EXPECT_GE(profiler.Calls(ProfilePhase::ComputeTimeStep), steps);
+  // Vehicles that are waiting to charge draw no faults.
+  EXPECT_GT(profiler.Calls(ProfilePhase::RandomDraw), 0);
+  EXPECT_LE(profiler.Calls(ProfilePhase::RandomDraw), steps * vehicles.Size());
+  EXPECT_GT(profiler.Counter(ProfileCounter::Enqueues), 0);
+  EXPECT_EQ(profiler.Calls(ProfilePhase::LowestCount), profiler.Counter(ProfileCounter::Enqueues));
+  EXPECT_LE(profiler.Counter(ProfileCounter::Dequeues), profiler.Counter(ProfileCounter::Enqueues));
+  EXPECT_GT(profiler.TotalNanoseconds(), 0);
+  GlobalProfiler().Reset();
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,127 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/RingBuffer.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Demo {
+
+namespace {
+
+TEST(RingBuffer, Empty) {
+  RingBuffer<int64_t> queue;
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 0);
+  EXPECT_EQ(queue.Capacity(), 0);
+  queue.PushBack(111);
+  EXPECT_FALSE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 1);
+}
+
+TEST(RingBuffer, FirstInFirstOut) {
+  RingBuffer<int64_t> queue;
+  for (int64_t value = 0; value < 100; ++value) {
+    queue.PushBack(value);
+  }
+  EXPECT_EQ(queue.Size(), 100);
+  EXPECT_EQ(queue[99], 99);
+  for (int64_t value = 0; value < 100; ++value) {
+    ASSERT_EQ(queue.Front(), value);
+    queue.PopFront();
+  }
+  EXPECT_TRUE(queue.Empty());
+  queue.PopFront();
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(RingBuffer, WrapAroundWithoutGrowing) {
+  RingBuffer<int64_t> queue;
+  queue.Reserve(5);
+  EXPECT_EQ(queue.Capacity(), 8);
+  int64_t next_pushed = 0;
+  int64_t next_popped = 0;
+  for (int64_t round = 0; round < 100; ++round) {
+    while (queue.Size() < 8) {
+      queue.PushBack(next_pushed++);
+    }
+    while (queue.Size() > 3) {
+      ASSERT_EQ(queue.Front(), next_popped++);
+      queue.PopFront();
+    }
+  }
+  EXPECT_EQ(queue.Capacity(), 8);
+}
+
+TEST(RingBuffer, GrowWhenWrapped) {
+  RingBuffer<int64_t> queue;
+  for (int64_t value = 0; value < 4; ++value) {
+    queue.PushBack(value);
+  }
+  queue.PopFront();
+  queue.PopFront();
+  for (int64_t value = 4; value < 10; ++value) {
+    queue.PushBack(value);
+  }
+  EXPECT_EQ(queue.Size(), 8);
+  for (int64_t value = 2; value < 10; ++value) {
+    ASSERT_EQ(queue.Front(), value);
+    queue.PopFront();
+  }
+}
+
+TEST(RingBuffer, Erase) {
+  RingBuffer<int64_t> queue;
+  queue.Reserve(4);
+  queue.PushBack(0);
+  queue.PushBack(0);
+  queue.PopFront();
+  queue.PopFront();
+  for (int64_t value = 0; value < 4; ++value) {
+    queue.PushBack(value);
+  }
+  EXPECT_EQ(queue.Capacity(), 4);
+  queue.Erase(1);
+  EXPECT_EQ(queue.Size(), 3);
+  EXPECT_EQ(queue[0], 0);
+  EXPECT_EQ(queue[1], 2);
+  EXPECT_EQ(queue[2], 3);
+  queue.Erase(2);
+  EXPECT_EQ(queue.Size(), 2);
+  queue.Erase(0);
+  EXPECT_EQ(queue.Size(), 1);
+  EXPECT_EQ(queue.Front(), 2);
+}
+
+TEST(RingBuffer, Clear) {
+  RingBuffer<int64_t> queue;
+  queue.PushBack(111);
+  queue.PushBack(222);
+  const std::size_t capacity = queue.Capacity();
+  queue.Clear();
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Capacity(), capacity);
+}
+
+}  // namespace
+
+}  // namespace Demo
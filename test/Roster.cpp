@@ -0,0 +1,158 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Roster.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+// Writes a given text to a file at a given path.
+void WriteText(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream stream{path, std::ios::binary};
+  stream << text;
+}
+
+std::vector<RosterEntry> CreateEntries() {
+  return {
+      {/*id=*/111, /*model_id=*/0, /*battery=*/1.0, /*home_charging_station_id=*/2},
+      {/*id=*/-222, /*model_id=*/3, /*battery=*/0.1, /*home_charging_station_id=*/std::nullopt},
+      {/*id=*/333, /*model_id=*/4, /*battery=*/0.0, /*home_charging_station_id=*/0},
+  };
+}
+
+TEST(Roster, Csv) {
+  const std::filesystem::path path{"roster.csv"};
+  WriteText(path, "id,model_id,battery,home_station\r\n"
+                  "111,0,1,2\r\n"
+                  "\r\n"
+                  "-222,3,0.1,\n"
+                  "\n"
+                  "333,4,0,0");
+
+  const Roster roster{path};
+  ASSERT_TRUE(roster.IsValid());
+  EXPECT_EQ(roster.Format(), RosterFormat::Csv);
+  ASSERT_EQ(roster.Size(), 3);
+  const std::vector<RosterEntry> entries = CreateEntries();
+  for (std::size_t index = 0; index < entries.size(); ++index) {
+    EXPECT_EQ(roster.Row(index), entries[index]);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(Roster, CsvWithoutHeaderOrHomeStation) {
+  const std::filesystem::path path{"roster_without_header.csv"};
+  WriteText(path, "0,1,0.5\n1,2,0.25\n");
+
+  const Roster roster{path};
+  ASSERT_TRUE(roster.IsValid());
+  ASSERT_EQ(roster.Size(), 2);
+  EXPECT_EQ(roster.Row(0), RosterEntry({0, 1, 0.5, std::nullopt}));
+  EXPECT_EQ(roster.Row(1), RosterEntry({1, 2, 0.25, std::nullopt}));
+
+  std::filesystem::remove(path);
+}
+
+TEST(Roster, LongCsv) {
+  // Many rows, so that most line feeds are found sixteen bytes at a time.
+  const std::filesystem::path path{"long_roster.csv"};
+  std::string text{RosterCsvHeader};
+  text += '\n';
+  for (int64_t id = 0; id < 1000; ++id) {
+    text += std::to_string(id) + "," + std::to_string(id % 5) + ",0.75," + std::to_string(id % 3)
+            + "\n";
+  }
+  WriteText(path, text);
+
+  const Roster roster{path};
+  ASSERT_EQ(roster.Size(), 1000);
+  for (std::size_t index = 0; index < roster.Size(); ++index) {
+    const int64_t id = static_cast<int64_t>(index);
+    ASSERT_EQ(roster.Row(index), RosterEntry({id, id % 5, 0.75, id % 3}));
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(Roster, MalformedCsvRows) {
+  const std::filesystem::path path{"malformed_roster.csv"};
+  WriteText(path, "1,2\n1,2,x\n1,2,0.5,3,4\n1,2,1.5\n1,2,0.5,-3\n1,2,0.5,3\n");
+
+  const Roster roster{path};
+  ASSERT_TRUE(roster.IsValid());
+  ASSERT_EQ(roster.Size(), 6);
+  for (std::size_t index = 0; index < 5; ++index) {
+    EXPECT_EQ(roster.Row(index), std::nullopt);
+  }
+  EXPECT_EQ(roster.Row(5), RosterEntry({1, 2, 0.5, 3}));
+
+  std::filesystem::remove(path);
+}
+
+TEST(Roster, RoundTrip) {
+  const std::vector<RosterEntry> entries = CreateEntries();
+  for (const RosterFormat format : {RosterFormat::Csv, RosterFormat::Binary}) {
+    const std::filesystem::path path{"round_trip.roster"};
+    { const RosterFileWriter writer{path, entries, format}; }
+
+    const Roster roster{path};
+    ASSERT_TRUE(roster.IsValid());
+    EXPECT_EQ(roster.Format(), format);
+    ASSERT_EQ(roster.Size(), entries.size());
+    for (std::size_t index = 0; index < entries.size(); ++index) {
+      EXPECT_EQ(roster.Row(index), entries[index]);
+    }
+
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(Roster, TruncatedBinary) {
+  const std::filesystem::path path{"truncated.roster"};
+  { const RosterFileWriter writer{path, CreateEntries(), RosterFormat::Binary}; }
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+  const Roster roster{path};
+  EXPECT_FALSE(roster.IsValid());
+  EXPECT_EQ(roster.Size(), 0);
+
+  std::filesystem::remove(path);
+}
+
+TEST(Roster, MissingFile) {
+  const Roster roster{"missing.roster"};
+  EXPECT_FALSE(roster.IsValid());
+  EXPECT_EQ(roster.Size(), 0);
+}
+
+}  // namespace
+
+}  // namespace Demo
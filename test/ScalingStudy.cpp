@@ -0,0 +1,159 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/ScalingStudy.hpp"
+
+#include <gtest/gtest.h>
+
+#include "../source/SampleVehicleModels.hpp"
+
+namespace Demo {
+
+namespace {
+
+TEST(ScalingStudy, LogarithmicGrid) {
+  EXPECT_EQ(LogarithmicGrid(100, 10'000'000, 1),
+            std::vector<int64_t>({100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000}));
+  EXPECT_EQ(LogarithmicGrid(1, 100, 2), std::vector<int64_t>({1, 3, 10, 32, 100}));
+  EXPECT_EQ(LogarithmicGrid(1, 50, 1), std::vector<int64_t>({1, 10, 50}));
+  EXPECT_EQ(LogarithmicGrid(1, 4, 4), std::vector<int64_t>({1, 2, 3, 4}));
+  EXPECT_EQ(LogarithmicGrid(7, 7, 1), std::vector<int64_t>({7}));
+  EXPECT_TRUE(LogarithmicGrid(0, 10, 1).empty());
+  EXPECT_TRUE(LogarithmicGrid(10, 1, 1).empty());
+}
+
+TEST(ScalingStudy, FitOneVariable) {
+  std::vector<ScalingPoint> points;
+  for (const int64_t vehicles : {100, 1'000, 10'000, 100'000}) {
+    ScalingPoint point;
+    point.vehicles = vehicles;
+    point.charging_stations = 10;
+    point.wall_seconds = 3.0E-6 * std::pow(static_cast<double>(vehicles), 2.0);
+    points.push_back(point);
+  }
+  const std::optional<ScalingFit> fit =
+      FitScaling(points, [](const ScalingPoint& point) { return point.wall_seconds; });
+  ASSERT_TRUE(fit.has_value());
+  EXPECT_NEAR(fit->vehicle_exponent, 2.0, 1.0E-9);
+  EXPECT_DOUBLE_EQ(fit->charging_station_exponent, 0.0);
+  EXPECT_NEAR(fit->coefficient, 3.0E-6, 1.0E-12);
+  EXPECT_NEAR(fit->r_squared, 1.0, 1.0E-9);
+}
+
+TEST(ScalingStudy, FitTwoVariables) {
+  std::vector<ScalingPoint> points;
+  for (const int64_t charging_stations : {1, 10, 100}) {
+    for (const int64_t vehicles : {100, 1'000, 10'000}) {
+      ScalingPoint point;
+      point.vehicles = vehicles;
+      point.charging_stations = charging_stations;
+      point.wall_seconds = 0.5 * std::pow(static_cast<double>(vehicles), 1.5)
+                           * std::pow(static_cast<double>(charging_stations), 0.25);
+      points.push_back(point);
+    }
+  }
+  const std::optional<ScalingFit> fit =
+      FitScaling(points, [](const ScalingPoint& point) { return point.wall_seconds; });
+  ASSERT_TRUE(fit.has_value());
+  EXPECT_NEAR(fit->vehicle_exponent, 1.5, 1.0E-9);
+  EXPECT_NEAR(fit->charging_station_exponent, 0.25, 1.0E-9);
+  EXPECT_NEAR(fit->coefficient, 0.5, 1.0E-9);
+}
+
+TEST(ScalingStudy, FitRequiresTwoVehicleCounts) {
+  std::vector<ScalingPoint> points(2);
+  points[0].vehicles = 100;
+  points[0].charging_stations = 1;
+  points[0].wall_seconds = 1.0;
+  points[1].vehicles = 100;
+  points[1].charging_stations = 10;
+  points[1].wall_seconds = 2.0;
+  EXPECT_FALSE(
+      FitScaling(points, [](const ScalingPoint& point) { return point.wall_seconds; }).has_value());
+  EXPECT_FALSE(FitScaling(std::vector<ScalingPoint>(), [](const ScalingPoint& point) {
+                 return point.wall_seconds;
+               }).has_value());
+}
+
+TEST(ScalingStudy, MeasurePoint) {
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  const ScalingPoint point = MeasureScalingPoint(
+      200, 5, PhQ::Time(2.0, PhQ::Unit::Time::Hour), vehicle_models, 7, 60.0);
+  EXPECT_EQ(point.vehicles, 200);
+  EXPECT_EQ(point.charging_stations, 5);
+  EXPECT_FALSE(point.truncated);
+  EXPECT_NEAR(point.simulated_hours, 2.0, 1.0E-9);
+  EXPECT_GT(point.events, 200);
+  EXPECT_GT(point.time_steps, 0);
+  EXPECT_GT(point.events_per_second, 0.0);
+  EXPECT_GT(point.wall_seconds_per_simulated_hour, 0.0);
+#ifdef __linux__
+  EXPECT_GT(point.peak_resident_bytes, 0);
+#endif
+
+  // The same seed gives the same simulation.
+  const ScalingPoint repeated = MeasureScalingPoint(
+      200, 5, PhQ::Time(2.0, PhQ::Unit::Time::Hour), vehicle_models, 7, 60.0);
+  EXPECT_EQ(repeated.events, point.events);
+  EXPECT_EQ(repeated.time_steps, point.time_steps);
+}
+
+TEST(ScalingStudy, MeasurePointTimeLimit) {
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  const ScalingPoint point = MeasureScalingPoint(
+      200, 5, PhQ::Time(1000.0, PhQ::Unit::Time::Hour), vehicle_models, 7, 0.0);
+  EXPECT_TRUE(point.truncated);
+  EXPECT_EQ(point.time_steps, ScalingStudyStepBatch);
+  EXPECT_LT(point.simulated_hours, 1000.0);
+}
+
+TEST(ScalingStudy, ProcessMemory) {
+#ifdef __linux__
+  EXPECT_GT(CurrentResidentSetSize(), 0);
+  EXPECT_GE(PeakResidentSetSize(), CurrentResidentSetSize());
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(ScalingStudy, Json) {
+  std::vector<ScalingPoint> points(2);
+  points[0].vehicles = 100;
+  points[0].charging_stations = 1;
+  points[0].events = 42;
+  points[1].vehicles = 1000;
+  points[1].charging_stations = 1;
+  points[1].truncated = true;
+  ScalingFit fit;
+  fit.vehicle_exponent = 2.0;
+  const std::string json = ScalingStudyToJson(points, fit, std::nullopt);
+  EXPECT_NE(json.find("\"vehicles\": 100, \"charging_stations\": 1"), std::string::npos);
+  EXPECT_NE(json.find("\"events\": 42"), std::string::npos);
+  EXPECT_NE(json.find("\"truncated\": true}\n"), std::string::npos);
+  EXPECT_NE(json.find("\"wall_time_fit\": {"), std::string::npos);
+  EXPECT_NE(json.find("\"vehicle_exponent\": 2.0000"), std::string::npos);
+  EXPECT_EQ(json.find("time_per_event_fit"), std::string::npos);
+}
+
+}  // namespace
+
+}  // namespace Demo
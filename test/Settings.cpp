@@ -34,6 +34,10 @@ TEST(Settings, Default) {
   EXPECT_EQ(settings.Vehicles(), 0);
   EXPECT_EQ(settings.ChargingStations(), 0);
   EXPECT_EQ(settings.Seed(), std::nullopt);
+  EXPECT_TRUE(settings.FleetMix().empty());
+  EXPECT_FALSE(settings.FleetMixExact());
+  EXPECT_TRUE(settings.Roster().empty());
+  EXPECT_TRUE(settings.VehicleModelCatalog().empty());
 }
 
 TEST(Settings, Regular) {
@@ -72,6 +76,72 @@ TEST(Settings, Regular) {
   EXPECT_EQ(settings.Seed().value(), 42);
 }
 
+TEST(Settings, FleetMix) {
+  char program[] = "bin/joby-demo";
+
+  char vehicles_key[] = "--vehicles";
+  char vehicles_value[] = "20";
+
+  char fleet_mix_key[] = "--fleet-mix";
+  char fleet_mix_value[] = "60,20,10,5,5";
+
+  char fleet_mix_exact_key[] = "--fleet-mix-exact";
+
+  int argc = 6;
+
+  char* argv[] = {
+      program, vehicles_key, vehicles_value, fleet_mix_key, fleet_mix_value, fleet_mix_exact_key,
+  };
+
+  const Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.Vehicles(), 20);
+  EXPECT_EQ(settings.FleetMix(), std::vector<double>({60.0, 20.0, 10.0, 5.0, 5.0}));
+  EXPECT_TRUE(settings.FleetMixExact());
+}
+
+TEST(Settings, Roster) {
+  char program[] = "bin/joby-demo";
+
+  char roster_key[] = "--roster";
+  char roster_value[] = "fleet.csv";
+
+  char charging_stations_key[] = "--charging-stations";
+  char charging_stations_value[] = "3";
+
+  int argc = 5;
+
+  char* argv[] = {
+      program, roster_key, roster_value, charging_stations_key, charging_stations_value,
+  };
+
+  const Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.Roster(), "fleet.csv");
+  EXPECT_EQ(settings.ChargingStations(), 3);
+}
+
+TEST(Settings, VehicleModelCatalog) {
+  char program[] = "bin/joby-demo";
+
+  char vehicle_models_key[] = "--vehicle-models";
+  char vehicle_models_value[] = "vehicle_models.csv";
+
+  char vehicles_key[] = "--vehicles";
+  char vehicles_value[] = "20";
+
+  int argc = 5;
+
+  char* argv[] = {
+      program, vehicle_models_key, vehicle_models_value, vehicles_key, vehicles_value,
+  };
+
+  const Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.VehicleModelCatalog(), "vehicle_models.csv");
+  EXPECT_EQ(settings.Vehicles(), 20);
+}
+
 TEST(Settings, Bogus) {
   char program[] = "bin/joby-demo";
 
@@ -98,6 +168,31 @@ TEST(Settings, Bogus) {
   EXPECT_EQ(settings.ChargingStations(), 0);
 }
 
+TEST(Settings, FlightRecorderCapacity) {
+  char program[] = "bin/joby-demo";
+
+  char capacity_key[] = "--flight-recorder-capacity";
+  char capacity_value[] = "1000";
+
+  int argc = 3;
+
+  char* argv[] = {program, capacity_key, capacity_value};
+
+  const Settings settings{argc, argv};
+
+  EXPECT_EQ(settings.FlightRecorderCapacity(), 1000);
+
+  // A capacity whose file size would overflow is rejected. The logger runs a background thread, so
+  // the death test re-executes the test binary rather than forking it.
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+  char large_capacity_value[] = "9223372036854775808";
+
+  char* large_argv[] = {program, capacity_key, large_capacity_value};
+
+  EXPECT_EXIT(Settings(argc, large_argv), ::testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
 }  // namespace
 
 }  // namespace Demo
@@ -24,14 +24,120 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <vector>
+
+#include "../source/AggregateStatistics.hpp"
+#include "../source/LoggingObserver.hpp"
+#include "../source/SampleVehicleModels.hpp"
+
+namespace {
+
+// Number of heap allocations made so far by the current thread. Only the current thread is counted
+// because the logger formats and writes its messages on a background thread.
+thread_local uint64_t allocation_count = 0;
+
+}  // namespace
+
+// Replaces the global allocation functions of this test program to count heap allocations. The
+// array forms forward to these by default.
+void* operator new(const std::size_t size) {
+  ++allocation_count;
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+// GCC warns when these are inlined into callers that allocated with operator new, even though the
+// pointers come from std::malloc above.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* const pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer, const std::size_t /*size*/) noexcept {
+  std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 namespace Demo {
 
 namespace {
 
-TEST(Simulation, Regular) {
-  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+// Counts the heap allocations made by the current thread during its lifetime.
+class AllocationCounter {
+public:
+  AllocationCounter() noexcept : start_(allocation_count) {}
+
+  // Returns the number of heap allocations made by the current thread since this counter was
+  // constructed.
+  uint64_t Count() const noexcept {
+    return allocation_count - start_;
+  }
+
+private:
+  uint64_t start_;
+};
+
+// Observer that counts the events of a simulation.
+class CountingObserver : public SimulationObserver {
+public:
+  void OnTimeStep(const std::size_t /*time_step_count*/, const PhQ::Time<>& /*time_step*/,
+                  const PhQ::Time<>& /*elapsed_time*/) noexcept {
+    ++time_steps;
+  }
+
+  void OnTakeoff(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {
+    ++takeoffs;
+  }
+
+  void OnLanding(const PhQ::Time<>& time, const Vehicle& /*vehicle*/) noexcept {
+    ++landings;
+    last_landing_time = time;
+  }
+
+  void OnEnqueue(const PhQ::Time<>& /*time*/, const Vehicle& vehicle) noexcept {
+    ++enqueues;
+    EXPECT_TRUE(vehicle.ChargingStationId().has_value());
+  }
+
+  void OnChargeStart(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {
+    ++charge_starts;
+  }
+
+  void OnChargeEnd(const PhQ::Time<>& /*time*/, const Vehicle& vehicle) noexcept {
+    ++charge_ends;
+    EXPECT_TRUE(vehicle.ChargingStationId().has_value());
+  }
+
+  int64_t time_steps = 0;
+
+  int64_t takeoffs = 0;
+
+  int64_t landings = 0;
+
+  int64_t enqueues = 0;
+
+  int64_t charge_starts = 0;
+
+  int64_t charge_ends = 0;
+
+  PhQ::Time<> last_landing_time = PhQ::Time<>::Zero();
+};
 
-  const std::shared_ptr<const VehicleModel> vehicle_model = std::make_shared<const VehicleModel>(
+std::shared_ptr<const VehicleModel> CreateVehicleModel() {
+  return std::make_shared<const VehicleModel>(
       /*id=*/111,
       /*manufacturer_name_english=*/"Manufacturer A",
       /*model_name_english=*/"Model B",
@@ -42,9 +148,38 @@ TEST(Simulation, Regular) {
       /*fault_rate=*/PhQ::Frequency(1.0, PhQ::Unit::Frequency::Hertz),
       /*transport_energy_consumption=*/
       PhQ::TransportEnergyConsumption(1.0, PhQ::Unit::TransportEnergyConsumption::JoulePerMetre));
+}
+
+TEST(Simulation, Regular) {
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+
+  Vehicles vehicles;
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
+
+  ChargingStations charging_stations{1};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  Simulation simulation{duration, vehicles, charging_stations, random_generator};
+  EXPECT_FALSE(simulation.Finished());
+  EXPECT_EQ(simulation.TimeStepCount(), 0);
+
+  EXPECT_EQ(simulation.Run(), 5);
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(simulation.TimeStepCount(), 5);
+  EXPECT_EQ(simulation.ElapsedTime(), duration);
+
+  EXPECT_EQ(simulation.Run(), 0);
+  EXPECT_EQ(simulation.StepEvents(10), 0);
+}
+
+TEST(Simulation, RunUntil) {
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
 
   Vehicles vehicles;
-  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, vehicle_model));
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
 
   ChargingStations charging_stations{1};
 
@@ -52,7 +187,221 @@ TEST(Simulation, Regular) {
   std::mt19937_64 random_generator(random_device());
   random_generator.seed(0);
 
-  const Simulation simulation{duration, vehicles, charging_stations, random_generator};
+  Simulation simulation{duration, vehicles, charging_stations, random_generator};
+
+  EXPECT_EQ(simulation.RunUntil(PhQ::Time(2.5, PhQ::Unit::Time::Second)), 3);
+  EXPECT_FALSE(simulation.Finished());
+  EXPECT_EQ(simulation.ElapsedTime(), PhQ::Time(2.5, PhQ::Unit::Time::Second));
+  EXPECT_EQ(simulation.TimeStep(), PhQ::Time(0.5, PhQ::Unit::Time::Second));
+
+  EXPECT_EQ(simulation.RunUntil(PhQ::Time(1.0, PhQ::Unit::Time::Second)), 0);
+  EXPECT_EQ(simulation.ElapsedTime(), PhQ::Time(2.5, PhQ::Unit::Time::Second));
+
+  EXPECT_EQ(simulation.RunUntil(PhQ::Time(100.0, PhQ::Unit::Time::Second)), 3);
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(simulation.ElapsedTime(), duration);
+}
+
+TEST(Simulation, StepEvents) {
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+
+  Vehicles vehicles;
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
+
+  ChargingStations charging_stations{1};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  Simulation simulation{duration, vehicles, charging_stations, random_generator};
+
+  EXPECT_EQ(simulation.StepEvents(2), 2);
+  EXPECT_EQ(simulation.TimeStepCount(), 2);
+  EXPECT_EQ(simulation.ElapsedTime(), PhQ::Time(2.0, PhQ::Unit::Time::Second));
+
+  EXPECT_EQ(simulation.StepEvents(0), 0);
+  EXPECT_EQ(simulation.TimeStepCount(), 2);
+
+  EXPECT_EQ(simulation.StepEvents(10), 3);
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(simulation.ElapsedTime(), duration);
+}
+
+TEST(Simulation, Observer) {
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+
+  Vehicles vehicles;
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
+
+  ChargingStations charging_stations{1};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  Simulation<CountingObserver> simulation{duration, vehicles, charging_stations, random_generator};
+  simulation.Run();
+
+  const CountingObserver& observer = simulation.Observer();
+  EXPECT_EQ(observer.time_steps, 5);
+  EXPECT_EQ(observer.takeoffs, 3);
+  EXPECT_EQ(observer.landings, 3);
+  EXPECT_EQ(observer.enqueues, 3);
+  EXPECT_EQ(observer.charge_starts, 2);
+  EXPECT_EQ(observer.charge_ends, 2);
+  EXPECT_EQ(observer.last_landing_time, duration);
+}
+
+TEST(Simulation, NoAllocationsAfterWarmUp) {
+  const PhQ::Time duration{10.0, PhQ::Unit::Time::Hour};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+
+  Vehicles vehicles{200, vehicle_models, random_generator};
+
+  ChargingStations charging_stations{3};
+
+  Simulation simulation{duration, vehicles, charging_stations, random_generator};
+
+  // Warm up until the charging station queues have reached their working sizes.
+  simulation.RunUntil(PhQ::Time(2.0, PhQ::Unit::Time::Hour));
+  ASSERT_FALSE(simulation.Finished());
+
+  const AllocationCounter counter;
+  const std::size_t time_step_count = simulation.Run();
+  const uint64_t allocations = counter.Count();
+
+  EXPECT_GT(time_step_count, 0);
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(allocations, 0);
+}
+
+TEST(Simulation, NoAllocationsAfterWarmUpWhileLogging) {
+  const PhQ::Time duration{10.0, PhQ::Unit::Time::Hour};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+
+  Vehicles vehicles{200, vehicle_models, random_generator};
+
+  ChargingStations charging_stations{3};
+
+  // Each time step is formatted and published, as in the main program, but written to a file.
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "simulation.log";
+  const ScopedLogLevel log_level{LogLevel::Information};
+  ASSERT_TRUE(GlobalLogger().SetFile(path));
+
+  Simulation<LoggingObserver> simulation{duration, vehicles, charging_stations, random_generator};
+
+  simulation.RunUntil(PhQ::Time(2.0, PhQ::Unit::Time::Hour));
+  ASSERT_FALSE(simulation.Finished());
+
+  const AllocationCounter counter;
+  const std::size_t time_step_count = simulation.Run();
+  const uint64_t allocations = counter.Count();
+
+  GlobalLogger().SetFile({});
+  std::filesystem::remove(path);
+
+  EXPECT_GT(time_step_count, 0);
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(allocations, 0);
+}
+
+TEST(Simulation, CommissionAndRetire) {
+  const PhQ::Time duration{6.0, PhQ::Unit::Time::Hour};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+
+  Vehicles vehicles{20, vehicle_models, random_generator};
+
+  ChargingStations charging_stations{3};
+
+  Simulation<CountingObserver> simulation{
+      duration, vehicles, charging_stations, random_generator};
+
+  simulation.RunUntil(PhQ::Time(3.0, PhQ::Unit::Time::Hour));
+  ASSERT_FALSE(simulation.Finished());
+
+  // Retire every vehicle that is charging or waiting to charge.
+  std::vector<std::shared_ptr<Vehicle>> retired;
+  for (VehicleId id = 0; id < 20; ++id) {
+    const std::shared_ptr<Vehicle> vehicle = vehicles.At(id);
+    if (vehicle->ChargingStationId().has_value()) {
+      retired.push_back(simulation.Retire(id));
+    }
+  }
+  ASSERT_FALSE(retired.empty());
+  EXPECT_EQ(simulation.Retire(retired.front()->Id()), nullptr);
+  EXPECT_EQ(vehicles.Size(), 20 - retired.size());
+  EXPECT_EQ(simulation.Observer().charge_starts, simulation.Observer().charge_ends);
+
+  // Retire a vehicle in mid-flight, which lands it.
+  std::shared_ptr<Vehicle> flying;
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    if (vehicle->Status() == VehicleStatus::Flying) {
+      flying = vehicle;
+      break;
+    }
+  }
+  ASSERT_NE(flying, nullptr);
+  const int64_t landings = simulation.Observer().landings;
+  retired.push_back(simulation.Retire(flying->Id()));
+  EXPECT_EQ(retired.back(), flying);
+  EXPECT_EQ(simulation.Observer().landings, landings + 1);
+  EXPECT_EQ(simulation.Observer().last_landing_time, simulation.ElapsedTime());
+  EXPECT_EQ(vehicles.Size(), 20 - retired.size());
+
+  // The retired vehicles still count towards the aggregate statistics.
+  EXPECT_EQ(vehicles.Retired().size(), retired.size());
+  int64_t flight_count = 0;
+  for (const std::shared_ptr<Vehicle>& vehicle : retired) {
+    flight_count += vehicle->Statistics().TotalFlightCount();
+  }
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    flight_count += vehicle->Statistics().TotalFlightCount();
+  }
+  int64_t aggregate_flight_count = 0;
+  const AggregateStatistics aggregate_statistics{vehicles};
+  for (const std::pair<const VehicleModelId, Statistics>& id_and_statistics :
+       aggregate_statistics) {
+    aggregate_flight_count += id_and_statistics.second.TotalFlightCount();
+  }
+  EXPECT_EQ(aggregate_flight_count, flight_count);
+
+  for (const std::shared_ptr<Vehicle>& vehicle : retired) {
+    EXPECT_EQ(vehicle->Status(), VehicleStatus::OnStandby);
+    EXPECT_FALSE(vehicle->ChargingStationId().has_value());
+    for (ChargingStationId id = 0; id < 3; ++id) {
+      EXPECT_FALSE(charging_stations.At(id)->Exists(vehicle->Id()));
+    }
+  }
+
+  simulation.RunUntil(PhQ::Time(4.5, PhQ::Unit::Time::Hour));
+
+  for (const std::shared_ptr<Vehicle>& vehicle : retired) {
+    EXPECT_TRUE(simulation.Commission(vehicle));
+    EXPECT_FALSE(simulation.Commission(vehicle));
+  }
+  EXPECT_FALSE(simulation.Commission(nullptr));
+  EXPECT_EQ(vehicles.Size(), 20);
+  EXPECT_TRUE(vehicles.Retired().empty());
+
+  simulation.Run();
+  EXPECT_TRUE(simulation.Finished());
+  EXPECT_EQ(simulation.ElapsedTime(), duration);
 }
 
 }  // namespace
@@ -0,0 +1,161 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/SlotMap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+TEST(SlotMap, Empty) {
+  SlotMap<int64_t> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Size(), 0);
+  EXPECT_EQ(map.SlotCount(), 0);
+  EXPECT_EQ(map.Find(SlotHandle()), nullptr);
+  EXPECT_FALSE(map.Erase(SlotHandle()));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(SlotMap, InsertFindErase) {
+  SlotMap<int64_t> map;
+  const SlotHandle first = map.Insert(111);
+  const SlotHandle second = map.Insert(222);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(map.Size(), 2);
+  ASSERT_NE(map.Find(first), nullptr);
+  EXPECT_EQ(*map.Find(first), 111);
+  ASSERT_NE(map.Find(second), nullptr);
+  EXPECT_EQ(*map.Find(second), 222);
+  EXPECT_TRUE(map.Erase(first));
+  EXPECT_FALSE(map.Erase(first));
+  EXPECT_FALSE(map.Contains(first));
+  EXPECT_EQ(map.Find(first), nullptr);
+  ASSERT_NE(map.Find(second), nullptr);
+  EXPECT_EQ(*map.Find(second), 222);
+  EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(SlotMap, StaleHandle) {
+  SlotMap<int64_t> map;
+  const SlotHandle stale = map.Insert(111);
+  map.Erase(stale);
+  EXPECT_EQ(map.NextSlot(), stale.slot);
+  const SlotHandle reused = map.Insert(222);
+  EXPECT_EQ(reused.slot, stale.slot);
+  EXPECT_NE(reused.generation, stale.generation);
+  EXPECT_EQ(map.Find(stale), nullptr);
+  ASSERT_NE(map.Find(reused), nullptr);
+  EXPECT_EQ(*map.Find(reused), 222);
+  EXPECT_EQ(map.SlotCount(), 1);
+}
+
+TEST(SlotMap, DenseIteration) {
+  SlotMap<int64_t> map;
+  const SlotHandle first = map.Insert(111);
+  map.Insert(222);
+  const SlotHandle third = map.Insert(333);
+  map.Erase(first);
+  EXPECT_EQ(std::vector<int64_t>(map.cbegin(), map.cend()), std::vector<int64_t>({333, 222}));
+  EXPECT_EQ(map.HandleAt(0), third);
+  EXPECT_EQ(map[0], 333);
+  ASSERT_NE(map.Find(third), nullptr);
+  EXPECT_EQ(*map.Find(third), 333);
+}
+
+TEST(SlotMap, Resize) {
+  SlotMap<int64_t> map;
+  map.Resize(3);
+  EXPECT_EQ(map.Size(), 3);
+  for (std::size_t position = 0; position < map.Size(); ++position) {
+    map[position] = static_cast<int64_t>(position * 111);
+  }
+  for (uint32_t slot = 0; slot < 3; ++slot) {
+    ASSERT_NE(map.Find(map.HandleOfSlot(slot)), nullptr);
+    EXPECT_EQ(*map.Find(map.HandleOfSlot(slot)), slot * 111);
+  }
+  EXPECT_EQ(map.NextSlot(), 3);
+  EXPECT_EQ(map.Insert(333).slot, 3);
+}
+
+TEST(SlotMap, Reserve) {
+  SlotMap<int64_t> map;
+  map.Reserve(100);
+  std::vector<SlotHandle> handles;
+  for (int64_t value = 0; value < 100; ++value) {
+    handles.push_back(map.Insert(value));
+  }
+  for (const SlotHandle& handle : handles) {
+    map.Erase(handle);
+  }
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.SlotCount(), 100);
+  for (int64_t value = 0; value < 100; ++value) {
+    map.Insert(value);
+  }
+  EXPECT_EQ(map.SlotCount(), 100);
+}
+
+TEST(SlotMap, MatchesStandardMap) {
+  std::mt19937_64 random_generator(0);
+  SlotMap<int64_t> map;
+  std::vector<SlotHandle> handles;
+  std::unordered_map<uint32_t, int64_t> reference;
+  for (int64_t iteration = 0; iteration < 20000; ++iteration) {
+    if (!handles.empty() && random_generator() % 3 == 0) {
+      const std::size_t index = random_generator() % handles.size();
+      const SlotHandle handle = handles[index];
+      ASSERT_EQ(map.Erase(handle), reference.erase(handle.slot) == 1);
+      handles[index] = handles.back();
+      handles.pop_back();
+      ASSERT_EQ(map.Find(handle), nullptr);
+    } else {
+      const SlotHandle handle = map.Insert(iteration);
+      handles.push_back(handle);
+      reference[handle.slot] = iteration;
+    }
+    ASSERT_EQ(map.Size(), reference.size());
+  }
+  for (const SlotHandle& handle : handles) {
+    ASSERT_NE(map.Find(handle), nullptr);
+    EXPECT_EQ(*map.Find(handle), reference.at(handle.slot));
+  }
+  int64_t sum = 0;
+  int64_t reference_sum = 0;
+  for (const int64_t value : map) {
+    sum += value;
+  }
+  for (const std::pair<const uint32_t, int64_t>& entry : reference) {
+    reference_sum += entry.second;
+  }
+  EXPECT_EQ(sum, reference_sum);
+}
+
+}  // namespace
+
+}  // namespace Demo
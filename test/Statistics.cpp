@@ -201,6 +201,90 @@ TEST(Statistics, Aggregate) {
   EXPECT_EQ(aggregate.TotalFaultCount(), 16);
 }
 
+TEST(Statistics, MeansWithoutCounts) {
+  // Durations and distances without a count, such as those of an ongoing flight whose count is
+  // incremented afterwards, do not yield a mean until the count is positive.
+  Statistics statistics;
+  statistics.ModifyTotalFlightDurationAndDistance(
+      /*passenger_count=*/2, PhQ::Time(3.0, PhQ::Unit::Time::Minute),
+      PhQ::Length(3.0, PhQ::Unit::Length::Kilometre));
+  statistics.ModifyTotalChargingSessionDuration(PhQ::Time(2.0, PhQ::Unit::Time::Minute));
+  EXPECT_EQ(statistics.MeanFlightDuration(), PhQ::Time<>::Zero());
+  EXPECT_EQ(statistics.MeanFlightDistance(), PhQ::Length<>::Zero());
+  EXPECT_EQ(statistics.MeanChargingDuration(), PhQ::Time<>::Zero());
+
+  statistics.IncrementTotalFlightCount();
+  statistics.IncrementTotalChargingSessionCount();
+  statistics.IncrementTotalChargingSessionCount();
+  EXPECT_EQ(statistics.MeanFlightDuration(), PhQ::Time(3.0, PhQ::Unit::Time::Minute));
+  EXPECT_EQ(statistics.MeanFlightDistance(), PhQ::Length(3.0, PhQ::Unit::Length::Kilometre));
+  EXPECT_EQ(statistics.MeanChargingDuration(), PhQ::Time(1.0, PhQ::Unit::Time::Minute));
+
+  // Aggregating empty statistics yields zero means rather than dividing by zero.
+  Statistics aggregate;
+  aggregate.Aggregate(Statistics());
+  EXPECT_EQ(aggregate.MeanFlightDuration(), PhQ::Time<>::Zero());
+  EXPECT_EQ(aggregate.MeanChargingDuration(), PhQ::Time<>::Zero());
+}
+
+TEST(Statistics, MetricSubsets) {
+  // Only the totals of the tracked metrics are stored.
+  EXPECT_EQ(sizeof(BasicStatistics<StatisticsMetrics::Faults>), sizeof(int64_t));
+  EXPECT_EQ(sizeof(BasicStatistics<StatisticsMetrics::ChargingSessions>), sizeof(int64_t) + sizeof(PhQ::Time<>));
+  EXPECT_LT(sizeof(BasicStatistics<StatisticsMetrics::Flights>), sizeof(Statistics));
+  static_assert(BasicStatistics<StatisticsMetrics::Flights>::TracksFlights && !BasicStatistics<StatisticsMetrics::Flights>::TracksFaults);
+  static_assert(
+      BasicStatistics<StatisticsMetrics::Flights | StatisticsMetrics::Faults>::TracksFaults);
+
+  // The modifiers of the other metrics do nothing and their accessors return zero.
+  BasicStatistics<StatisticsMetrics::Faults> statistics;
+  statistics.IncrementTotalFlightCount();
+  statistics.ModifyTotalFlightDurationAndDistance(
+      /*passenger_count=*/2, PhQ::Time(3.0, PhQ::Unit::Time::Minute),
+      PhQ::Length(3.0, PhQ::Unit::Length::Kilometre));
+  statistics.IncrementTotalChargingSessionCount();
+  statistics.ModifyTotalChargingSessionDuration(PhQ::Time(2.0, PhQ::Unit::Time::Minute));
+  statistics.ModifyTotalFaultCount(5);
+  EXPECT_EQ(statistics.TotalFlightCount(), 0);
+  EXPECT_EQ(statistics.TotalFlightDuration(), PhQ::Time<>::Zero());
+  EXPECT_EQ(statistics.TotalFlightPassengerDistance(), PhQ::Length<>::Zero());
+  EXPECT_EQ(statistics.MeanFlightDistance(), PhQ::Length<>::Zero());
+  EXPECT_EQ(statistics.TotalChargingSessionCount(), 0);
+  EXPECT_EQ(statistics.MeanChargingDuration(), PhQ::Time<>::Zero());
+  EXPECT_EQ(statistics.TotalFaultCount(), 5);
+  EXPECT_EQ(statistics, BasicStatistics<StatisticsMetrics::Faults>(0, PhQ::Time<>::Zero(), PhQ::Length<>::Zero(),
+                                        PhQ::Length<>::Zero(), 0, PhQ::Time<>::Zero(), 5));
+}
+
+TEST(Statistics, AggregateMetricSubsets) {
+  const Statistics statistics{
+      /*total_flight_count=*/2,
+      /*total_flight_duration=*/PhQ::Time(2.0, PhQ::Unit::Time::Minute),
+      /*total_flight_distance=*/PhQ::Length(2.0, PhQ::Unit::Length::Kilometre),
+      /*total_flight_passenger_distance=*/PhQ::Length(4.0, PhQ::Unit::Length::Kilometre),
+      /*total_charging_session_count=*/1,
+      /*total_charging_duration=*/PhQ::Time(1.0, PhQ::Unit::Time::Minute),
+      /*total_fault_count=*/3};
+
+  // Only the metrics tracked by the aggregate are aggregated.
+  BasicStatistics<StatisticsMetrics::Flights> flight_aggregate;
+  flight_aggregate.Aggregate(statistics);
+  flight_aggregate.Aggregate(statistics);
+  EXPECT_EQ(flight_aggregate.TotalFlightCount(), 4);
+  EXPECT_EQ(flight_aggregate.MeanFlightDistance(),
+            PhQ::Length(1.0, PhQ::Unit::Length::Kilometre));
+  EXPECT_EQ(flight_aggregate.TotalChargingSessionCount(), 0);
+  EXPECT_EQ(flight_aggregate.TotalFaultCount(), 0);
+
+  // Only the metrics tracked by the aggregated statistics are aggregated.
+  Statistics aggregate = statistics;
+  aggregate.Aggregate(BasicStatistics<StatisticsMetrics::Faults>(0, PhQ::Time<>::Zero(), PhQ::Length<>::Zero(),
+                                      PhQ::Length<>::Zero(), 0, PhQ::Time<>::Zero(), 4));
+  EXPECT_EQ(aggregate.TotalFlightCount(), 2);
+  EXPECT_EQ(aggregate.TotalChargingSessionCount(), 1);
+  EXPECT_EQ(aggregate.TotalFaultCount(), 7);
+}
+
 }  // namespace
 
 }  // namespace Demo
@@ -0,0 +1,163 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Timeline.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../source/ChargingStations.hpp"
+#include "../source/Profiler.hpp"
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/Vehicles.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Returns the number of occurrences of a given text in a given string.
+std::size_t Occurrences(const std::string& string, const std::string& text) {
+  std::size_t count = 0;
+  for (std::size_t position = string.find(text); position != std::string::npos;
+       position = string.find(text, position + text.size())) {
+    ++count;
+  }
+  return count;
+}
+
+TEST(Timeline, Inactive) {
+  Timeline timeline;
+  EXPECT_FALSE(timeline.Active());
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  timeline.Record(ProfilePhase::ComputeTimeStep, now, now);
+  EXPECT_EQ(timeline.ThreadCount(), 0);
+  EXPECT_EQ(timeline.SpanCount(), 0);
+}
+
+TEST(Timeline, RecordAndWriteJson) {
+  Timeline timeline;
+  timeline.Start(16);
+  EXPECT_TRUE(timeline.Active());
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  timeline.Record(ProfilePhase::ComputeTimeStep, start, start + std::chrono::microseconds(3));
+  timeline.Record(ProfilePhase::LowestCount, start, start + std::chrono::nanoseconds(1500));
+  timeline.Stop();
+  EXPECT_FALSE(timeline.Active());
+
+  // Spans are not recorded once stopped.
+  timeline.Record(ProfilePhase::Output, start, start);
+  EXPECT_EQ(timeline.ThreadCount(), 1);
+  EXPECT_EQ(timeline.SpanCount(), 2);
+  EXPECT_EQ(timeline.DroppedCount(), 0);
+
+  std::ostringstream stream;
+  timeline.WriteJson(stream);
+  const std::string json = stream.str();
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [", 0), 0);
+  EXPECT_NE(json.find("\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\": \"ComputeTimeStep\", \"cat\": \"simulation\", \"ph\": \"X\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"dur\": 3.000"), std::string::npos);
+  EXPECT_NE(json.find("\"name\": \"LowestCount\""), std::string::npos);
+  EXPECT_NE(json.find("\"dur\": 1.500"), std::string::npos);
+  EXPECT_EQ(Occurrences(json, "\"ph\": \"X\""), 2);
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+TEST(Timeline, DropsWhenFull) {
+  Timeline timeline;
+  timeline.Start(4);
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  for (int index = 0; index < 10; ++index) {
+    timeline.Record(ProfilePhase::RandomDraw, now, now);
+  }
+  EXPECT_EQ(timeline.SpanCount(), 4);
+  EXPECT_EQ(timeline.DroppedCount(), 6);
+
+  // Starting again discards the previous spans.
+  timeline.Start(4);
+  EXPECT_EQ(timeline.SpanCount(), 0);
+  timeline.Record(ProfilePhase::RandomDraw, now, now);
+  EXPECT_EQ(timeline.ThreadCount(), 1);
+  EXPECT_EQ(timeline.SpanCount(), 1);
+}
+
+TEST(Timeline, PerThread) {
+  Timeline timeline;
+  timeline.Start(1024);
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < 4; ++thread_index) {
+    threads.emplace_back([&timeline] {
+      for (int index = 0; index < 100; ++index) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        timeline.Record(ProfilePhase::PerformTimeStep, start, std::chrono::steady_clock::now());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  timeline.Stop();
+  EXPECT_EQ(timeline.ThreadCount(), 4);
+  EXPECT_EQ(timeline.SpanCount(), 400);
+
+  std::ostringstream stream;
+  timeline.WriteJson(stream);
+  EXPECT_EQ(Occurrences(stream.str(), "\"name\": \"thread_name\""), 4);
+  EXPECT_EQ(Occurrences(stream.str(), "\"tid\": 3}"), 100);
+}
+
+TEST(Timeline, Simulation) {
+  std::mt19937_64 random_generator(5);
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  Vehicles vehicles{20, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+  Simulation simulation{
+      PhQ::Time(3.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator};
+
+  GlobalTimeline().Start();
+  simulation.Run();
+  GlobalTimeline().Stop();
+
+  std::ostringstream stream;
+  GlobalTimeline().WriteJson(stream);
+  const std::string json = stream.str();
+  const std::size_t steps = simulation.TimeStepCount();
+  EXPECT_EQ(Occurrences(json, "\"name\": \"UpdateVehiclesAtStart\""), steps);
+  EXPECT_EQ(Occurrences(json, "\"name\": \"PerformTimeStep\""), steps);
+  EXPECT_EQ(Occurrences(json, "\"name\": \"UpdateVehiclesAtEnd\""), steps);
+  EXPECT_GE(Occurrences(json, "\"name\": \"ComputeTimeStep\""), steps);
+
+  const std::filesystem::path path = "timeline_test.json";
+  EXPECT_TRUE(GlobalTimeline().Write(path));
+  EXPECT_EQ(std::filesystem::file_size(path), json.size());
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,205 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/TraceRecorder.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "../source/ObserverGroup.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/TraceReader.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Observer that counts the takeoffs and faults of a simulation.
+class CountingObserver : public SimulationObserver {
+public:
+  void OnTakeoff(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/) noexcept {
+    ++takeoffs;
+  }
+
+  void OnFault(const PhQ::Time<>& /*time*/, const Vehicle& /*vehicle*/,
+               const int64_t fault_count) noexcept {
+    faults += fault_count;
+  }
+
+  int64_t takeoffs = 0;
+
+  int64_t faults = 0;
+};
+
+std::shared_ptr<const VehicleModel> CreateVehicleModel() {
+  return std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model B",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(1.0, PhQ::Unit::Speed::MetrePerSecond),
+      /*battery_capacity=*/PhQ::Energy(1.0, PhQ::Unit::Energy::Joule),
+      /*charging_duration=*/PhQ::Time(1.0, PhQ::Unit::Time::Second),
+      /*fault_rate=*/PhQ::Frequency(1.0, PhQ::Unit::Frequency::Hertz),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(1.0, PhQ::Unit::TransportEnergyConsumption::JoulePerMetre));
+}
+
+TEST(TraceRecorder, RoundTrip) {
+  const std::filesystem::path path{"round_trip.trace"};
+
+  std::vector<TraceRecord> records;
+  for (int64_t index = 0; index < 10000; ++index) {
+    TraceRecord record;
+    record.event = static_cast<TraceEvent>(index % TraceEventCount);
+    record.time_nanoseconds = index * 1000000 - (index % 7) * 3;
+    record.vehicle_id = index % 2 == 0 ? index : -index;
+    record.charging_station_id = index % 13;
+    record.fault_count = index % 5;
+    records.push_back(record);
+  }
+
+  {
+    TraceRecorder recorder{path, /*sampling_interval=*/3};
+    ASSERT_TRUE(recorder.IsOpen());
+    EXPECT_EQ(recorder.Path(), path);
+    EXPECT_EQ(recorder.SamplingInterval(), 3);
+    for (const TraceRecord& record : records) {
+      recorder.Record(record);
+    }
+    EXPECT_EQ(recorder.RecordCount(), records.size());
+  }
+
+  TraceReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.SamplingInterval(), 3);
+  EXPECT_EQ(reader.ReadAll(), records);
+  EXPECT_TRUE(reader.IsValid());
+
+  std::filesystem::remove(path);
+}
+
+TEST(TraceRecorder, Compact) {
+  const std::filesystem::path path{"compact.trace"};
+
+  {
+    TraceRecorder recorder{path};
+    TraceRecord record;
+    record.event = TraceEvent::Takeoff;
+    for (int64_t index = 0; index < 1000; ++index) {
+      record.time_nanoseconds = index;
+      record.vehicle_id = index % 50;
+      recorder.Record(record);
+    }
+  }
+
+  // Small time differences and IDs take one byte each, plus one byte for the kind of event.
+  EXPECT_LE(std::filesystem::file_size(path), 16 + 1000 * 3);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TraceRecorder, Sampling) {
+  TraceRecorder all{std::filesystem::path()};
+  EXPECT_FALSE(all.IsOpen());
+  EXPECT_TRUE(all.Samples(0));
+  EXPECT_TRUE(all.Samples(12345));
+
+  TraceRecorder some{std::filesystem::path(), /*sampling_interval=*/4};
+  int64_t sampled = 0;
+  for (VehicleId id = 0; id < 10000; ++id) {
+    sampled += some.Samples(id) ? 1 : 0;
+  }
+  EXPECT_GT(sampled, 2200);
+  EXPECT_LT(sampled, 2800);
+}
+
+TEST(TraceRecorder, InvalidFile) {
+  const std::filesystem::path path{"invalid.trace"};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "NOTATRACEFILE";
+  }
+
+  TraceReader reader{path};
+  EXPECT_FALSE(reader.IsValid());
+  EXPECT_FALSE(reader.Next().has_value());
+
+  std::filesystem::remove(path);
+}
+
+TEST(TraceRecorder, Simulation) {
+  const std::filesystem::path path{"simulation.trace"};
+  const PhQ::Time duration{5.0, PhQ::Unit::Time::Second};
+
+  Vehicles vehicles;
+  vehicles.Insert(std::make_shared<Vehicle>(/*id=*/222, CreateVehicleModel()));
+
+  ChargingStations charging_stations{1};
+
+  std::random_device random_device;
+  std::mt19937_64 random_generator(random_device());
+  random_generator.seed(0);
+
+  CountingObserver counting_observer;
+  {
+    TraceRecorder recorder{path};
+    Simulation<ObserverGroup<CountingObserver, TraceObserver>> simulation{
+        duration, vehicles, charging_stations, random_generator, {{}, TraceObserver{&recorder}}};
+    simulation.Run();
+    counting_observer = simulation.Observer().Get<0>();
+  }
+
+  TraceReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  const std::vector<TraceRecord> records = reader.ReadAll();
+  EXPECT_TRUE(reader.IsValid());
+
+  int64_t takeoffs = 0;
+  int64_t enqueues = 0;
+  int64_t faults = 0;
+  int64_t previous_time_nanoseconds = 0;
+  for (const TraceRecord& record : records) {
+    EXPECT_EQ(record.vehicle_id, 222);
+    EXPECT_GE(record.time_nanoseconds, previous_time_nanoseconds);
+    previous_time_nanoseconds = record.time_nanoseconds;
+    takeoffs += record.event == TraceEvent::Takeoff ? 1 : 0;
+    enqueues += record.event == TraceEvent::Enqueue ? 1 : 0;
+    faults += record.event == TraceEvent::Fault ? record.fault_count : 0;
+    if (record.event == TraceEvent::Enqueue) {
+      EXPECT_EQ(record.charging_station_id, 0);
+    }
+  }
+  EXPECT_EQ(takeoffs, 3);
+  EXPECT_EQ(takeoffs, counting_observer.takeoffs);
+  EXPECT_EQ(enqueues, 3);
+  EXPECT_EQ(faults, counting_observer.faults);
+  EXPECT_EQ(faults, vehicles.At(222)->Statistics().TotalFaultCount());
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+
+}  // namespace Demo
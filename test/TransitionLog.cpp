@@ -0,0 +1,226 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/TransitionLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../source/SampleVehicleModels.hpp"
+#include "../source/Simulation.hpp"
+#include "../source/TransitionLogReader.hpp"
+#include "../source/TransitionLogReplay.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Expects two quantities to be equal to within a relative tolerance, since replayed times are
+// rounded to the nearest nanosecond.
+template <typename Quantity>
+void ExpectNear(const Quantity& first, const Quantity& second) {
+  EXPECT_NEAR(first.Value(), second.Value(), 1.0E-6 * std::max(std::abs(second.Value()), 1.0));
+}
+
+// Expects two sets of statistics to be equal to within the tolerance of ExpectNear.
+void ExpectNear(const Statistics& first, const Statistics& second) {
+  EXPECT_EQ(first.TotalFlightCount(), second.TotalFlightCount());
+  ExpectNear(first.TotalFlightDuration(), second.TotalFlightDuration());
+  ExpectNear(first.TotalFlightDistance(), second.TotalFlightDistance());
+  ExpectNear(first.TotalFlightPassengerDistance(), second.TotalFlightPassengerDistance());
+  EXPECT_EQ(first.TotalChargingSessionCount(), second.TotalChargingSessionCount());
+  ExpectNear(first.TotalChargingDuration(), second.TotalChargingDuration());
+  EXPECT_EQ(first.TotalFaultCount(), second.TotalFaultCount());
+}
+
+TEST(TransitionLog, RoundTrip) {
+  const std::filesystem::path path{"round_trip.transitions"};
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  std::mt19937_64 random_generator(0);
+  const Vehicles vehicles{10, vehicle_models, random_generator};
+
+  std::vector<TraceRecord> records;
+  for (int64_t index = 0; index < 1000; ++index) {
+    TraceRecord record;
+    record.event = static_cast<TraceEvent>(index % TraceEventCount);
+    record.time_nanoseconds = index * 1000;
+    record.vehicle_id = index % 10;
+    record.charging_station_id = index % 3;
+    record.fault_count = 1 + index % 2;
+    records.push_back(record);
+  }
+
+  {
+    TransitionLogWriter writer{path, vehicle_models, vehicles, /*block_size=*/256};
+    ASSERT_TRUE(writer.IsOpen());
+    for (const TraceRecord& record : records) {
+      writer.Record(record);
+    }
+    writer.Close(PhQ::Time(1.0, PhQ::Unit::Time::Second));
+    EXPECT_EQ(writer.RecordCount(), records.size());
+    EXPECT_GT(writer.BlockCount(), 1);
+  }
+
+  const TransitionLogReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.Size(), std::filesystem::file_size(path));
+  EXPECT_EQ(reader.RecordCount(), records.size());
+  ASSERT_TRUE(reader.EndTimeNanoseconds().has_value());
+  EXPECT_EQ(reader.EndTimeNanoseconds().value(), 1000000000);
+
+  ASSERT_EQ(reader.Models().Size(), vehicle_models.Size());
+  for (const std::shared_ptr<const VehicleModel>& model : vehicle_models) {
+    const std::shared_ptr<const VehicleModel> read_model = reader.Models().At(model->Id());
+    ASSERT_NE(read_model, nullptr);
+    EXPECT_EQ(read_model->ManufacturerNameEnglish(), model->ManufacturerNameEnglish());
+    EXPECT_EQ(read_model->ModelNameEnglish(), model->ModelNameEnglish());
+    EXPECT_EQ(read_model->PassengerCount(), model->PassengerCount());
+    EXPECT_EQ(read_model->CruiseSpeed(), model->CruiseSpeed());
+    EXPECT_EQ(read_model->BatteryCapacity(), model->BatteryCapacity());
+  }
+
+  ASSERT_EQ(reader.Vehicles().size(), vehicles.Size());
+  for (const TransitionLogVehicle& vehicle : reader.Vehicles()) {
+    ASSERT_TRUE(vehicles.Exists(vehicle.id));
+    EXPECT_EQ(vehicle.model_id, vehicles.At(vehicle.id)->Model()->Id());
+  }
+
+  // Decode the blocks in reverse order to show that they are independent.
+  std::vector<std::vector<TraceRecord>> blocks_records(reader.Blocks().size());
+  for (std::size_t index = reader.Blocks().size(); index-- > 0;) {
+    EXPECT_TRUE(TransitionLogReader::DecodeBlock(
+        reader.Blocks()[index],
+        [&](const TraceRecord& record) { blocks_records[index].push_back(record); }));
+  }
+  std::vector<TraceRecord> decoded_records;
+  for (const std::vector<TraceRecord>& block_records : blocks_records) {
+    decoded_records.insert(decoded_records.end(), block_records.begin(), block_records.end());
+  }
+  EXPECT_EQ(decoded_records, records);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TransitionLog, Replay) {
+  const std::filesystem::path path{"replay.transitions"};
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  std::mt19937_64 random_generator(0);
+  Vehicles vehicles{50, vehicle_models, random_generator};
+  ChargingStations charging_stations{3};
+
+  {
+    TransitionLogWriter writer{path, vehicle_models, vehicles, /*block_size=*/512};
+    Simulation<TransitionLogObserver> simulation{
+        PhQ::Time(3.0, PhQ::Unit::Time::Hour), vehicles, charging_stations, random_generator,
+        TransitionLogObserver{&writer}};
+    simulation.Run();
+    writer.Close(simulation.ElapsedTime());
+  }
+
+  const TransitionLogReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_GT(reader.Blocks().size(), 1);
+
+  const AggregateStatistics aggregate_statistics{vehicles};
+
+  for (const std::size_t thread_count : {1, 4}) {
+    const TransitionLogReplay replay{reader, thread_count};
+    ASSERT_TRUE(replay.IsValid());
+    ExpectNear(replay.EndTime(), PhQ::Time(3.0, PhQ::Unit::Time::Hour));
+
+    for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+      const std::optional<Statistics> statistics = replay.At(vehicle->Id());
+      ASSERT_TRUE(statistics.has_value());
+      ExpectNear(statistics.value(), vehicle->Statistics());
+    }
+
+    ASSERT_EQ(replay.Aggregate().Size(), aggregate_statistics.Size());
+    for (const std::pair<const VehicleModelId, Statistics>& id_and_statistics :
+         aggregate_statistics) {
+      const std::optional<Statistics> statistics = replay.Aggregate().At(id_and_statistics.first);
+      ASSERT_TRUE(statistics.has_value());
+      ExpectNear(statistics.value(), id_and_statistics.second);
+    }
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(TransitionLog, Truncated) {
+  const std::filesystem::path path{"truncated.transitions"};
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  std::mt19937_64 random_generator(0);
+  const Vehicles vehicles{2, vehicle_models, random_generator};
+
+  {
+    TransitionLogWriter writer{path, vehicle_models, vehicles, /*block_size=*/128};
+    TraceRecord record;
+    for (int64_t index = 0; index < 100; ++index) {
+      record.event = index % 2 == 0 ? TraceEvent::Takeoff : TraceEvent::Landing;
+      record.time_nanoseconds = index * 10;
+      record.vehicle_id = 0;
+      writer.Record(record);
+    }
+  }
+
+  // Remove the final empty block and part of the last block.
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 20);
+
+  const TransitionLogReader reader{path};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_FALSE(reader.EndTimeNanoseconds().has_value());
+  EXPECT_LT(reader.RecordCount(), 100);
+
+  const TransitionLogReplay replay{reader};
+  ASSERT_TRUE(replay.IsValid());
+  const std::optional<Statistics> statistics = replay.At(0);
+  ASSERT_TRUE(statistics.has_value());
+  EXPECT_EQ(statistics->TotalFlightCount(), static_cast<int64_t>(reader.RecordCount() + 1) / 2);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TransitionLog, InvalidFile) {
+  const std::filesystem::path path{"invalid.transitions"};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "NOTATRANSITIONLOG";
+  }
+
+  const TransitionLogReader reader{path};
+  EXPECT_FALSE(reader.IsValid());
+
+  const TransitionLogReplay replay{reader};
+  EXPECT_FALSE(replay.IsValid());
+
+  std::filesystem::remove(path);
+
+  const TransitionLogReader missing{path};
+  EXPECT_FALSE(missing.IsValid());
+}
+
+}  // namespace
+
+}  // namespace Demo
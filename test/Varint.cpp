@@ -0,0 +1,96 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/Varint.hpp"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace Demo {
+
+namespace {
+
+TEST(Varint, ZigZag) {
+  EXPECT_EQ(ZigZagEncode(0), 0);
+  EXPECT_EQ(ZigZagEncode(-1), 1);
+  EXPECT_EQ(ZigZagEncode(1), 2);
+  EXPECT_EQ(ZigZagEncode(-2), 3);
+  EXPECT_EQ(ZigZagEncode(2), 4);
+  EXPECT_EQ(ZigZagEncode(std::numeric_limits<int64_t>::max()),
+            std::numeric_limits<uint64_t>::max() - 1);
+  EXPECT_EQ(ZigZagEncode(std::numeric_limits<int64_t>::min()),
+            std::numeric_limits<uint64_t>::max());
+
+  for (const int64_t value :
+       {int64_t{0}, int64_t{-1}, int64_t{1}, int64_t{-123456789}, int64_t{987654321},
+        std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+    EXPECT_EQ(ZigZagDecode(ZigZagEncode(value)), value);
+  }
+}
+
+TEST(Varint, Size) {
+  uint8_t buffer[MaximumVarintSize];
+  EXPECT_EQ(EncodeVarint(0, buffer) - buffer, 1);
+  EXPECT_EQ(EncodeVarint(127, buffer) - buffer, 1);
+  EXPECT_EQ(EncodeVarint(128, buffer) - buffer, 2);
+  EXPECT_EQ(EncodeVarint(16383, buffer) - buffer, 2);
+  EXPECT_EQ(EncodeVarint(16384, buffer) - buffer, 3);
+  EXPECT_EQ(EncodeVarint(std::numeric_limits<uint64_t>::max(), buffer) - buffer,
+            static_cast<std::ptrdiff_t>(MaximumVarintSize));
+}
+
+TEST(Varint, RoundTrip) {
+  const std::vector<uint64_t> values{
+      0, 1, 127, 128, 300, 16384, 1ULL << 35, 1ULL << 63, std::numeric_limits<uint64_t>::max()};
+  std::vector<uint8_t> buffer(values.size() * MaximumVarintSize);
+  uint8_t* end = buffer.data();
+  for (const uint64_t value : values) {
+    end = EncodeVarint(value, end);
+  }
+
+  const uint8_t* current = buffer.data();
+  for (const uint64_t value : values) {
+    const std::optional<uint64_t> decoded = DecodeVarint(current, end);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded.value(), value);
+  }
+  EXPECT_EQ(current, end);
+}
+
+TEST(Varint, Truncated) {
+  uint8_t buffer[MaximumVarintSize];
+  const uint8_t* const end = EncodeVarint(300, buffer);
+  const uint8_t* current = buffer;
+  EXPECT_FALSE(DecodeVarint(current, end - 1).has_value());
+  EXPECT_EQ(current, buffer);
+  EXPECT_FALSE(DecodeVarint(current, current).has_value());
+
+  const uint8_t overlong[MaximumVarintSize + 1] = {
+      0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+  current = overlong;
+  EXPECT_FALSE(DecodeVarint(current, overlong + sizeof(overlong)).has_value());
+}
+
+}  // namespace
+
+}  // namespace Demo
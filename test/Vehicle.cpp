@@ -32,6 +32,7 @@ TEST(Vehicle, DefaultConstructor) {
   const Vehicle vehicle;
   EXPECT_EQ(vehicle.Id(), 0);
   EXPECT_EQ(vehicle.Model(), nullptr);
+  EXPECT_EQ(vehicle.ModelIndex(), NoVehicleModel);
   EXPECT_EQ(vehicle.Status(), VehicleStatus::OnStandby);
   EXPECT_EQ(vehicle.ChargingStationId(), std::nullopt);
   EXPECT_EQ(vehicle.Battery(), PhQ::Energy<>::Zero());
@@ -62,6 +63,12 @@ TEST(Vehicle, MainConstructor) {
 
   EXPECT_EQ(vehicle.Id(), id);
   EXPECT_EQ(vehicle.Model(), vehicle_model);
+  EXPECT_EQ(vehicle.ModelTable()->Model(vehicle.ModelIndex()), vehicle_model);
+
+  // Vehicles constructed from the same vehicle model share one vehicle model table.
+  const Vehicle other = {id + 1, vehicle_model};
+  EXPECT_EQ(other.ModelTable(), vehicle.ModelTable());
+  EXPECT_EQ(other.ModelIndex(), vehicle.ModelIndex());
   EXPECT_EQ(vehicle.Status(), VehicleStatus::OnStandby);
   EXPECT_EQ(vehicle.ChargingStationId(), std::nullopt);
   EXPECT_EQ(vehicle.Battery(), vehicle_model->BatteryCapacity());
@@ -72,6 +79,48 @@ TEST(Vehicle, MainConstructor) {
   EXPECT_EQ(vehicle.DurationToNextStatusChange(), vehicle_model->EnduranceLimit());
 }
 
+TEST(Vehicle, HomeChargingStation) {
+  const std::shared_ptr<const VehicleModel> vehicle_model = std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model A",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(1.0, PhQ::Unit::Speed::MetrePerSecond),
+      /*battery_capacity=*/PhQ::Energy(2.0, PhQ::Unit::Energy::Joule),
+      /*charging_duration=*/PhQ::Time(1.0, PhQ::Unit::Time::Second),
+      /*fault_rate=*/PhQ::Frequency(1.0, PhQ::Unit::Frequency::Hertz),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(1.0, PhQ::Unit::TransportEnergyConsumption::JoulePerMetre));
+  VehicleModelTable model_table;
+  const VehicleModelIndex model_index = model_table.Register(vehicle_model);
+
+  ChargingStations charging_stations;
+  charging_stations.Insert(std::make_shared<ChargingStation>(0));
+  charging_stations.Insert(std::make_shared<ChargingStation>(1));
+  charging_stations.At(0)->Enqueue(333);
+
+  // The vehicle charges at its home charging station even though its queue is longer.
+  Vehicle vehicle{
+      222, &model_table, model_index, /*state_of_charge=*/0.0, /*home_charging_station_id=*/0};
+  EXPECT_EQ(vehicle.Battery(), PhQ::Energy<>::Zero());
+  EXPECT_EQ(vehicle.HomeChargingStationId(), 0);
+  vehicle.Update(charging_stations);
+  EXPECT_EQ(vehicle.Status(), VehicleStatus::WaitingToCharge);
+  EXPECT_EQ(vehicle.ChargingStationId(), 0);
+
+  // A vehicle whose home charging station does not exist charges at the shortest queue.
+  Vehicle other{
+      444, &model_table, model_index, /*state_of_charge=*/-1.0, /*home_charging_station_id=*/7};
+  other.Update(charging_stations);
+  EXPECT_EQ(other.Status(), VehicleStatus::Charging);
+  EXPECT_EQ(other.ChargingStationId(), 1);
+
+  const Vehicle partial{
+      555, &model_table, model_index, /*state_of_charge=*/0.25, std::nullopt};
+  EXPECT_EQ(partial.Battery(), PhQ::Energy(0.5, PhQ::Unit::Energy::Joule));
+  EXPECT_EQ(partial.HomeChargingStationId(), std::nullopt);
+}
+
 TEST(Vehicle, TimeStep) {
   const VehicleId id = 222;
 
@@ -0,0 +1,140 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/VehicleGroup.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace Demo {
+
+namespace {
+
+std::shared_ptr<const VehicleModel> CreateVehicleModel(const double fault_rate_per_hour = 0.0) {
+  return std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model A",
+      /*passenger_count=*/3,
+      /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+      /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+      /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+      /*fault_rate=*/PhQ::Frequency(fault_rate_per_hour, PhQ::Unit::Frequency::PerHour),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(
+          1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile));
+}
+
+TEST(VehicleGroup, Insert) {
+  VehicleGroup group;
+  EXPECT_TRUE(group.Empty());
+  EXPECT_FALSE(group.Insert(Vehicle()));
+
+  const Vehicle vehicle{222, CreateVehicleModel()};
+  EXPECT_TRUE(group.Insert(vehicle));
+  EXPECT_EQ(group.Size(), 1);
+  EXPECT_EQ(group.Id(0), 222);
+  EXPECT_EQ(group.Battery(0), vehicle.Battery());
+  EXPECT_EQ(group.Statistics(0), vehicle.Statistics());
+}
+
+TEST(VehicleGroup, MatchesVehicles) {
+  const std::shared_ptr<const VehicleModel> model = CreateVehicleModel();
+  ChargingStations charging_stations{1};
+  std::mt19937_64 random_generator(0);
+  const PhQ::Time duration{1.0, PhQ::Unit::Time::Minute};
+
+  // Take off and fly a few vehicles individually and as a group.
+  std::vector<Vehicle> vehicles;
+  VehicleGroup group;
+  for (VehicleId id = 0; id < 7; ++id) {
+    vehicles.emplace_back(id, model);
+    vehicles.back().Update(charging_stations);
+    ASSERT_EQ(vehicles.back().Status(), VehicleStatus::Flying);
+    group.Insert(vehicles.back());
+  }
+  for (int64_t step = 0; step < 10; ++step) {
+    for (Vehicle& vehicle : vehicles) {
+      vehicle.PerformTimeStep(duration, charging_stations, random_generator);
+    }
+    group.Fly(duration);
+  }
+  for (std::size_t position = 0; position < vehicles.size(); ++position) {
+    EXPECT_DOUBLE_EQ(group.Battery(position).Value(), vehicles[position].Battery().Value());
+    const Statistics statistics = group.Statistics(position);
+    const Statistics& expected = vehicles[position].Statistics();
+    EXPECT_EQ(statistics.TotalFlightCount(), expected.TotalFlightCount());
+    EXPECT_DOUBLE_EQ(
+        statistics.TotalFlightDuration().Value(), expected.TotalFlightDuration().Value());
+    EXPECT_DOUBLE_EQ(
+        statistics.TotalFlightDistance().Value(), expected.TotalFlightDistance().Value());
+    EXPECT_DOUBLE_EQ(statistics.TotalFlightPassengerDistance().Value(),
+                     expected.TotalFlightPassengerDistance().Value());
+    EXPECT_DOUBLE_EQ(
+        statistics.MeanFlightDistance().Value(), expected.MeanFlightDistance().Value());
+  }
+
+  // Charge the group.
+  const PhQ::Energy battery = group.Battery(0);
+  group.Charge(duration);
+  EXPECT_DOUBLE_EQ(group.Battery(0).Value(),
+                   (battery + model->ChargingRate() * duration).Value());
+  EXPECT_EQ(group.Statistics(0).TotalChargingDuration(), duration);
+}
+
+TEST(VehicleGroup, FaultsMatchVehicles) {
+  const std::shared_ptr<const VehicleModel> model = CreateVehicleModel(30.0);
+  ChargingStations charging_stations{1};
+  BatchSampler vehicles_sampler(1);
+  BatchSampler group_sampler(1);
+  const PhQ::Time duration{1.0, PhQ::Unit::Time::Minute};
+
+  // Fly a few vehicles individually and as a group, drawing their faults from identical samplers.
+  std::vector<Vehicle> vehicles;
+  VehicleGroup group;
+  for (VehicleId id = 0; id < 11; ++id) {
+    vehicles.emplace_back(id, model);
+    vehicles.back().Update(charging_stations);
+    group.Insert(vehicles.back());
+  }
+  int64_t total = 0;
+  for (int64_t step = 0; step < 10; ++step) {
+    for (Vehicle& vehicle : vehicles) {
+      vehicle.PerformTimeStep(duration, charging_stations, vehicles_sampler);
+    }
+    group.Fly(duration);
+    total += group.RandomlyGenerateFaults(duration, group_sampler);
+  }
+  int64_t expected_total = 0;
+  for (std::size_t position = 0; position < vehicles.size(); ++position) {
+    EXPECT_EQ(group.Statistics(position).TotalFaultCount(),
+              vehicles[position].Statistics().TotalFaultCount());
+    expected_total += vehicles[position].Statistics().TotalFaultCount();
+  }
+  EXPECT_EQ(total, expected_total);
+  EXPECT_GT(total, 0);
+}
+
+}  // namespace
+
+}  // namespace Demo
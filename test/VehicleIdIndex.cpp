@@ -0,0 +1,92 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/VehicleIdIndex.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Demo {
+
+namespace {
+
+TEST(VehicleIdIndex, Dense) {
+  VehicleIdIndex<> index;
+  EXPECT_TRUE(index.Dense());
+  EXPECT_FALSE(index.Contains(0));
+  for (VehicleId id = 0; id < 100; ++id) {
+    EXPECT_TRUE(index.Insert(id, static_cast<std::size_t>(id)));
+  }
+  EXPECT_FALSE(index.Insert(42, 100));
+  EXPECT_TRUE(index.Dense());
+  EXPECT_EQ(index.Size(), 100);
+  EXPECT_EQ(index.Find(0), 0);
+  EXPECT_EQ(index.Find(99), 99);
+  EXPECT_EQ(index.Find(100), std::nullopt);
+  EXPECT_EQ(index.Find(-1), std::nullopt);
+}
+
+TEST(VehicleIdIndex, Sparse) {
+  VehicleIdIndex<> index;
+  EXPECT_TRUE(index.Insert(0, 0));
+  EXPECT_TRUE(index.Insert(1, 1));
+  EXPECT_TRUE(index.Insert(1000, 2));
+  EXPECT_FALSE(index.Dense());
+  EXPECT_TRUE(index.Insert(-7, 3));
+  EXPECT_FALSE(index.Insert(1, 4));
+  EXPECT_EQ(index.Size(), 4);
+  EXPECT_EQ(index.Find(0), 0);
+  EXPECT_EQ(index.Find(1), 1);
+  EXPECT_EQ(index.Find(1000), 2);
+  EXPECT_EQ(index.Find(-7), 3);
+  EXPECT_EQ(index.Find(2), std::nullopt);
+}
+
+TEST(VehicleIdIndex, SkippedPosition) {
+  // A duplicate vehicle ID leaves a gap in the positions, after which the index is sparse.
+  VehicleIdIndex<> index;
+  EXPECT_TRUE(index.Insert(0, 0));
+  EXPECT_FALSE(index.Insert(0, 1));
+  EXPECT_TRUE(index.Insert(1, 2));
+  EXPECT_FALSE(index.Dense());
+  EXPECT_EQ(index.Find(0), 0);
+  EXPECT_EQ(index.Find(1), 2);
+}
+
+TEST(VehicleIdIndex, Erase) {
+  VehicleIdIndex<> index;
+  EXPECT_FALSE(index.Erase(0));
+  for (VehicleId id = 0; id < 10; ++id) {
+    index.Insert(id, static_cast<std::size_t>(id));
+  }
+  EXPECT_TRUE(index.Erase(3));
+  EXPECT_FALSE(index.Erase(3));
+  EXPECT_FALSE(index.Dense());
+  EXPECT_EQ(index.Size(), 9);
+  EXPECT_EQ(index.Find(3), std::nullopt);
+  EXPECT_EQ(index.Find(4), 4);
+  EXPECT_TRUE(index.Insert(3, 10));
+  EXPECT_EQ(index.Find(3), 10);
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,149 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/VehicleModelCatalog.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../source/SampleVehicleModels.hpp"
+
+namespace Demo {
+
+namespace {
+
+// Writes a given text to a file at a given path.
+void WriteText(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream stream{path, std::ios::binary};
+  stream << text;
+}
+
+void ExpectEqual(const VehicleModelParameters& left, const VehicleModelParameters& right) {
+  EXPECT_DOUBLE_EQ(left.cruise_speed, right.cruise_speed);
+  EXPECT_DOUBLE_EQ(left.transport_power_usage, right.transport_power_usage);
+  EXPECT_DOUBLE_EQ(left.transport_energy_consumption, right.transport_energy_consumption);
+  EXPECT_DOUBLE_EQ(left.charging_rate, right.charging_rate);
+  EXPECT_DOUBLE_EQ(left.battery_capacity, right.battery_capacity);
+  EXPECT_DOUBLE_EQ(left.mean_fault_rate, right.mean_fault_rate);
+  EXPECT_EQ(left.passenger_count, right.passenger_count);
+}
+
+// Expects two vehicle models to have the same ID, names, and parameters.
+void ExpectSame(const VehicleModel& left, const VehicleModel& right) {
+  EXPECT_EQ(left.Id(), right.Id());
+  EXPECT_EQ(left.ManufacturerNameEnglish(), right.ManufacturerNameEnglish());
+  EXPECT_EQ(left.ModelNameEnglish(), right.ModelNameEnglish());
+  EXPECT_EQ(left.PassengerCount(), right.PassengerCount());
+  EXPECT_EQ(left.CruiseSpeed(), right.CruiseSpeed());
+  EXPECT_EQ(left.BatteryCapacity(), right.BatteryCapacity());
+  EXPECT_EQ(left.ChargingDuration(), right.ChargingDuration());
+  EXPECT_EQ(left.MeanFaultRate(), right.MeanFaultRate());
+  EXPECT_EQ(left.TransportEnergyConsumption(), right.TransportEnergyConsumption());
+}
+
+TEST(VehicleModelCatalog, Parameters) {
+  // The parameters are computed at compile time.
+  constexpr VehicleModelParameters parameters = SampleVehicleModelCatalog[0].Parameters();
+  static_assert(parameters.passenger_count == 4);
+  static_assert(parameters.battery_capacity == 320.0 * 3.6e6);
+
+  for (const VehicleModelSpec& spec : SampleVehicleModelCatalog) {
+    VehicleModelTable table;
+    const VehicleModelIndex index = table.Register(spec.ToVehicleModel());
+    ExpectEqual(spec.Parameters(), table.Parameters(index));
+  }
+}
+
+TEST(VehicleModelCatalog, SampleVehicleModels) {
+  const VehicleModels vehicle_models = GenerateSampleVehicleModels();
+  ASSERT_EQ(vehicle_models.Size(), SampleVehicleModelCatalog.size());
+  for (const VehicleModelSpec& spec : SampleVehicleModelCatalog) {
+    const std::shared_ptr<const VehicleModel> model = vehicle_models.At(spec.id);
+    ASSERT_NE(model, nullptr);
+    ExpectSame(*model, *spec.ToVehicleModel());
+  }
+}
+
+TEST(VehicleModelCatalog, Read) {
+  const std::filesystem::path path{"vehicle_models.csv"};
+  WriteText(path, std::string{VehicleModelCatalogCsvHeader} + "\r\n"
+                      + "7,Foxtrot Company,Foxtrot Model,6,140,400,0.5,0.15,2.0\r\n"
+                      + "\r\n"
+                      + "0,Alpha Company,Alpha Model,4,120,320,0.6,0.25,1.6");
+
+  const VehicleModels vehicle_models = ReadVehicleModelCatalog(path);
+  ASSERT_EQ(vehicle_models.Size(), 2);
+  ASSERT_NE(vehicle_models.At(0), nullptr);
+  ExpectSame(*vehicle_models.At(0), *SampleVehicleModelCatalog[0].ToVehicleModel());
+  const std::shared_ptr<const VehicleModel> model = vehicle_models.At(7);
+  ASSERT_NE(model, nullptr);
+  ExpectSame(*model, *VehicleModelSpec{7, "Foxtrot Company", "Foxtrot Model", 6, 140.0, 400.0,
+                                         0.5, 0.15, 2.0}
+                          .ToVehicleModel());
+
+  std::filesystem::remove(path);
+}
+
+TEST(VehicleModelCatalog, ReadWithoutHeader) {
+  const std::filesystem::path path{"vehicle_models_without_header.csv"};
+  WriteText(path, "1,Bravo Company,Bravo Model,5,100,100,0.2,0.1,1.5\n");
+
+  const VehicleModels vehicle_models = ReadVehicleModelCatalog(path);
+  ASSERT_EQ(vehicle_models.Size(), 1);
+  ASSERT_NE(vehicle_models.At(1), nullptr);
+  ExpectSame(*vehicle_models.At(1), *SampleVehicleModelCatalog[1].ToVehicleModel());
+
+  std::filesystem::remove(path);
+}
+
+TEST(VehicleModelCatalog, Invalid) {
+  const std::filesystem::path path{"invalid_vehicle_models.csv"};
+
+  // Missing field.
+  WriteText(path, "1,Bravo Company,Bravo Model,5,100,100,0.2,0.1\n");
+  EXPECT_TRUE(ReadVehicleModelCatalog(path).Empty());
+
+  // Non-numeric field.
+  WriteText(path, "1,Bravo Company,Bravo Model,five,100,100,0.2,0.1,1.5\n");
+  EXPECT_TRUE(ReadVehicleModelCatalog(path).Empty());
+
+  // Extra field.
+  WriteText(path, "1,Bravo Company,Bravo Model,5,100,100,0.2,0.1,1.5,7\n");
+  EXPECT_TRUE(ReadVehicleModelCatalog(path).Empty());
+
+  // Repeated vehicle model ID.
+  WriteText(path, "1,Bravo Company,Bravo Model,5,100,100,0.2,0.1,1.5\n"
+                  "1,Delta Company,Delta Model,2,90,120,0.62,0.22,0.8\n");
+  EXPECT_TRUE(ReadVehicleModelCatalog(path).Empty());
+
+  std::filesystem::remove(path);
+
+  // Missing file.
+  EXPECT_TRUE(ReadVehicleModelCatalog(path).Empty());
+}
+
+}  // namespace
+
+}  // namespace Demo
@@ -0,0 +1,81 @@
+// Copyright © 2023-2024 Alexandre Coderre-Chabot
+//
+// This file is part of Joby Demonstration, a simple demonstration of C++ principles in the context
+// of a vehicle fleet simulation.
+//
+// Joby Demonstration is hosted at:
+//     https://github.com/acodcha/joby-demo
+//
+// This file is licensed under the MIT license (https://mit-license.org). Permission is hereby
+// granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//   - The above copyright notice and this permission notice shall be included in all copies or
+//     substantial portions of the Software.
+//   - THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//     BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//     NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//     DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../source/VehicleModelTable.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Demo {
+
+namespace {
+
+std::shared_ptr<const VehicleModel> CreateVehicleModel(const VehicleModelId id) {
+  return std::make_shared<const VehicleModel>(
+      id,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model A",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(2.0, PhQ::Unit::Speed::MetrePerSecond),
+      /*battery_capacity=*/PhQ::Energy(10.0, PhQ::Unit::Energy::Joule),
+      /*charging_duration=*/PhQ::Time(5.0, PhQ::Unit::Time::Second),
+      /*fault_rate=*/PhQ::Frequency(0.5, PhQ::Unit::Frequency::Hertz),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(3.0, PhQ::Unit::TransportEnergyConsumption::JoulePerMetre));
+}
+
+TEST(VehicleModelTable, Parameters) {
+  EXPECT_EQ(sizeof(VehicleModelParameters), 64);
+
+  VehicleModelTable table;
+  const VehicleModelIndex index = table.Register(CreateVehicleModel(111));
+  EXPECT_EQ(index, 0);
+
+  const VehicleModelParameters& parameters = table.Parameters(index);
+  EXPECT_EQ(parameters.cruise_speed, 2.0);
+  EXPECT_EQ(parameters.transport_power_usage, 6.0);
+  EXPECT_EQ(parameters.transport_energy_consumption, 3.0);
+  EXPECT_EQ(parameters.charging_rate, 2.0);
+  EXPECT_EQ(parameters.battery_capacity, 10.0);
+  EXPECT_EQ(parameters.mean_fault_rate, 0.5);
+  EXPECT_EQ(parameters.passenger_count, 4);
+}
+
+TEST(VehicleModelTable, Register) {
+  VehicleModelTable table;
+  const std::shared_ptr<const VehicleModel> model111 = CreateVehicleModel(111);
+  const std::shared_ptr<const VehicleModel> model222 = CreateVehicleModel(222);
+
+  EXPECT_EQ(table.Register(nullptr), NoVehicleModel);
+  EXPECT_EQ(table.Register(model111), 0);
+  EXPECT_EQ(table.Register(model222), 1);
+  EXPECT_EQ(table.Register(model111), 0);
+  EXPECT_EQ(table.Size(), 2);
+
+  EXPECT_EQ(table.Model(0), model111);
+  EXPECT_EQ(table.Model(1), model222);
+  EXPECT_EQ(table.Model(2), nullptr);
+  EXPECT_EQ(table.Model(NoVehicleModel), nullptr);
+}
+
+}  // namespace
+
+}  // namespace Demo
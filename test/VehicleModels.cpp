@@ -150,6 +150,50 @@ TEST(VehicleModels, At) {
   EXPECT_EQ(models.At(789), nullptr);
 }
 
+TEST(VehicleModels, Table) {
+  const std::shared_ptr<const VehicleModel> shared111 = std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model A",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+      /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+      /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+      /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(
+          1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile));
+  const std::shared_ptr<const VehicleModel> shared222 = std::make_shared<const VehicleModel>(
+      /*id=*/222,
+      /*manufacturer_name_english=*/"Manufacturer B",
+      /*model_name_english=*/"Model B",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(110.0, PhQ::Unit::Speed::MilePerHour),
+      /*battery_capacity=*/PhQ::Energy(180.0, PhQ::Unit::Energy::KilowattHour),
+      /*charging_duration=*/PhQ::Time(0.9, PhQ::Unit::Time::Hour),
+      /*fault_rate=*/PhQ::Frequency(0.11, PhQ::Unit::Frequency::PerHour),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(
+          2.2, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile));
+
+  VehicleModels models;
+  EXPECT_EQ(models.Table(), nullptr);
+  models.Insert(shared111);
+  const std::shared_ptr<const VehicleModelTable> table = models.Table();
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(table->Size(), 1);
+  EXPECT_EQ(table->Model(0), shared111);
+
+  // Inserting into a collection whose table is shared, as it is with vehicles, leaves the shared
+  // table unchanged.
+  models.Insert(shared222);
+  EXPECT_EQ(table->Size(), 1);
+  EXPECT_EQ(models.Table()->Size(), 2);
+  EXPECT_EQ(models.Table()->Model(0), shared111);
+  EXPECT_EQ(models.Table()->Model(1), shared222);
+  EXPECT_EQ(models.Table()->Parameters(1).battery_capacity, shared222->BatteryCapacity().Value());
+}
+
 TEST(VehicleModels, Random) {
   const std::shared_ptr<const VehicleModel> shared111 = std::make_shared<const VehicleModel>(
       /*id=*/111,
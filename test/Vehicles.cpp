@@ -24,6 +24,10 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <optional>
+#include <vector>
+
 namespace Demo {
 
 namespace {
@@ -52,11 +56,20 @@ TEST(Vehicles, RandomConstructor) {
   const Vehicles vehicles{4, vehicle_models, random_generator};
 
   EXPECT_EQ(vehicles.Size(), 4);
+  EXPECT_TRUE(vehicles.DenseIds());
   EXPECT_NE(vehicles.At(0), nullptr);
   EXPECT_NE(vehicles.At(1), nullptr);
   EXPECT_NE(vehicles.At(2), nullptr);
   EXPECT_NE(vehicles.At(3), nullptr);
   EXPECT_EQ(vehicles.At(4), nullptr);
+
+  // The vehicles point to the vehicle model table of the collection of vehicle models, which the
+  // collection of vehicles keeps alive.
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    EXPECT_EQ(vehicle->ModelTable(), vehicle_models.Table().get());
+  }
+  vehicle_models = VehicleModels();
+  EXPECT_EQ(vehicles.At(0)->Model(), model);
 }
 
 TEST(Vehicles, Empty) {
@@ -137,6 +150,70 @@ TEST(Vehicles, Insert) {
   EXPECT_FALSE(vehicles.Insert(vehicle222));
   EXPECT_TRUE(vehicles.Insert(vehicle333));
   EXPECT_FALSE(vehicles.Insert(vehicle333));
+  EXPECT_FALSE(vehicles.DenseIds());
+  EXPECT_EQ(vehicles.At(222), vehicle222);
+  EXPECT_EQ(vehicles.At(333), vehicle333);
+  EXPECT_EQ(vehicles.At(0), nullptr);
+  EXPECT_EQ(vehicles.Find(222), vehicle222.get());
+  EXPECT_EQ(vehicles.Find(0), nullptr);
+}
+
+TEST(Vehicles, Remove) {
+  const std::shared_ptr<const VehicleModel> model = std::make_shared<const VehicleModel>(
+      /*id=*/111,
+      /*manufacturer_name_english=*/"Manufacturer A",
+      /*model_name_english=*/"Model A",
+      /*passenger_count=*/4,
+      /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+      /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+      /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+      /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
+      /*transport_energy_consumption=*/
+      PhQ::TransportEnergyConsumption(
+          1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile));
+
+  const std::shared_ptr<Vehicle> vehicle0 = std::make_shared<Vehicle>(0, model);
+
+  const std::shared_ptr<Vehicle> vehicle1 = std::make_shared<Vehicle>(1, model);
+
+  const std::shared_ptr<Vehicle> vehicle2 = std::make_shared<Vehicle>(2, model);
+
+  Vehicles vehicles;
+  vehicles.Insert(vehicle0);
+  vehicles.Insert(vehicle1);
+  vehicles.Insert(vehicle2);
+  EXPECT_TRUE(vehicles.DenseIds());
+
+  const SlotHandle handle0 = vehicles.Handle(0);
+  const SlotHandle handle2 = vehicles.Handle(2);
+  EXPECT_EQ(vehicles.Find(handle0), vehicle0.get());
+
+  EXPECT_EQ(vehicles.VehicleModelCount(111), 3);
+  EXPECT_TRUE(vehicles.Retired().empty());
+
+  EXPECT_TRUE(vehicles.Remove(0));
+  EXPECT_FALSE(vehicles.Remove(0));
+  EXPECT_FALSE(vehicles.Remove(333));
+  EXPECT_EQ(vehicles.VehicleModelCount(111), 2);
+  ASSERT_EQ(vehicles.Retired().size(), 1);
+  EXPECT_EQ(vehicles.Retired().begin()->second, vehicle0);
+  EXPECT_FALSE(vehicles.DenseIds());
+  EXPECT_EQ(vehicles.Size(), 2);
+  EXPECT_FALSE(vehicles.Exists(0));
+  EXPECT_EQ(vehicles.At(0), nullptr);
+  EXPECT_EQ(vehicles.Find(handle0), nullptr);
+  EXPECT_EQ(vehicles.Find(handle2), vehicle2.get());
+  EXPECT_EQ(vehicles.At(1), vehicle1);
+  EXPECT_EQ(*vehicles.cbegin(), vehicle2);
+
+  EXPECT_TRUE(vehicles.Insert(vehicle0));
+  EXPECT_EQ(vehicles.Size(), 3);
+  EXPECT_EQ(vehicles.VehicleModelCount(111), 3);
+  EXPECT_TRUE(vehicles.Retired().empty());
+  EXPECT_EQ(vehicles.At(0), vehicle0);
+  EXPECT_EQ(vehicles.Find(handle0), nullptr);
+  EXPECT_EQ(vehicles.Find(vehicles.Handle(0)), vehicle0.get());
+  EXPECT_EQ(vehicles.Find(vehicles.Handle(333)), nullptr);
 }
 
 TEST(Vehicles, Exists) {
@@ -267,6 +344,128 @@ TEST(Vehicles, Iterator) {
   EXPECT_EQ(count3, 2);
 }
 
+TEST(Vehicles, FleetComposition) {
+  VehicleModels vehicle_models;
+  for (const VehicleModelId id : {111, 222, 333}) {
+    vehicle_models.Insert(std::make_shared<const VehicleModel>(
+        /*id=*/id,
+        /*manufacturer_name_english=*/"Manufacturer",
+        /*model_name_english=*/"Model",
+        /*passenger_count=*/4,
+        /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+        /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+        /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+        /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
+        /*transport_energy_consumption=*/
+        PhQ::TransportEnergyConsumption(
+            1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
+  }
+
+  std::mt19937_64 random_generator(0);
+
+  const Vehicles vehicles{
+      10, vehicle_models, FleetComposition{{7.0, 0.0, 3.0}, FleetCompositionMode::Exact},
+      random_generator};
+
+  EXPECT_EQ(vehicles.Size(), 10);
+  std::size_t first_model_count = 0;
+  for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+    EXPECT_NE(vehicle->Model()->Id(), 222);
+    first_model_count += vehicle->Model()->Id() == 111 ? 1 : 0;
+  }
+  EXPECT_EQ(first_model_count, 7);
+  EXPECT_NE(vehicles.At(9), nullptr);
+  EXPECT_EQ(vehicles.At(10), nullptr);
+
+  const Vehicles mismatched{10, vehicle_models, FleetComposition{{1.0, 1.0}}, random_generator};
+  EXPECT_TRUE(mismatched.Empty());
+}
+
+TEST(Vehicles, ThreadCount) {
+  VehicleModels vehicle_models;
+  for (const VehicleModelId id : {111, 222}) {
+    vehicle_models.Insert(std::make_shared<const VehicleModel>(
+        /*id=*/id,
+        /*manufacturer_name_english=*/"Manufacturer",
+        /*model_name_english=*/"Model",
+        /*passenger_count=*/4,
+        /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+        /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+        /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+        /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
+        /*transport_energy_consumption=*/
+        PhQ::TransportEnergyConsumption(
+            1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
+  }
+
+  std::mt19937_64 random_generator(0);
+  const Vehicles serial{100000, vehicle_models, FleetComposition{{3.0, 1.0}}, random_generator,
+                        std::pmr::new_delete_resource(), 1};
+  random_generator.seed(0);
+  const Vehicles parallel{100000, vehicle_models, FleetComposition{{3.0, 1.0}},
+                          random_generator, std::pmr::new_delete_resource(), 4};
+
+  ASSERT_EQ(serial.Size(), 100000);
+  ASSERT_EQ(parallel.Size(), 100000);
+  for (VehicleId id = 0; id < 100000; ++id) {
+    ASSERT_NE(parallel.At(id), nullptr);
+    EXPECT_EQ(parallel.At(id)->Id(), id);
+    EXPECT_EQ(parallel.At(id)->ModelIndex(), serial.At(id)->ModelIndex());
+  }
+}
+
+TEST(Vehicles, Roster) {
+  VehicleModels vehicle_models;
+  for (const VehicleModelId id : {111, 222}) {
+    vehicle_models.Insert(std::make_shared<const VehicleModel>(
+        /*id=*/id,
+        /*manufacturer_name_english=*/"Manufacturer",
+        /*model_name_english=*/"Model",
+        /*passenger_count=*/4,
+        /*cruise_speed=*/PhQ::Speed(120.0, PhQ::Unit::Speed::MilePerHour),
+        /*battery_capacity=*/PhQ::Energy(320.0, PhQ::Unit::Energy::KilowattHour),
+        /*charging_duration=*/PhQ::Time(0.6, PhQ::Unit::Time::Hour),
+        /*fault_rate=*/PhQ::Frequency(0.25, PhQ::Unit::Frequency::PerHour),
+        /*transport_energy_consumption=*/
+        PhQ::TransportEnergyConsumption(
+            1.6, PhQ::Unit::TransportEnergyConsumption::KilowattHourPerMile)));
+  }
+
+  const std::filesystem::path path{"vehicles.roster"};
+  std::vector<RosterEntry> entries;
+  for (VehicleId id = 0; id < 40000; ++id) {
+    entries.push_back({1000 + 7 * id, id % 3 == 0 ? 222 : 111, 0.5,
+                       id % 2 == 0 ? std::optional<ChargingStationId>(id % 5) : std::nullopt});
+  }
+  { const RosterFileWriter writer{path, entries, RosterFormat::Binary}; }
+
+  const Vehicles vehicles{Roster{path}, vehicle_models, std::pmr::new_delete_resource(), 4};
+  ASSERT_EQ(vehicles.Size(), entries.size());
+  EXPECT_FALSE(vehicles.DenseIds());
+  for (const RosterEntry& entry : entries) {
+    const Vehicle* const vehicle = vehicles.Find(entry.id);
+    ASSERT_NE(vehicle, nullptr);
+    EXPECT_EQ(vehicle->Model()->Id(), entry.model_id);
+    EXPECT_EQ(vehicle->Battery(), PhQ::Energy(160.0, PhQ::Unit::Energy::KilowattHour));
+    EXPECT_EQ(vehicle->HomeChargingStationId(), entry.home_charging_station_id);
+  }
+
+  entries[30000].model_id = 333;
+  { const RosterFileWriter writer{path, entries, RosterFormat::Csv}; }
+  EXPECT_TRUE(Vehicles(Roster{path}, vehicle_models).Empty());
+
+  entries[30000].model_id = 111;
+  entries[30000].id = entries[10].id;
+  { const RosterFileWriter writer{path, entries, RosterFormat::Csv}; }
+  EXPECT_TRUE(Vehicles(Roster{path}, vehicle_models).Empty());
+
+  entries[30000].id = -1;
+  { const RosterFileWriter writer{path, entries, RosterFormat::Csv}; }
+  EXPECT_EQ(Vehicles(Roster{path}, vehicle_models).Size(), entries.size());
+
+  std::filesystem::remove(path);
+}
+
 }  // namespace
 
 }  // namespace Demo